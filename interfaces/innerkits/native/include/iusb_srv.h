@@ -38,6 +38,29 @@ public:
 using TransferCallback = std::function<void(const TransferCallbackInfo &,
     const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &, uint64_t)>;
 
+class TransferBatchResult {
+public:
+    TransferCallbackInfo info;
+    std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> isoInfo;
+    uint64_t userData;
+};
+
+/* results are in submission order */
+using TransferBatchCallback = std::function<void(const std::vector<TransferBatchResult> &)>;
+
+/* completion of a transfer the service ran for the caller, clientData is only set for a request wait */
+class TransferDataResult {
+public:
+    int32_t status;
+    std::vector<uint8_t> clientData;
+    std::vector<uint8_t> bufferData;
+    uint64_t userData;
+};
+
+using TransferDataCallback = std::function<void(TransferDataResult &)>;
+/* the service started the transfer of userData, its timeout runs from here */
+using TransferStartedCallback = std::function<void(uint64_t)>;
+
 } // namespace USB
 } // namespace OHOS
 
@@ -16,13 +16,28 @@
 #ifndef SERIAL_DEATH_MONITOR_H
 #define SERIAL_DEATH_MONITOR_H
 
+#include <functional>
+#include <map>
+#include <mutex>
 #include "ipc_object_stub.h"
 
 namespace OHOS::USB {
+/* portId, bytes buffered by the service, overrun count of the port */
+using SerialDataCallback = std::function<void(int32_t, uint32_t, uint64_t)>;
+
 class SerialDeathMonitor : public OHOS::IPCObjectStub {
 public:
     explicit SerialDeathMonitor() : OHOS::IPCObjectStub() {}
     ~SerialDeathMonitor() override = default;
+
+    int32_t OnRemoteRequest(uint32_t code, OHOS::MessageParcel &data, OHOS::MessageParcel &reply,
+        OHOS::MessageOption &option) override;
+    void SetDataCallback(int32_t portId, const SerialDataCallback &cb);
+    void RemoveDataCallback(int32_t portId);
+
+private:
+    std::mutex mutex_;
+    std::map<int32_t, SerialDataCallback> dataCallbacks_;
 };
 } // namespace OHOS::USB
 #endif // SERIAL_DEATH_MONITOR_H
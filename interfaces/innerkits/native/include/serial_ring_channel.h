@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_RING_CHANNEL_H
+#define SERIAL_RING_CHANNEL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include "serial_shm_ring.h"
+
+namespace OHOS::USB {
+/*
+ * Client end of the shared rings of a port opened with SerialOpen(portId, true). Reads take bytes the service
+ * already pulled from the device, writes return once the bytes are queued for the device. Neither issues a
+ * binder call.
+ */
+class SerialRingChannel {
+public:
+    /* takes ownership of the descriptors, they are closed on failure as well */
+    static std::shared_ptr<SerialRingChannel> Create(int32_t ringFd, int32_t rxDataFd, int32_t rxSpaceFd,
+        int32_t txDataFd, int32_t txSpaceFd);
+    ~SerialRingChannel();
+
+    int32_t Read(uint8_t *data, uint32_t size, uint32_t &actualSize, uint32_t timeout);
+    int32_t Write(const uint8_t *data, uint32_t size, uint32_t &actualSize, uint32_t timeout);
+    /* wakes readers and writers blocked on the rings, fails if queued bytes never reached the device */
+    int32_t Close();
+
+private:
+    static constexpr size_t RING_FD_NUM = 5;
+
+    SerialRingChannel() = default;
+
+    void *base_ = nullptr;
+    int32_t fds_[RING_FD_NUM] = {-1, -1, -1, -1, -1};
+    SerialShmRing rx_;
+    SerialShmRing tx_;
+    std::mutex readMutex_;
+    std::mutex writeMutex_;
+};
+} // namespace OHOS::USB
+#endif // SERIAL_RING_CHANNEL_H
@@ -33,6 +33,8 @@ public:
     
     int32_t UsbSubmitTransfer(HDI::Usb::V1_2::USBTransferInfo &info, const TransferCallback &cb,
         sptr<Ashmem> &ashmem);
+    int32_t UsbSubmitTransferBatch(std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos,
+        const TransferBatchCallback &cb, sptr<Ashmem> &ashmem);
     int32_t UsbCancelTransfer(int32_t &endpoint);
     
     int32_t ControlTransfer(const HDI::Usb::V1_0::UsbCtrlTransfer &ctrl, std::vector<uint8_t> &bufferData);
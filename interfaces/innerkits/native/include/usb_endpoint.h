@@ -45,6 +45,10 @@ public:
         interval_ = GetIntValue(endpoint, "interval");
         maxPacketSize_ = GetIntValue(endpoint, "maxPacketSize");
         interfaceId_ = GetIntValue(endpoint, "interfaceId");
+        maxBurst_ = static_cast<uint32_t>(GetIntValue(endpoint, "maxBurst"));
+        maxStreams_ = static_cast<uint32_t>(GetIntValue(endpoint, "maxStreams"));
+        mult_ = static_cast<uint32_t>(GetIntValue(endpoint, "mult"));
+        bytesPerInterval_ = static_cast<uint32_t>(GetIntValue(endpoint, "bytesPerInterval"));
     }
 
     USBEndpoint() {}
@@ -56,6 +60,10 @@ public:
         WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Int32, parcel, this->interval_);
         WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Int32, parcel, this->maxPacketSize_);
         WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Uint8, parcel, this->interfaceId_);
+        WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Uint32, parcel, this->maxBurst_);
+        WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Uint32, parcel, this->maxStreams_);
+        WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Uint32, parcel, this->mult_);
+        WRITE_PARCEL_AND_RETURN_FALSE_WHEN_FAIL(Uint32, parcel, this->bytesPerInterval_);
         return true;
     }
 
@@ -70,6 +78,10 @@ public:
         usbEndpoint->interval_ = data.ReadInt32();
         usbEndpoint->maxPacketSize_ = data.ReadInt32();
         usbEndpoint->interfaceId_ = data.ReadUint8();
+        usbEndpoint->maxBurst_ = data.ReadUint32();
+        usbEndpoint->maxStreams_ = data.ReadUint32();
+        usbEndpoint->mult_ = data.ReadUint32();
+        usbEndpoint->bytesPerInterval_ = data.ReadUint32();
         return usbEndpoint;
     }
     static int GetIntValue(const cJSON *jsonObject, const char *key)
@@ -184,6 +196,49 @@ public:
         return interfaceId_;
     }
 
+    /* packets per burst from the SuperSpeed companion, 1 for slower endpoints */
+    uint32_t GetMaxBurst() const
+    {
+        return maxBurst_;
+    }
+
+    void SetMaxBurst(uint32_t maxBurst)
+    {
+        maxBurst_ = maxBurst;
+    }
+
+    /* bulk streams of a SuperSpeed endpoint, 0 without stream support */
+    uint32_t GetMaxStreams() const
+    {
+        return maxStreams_;
+    }
+
+    void SetMaxStreams(uint32_t maxStreams)
+    {
+        maxStreams_ = maxStreams;
+    }
+
+    /* bursts per service interval of a SuperSpeed isochronous endpoint */
+    uint32_t GetMult() const
+    {
+        return mult_;
+    }
+
+    void SetMult(uint32_t mult)
+    {
+        mult_ = mult;
+    }
+
+    uint32_t GetBytesPerInterval() const
+    {
+        return bytesPerInterval_;
+    }
+
+    void SetBytesPerInterval(uint32_t bytesPerInterval)
+    {
+        bytesPerInterval_ = bytesPerInterval;
+    }
+
     const std::string getJsonString() const
     {
         cJSON *endPointJson = cJSON_CreateObject();
@@ -199,6 +254,10 @@ public:
         cJSON_AddNumberToObject(endPointJson, "number", static_cast<double>(GetEndpointNumber()));
         cJSON_AddNumberToObject(endPointJson, "type", static_cast<double>(GetType()));
         cJSON_AddNumberToObject(endPointJson, "interfaceId", static_cast<double>(interfaceId_));
+        cJSON_AddNumberToObject(endPointJson, "maxBurst", static_cast<double>(maxBurst_));
+        cJSON_AddNumberToObject(endPointJson, "maxStreams", static_cast<double>(maxStreams_));
+        cJSON_AddNumberToObject(endPointJson, "mult", static_cast<double>(mult_));
+        cJSON_AddNumberToObject(endPointJson, "bytesPerInterval", static_cast<double>(bytesPerInterval_));
         char *pEndPointJson = cJSON_PrintUnformatted(endPointJson);
         cJSON_Delete(endPointJson);
         if (!pEndPointJson) {
@@ -217,6 +276,10 @@ private:
     int32_t interval_ = INVALID_USB_INT_VALUE;
     int32_t maxPacketSize_ = INVALID_USB_INT_VALUE;
     uint8_t interfaceId_ = UINT8_MAX;
+    uint32_t maxBurst_ = 1;
+    uint32_t maxStreams_ = 0;
+    uint32_t mult_ = 1;
+    uint32_t bytesPerInterval_ = 0;
 };
 } // namespace USB
 } // namespace OHOS
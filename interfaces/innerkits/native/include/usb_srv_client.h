@@ -26,10 +26,12 @@
 #include "iusb_server.h"
 #include "usb_device.h"
 #include "usb_device_pipe.h"
+#include "usb_device_snapshot.h"
 #include "usb_port.h"
 #include "usb_request.h"
 #include "usb_interface_type.h"
 #include "serial_death_monitor.h"
+#include "serial_ring_channel.h"
 #include "usb_server_types.h"
 namespace OHOS {
 namespace USB {
@@ -51,6 +53,16 @@ public:
     int32_t RequestRight(std::string deviceName);
     int32_t RemoveRight(std::string deviceName);
     int32_t GetDevices(std::vector<UsbDevice> &deviceList);
+    /* read-only mapping of the service's device table, reused until the service reports a new sequence */
+    int32_t GetDevicesSnapshot(std::shared_ptr<const UsbDeviceSnapshot> &snapshot);
+    /* generation of the device table, it moves whenever GetDevices would return something different */
+    int32_t GetDeviceGeneration(uint64_t &generation);
+    /*
+     * Changes since an earlier generation. Apply removed before added and changed, a bus address may be reused.
+     * With fullSync set the caller's view is too old, added then holds the whole table and replaces it.
+     */
+    int32_t GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync, std::vector<UsbDevice> &added,
+        std::vector<UsbDevice> &changed, std::vector<std::string> &removed);
     int32_t GetPorts(std::vector<UsbPort> &usbPorts);
     int32_t GetSupportedModes(int32_t portId, int32_t &supportedModes);
     int32_t SetPortRole(int32_t portId, int32_t powerRole, int32_t dataRole);
@@ -90,11 +102,24 @@ public:
     int32_t UsbCancelTransfer(USBDevicePipe &pipe, int32_t &endpoint);
     int32_t UsbSubmitTransfer(USBDevicePipe &pipe, HDI::Usb::V1_2::USBTransferInfo &info,
         const TransferCallback &cb, sptr<Ashmem> &ashmem);
+    /* payloads of infos are laid out back to back in ashmem, cb fires once after all transfers complete */
+    int32_t UsbSubmitTransferBatch(USBDevicePipe &pipe, std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos,
+        const TransferBatchCallback &cb, sptr<Ashmem> &ashmem);
     int32_t RegBulkCallback(USBDevicePipe &pipe, const USBEndpoint &endpoint, const sptr<IRemoteObject> &cb);
     int32_t UnRegBulkCallback(USBDevicePipe &pipe, const USBEndpoint &endpoint);
     int32_t BulkRead(USBDevicePipe &pipe, const USBEndpoint &endpoint, sptr<Ashmem> &ashmem);
     int32_t BulkWrite(USBDevicePipe &pipe, const USBEndpoint &endpoint, sptr<Ashmem> &ashmem);
     int32_t BulkCancel(USBDevicePipe &pipe, const USBEndpoint &endpoint);
+    /* ashmem is shared with service once, then transfers only carry offset and length */
+    int32_t RegBulkTransferBuffer(USBDevicePipe &pipe, const USBEndpoint &endpoint, sptr<Ashmem> &ashmem);
+    int32_t UnRegBulkTransferBuffer(USBDevicePipe &pipe, const USBEndpoint &endpoint);
+    /* pooled ashmem slots of an endpoint are shared with service once, then submits only carry the slot */
+    int32_t RegSubmitTransferBuffer(USBDevicePipe &pipe, int32_t endpoint, int32_t slot, sptr<Ashmem> &ashmem);
+    int32_t UnRegSubmitTransferBuffers(USBDevicePipe &pipe, int32_t endpoint);
+    int32_t UsbSubmitTransfer(USBDevicePipe &pipe, HDI::Usb::V1_2::USBTransferInfo &info,
+        const TransferCallback &cb, int32_t slot);
+    int32_t BulkTransfer(USBDevicePipe &pipe, const USBEndpoint &endpoint, int32_t offset, int32_t length,
+        int32_t &actualLength, int32_t timeOut);
     int32_t AddRight(const std::string &bundleName, const std::string &deviceName);
     int32_t AddAccessRight(const std::string &tokenId, const std::string &deviceName);
     int32_t ManageGlobalInterface(bool disable);
@@ -111,11 +136,19 @@ public:
     int32_t CloseAccessory(const int32_t fd);
 
     int32_t SerialOpen(int32_t portId);
+    /* useRing maps shared rings for the port, reads and writes then bypass binder */
+    int32_t SerialOpen(int32_t portId, bool useRing);
     int32_t SerialClose(int32_t portId);
     int32_t SerialRead(int32_t portId, std::vector<uint8_t> &data, uint32_t bufferSize,
         uint32_t& actualSize, uint32_t timeout);
     int32_t SerialWrite(int32_t portId, const std::vector<uint8_t>& data,
         uint32_t bufferSize, uint32_t& actualSize, uint32_t timeout);
+    int32_t SerialRead(int32_t portId, uint8_t *data, uint32_t bufferSize, uint32_t &actualSize, uint32_t timeout);
+    int32_t SerialWrite(int32_t portId, const uint8_t *data, uint32_t bufferSize, uint32_t &actualSize,
+        uint32_t timeout);
+    /* cb fires when data is buffered for the port, SerialRead then returns without waiting on the device */
+    int32_t SerialSubscribe(int32_t portId, const SerialDataCallback &cb);
+    int32_t SerialUnsubscribe(int32_t portId);
     int32_t SerialGetAttribute(int32_t portId, UsbSerialAttr& attribute);
     int32_t SerialSetAttribute(int32_t portId, const UsbSerialAttr& attribute);
     int32_t SerialGetPortList(
@@ -132,6 +165,15 @@ private:
     void UsbCtrlTransferChange(const HDI::Usb::V1_0::UsbCtrlTransfer &param, UsbCtlSetUp &ctlSetup);
     void UsbCtrlTransferChange(const HDI::Usb::V1_2::UsbCtrlTransferParams &param, UsbCtlSetUp &ctlSetup);
     void UsbTransInfoChange(const HDI::Usb::V1_2::USBTransferInfo &param, UsbTransInfo &info);
+    /* the sync transfers run on an io lane of the service and are waited for here, no binder thread is pinned */
+    int32_t WaitBulkTransferRead(USBDevicePipe &pipe, const USBEndpoint &endpoint, int32_t length,
+        std::vector<uint8_t> &bufferData, int32_t timeOut);
+    int32_t WaitBulkTransferWrite(USBDevicePipe &pipe, const USBEndpoint &endpoint,
+        std::vector<uint8_t> &bufferData, int32_t timeOut);
+    int32_t WaitControlTransfer(USBDevicePipe &pipe, const UsbCtlSetUp &ctlSetup, bool withLength,
+        std::vector<uint8_t> &bufferData);
+    int32_t WaitRequest(USBDevicePipe &pipe, int32_t timeOut, std::vector<uint8_t> &clientData,
+        std::vector<uint8_t> &bufferData);
     void UsbDeviceIdChange(const std::vector<UsbDeviceId> &deviceIdList,
         std::vector<UsbDeviceIdInfo> &deviceIdInfoList);
     class UsbSrvDeathRecipient : public IRemoteObject::DeathRecipient {
@@ -150,7 +192,16 @@ private:
     sptr<IUsbServer> proxy_ = nullptr;
     sptr<IRemoteObject::DeathRecipient> deathRecipient_ = nullptr;
     std::mutex mutex_;
+    std::shared_ptr<SerialRingChannel> GetSerialRing(int32_t portId);
+    int32_t RemoveSerialRing(int32_t portId);
     sptr<SerialDeathMonitor> serialRemote = nullptr;
+    std::map<int32_t, std::shared_ptr<SerialRingChannel>> serialRings_;
+    std::mutex serialRingsMutex_;
+    std::shared_ptr<const UsbDeviceSnapshot> devicesSnapshot_;
+    /* devices decoded from devicesSnapshot_, handed out again while the service generation stays the same */
+    std::vector<UsbDevice> devicesDecodedList_;
+    bool devicesDecoded_ = false;
+    std::mutex devicesSnapshotMutex_;
 };
 } // namespace USB
 } // namespace OHOS
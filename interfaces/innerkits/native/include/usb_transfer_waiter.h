@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_TRANSFER_WAITER_H
+#define USB_TRANSFER_WAITER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include "iusb_srv.h"
+#include "usbd_callback_server.h"
+
+namespace OHOS {
+namespace USB {
+/*
+ * Waits for the result of one transfer the service runs on an io lane. The transfer may queue behind others on
+ * its lane, so the deadline of timeOut plus a margin only starts once the service reports the lane started it.
+ * Before that the wait lasts as long as the service is alive.
+ */
+class UsbTransferWaiter {
+public:
+    using AliveCheck = std::function<bool()>;
+
+    UsbTransferWaiter();
+    ~UsbTransferWaiter() = default;
+
+    /* passed to the async call, nullptr when out of memory */
+    sptr<IRemoteObject> GetCallback() const;
+    /* the result status, UEC_INTERFACE_TIMED_OUT or UEC_INTERFACE_DEAD_OBJECT when no result came */
+    int32_t Wait(int32_t timeOut, const AliveCheck &isAlive, TransferDataResult &result);
+
+private:
+    struct State {
+        std::mutex mutex;
+        std::condition_variable cond;
+        bool started = false;
+        std::chrono::steady_clock::time_point startTime;
+        bool done = false;
+        TransferDataResult result;
+    };
+
+    /* shared with the callback, the service may hold the callback after the waiter is gone */
+    std::shared_ptr<State> state_;
+    sptr<UsbdCallBackServer> callback_;
+};
+} // namespace USB
+} // namespace OHOS
+#endif // USB_TRANSFER_WAITER_H
@@ -24,6 +24,10 @@ namespace OHOS::USB {
 class UsbdCallBackServer : public UsbdStubCallBack {
 public:
     explicit UsbdCallBackServer(const TransferCallback &callback) : callback_(callback) {}
+    explicit UsbdCallBackServer(const TransferBatchCallback &callback) : batchCallback_(callback) {}
+    explicit UsbdCallBackServer(const TransferDataCallback &callback) : dataCallback_(callback) {}
+    UsbdCallBackServer(const TransferDataCallback &callback, const TransferStartedCallback &startedCallback)
+        : dataCallback_(callback), startedCallback_(startedCallback) {}
     UsbdCallBackServer() = default;
     ~UsbdCallBackServer() = default;
     
@@ -31,11 +35,17 @@ public:
         std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, uint64_t userData) override;
     int32_t OnTransferReadCallback(int32_t status, int32_t actLength,
         std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, uint64_t userData) override;
+    int32_t OnTransferBatchCallback(std::vector<TransferBatchResult> &results) override;
+    int32_t OnTransferDataCallback(TransferDataResult &result) override;
+    int32_t OnTransferStartedCallback(uint64_t userData) override;
 
 private:
     std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> isoInfo_;
     TransferCallbackInfo info_;
     TransferCallback callback_;
+    TransferBatchCallback batchCallback_;
+    TransferDataCallback dataCallback_;
+    TransferStartedCallback startedCallback_;
 };
 } // namespace OHOS::USB
 #endif
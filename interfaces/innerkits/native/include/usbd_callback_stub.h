@@ -17,6 +17,8 @@
 #define USBD_STUB_CALLBACK_H
 
 #include "ipc_object_stub.h"
+#include "iusb_srv.h"
+#include "usb_errors.h"
 #include "v1_2/usb_types.h"
 
 namespace OHOS::USB {
@@ -25,6 +27,9 @@ public:
     enum {
         CMD_USBD_TRANSFER_CALLBACK_READ,
         CMD_USBD_TRANSFER_CALLBACK_WRITE,
+        CMD_USBD_TRANSFER_CALLBACK_BATCH,
+        CMD_USBD_TRANSFER_CALLBACK_DATA,
+        CMD_USBD_TRANSFER_CALLBACK_STARTED,
     };
 
     explicit UsbdStubCallBack() : OHOS::IPCObjectStub(u"UsbdStubCallback.V1_2") {}
@@ -36,9 +41,24 @@ public:
         std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, uint64_t userData) = 0;
     virtual int32_t OnTransferReadCallback(int32_t status, int32_t actLength,
         std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, uint64_t userData) = 0;
+    virtual int32_t OnTransferBatchCallback(std::vector<TransferBatchResult> &results)
+    {
+        return UEC_OK;
+    }
+    virtual int32_t OnTransferDataCallback(TransferDataResult &result)
+    {
+        return UEC_OK;
+    }
+    virtual int32_t OnTransferStartedCallback(uint64_t userData)
+    {
+        return UEC_OK;
+    }
 
     int32_t TransferWriteCallback(uint32_t code, OHOS::MessageParcel &data);
     int32_t TransferReadCallback(uint32_t code, OHOS::MessageParcel &data);
+    int32_t BatchTransferCallback(uint32_t code, OHOS::MessageParcel &data);
+    int32_t DataTransferCallback(uint32_t code, OHOS::MessageParcel &data);
+    int32_t StartedTransferCallback(uint32_t code, OHOS::MessageParcel &data);
 };
 } // namespace OHOS::USB
 #endif // USBD_STUB_CALLBACK_H
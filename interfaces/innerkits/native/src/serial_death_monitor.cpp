@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_death_monitor.h"
+#include "hilog_wrapper.h"
+#include "usb_common.h"
+#include "usb_errors.h"
+
+namespace OHOS::USB {
+int32_t SerialDeathMonitor::OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply,
+    MessageOption &option)
+{
+    if (code != SERIAL_NOTIFY_DATA_AVAILABLE) {
+        return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
+    }
+    int32_t portId = 0;
+    uint32_t available = 0;
+    uint64_t overrunCount = 0;
+    READ_PARCEL_WITH_RET(data, Int32, portId, UEC_INTERFACE_READ_PARCEL_ERROR);
+    READ_PARCEL_WITH_RET(data, Uint32, available, UEC_INTERFACE_READ_PARCEL_ERROR);
+    READ_PARCEL_WITH_RET(data, Uint64, overrunCount, UEC_INTERFACE_READ_PARCEL_ERROR);
+    SerialDataCallback cb;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = dataCallbacks_.find(portId);
+        if (it == dataCallbacks_.end()) {
+            USB_HILOGW(MODULE_USB_INNERKIT, "no data callback of port %{public}d", portId);
+            return UEC_OK;
+        }
+        cb = it->second;
+    }
+    cb(portId, available, overrunCount);
+    return UEC_OK;
+}
+
+void SerialDeathMonitor::SetDataCallback(int32_t portId, const SerialDataCallback &cb)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    dataCallbacks_[portId] = cb;
+}
+
+void SerialDeathMonitor::RemoveDataCallback(int32_t portId)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    dataCallbacks_.erase(portId);
+}
+} // namespace OHOS::USB
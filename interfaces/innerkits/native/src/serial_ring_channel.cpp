@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_ring_channel.h"
+
+#include <sys/mman.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <iterator>
+#include "hilog_wrapper.h"
+#include "usb_errors.h"
+
+namespace OHOS::USB {
+constexpr uint32_t RING_WRITE_LOW_WATER = 4096;
+
+std::shared_ptr<SerialRingChannel> SerialRingChannel::Create(int32_t ringFd, int32_t rxDataFd, int32_t rxSpaceFd,
+    int32_t txDataFd, int32_t txSpaceFd)
+{
+    std::shared_ptr<SerialRingChannel> channel(new (std::nothrow) SerialRingChannel());
+    int32_t fds[RING_FD_NUM] = {ringFd, rxDataFd, rxSpaceFd, txDataFd, txSpaceFd};
+    if (channel == nullptr) {
+        for (int32_t fd : fds) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+        return nullptr;
+    }
+    std::copy(std::begin(fds), std::end(fds), std::begin(channel->fds_));
+    for (int32_t fd : fds) {
+        if (fd < 0) {
+            USB_HILOGE(MODULE_USB_INNERKIT, "invalid ring descriptor");
+            return nullptr;
+        }
+    }
+    void *base = mmap(nullptr, SERIAL_SHM_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, ringFd, 0);
+    if (base == MAP_FAILED) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "map serial ring failed, errno:%{public}d", errno);
+        return nullptr;
+    }
+    channel->base_ = base;
+    uint8_t *addr = static_cast<uint8_t *>(base);
+    channel->rx_ = SerialShmRing(addr + SERIAL_SHM_RX_OFFSET, rxDataFd, rxSpaceFd);
+    channel->tx_ = SerialShmRing(addr + SERIAL_SHM_TX_OFFSET, txDataFd, txSpaceFd);
+    return channel;
+}
+
+SerialRingChannel::~SerialRingChannel()
+{
+    if (base_ != nullptr) {
+        munmap(base_, SERIAL_SHM_REGION_SIZE);
+        base_ = nullptr;
+    }
+    for (int32_t &fd : fds_) {
+        if (fd >= 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+int32_t SerialRingChannel::Read(uint8_t *data, uint32_t size, uint32_t &actualSize, uint32_t timeout)
+{
+    std::lock_guard<std::mutex> guard(readMutex_);
+    actualSize = 0;
+    if (data == nullptr || size == 0) {
+        return UEC_INTERFACE_INVALID_VALUE;
+    }
+    if (!rx_.WaitReadable(timeout)) {
+        return rx_.IsClosed() ? UEC_SERIAL_IO_EXCEPTION : UEC_INTERFACE_TIMED_OUT;
+    }
+    actualSize = rx_.Pop(data, size);
+    return UEC_OK;
+}
+
+int32_t SerialRingChannel::Write(const uint8_t *data, uint32_t size, uint32_t &actualSize, uint32_t timeout)
+{
+    std::lock_guard<std::mutex> guard(writeMutex_);
+    actualSize = 0;
+    if (data == nullptr || size == 0) {
+        return UEC_INTERFACE_INVALID_VALUE;
+    }
+    if (tx_.TakeFailure()) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "earlier serial write did not reach the device");
+        return UEC_SERIAL_IO_EXCEPTION;
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeout);
+    while (actualSize < size) {
+        actualSize += tx_.Push(data + actualSize, size - actualSize);
+        if (actualSize == size) {
+            break;
+        }
+        uint32_t waitMs = 0;
+        if (timeout != 0) {
+            auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            if (left <= 0) {
+                break;
+            }
+            waitMs = static_cast<uint32_t>(left);
+        }
+        if (!tx_.WaitWritable(std::min(size - actualSize, RING_WRITE_LOW_WATER), waitMs) && tx_.IsClosed()) {
+            return UEC_SERIAL_IO_EXCEPTION;
+        }
+    }
+    return actualSize > 0 ? UEC_OK : UEC_INTERFACE_TIMED_OUT;
+}
+
+int32_t SerialRingChannel::Close()
+{
+    if (base_ == nullptr) {
+        return UEC_OK;
+    }
+    rx_.Close();
+    tx_.Close();
+    return tx_.TakeFailure() ? UEC_SERIAL_IO_EXCEPTION : UEC_OK;
+}
+} // namespace OHOS::USB
@@ -70,6 +70,12 @@ int32_t USBDevicePipe::UsbSubmitTransfer(HDI::Usb::V1_2::USBTransferInfo &asyncC
     return UsbSrvClient::GetInstance().UsbSubmitTransfer(*this, asyncContext, cb, ashmem);
 }
 
+int32_t USBDevicePipe::UsbSubmitTransferBatch(std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos,
+    const TransferBatchCallback &cb, sptr<Ashmem> &ashmem)
+{
+    return UsbSrvClient::GetInstance().UsbSubmitTransferBatch(*this, infos, cb, ashmem);
+}
+
 int32_t USBDevicePipe::UsbControlTransfer(
     const HDI::Usb::V1_2::UsbCtrlTransferParams &ctrlParams, std::vector<uint8_t> &bufferData)
 {
@@ -14,10 +14,16 @@
  */
 
 #include "usb_srv_client.h"
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <unistd.h>
 #include "datetime_ex.h"
 #include "if_system_ability_manager.h"
 #include "ipc_skeleton.h"
 #include "iservice_registry.h"
+#include "securec.h"
 #include "string_ex.h"
 #include "system_ability_definition.h"
 #include "usb_common.h"
@@ -25,6 +31,7 @@
 #include "usb_errors.h"
 #include "timer.h"
 #include "v1_2/iusb_interface.h"
+#include "usb_transfer_waiter.h"
 #include "usbd_callback_server.h"
 #include "usb_bulk_trans_data.h"
 using namespace OHOS::HDI::Usb::V1_2;
@@ -34,6 +41,28 @@ constexpr uint32_t WAIT_SERVICE_LOAD = 500;
 constexpr uint32_t MAX_WAIT_LOAD_SA_SECONDS = 4;
 #ifdef USB_MANAGER_FEATURE_HOST
 constexpr int32_t PARAM_ERROR = 401;
+
+namespace {
+using TransferSubmit = std::function<int32_t(const sptr<IRemoteObject> &cb)>;
+
+int32_t RunTransfer(const sptr<IUsbServer> &proxy, int32_t timeOut, const TransferSubmit &submit,
+    TransferDataResult &result)
+{
+    UsbTransferWaiter waiter;
+    sptr<IRemoteObject> cb = waiter.GetCallback();
+    if (cb == nullptr) {
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    int32_t ret = submit(cb);
+    if (ret != UEC_OK) {
+        return ret;
+    }
+    return waiter.Wait(timeOut, [&proxy]() {
+        sptr<IRemoteObject> remote = proxy->AsObject();
+        return remote != nullptr && !remote->IsObjectDead();
+    }, result);
+}
+} // namespace
 #endif // USB_MANAGER_FEATURE_HOST
 [[ maybe_unused ]] constexpr int32_t CAPABILITY_NOT_SUPPORT = 801;
 UsbSrvClient::UsbSrvClient()
@@ -99,6 +128,21 @@ void UsbSrvClient::ResetProxy(const wptr<IRemoteObject> &remote)
     if ((serviceRemote != nullptr) && (serviceRemote == remote.promote())) {
         serviceRemote->RemoveDeathRecipient(deathRecipient_);
         proxy_ = nullptr;
+        {
+            /* the pumps died with the service, release anyone blocked on a ring */
+            std::lock_guard<std::mutex> guard(serialRingsMutex_);
+            for (auto &it : serialRings_) {
+                (void)it.second->Close();
+            }
+            serialRings_.clear();
+        }
+        {
+            /* a restarted service numbers its snapshots from scratch */
+            std::lock_guard<std::mutex> guard(devicesSnapshotMutex_);
+            devicesSnapshot_ = nullptr;
+            devicesDecodedList_.clear();
+            devicesDecoded_ = false;
+        }
 
         std::this_thread::sleep_for(std::chrono::milliseconds(WAIT_SERVICE_LOAD));
         ConnectUnLocked();
@@ -178,6 +222,35 @@ int32_t UsbSrvClient::RemoveRight(std::string deviceName)
 int32_t UsbSrvClient::GetDevices(std::vector<UsbDevice> &deviceList)
 {
     RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    uint64_t generation = 0;
+    if (GetDeviceGeneration(generation) == UEC_OK) {
+        std::lock_guard<std::mutex> guard(devicesSnapshotMutex_);
+        if (devicesDecoded_ && devicesSnapshot_ != nullptr && devicesSnapshot_->GetSequence() == generation) {
+            deviceList.insert(deviceList.end(), devicesDecodedList_.begin(), devicesDecodedList_.end());
+            USB_HILOGI(MODULE_USB_INNERKIT, "GetDevices deviceList size = %{public}zu!", deviceList.size());
+            return UEC_OK;
+        }
+    }
+    std::shared_ptr<const UsbDeviceSnapshot> snapshot;
+    if (GetDevicesSnapshot(snapshot) == UEC_OK) {
+        std::vector<UsbDevice> decoded;
+        uint32_t count = snapshot->GetDeviceCount();
+        decoded.reserve(count);
+        for (uint32_t i = 0; i < count; ++i) {
+            snapshot->ToDevice(i, decoded.emplace_back());
+        }
+        deviceList.insert(deviceList.end(), decoded.begin(), decoded.end());
+        {
+            std::lock_guard<std::mutex> guard(devicesSnapshotMutex_);
+            /* a newer snapshot may have been mapped meanwhile, the list is only kept for the one it came from */
+            if (devicesSnapshot_ == snapshot) {
+                devicesDecodedList_ = std::move(decoded);
+                devicesDecoded_ = true;
+            }
+        }
+        USB_HILOGI(MODULE_USB_INNERKIT, "GetDevices deviceList size = %{public}zu!", deviceList.size());
+        return UEC_OK;
+    }
     int32_t ret = proxy_->GetDevices(deviceList);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_INNERKIT, "GetDevices failed ret = %{public}d!", ret);
@@ -187,6 +260,57 @@ int32_t UsbSrvClient::GetDevices(std::vector<UsbDevice> &deviceList)
     return ret;
 }
 
+int32_t UsbSrvClient::GetDevicesSnapshot(std::shared_ptr<const UsbDeviceSnapshot> &snapshot)
+{
+    RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    int32_t fd = -1;
+    uint32_t size = 0;
+    uint64_t sequence = 0;
+    int32_t ret = proxy_->GetDevicesSnapshot(fd, size, sequence);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "GetDevicesSnapshot failed ret = %{public}d!", ret);
+        return ret;
+    }
+    std::lock_guard<std::mutex> guard(devicesSnapshotMutex_);
+    if (devicesSnapshot_ == nullptr || devicesSnapshot_->GetSequence() != sequence) {
+        std::shared_ptr<const UsbDeviceSnapshot> mapped = UsbDeviceSnapshot::Map(fd, size);
+        if (mapped == nullptr) {
+            close(fd);
+            return UEC_INTERFACE_INVALID_VALUE;
+        }
+        devicesSnapshot_ = mapped;
+        devicesDecodedList_.clear();
+        devicesDecoded_ = false;
+    }
+    close(fd);
+    snapshot = devicesSnapshot_;
+    return UEC_OK;
+}
+
+int32_t UsbSrvClient::GetDeviceGeneration(uint64_t &generation)
+{
+    RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    int32_t ret = proxy_->GetDeviceGeneration(generation);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "GetDeviceGeneration failed ret = %{public}d!", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync,
+    std::vector<UsbDevice> &added, std::vector<UsbDevice> &changed, std::vector<std::string> &removed)
+{
+    RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    int32_t ret = proxy_->GetDevicesSince(since, generation, fullSync, added, changed, removed);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "GetDevicesSince failed ret = %{public}d!", ret);
+        return ret;
+    }
+    USB_HILOGI(MODULE_USB_INNERKIT, "GetDevicesSince full:%{public}d added:%{public}zu changed:%{public}zu "
+        "removed:%{public}zu", fullSync, added.size(), changed.size(), removed.size());
+    return ret;
+}
+
 int32_t UsbSrvClient::ClaimInterface(USBDevicePipe &pipe, const UsbInterface &interface, bool force)
 {
     RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
@@ -235,13 +359,9 @@ int32_t UsbSrvClient::BulkTransfer(
     if (USB_ENDPOINT_DIR_IN == endpoint.GetDirection()) {
         int32_t length = static_cast<int32_t>(bufferData.size());
         bufferData.clear();
-        UsbBulkTransData bulkData;
-        ret = proxy_->BulkTransferReadwithLength(pipe.GetBusNum(), pipe.GetDevAddr(),
-            endpoint, length, bulkData, timeOut);
-        bufferData.swap(bulkData.data_);
+        ret = WaitBulkTransferRead(pipe, endpoint, length, bufferData, timeOut);
     } else if (USB_ENDPOINT_DIR_OUT == endpoint.GetDirection()) {
-        UsbBulkTransData bulkData (bufferData);
-        ret = proxy_->BulkTransferWrite(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, bulkData, timeOut);
+        ret = WaitBulkTransferWrite(pipe, endpoint, bufferData, timeOut);
     }
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
@@ -268,7 +388,7 @@ int32_t UsbSrvClient::ControlTransfer(
     if ((static_cast<uint32_t>(ctlSetup.reqType) & USB_ENDPOINT_DIR_MASK) == USB_ENDPOINT_DIR_IN) {
         bufferData.clear();
     }
-    int32_t ret = proxy_->ControlTransfer(pipe.GetBusNum(), pipe.GetDevAddr(), ctlSetup, bufferData);
+    int32_t ret = WaitControlTransfer(pipe, ctlSetup, false, bufferData);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
     }
@@ -296,7 +416,7 @@ int32_t UsbSrvClient::UsbControlTransfer(USBDevicePipe &pipe, const HDI::Usb::V1
     if ((static_cast<uint32_t>(ctlSetup.reqType) & USB_ENDPOINT_DIR_MASK) == USB_ENDPOINT_DIR_IN) {
         bufferData.clear();
     }
-    int32_t ret = proxy_->UsbControlTransfer(pipe.GetBusNum(), pipe.GetDevAddr(), ctlSetup, bufferData);
+    int32_t ret = WaitControlTransfer(pipe, ctlSetup, true, bufferData);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
     }
@@ -350,7 +470,7 @@ int32_t UsbSrvClient::PipeRequestWait(USBDevicePipe &pipe, int64_t timeOut, UsbR
     RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
     std::vector<uint8_t> clientData;
     std::vector<uint8_t> bufferData;
-    int32_t ret = proxy_->RequestWait(pipe.GetBusNum(), pipe.GetDevAddr(), timeOut, clientData, bufferData);
+    int32_t ret = WaitRequest(pipe, static_cast<int32_t>(timeOut), clientData, bufferData);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d.", ret);
         return ret;
@@ -362,6 +482,80 @@ int32_t UsbSrvClient::PipeRequestWait(USBDevicePipe &pipe, int64_t timeOut, UsbR
     return ret;
 }
 
+// a full io lane falls back to the blocking call, it behaves as before under load
+int32_t UsbSrvClient::WaitBulkTransferRead(USBDevicePipe &pipe, const USBEndpoint &endpoint, int32_t length,
+    std::vector<uint8_t> &bufferData, int32_t timeOut)
+{
+    sptr<IUsbServer> proxy = proxy_;
+    RETURN_IF_WITH_RET(proxy == nullptr, UEC_INTERFACE_NO_INIT);
+    TransferDataResult result;
+    int32_t ret = RunTransfer(proxy, timeOut, [&](const sptr<IRemoteObject> &cb) {
+        return proxy->BulkTransferReadAsync(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, length, timeOut, cb, 0);
+    }, result);
+    if (ret == UEC_SERVICE_WOULD_BLOCK) {
+        UsbBulkTransData bulkData;
+        ret = proxy->BulkTransferReadwithLength(pipe.GetBusNum(), pipe.GetDevAddr(),
+            endpoint, length, bulkData, timeOut);
+        bufferData.swap(bulkData.data_);
+        return ret;
+    }
+    bufferData.swap(result.bufferData);
+    return ret;
+}
+
+int32_t UsbSrvClient::WaitBulkTransferWrite(USBDevicePipe &pipe, const USBEndpoint &endpoint,
+    std::vector<uint8_t> &bufferData, int32_t timeOut)
+{
+    sptr<IUsbServer> proxy = proxy_;
+    RETURN_IF_WITH_RET(proxy == nullptr, UEC_INTERFACE_NO_INIT);
+    UsbBulkTransData bulkData(bufferData);
+    TransferDataResult result;
+    int32_t ret = RunTransfer(proxy, timeOut, [&](const sptr<IRemoteObject> &cb) {
+        return proxy->BulkTransferWriteAsync(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, bulkData, timeOut, cb, 0);
+    }, result);
+    if (ret == UEC_SERVICE_WOULD_BLOCK) {
+        ret = proxy->BulkTransferWrite(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, bulkData, timeOut);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::WaitControlTransfer(USBDevicePipe &pipe, const UsbCtlSetUp &ctlSetup, bool withLength,
+    std::vector<uint8_t> &bufferData)
+{
+    sptr<IUsbServer> proxy = proxy_;
+    RETURN_IF_WITH_RET(proxy == nullptr, UEC_INTERFACE_NO_INIT);
+    TransferDataResult result;
+    int32_t ret = RunTransfer(proxy, ctlSetup.timeout, [&](const sptr<IRemoteObject> &cb) {
+        return proxy->ControlTransferAsync(pipe.GetBusNum(), pipe.GetDevAddr(), ctlSetup, bufferData, withLength,
+            cb, 0);
+    }, result);
+    if (ret == UEC_SERVICE_WOULD_BLOCK) {
+        return withLength ? proxy->UsbControlTransfer(pipe.GetBusNum(), pipe.GetDevAddr(), ctlSetup, bufferData) :
+            proxy->ControlTransfer(pipe.GetBusNum(), pipe.GetDevAddr(), ctlSetup, bufferData);
+    }
+    if (ret == UEC_OK) {
+        bufferData.swap(result.bufferData);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::WaitRequest(USBDevicePipe &pipe, int32_t timeOut, std::vector<uint8_t> &clientData,
+    std::vector<uint8_t> &bufferData)
+{
+    sptr<IUsbServer> proxy = proxy_;
+    RETURN_IF_WITH_RET(proxy == nullptr, UEC_INTERFACE_NO_INIT);
+    TransferDataResult result;
+    int32_t ret = RunTransfer(proxy, timeOut, [&](const sptr<IRemoteObject> &cb) {
+        return proxy->RequestWaitAsync(pipe.GetBusNum(), pipe.GetDevAddr(), timeOut, cb, 0);
+    }, result);
+    if (ret == UEC_SERVICE_WOULD_BLOCK) {
+        return proxy->RequestWait(pipe.GetBusNum(), pipe.GetDevAddr(), timeOut, clientData, bufferData);
+    }
+    clientData.swap(result.clientData);
+    bufferData.swap(result.bufferData);
+    return ret;
+}
+
 int32_t UsbSrvClient::RequestInitialize(UsbRequest &request)
 {
     RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
@@ -435,6 +629,28 @@ int32_t UsbSrvClient::UsbSubmitTransfer(USBDevicePipe &pipe, HDI::Usb::V1_2::USB
     return ret;
 }
 
+int32_t UsbSrvClient::UsbSubmitTransferBatch(USBDevicePipe &pipe,
+    std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos, const TransferBatchCallback &cb, sptr<Ashmem> &ashmem)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    if (cb == nullptr || ashmem == nullptr || infos.empty()) {
+        return PARAM_ERROR;
+    }
+    sptr<UsbdCallBackServer> callBackService = new UsbdCallBackServer(cb);
+    std::vector<UsbTransInfo> params(infos.size());
+    for (size_t i = 0; i < infos.size(); ++i) {
+        UsbTransInfoChange(infos[i], params[i]);
+    }
+    int32_t fd = ashmem->GetAshmemFd();
+    int32_t memSize = ashmem->GetAshmemSize();
+    int32_t ret = proxy_->UsbSubmitTransferBatch(
+        pipe.GetBusNum(), pipe.GetDevAddr(), params, callBackService, fd, memSize);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "UsbSubmitTransferBatch failed with ret = %{public}d", ret);
+    }
+    return ret;
+}
+
 int32_t UsbSrvClient::RegBulkCallback(USBDevicePipe &pipe, const USBEndpoint &endpoint, const sptr<IRemoteObject> &cb)
 {
     RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
@@ -489,6 +705,95 @@ int32_t UsbSrvClient::BulkCancel(USBDevicePipe &pipe, const USBEndpoint &endpoin
     return ret;
 }
 
+int32_t UsbSrvClient::RegBulkTransferBuffer(USBDevicePipe &pipe, const USBEndpoint &endpoint, sptr<Ashmem> &ashmem)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    RETURN_IF_WITH_RET(ashmem == nullptr, UEC_INTERFACE_INVALID_VALUE);
+    int32_t fd = ashmem->GetAshmemFd();
+    int32_t memSize = ashmem->GetAshmemSize();
+    /* the service drops the buffers of this process when the monitor object dies with it */
+    int32_t ret = proxy_->RegBulkTransferBuffer(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, fd, memSize,
+        serialRemote);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::UnRegBulkTransferBuffer(USBDevicePipe &pipe, const USBEndpoint &endpoint)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    int32_t ret = proxy_->UnRegBulkTransferBuffer(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::RegSubmitTransferBuffer(USBDevicePipe &pipe, int32_t endpoint, int32_t slot,
+    sptr<Ashmem> &ashmem)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    RETURN_IF_WITH_RET(ashmem == nullptr, UEC_INTERFACE_INVALID_VALUE);
+    int32_t fd = ashmem->GetAshmemFd();
+    int32_t memSize = ashmem->GetAshmemSize();
+    int32_t ret = proxy_->RegSubmitTransferBuffer(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, slot, fd, memSize);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::UnRegSubmitTransferBuffers(USBDevicePipe &pipe, int32_t endpoint)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    int32_t ret = proxy_->UnRegSubmitTransferBuffers(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::UsbSubmitTransfer(USBDevicePipe &pipe, HDI::Usb::V1_2::USBTransferInfo &info,
+    const TransferCallback &cb, int32_t slot)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    if (cb == nullptr) {
+        return PARAM_ERROR;
+    }
+    sptr<UsbdCallBackServer> callBackService = new UsbdCallBackServer(cb);
+    UsbTransInfo param;
+    UsbTransInfoChange(info, param);
+    int32_t ret = proxy_->UsbSubmitTransferWithBuffer(pipe.GetBusNum(), pipe.GetDevAddr(), param, callBackService,
+        slot);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "UsbSubmitTransferWithBuffer failed with ret = %{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::BulkTransfer(USBDevicePipe &pipe, const USBEndpoint &endpoint, int32_t offset,
+    int32_t length, int32_t &actualLength, int32_t timeOut)
+{
+    RETURN_IF_WITH_RET(proxy_ == nullptr, UEC_INTERFACE_NO_INIT);
+    int32_t ret = UEC_INTERFACE_INVALID_VALUE;
+    actualLength = 0;
+    if (USB_ENDPOINT_DIR_IN == endpoint.GetDirection()) {
+        ret = proxy_->BulkTransferReadWithBuffer(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, offset, length,
+            actualLength, timeOut);
+    } else if (USB_ENDPOINT_DIR_OUT == endpoint.GetDirection()) {
+        ret = proxy_->BulkTransferWriteWithBuffer(pipe.GetBusNum(), pipe.GetDevAddr(), endpoint, offset, length,
+            timeOut);
+        if (ret == UEC_OK) {
+            actualLength = length;
+        }
+    }
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "failed width ret = %{public}d !", ret);
+    }
+    return ret;
+}
+
 int32_t UsbSrvClient::AddRight(const std::string &bundleName, const std::string &deviceName)
 {
     RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
@@ -648,6 +953,25 @@ int32_t UsbSrvClient::GetDevices(std::vector<UsbDevice> &deviceList)
     return CAPABILITY_NOT_SUPPORT;
 }
 
+int32_t UsbSrvClient::GetDevicesSnapshot(std::shared_ptr<const UsbDeviceSnapshot> &snapshot)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::GetDeviceGeneration(uint64_t &generation)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync,
+    std::vector<UsbDevice> &added, std::vector<UsbDevice> &changed, std::vector<std::string> &removed)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
 int32_t UsbSrvClient::ClaimInterface(USBDevicePipe &pipe, const UsbInterface &interface, bool force)
 {
     USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
@@ -766,6 +1090,13 @@ int32_t UsbSrvClient::UsbSubmitTransfer(USBDevicePipe &pipe, HDI::Usb::V1_2::USB
     return CAPABILITY_NOT_SUPPORT;
 }
 
+int32_t UsbSrvClient::UsbSubmitTransferBatch(USBDevicePipe &pipe,
+    std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos, const TransferBatchCallback &cb, sptr<Ashmem> &ashmem)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
 int32_t UsbSrvClient::RegBulkCallback(USBDevicePipe &pipe, const USBEndpoint &endpoint, const sptr<IRemoteObject> &cb)
 {
     USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
@@ -796,6 +1127,45 @@ int32_t UsbSrvClient::BulkCancel(USBDevicePipe &pipe, const USBEndpoint &endpoin
     return CAPABILITY_NOT_SUPPORT;
 }
 
+int32_t UsbSrvClient::RegBulkTransferBuffer(USBDevicePipe &pipe, const USBEndpoint &endpoint, sptr<Ashmem> &ashmem)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::UnRegBulkTransferBuffer(USBDevicePipe &pipe, const USBEndpoint &endpoint)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::RegSubmitTransferBuffer(USBDevicePipe &pipe, int32_t endpoint, int32_t slot,
+    sptr<Ashmem> &ashmem)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::UnRegSubmitTransferBuffers(USBDevicePipe &pipe, int32_t endpoint)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::UsbSubmitTransfer(USBDevicePipe &pipe, HDI::Usb::V1_2::USBTransferInfo &info,
+    const TransferCallback &cb, int32_t slot)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
+int32_t UsbSrvClient::BulkTransfer(USBDevicePipe &pipe, const USBEndpoint &endpoint, int32_t offset,
+    int32_t length, int32_t &actualLength, int32_t timeOut)
+{
+    USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
+    return CAPABILITY_NOT_SUPPORT;
+}
+
 int32_t UsbSrvClient::AddRight(const std::string &bundleName, const std::string &deviceName)
 {
     USB_HILOGW(MODULE_USB_INNERKIT, "%{public}s: Capability not supported.", __FUNCTION__);
@@ -1098,21 +1468,85 @@ int32_t UsbSrvClient::SerialOpen(int32_t portId)
     return ret;
 }
 
+int32_t UsbSrvClient::SerialOpen(int32_t portId, bool useRing)
+{
+    if (!useRing) {
+        return SerialOpen(portId);
+    }
+    USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialOpenRing");
+    RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    int32_t ringFd = -1;
+    int32_t rxDataFd = -1;
+    int32_t rxSpaceFd = -1;
+    int32_t txDataFd = -1;
+    int32_t txSpaceFd = -1;
+    int32_t ret = proxy_->SerialOpenRing(portId, serialRemote, ringFd, rxDataFd, rxSpaceFd, txDataFd, txSpaceFd);
+    if (ret == UEC_SERVICE_NO_MEMORY) {
+        USB_HILOGW(MODULE_USB_INNERKIT, "no shared ring for port %{public}d, fall back to binder", portId);
+        return SerialOpen(portId);
+    }
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "UsbSrvClient::SerialOpenRing failed ret = %{public}d!", ret);
+        return ret;
+    }
+    auto channel = SerialRingChannel::Create(ringFd, rxDataFd, rxSpaceFd, txDataFd, txSpaceFd);
+    if (channel == nullptr) {
+        /* the service serves the port through the ring only, a client that cannot map it gives the port back */
+        proxy_->SerialClose(portId);
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    std::lock_guard<std::mutex> guard(serialRingsMutex_);
+    serialRings_[portId] = channel;
+    return UEC_OK;
+}
+
+std::shared_ptr<SerialRingChannel> UsbSrvClient::GetSerialRing(int32_t portId)
+{
+    std::lock_guard<std::mutex> guard(serialRingsMutex_);
+    auto it = serialRings_.find(portId);
+    return it == serialRings_.end() ? nullptr : it->second;
+}
+
+int32_t UsbSrvClient::RemoveSerialRing(int32_t portId)
+{
+    std::shared_ptr<SerialRingChannel> channel;
+    {
+        std::lock_guard<std::mutex> guard(serialRingsMutex_);
+        auto it = serialRings_.find(portId);
+        if (it == serialRings_.end()) {
+            return UEC_OK;
+        }
+        channel = it->second;
+        serialRings_.erase(it);
+    }
+    return channel->Close();
+}
+
 int32_t UsbSrvClient::SerialClose(int32_t portId)
 {
     USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialClose");
     RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    serialRemote->RemoveDataCallback(portId);
     int32_t ret = proxy_->SerialClose(portId);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_INNERKIT, "UsbSrvClient::SerialClose failed ret = %{public}d!", ret);
     }
-    return ret;
+    /* the pumps are stopped now, a write they failed while draining is visible in the ring */
+    int32_t ringRet = RemoveSerialRing(portId);
+    return ret != UEC_OK ? ret : ringRet;
 }
 
 int32_t UsbSrvClient::SerialRead(int32_t portId, std::vector<uint8_t> &data,
     uint32_t bufferSize, uint32_t &actualSize, uint32_t timeout)
 {
     USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialRead");
+    auto channel = GetSerialRing(portId);
+    if (channel != nullptr) {
+        data.resize(bufferSize);
+        int32_t ret = channel->Read(data.data(), bufferSize, actualSize, timeout);
+        data.resize(actualSize);
+        return ret;
+    }
     RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
     int32_t ret = proxy_->SerialRead(portId, data, bufferSize, actualSize, timeout);
     if (ret != UEC_OK) {
@@ -1125,6 +1559,11 @@ int32_t UsbSrvClient::SerialWrite(int32_t portId, const std::vector<uint8_t>& da
     uint32_t bufferSize, uint32_t &actualSize, uint32_t timeout)
 {
     USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialWrite");
+    auto channel = GetSerialRing(portId);
+    if (channel != nullptr) {
+        return channel->Write(data.data(), std::min(bufferSize, static_cast<uint32_t>(data.size())), actualSize,
+            timeout);
+    }
     RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
     int32_t ret = proxy_->SerialWrite(portId, data, bufferSize, actualSize, timeout);
     if (ret != UEC_OK) {
@@ -1133,6 +1572,60 @@ int32_t UsbSrvClient::SerialWrite(int32_t portId, const std::vector<uint8_t>& da
     return ret;
 }
 
+int32_t UsbSrvClient::SerialRead(int32_t portId, uint8_t *data, uint32_t bufferSize, uint32_t &actualSize,
+    uint32_t timeout)
+{
+    RETURN_IF_WITH_RET(data == nullptr, UEC_INTERFACE_INVALID_VALUE);
+    auto channel = GetSerialRing(portId);
+    if (channel != nullptr) {
+        return channel->Read(data, bufferSize, actualSize, timeout);
+    }
+    std::vector<uint8_t> buffer;
+    int32_t ret = SerialRead(portId, buffer, bufferSize, actualSize, timeout);
+    if (ret == UEC_OK && !buffer.empty() && memcpy_s(data, bufferSize, buffer.data(), buffer.size()) != EOK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "UsbSrvClient::SerialRead copy failed");
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::SerialWrite(int32_t portId, const uint8_t *data, uint32_t bufferSize, uint32_t &actualSize,
+    uint32_t timeout)
+{
+    RETURN_IF_WITH_RET(data == nullptr, UEC_INTERFACE_INVALID_VALUE);
+    auto channel = GetSerialRing(portId);
+    if (channel != nullptr) {
+        return channel->Write(data, bufferSize, actualSize, timeout);
+    }
+    return SerialWrite(portId, std::vector<uint8_t>(data, data + bufferSize), bufferSize, actualSize, timeout);
+}
+
+int32_t UsbSrvClient::SerialSubscribe(int32_t portId, const SerialDataCallback &cb)
+{
+    USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialSubscribe");
+    RETURN_IF_WITH_RET(cb == nullptr, UEC_INTERFACE_INVALID_VALUE);
+    RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    serialRemote->SetDataCallback(portId, cb);
+    int32_t ret = proxy_->SerialSubscribe(portId, serialRemote);
+    if (ret != UEC_OK) {
+        serialRemote->RemoveDataCallback(portId);
+        USB_HILOGE(MODULE_USB_INNERKIT, "UsbSrvClient::SerialSubscribe failed ret = %{public}d!", ret);
+    }
+    return ret;
+}
+
+int32_t UsbSrvClient::SerialUnsubscribe(int32_t portId)
+{
+    USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialUnsubscribe");
+    RETURN_IF_WITH_RET(Connect() != UEC_OK, UEC_INTERFACE_NO_INIT);
+    int32_t ret = proxy_->SerialUnsubscribe(portId);
+    serialRemote->RemoveDataCallback(portId);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "UsbSrvClient::SerialUnsubscribe failed ret = %{public}d!", ret);
+    }
+    return ret;
+}
+
 int32_t UsbSrvClient::SerialGetAttribute(int32_t portId, UsbSerialAttr& attribute)
 {
     USB_HILOGI(MODULE_USB_INNERKIT, "Calling SerialGetAttribute");
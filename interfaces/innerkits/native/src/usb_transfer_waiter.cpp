@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_waiter.h"
+
+#include <algorithm>
+
+#include "hilog_wrapper.h"
+#include "usb_errors.h"
+
+namespace OHOS {
+namespace USB {
+constexpr int32_t TRANSFER_WAIT_MARGIN_MS = 1000;
+constexpr int32_t TRANSFER_POLL_MS = 1000;
+
+UsbTransferWaiter::UsbTransferWaiter() : state_(std::make_shared<State>())
+{
+    std::shared_ptr<State> state = state_;
+    TransferDataCallback onResult = [state](TransferDataResult &data) {
+        {
+            std::lock_guard<std::mutex> guard(state->mutex);
+            state->result = std::move(data);
+            state->done = true;
+        }
+        state->cond.notify_all();
+    };
+    TransferStartedCallback onStarted = [state](uint64_t) {
+        {
+            std::lock_guard<std::mutex> guard(state->mutex);
+            state->started = true;
+            state->startTime = std::chrono::steady_clock::now();
+        }
+        state->cond.notify_all();
+    };
+    callback_ = new (std::nothrow) UsbdCallBackServer(onResult, onStarted);
+}
+
+sptr<IRemoteObject> UsbTransferWaiter::GetCallback() const
+{
+    if (callback_ == nullptr) {
+        return nullptr;
+    }
+    return callback_->AsObject();
+}
+
+int32_t UsbTransferWaiter::Wait(int32_t timeOut, const AliveCheck &isAlive, TransferDataResult &result)
+{
+    std::unique_lock<std::mutex> lock(state_->mutex);
+    while (!state_->done) {
+        auto now = std::chrono::steady_clock::now();
+        auto wakeUp = now + std::chrono::milliseconds(TRANSFER_POLL_MS);
+        /* a timeOut of 0 waits for ever on the device as well */
+        if (state_->started && timeOut > 0) {
+            auto deadline = state_->startTime +
+                std::chrono::milliseconds(static_cast<int64_t>(timeOut) + TRANSFER_WAIT_MARGIN_MS);
+            if (now >= deadline) {
+                USB_HILOGE(MODULE_USB_INNERKIT, "transfer result lost, timed out after %{public}d ms", timeOut);
+                return UEC_INTERFACE_TIMED_OUT;
+            }
+            wakeUp = std::min(wakeUp, deadline);
+        }
+        auto ready = [this]() { return state_->done; };
+        if (state_->cond.wait_until(lock, wakeUp, ready)) {
+            break;
+        }
+        if (isAlive != nullptr && !isAlive()) {
+            USB_HILOGE(MODULE_USB_INNERKIT, "service died before the transfer completed");
+            return UEC_INTERFACE_DEAD_OBJECT;
+        }
+    }
+    result = std::move(state_->result);
+    return result.status;
+}
+} // namespace USB
+} // namespace OHOS
@@ -44,4 +44,31 @@ int32_t UsbdCallBackServer::OnTransferReadCallback(int32_t status, int32_t actua
     return UEC_OK;
 }
 
+int32_t UsbdCallBackServer::OnTransferBatchCallback(std::vector<TransferBatchResult> &results)
+{
+    if (batchCallback_ == nullptr) {
+        return UEC_OK;
+    }
+    batchCallback_(results);
+    return UEC_OK;
+}
+
+int32_t UsbdCallBackServer::OnTransferDataCallback(TransferDataResult &result)
+{
+    if (dataCallback_ == nullptr) {
+        return UEC_OK;
+    }
+    dataCallback_(result);
+    return UEC_OK;
+}
+
+int32_t UsbdCallBackServer::OnTransferStartedCallback(uint64_t userData)
+{
+    if (startedCallback_ == nullptr) {
+        return UEC_OK;
+    }
+    startedCallback_(userData);
+    return UEC_OK;
+}
+
 } // namespace OHOS::USB
@@ -43,6 +43,36 @@ int32_t UsbdStubCallBack::OnRemoteRequest(uint32_t code, MessageParcel &data, Me
             TransferReadCallback(code, data);
             break;
         }
+        case CMD_USBD_TRANSFER_CALLBACK_BATCH: {
+            std::u16string descriptor = GetInterfaceDescriptor();
+            std::u16string remoteDescriptor = data.ReadInterfaceToken();
+            if (descriptor != remoteDescriptor) {
+                USB_HILOGE(MODULE_USB_INNERKIT, "UsbdStubCallBack: invalid descriptor");
+                return UEC_INTERFACE_PERMISSION_DENIED;
+            }
+            BatchTransferCallback(code, data);
+            break;
+        }
+        case CMD_USBD_TRANSFER_CALLBACK_DATA: {
+            std::u16string descriptor = GetInterfaceDescriptor();
+            std::u16string remoteDescriptor = data.ReadInterfaceToken();
+            if (descriptor != remoteDescriptor) {
+                USB_HILOGE(MODULE_USB_INNERKIT, "UsbdStubCallBack: invalid descriptor");
+                return UEC_INTERFACE_PERMISSION_DENIED;
+            }
+            DataTransferCallback(code, data);
+            break;
+        }
+        case CMD_USBD_TRANSFER_CALLBACK_STARTED: {
+            std::u16string descriptor = GetInterfaceDescriptor();
+            std::u16string remoteDescriptor = data.ReadInterfaceToken();
+            if (descriptor != remoteDescriptor) {
+                USB_HILOGE(MODULE_USB_INNERKIT, "UsbdStubCallBack: invalid descriptor");
+                return UEC_INTERFACE_PERMISSION_DENIED;
+            }
+            StartedTransferCallback(code, data);
+            break;
+        }
         default: {
             return IPCObjectStub::OnRemoteRequest(code, data, reply, option);
         }
@@ -103,4 +133,53 @@ int32_t UsbdStubCallBack::TransferReadCallback(uint32_t code, OHOS::MessageParce
         __LINE__, status, actLength);
     return OnTransferReadCallback(status, actLength, usbIsoVecParcel->isoInfoVec, userData);
 }
+
+int32_t UsbdStubCallBack::BatchTransferCallback(uint32_t code, OHOS::MessageParcel &data)
+{
+    uint32_t count = 0;
+    if (!data.ReadUint32(count) || count > MAX_NUM_OF_BATCH_TRANSFER) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "get count error");
+        return UEC_SERVICE_WRITE_PARCEL_ERROR;
+    }
+    std::vector<TransferBatchResult> results(count);
+    for (auto &result : results) {
+        std::shared_ptr<UsbIsoVecParcel> usbIsoVecParcel(data.ReadParcelable<UsbIsoVecParcel>());
+        if (usbIsoVecParcel == nullptr) {
+            USB_HILOGE(MODULE_USB_INNERKIT, "get usbIsoVecParcel error");
+            return UEC_SERVICE_WRITE_PARCEL_ERROR;
+        }
+        if (!data.ReadInt32(result.info.status) || !data.ReadInt32(result.info.actualLength) ||
+            !data.ReadUint64(result.userData)) {
+            USB_HILOGE(MODULE_USB_INNERKIT, "get transfer result error");
+            return UEC_SERVICE_WRITE_PARCEL_ERROR;
+        }
+        result.isoInfo = std::move(usbIsoVecParcel->isoInfoVec);
+    }
+    USB_HILOGI(MODULE_USB_INNERKIT, "%{public}d BatchTransferCallback count:%{public}u", __LINE__, count);
+    return OnTransferBatchCallback(results);
+}
+
+int32_t UsbdStubCallBack::DataTransferCallback(uint32_t code, OHOS::MessageParcel &data)
+{
+    TransferDataResult result;
+    if (!data.ReadInt32(result.status) || !data.ReadUInt8Vector(&result.clientData) ||
+        !data.ReadUInt8Vector(&result.bufferData) || !data.ReadUint64(result.userData)) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "get transfer result error");
+        /* the caller waits for this result, fail the transfer instead of dropping it */
+        result = {UEC_INTERFACE_READ_PARCEL_ERROR, {}, {}, 0};
+        (void)OnTransferDataCallback(result);
+        return UEC_SERVICE_WRITE_PARCEL_ERROR;
+    }
+    return OnTransferDataCallback(result);
+}
+
+int32_t UsbdStubCallBack::StartedTransferCallback(uint32_t code, OHOS::MessageParcel &data)
+{
+    uint64_t userData = 0;
+    if (!data.ReadUint64(userData)) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "get userData error");
+        return UEC_SERVICE_WRITE_PARCEL_ERROR;
+    }
+    return OnTransferStartedCallback(userData);
+}
 } // namespace OHOS::USB
@@ -16,12 +16,14 @@
 #define USB_ASYNC_CONTEXT_H
 
 #include <chrono>
+#include <memory>
 #include "napi/native_api.h"
 #include "napi/native_node_api.h"
 #include "usb_device_pipe.h"
 #include "usb_endpoint.h"
 #include "usb_request.h"
 #include "usb_accessory.h"
+#include "usb_transfer_buffer_pool.h"
 
 namespace OHOS {
 namespace USB {
@@ -120,6 +122,8 @@ struct USBDeviceControlTransferAsyncContext : USBAsyncContext {
 
 struct USBBulkTransferAsyncContext : USBAsyncContext {
     uint8_t *buffer;
+    /* set when buffer points into the caller's Uint8Array, which stays pinned until the work completes */
+    napi_ref bufferRef{nullptr};
     uint32_t bufferLength;
     uint32_t dataSize;
     int32_t timeOut = 0;
@@ -154,6 +158,8 @@ struct USBTransferAsyncContext : USBAsyncContext {
     int32_t actualLength;
     size_t bufferLength = 0;
     sptr<Ashmem> ashmem = nullptr;
+    std::shared_ptr<UsbTransferBufferPool> bufferPool = nullptr;
+    int32_t slot = -1;
     uint8_t *userData;
     uint8_t *buffer;
     uint32_t numIsoPackets;
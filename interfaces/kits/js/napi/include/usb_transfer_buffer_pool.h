@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_TRANSFER_BUFFER_POOL_H
+#define USB_TRANSFER_BUFFER_POOL_H
+
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include "ashmem.h"
+#include "usb_device_pipe.h"
+#include "usb_endpoint.h"
+
+namespace OHOS {
+namespace USB {
+/*
+ * Ashmem slots of one endpoint used by usbSubmitTransfer. A slot is created, mapped and registered with
+ * the service once, later transfers of the same size class reuse it and only pass the slot index.
+ */
+class UsbTransferBufferPool {
+public:
+    UsbTransferBufferPool(const USBDevicePipe &pipe, int32_t endpoint);
+    ~UsbTransferBufferPool() = default;
+
+    static std::shared_ptr<UsbTransferBufferPool> GetPool(const USBDevicePipe &pipe, int32_t endpoint);
+    static void RemovePools(const USBDevicePipe &pipe);
+
+    /* returns the slot holding a mapped buffer of at least length bytes, or -1 if none is available */
+    int32_t Acquire(int32_t length, sptr<Ashmem> &ashmem);
+    void Release(int32_t slot);
+    /* forgets every registered buffer, the next Acquire of each slot creates and registers a new one */
+    void Invalidate();
+
+private:
+    struct Slot {
+        sptr<Ashmem> ashmem = nullptr;
+        int32_t size = 0;
+        bool busy = false;
+    };
+
+    static int32_t GetSizeClass(int32_t length);
+    int32_t ReserveSlot(int32_t size, sptr<Ashmem> &ashmem, bool &reuse);
+    bool SetupSlot(int32_t slot, int32_t size, sptr<Ashmem> &ashmem);
+
+    USBDevicePipe pipe_;
+    int32_t endpoint_;
+    std::mutex mutex_;
+    std::vector<Slot> slots_;
+
+    static std::mutex poolsMutex_;
+    static std::unordered_map<uint32_t, std::shared_ptr<UsbTransferBufferPool>> pools_;
+};
+
+/*
+ * Staging buffer of one endpoint used by bulkTransfer. The caller's Uint8Array is pinned by the async
+ * work and copied into or out of this mapping once, the service reads and writes the same mapping.
+ */
+class UsbBulkTransferBuffer {
+public:
+    UsbBulkTransferBuffer(const USBDevicePipe &pipe, const USBEndpoint &endpoint);
+    ~UsbBulkTransferBuffer() = default;
+
+    static std::shared_ptr<UsbBulkTransferBuffer> GetBuffer(const USBDevicePipe &pipe, const USBEndpoint &endpoint);
+    static void RemoveBuffers(const USBDevicePipe &pipe);
+    static bool IsPooledLength(uint32_t length);
+
+    /* returns UEC_INTERFACE_NO_MEMORY if the staging buffer cannot be set up and the caller should copy */
+    int32_t Transfer(uint8_t *buffer, uint32_t length, int32_t timeOut, int32_t &actualLength);
+
+private:
+    int32_t Reserve(int32_t size);
+
+    USBDevicePipe pipe_;
+    USBEndpoint endpoint_;
+    std::mutex mutex_;
+    sptr<Ashmem> ashmem_ = nullptr;
+    int32_t size_ = 0;
+
+    static std::mutex buffersMutex_;
+    static std::unordered_map<uint32_t, std::shared_ptr<UsbBulkTransferBuffer>> buffers_;
+};
+} // namespace USB
+} // namespace OHOS
+#endif // USB_TRANSFER_BUFFER_POOL_H
@@ -31,6 +31,7 @@
 #include "napi/native_node_api.h"
 #include "napi_common.h"
 #include "napi_util.h"
+#include "parameters.h"
 #include "serial_async_context.h"
 #include "serial_napi_errors.h"
 #include "usb_errors.h"
@@ -44,6 +45,7 @@ using namespace OHOS::USB;
 const int32_t ARGC_1 = 1;
 const int32_t ARGC_2 = 2;
 const int32_t ARGC_3 = 3;
+constexpr const char *SERIAL_SHARED_RING_PARAM = "persist.usb.serial.shared_ring";
 
 static UsbSrvClient &g_usbClient = UsbSrvClient::GetInstance();
 
@@ -246,11 +248,9 @@ static napi_value SerialWriteSyncNapi(napi_env env, napi_callback_info info)
         "The type of buffer must be an array of uint8_t.")) {
         return nullptr;
     }
-    std::vector<uint8_t> bufferVector(static_cast<uint8_t*>(bufferValue),
-        static_cast<uint8_t*>(bufferValue) + bufferLength);
-
     uint32_t actualSize = 0;
-    int32_t ret = g_usbClient.SerialWrite(portIdValue, bufferVector, bufferLength, actualSize, timeoutValue);
+    int32_t ret = g_usbClient.SerialWrite(portIdValue, static_cast<uint8_t*>(bufferValue), bufferLength,
+        actualSize, timeoutValue);
     if (!CheckAndThrowOnError(env, (ret == 0), ErrorCodeConversion(ret), "SerialWrite Failed.")) {
         return nullptr;
     }
@@ -273,11 +273,9 @@ static auto g_serialWriteExecute = [](napi_env env, void* data) {
         return;
     }
 
-    std::vector<uint8_t> bufferVector(static_cast<uint8_t*>(bufferValue),
-        static_cast<uint8_t*>(bufferValue) + context->size);
-
     uint32_t actualSize = 0;
-    int32_t ret = g_usbClient.SerialWrite(context->portId, bufferVector, context->size, actualSize, context->timeout);
+    int32_t ret = g_usbClient.SerialWrite(context->portId, static_cast<uint8_t*>(bufferValue), context->size,
+        actualSize, context->timeout);
     if (ret != 0) {
         context->contextErrno = ErrorCodeConversion(ret);
     }
@@ -399,18 +397,12 @@ static napi_value SerialReadSyncNapi(napi_env env, napi_callback_info info)
         return nullptr;
     }
 
-    std::vector<uint8_t> bufferData;
     uint32_t actualSize = 0;
-    int32_t ret = g_usbClient.SerialRead(portIdValue, bufferData, bufferLength,
+    int32_t ret = g_usbClient.SerialRead(portIdValue, static_cast<uint8_t*>(bufferValue), bufferLength,
         actualSize, timeoutValue);
     if (!CheckAndThrowOnError(env, (ret == 0), ErrorCodeConversion(ret), "SerialReadSync Failed.")) {
         return nullptr;
     }
-    ret = memcpy_s(bufferValue, bufferLength, bufferData.data(), bufferData.size());
-    if (ret != UEC_OK) {
-        USB_HILOGE(MODULE_USB_NAPI,
-            "serial read sync, memcpy_s failed ret: %{public}d", ret);
-    }
     napi_value result = nullptr;
     napi_create_int32(env, actualSize, &result);
     return result;
@@ -419,16 +411,11 @@ static napi_value SerialReadSyncNapi(napi_env env, napi_callback_info info)
 static auto g_serialReadExecute = [](napi_env env, void* data) {
     SerialReadAsyncContext *context = static_cast<SerialReadAsyncContext *>(data);
     uint32_t actualSize = 0;
-    std::vector<uint8_t> bufferData;
-    int32_t ret = g_usbClient.SerialRead(context->portId, bufferData,
+    int32_t ret = g_usbClient.SerialRead(context->portId, static_cast<uint8_t*>(context->pData),
         context->size, actualSize, context->timeout);
     if (ret != 0) {
         context->contextErrno = ErrorCodeConversion(ret);
     }
-    ret = memcpy_s(context->pData, context->size, bufferData.data(), bufferData.size());
-    if (ret != UEC_OK) {
-        USB_HILOGE(MODULE_USB_NAPI, "memcpy_s failed ret: %{public}d", ret);
-    }
     context->ret = actualSize;
 };
 
@@ -514,7 +501,9 @@ static napi_value SerialOpenNapi(napi_env env, napi_callback_info info)
         return nullptr;
     }
     USB_HILOGE(MODULE_USB_NAPI, "portIdValue: %{public}d", portIdValue);
-    int ret = g_usbClient.SerialOpen(portIdValue);
+    /* shared rings spare read and write the binder call, they stay opt-in until proven on more devices */
+    bool useRing = OHOS::system::GetBoolParameter(SERIAL_SHARED_RING_PARAM, false);
+    int ret = g_usbClient.SerialOpen(portIdValue, useRing);
     if (!CheckAndThrowOnError(env, ret == 0, ErrorCodeConversion(ret), "SerialOpen failed.")) {
         return nullptr;
     }
@@ -17,6 +17,7 @@
 
 #include <sys/time.h>
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <cstdint>
@@ -40,6 +41,7 @@
 #include "usb_napi_errors.h"
 #include "usb_srv_client.h"
 #include "usb_accessory.h"
+#include "usb_transfer_buffer_pool.h"
 #include "hitrace_meter.h"
 #include "hdf_base.h"
 #include "struct_parcel.h"
@@ -1971,10 +1973,34 @@ static napi_value PipeUsbControlTransfer(napi_env env, napi_callback_info info)
     return result;
 }
 
+static bool BulkTransferWithSharedBuffer(USBBulkTransferAsyncContext *asyncContext)
+{
+    int32_t actualLength = 0;
+    auto sharedBuffer = UsbBulkTransferBuffer::GetBuffer(asyncContext->pipe, asyncContext->endpoint);
+    int32_t ret = sharedBuffer->Transfer(asyncContext->buffer, asyncContext->bufferLength, asyncContext->timeOut,
+        actualLength);
+    if (ret == UEC_INTERFACE_NO_MEMORY) {
+        return false;
+    }
+    USB_HILOGD(MODULE_USB_NAPI, "call pipe result %{public}d", ret);
+    if (ret == UEC_OK) {
+        asyncContext->status = napi_ok;
+        asyncContext->dataSize = static_cast<uint32_t>(actualLength);
+    } else {
+        USB_HILOGE(MODULE_USB_NAPI, "BulkTransferExecute failed");
+        asyncContext->status = napi_generic_failure;
+        asyncContext->dataSize = 0;
+    }
+    return true;
+}
+
 static auto g_bulkTransferExecute = [](napi_env env, void *data) {
     USBBulkTransferAsyncContext *asyncContext = reinterpret_cast<USBBulkTransferAsyncContext *>(data);
+    if (asyncContext->bufferRef != nullptr && BulkTransferWithSharedBuffer(asyncContext)) {
+        return;
+    }
     std::vector<uint8_t> bufferData(asyncContext->buffer, asyncContext->buffer + asyncContext->bufferLength);
-    if (asyncContext->endpoint.GetDirection() == USB_ENDPOINT_DIR_OUT) {
+    if (asyncContext->endpoint.GetDirection() == USB_ENDPOINT_DIR_OUT && asyncContext->bufferRef == nullptr) {
         delete[] asyncContext->buffer;
         asyncContext->buffer = nullptr;
     }
@@ -2019,6 +2045,10 @@ static auto g_bulkTransferComplete = [](napi_env env, napi_status status, void *
         USB_HILOGE(MODULE_USB_NAPI, "BulkTransfer failed");
         napi_create_int32(env, -1, &queryResult);
     }
+    if (asyncContext->bufferRef != nullptr) {
+        napi_delete_reference(env, asyncContext->bufferRef);
+        asyncContext->bufferRef = nullptr;
+    }
     if (asyncContext->deferred) {
         napi_resolve_deferred(env, asyncContext->deferred, queryResult);
     }
@@ -2040,7 +2070,11 @@ static bool GetDescriptorOnBulkTransferParam(napi_env env, napi_value data,
     asyncContext.env = env;
     asyncContext.endpoint = ep;
 
-    if (ep.GetDirection() == USB_ENDPOINT_DIR_OUT && bufferSize > 0) {
+    if (UsbBulkTransferBuffer::IsPooledLength(bufferSize) &&
+        napi_create_reference(env, data, 1, &asyncContext.bufferRef) == napi_ok) {
+        /* the pinned array is copied once into the endpoint's shared buffer on the work thread */
+        asyncContext.buffer = buffer;
+    } else if (ep.GetDirection() == USB_ENDPOINT_DIR_OUT && bufferSize > 0) {
         uint8_t *nativeArrayBuffer = new (std::nothrow) uint8_t[bufferSize];
         RETURN_IF_WITH_RET(nativeArrayBuffer == nullptr, false);
 
@@ -2254,16 +2288,30 @@ static napi_value ParmsInput(napi_env env, AsyncCallBackContext &asyncCBWork)
     return res;
 }
 
+static void ReleaseTransferBuffer(USBTransferAsyncContext *asyncContext)
+{
+    if (asyncContext->bufferPool != nullptr) {
+        /* pooled buffers stay mapped and registered, the slot only becomes free for the next transfer */
+        asyncContext->bufferPool->Release(asyncContext->slot);
+        asyncContext->bufferPool = nullptr;
+        asyncContext->ashmem = nullptr;
+        return;
+    }
+    asyncContext->ashmem->UnmapAshmem();
+    asyncContext->ashmem->CloseAshmem();
+}
+
 static int32_t ReadDataToBuffer(USBTransferAsyncContext *asyncContext, const TransferCallbackInfo &info)
 {
     uint8_t endpointId = static_cast<uint8_t>(asyncContext->endpoint) & USB_ENDPOINT_DIR_MASK;
     size_t actBufLen = info.actualLength;
     if (endpointId == USB_ENDPOINT_DIR_IN && asyncContext->bufferLength > 0 && info.actualLength > 0) {
-        asyncContext->ashmem->MapReadAndWriteAshmem();
+        if (asyncContext->bufferPool == nullptr) {
+            asyncContext->ashmem->MapReadAndWriteAshmem();
+        }
         auto ashmemBuffer = asyncContext->ashmem->ReadFromAshmem(info.actualLength, 0);
         if (ashmemBuffer == nullptr) {
-            asyncContext->ashmem->UnmapAshmem();
-            asyncContext->ashmem->CloseAshmem();
+            ReleaseTransferBuffer(asyncContext);
             return actBufLen;
         }
 
@@ -2277,8 +2325,7 @@ static int32_t ReadDataToBuffer(USBTransferAsyncContext *asyncContext, const Tra
             USB_HILOGE(MODULE_USB_NAPI, "memcpy_s fatal failed error: %{public}d", ret);
         }
     }
-    asyncContext->ashmem->UnmapAshmem();
-    asyncContext->ashmem->CloseAshmem();
+    ReleaseTransferBuffer(asyncContext);
     return actBufLen;
 }
 
@@ -2365,6 +2412,37 @@ static bool CreateAndWriteAshmem(USBTransferAsyncContext *asyncContext, HDI::Usb
     return true;
 }
 
+static bool AcquirePooledAshmem(USBTransferAsyncContext *asyncContext, HDI::Usb::V1_2::USBTransferInfo &obj)
+{
+    uint8_t endpointId = static_cast<uint8_t>(asyncContext->endpoint) & USB_ENDPOINT_DIR_MASK;
+    bool isOut = endpointId == USB_ENDPOINT_DIR_OUT && asyncContext->length > 0;
+    int32_t bufLen = asyncContext->length <= 0 ? DEFAULT_SUBMIT_BUFFER_SIZE : asyncContext->length;
+    if (isOut) {
+        bufLen = std::max(bufLen, static_cast<int32_t>(asyncContext->bufferLength));
+    }
+    auto pool = UsbTransferBufferPool::GetPool(asyncContext->pipe, asyncContext->endpoint);
+    int32_t slot = pool->Acquire(bufLen, asyncContext->ashmem);
+    if (slot < 0) {
+        asyncContext->ashmem = nullptr;
+        return false;
+    }
+    if (isOut) {
+        StartTraceEx(HITRACE_LEVEL_INFO, HITRACE_TAG_USB, "NAPI:WriteToAshmem");
+        bool written = asyncContext->ashmem->WriteToAshmem(asyncContext->buffer, asyncContext->bufferLength, 0);
+        FinishTraceEx(HITRACE_LEVEL_INFO, HITRACE_TAG_USB);
+        if (!written) {
+            USB_HILOGW(MODULE_USB_NAPI, "write pooled ashmem failed, fall back to a dedicated buffer");
+            pool->Release(slot);
+            asyncContext->ashmem = nullptr;
+            return false;
+        }
+        obj.length = static_cast<int32_t>(asyncContext->bufferLength);
+    }
+    asyncContext->bufferPool = pool;
+    asyncContext->slot = slot;
+    return true;
+}
+
 static int32_t UsbSubmitTransferErrorCode(int32_t &error)
 {
     switch (error) {
@@ -2409,7 +2487,8 @@ static napi_value UsbSubmitTransfer(napi_env env, napi_callback_info info)
     asyncContext->env = env;
     HDI::Usb::V1_2::USBTransferInfo obj;
     GetUSBTransferInfo(obj, asyncContext);
-    if (obj.numIsoPackets > MAX_NUM_OF_ISO_PACKAGE || !CreateAndWriteAshmem(asyncContext, obj)) {
+    if (obj.numIsoPackets > MAX_NUM_OF_ISO_PACKAGE ||
+        (!AcquirePooledAshmem(asyncContext, obj) && !CreateAndWriteAshmem(asyncContext, obj))) {
         delete asyncContext;
         asyncContext = nullptr;
         return nullptr;
@@ -2420,11 +2499,27 @@ static napi_value UsbSubmitTransfer(napi_env env, napi_callback_info info)
         return JsCallBack(asyncContext, info, isoInfo);
     };
     StartTraceEx(HITRACE_LEVEL_INFO, HITRACE_TAG_USB, "NAPI:UsbSubmitTransfer");
-    int32_t ret = asyncContext->pipe.UsbSubmitTransfer(obj, func, asyncContext->ashmem);
+    int32_t ret = asyncContext->bufferPool != nullptr ?
+        g_usbClient.UsbSubmitTransfer(asyncContext->pipe, obj, func, asyncContext->slot) :
+        asyncContext->pipe.UsbSubmitTransfer(obj, func, asyncContext->ashmem);
+    if (ret != napi_ok && asyncContext->bufferPool != nullptr) {
+        /* the service may have lost the registered slots, e.g. after a restart, they are registered anew later */
+        USB_HILOGW(MODULE_USB_NAPI, "pooled submit failed ret:%{public}d, fall back to a dedicated buffer", ret);
+        auto pool = asyncContext->bufferPool;
+        ReleaseTransferBuffer(asyncContext);
+        pool->Invalidate();
+        if (!CreateAndWriteAshmem(asyncContext, obj)) {
+            FinishTraceEx(HITRACE_LEVEL_INFO, HITRACE_TAG_USB);
+            delete asyncContext;
+            asyncContext = nullptr;
+            ThrowBusinessError(env, UsbSubmitTransferErrorCode(ret), "");
+            return nullptr;
+        }
+        ret = asyncContext->pipe.UsbSubmitTransfer(obj, func, asyncContext->ashmem);
+    }
     FinishTraceEx(HITRACE_LEVEL_INFO, HITRACE_TAG_USB);
     if (ret != napi_ok) {
-        asyncContext->ashmem->UnmapAshmem();
-        asyncContext->ashmem->CloseAshmem();
+        ReleaseTransferBuffer(asyncContext);
         delete asyncContext;
         asyncContext = nullptr;
         ret = UsbSubmitTransferErrorCode(ret);
@@ -2643,6 +2738,8 @@ static napi_value PipeClose(napi_env env, napi_callback_info info)
 
     USBDevicePipe pipe;
     ParseUsbDevicePipe(env, obj, pipe);
+    UsbTransferBufferPool::RemovePools(pipe);
+    UsbBulkTransferBuffer::RemoveBuffers(pipe);
     int32_t ret = pipe.Close();
     napi_value result;
     napi_create_int32(env, ret, &result);
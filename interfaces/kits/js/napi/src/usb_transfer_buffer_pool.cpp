@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_buffer_pool.h"
+
+#include <algorithm>
+
+#include "hilog_wrapper.h"
+#include "securec.h"
+#include "struct_parcel.h"
+#include "usb_errors.h"
+#include "usb_srv_client.h"
+
+namespace OHOS {
+namespace USB {
+constexpr const char *POOL_ASHMEM_NAME = "UsbSubmitTransferPool";
+constexpr const char *BULK_ASHMEM_NAME = "UsbBulkTransferBuffer";
+constexpr int32_t MIN_POOLED_BUFFER_SIZE = 1024;
+constexpr int32_t MAX_POOLED_BUFFER_SIZE = 256 * 1024;
+constexpr int32_t MIN_BULK_BUFFER_SIZE = 4 * 1024;
+constexpr int32_t MAX_BULK_BUFFER_SIZE = 1024 * 1024;
+constexpr uint32_t POOL_KEY_BUS_SHIFT = 16;
+constexpr uint32_t POOL_KEY_DEV_SHIFT = 8;
+constexpr uint32_t POOL_KEY_ENDPOINT_MASK = 0xFF;
+constexpr uint32_t POOL_KEY_BUS_DEV_MASK = 0xFFFF00;
+
+std::mutex UsbTransferBufferPool::poolsMutex_;
+std::unordered_map<uint32_t, std::shared_ptr<UsbTransferBufferPool>> UsbTransferBufferPool::pools_;
+std::mutex UsbBulkTransferBuffer::buffersMutex_;
+std::unordered_map<uint32_t, std::shared_ptr<UsbBulkTransferBuffer>> UsbBulkTransferBuffer::buffers_;
+
+static uint32_t GetEndpointKey(const USBDevicePipe &pipe, int32_t endpoint)
+{
+    return (static_cast<uint32_t>(pipe.GetBusNum()) << POOL_KEY_BUS_SHIFT) |
+        (static_cast<uint32_t>(pipe.GetDevAddr()) << POOL_KEY_DEV_SHIFT) |
+        (static_cast<uint32_t>(endpoint) & POOL_KEY_ENDPOINT_MASK);
+}
+
+static int32_t RoundUpBufferSize(int32_t length, int32_t minSize)
+{
+    int32_t size = minSize;
+    while (size < length) {
+        size <<= 1;
+    }
+    return size;
+}
+
+UsbTransferBufferPool::UsbTransferBufferPool(const USBDevicePipe &pipe, int32_t endpoint)
+    : pipe_(pipe), endpoint_(endpoint)
+{
+}
+
+std::shared_ptr<UsbTransferBufferPool> UsbTransferBufferPool::GetPool(const USBDevicePipe &pipe, int32_t endpoint)
+{
+    std::lock_guard<std::mutex> guard(poolsMutex_);
+    auto &pool = pools_[GetEndpointKey(pipe, endpoint)];
+    if (pool == nullptr) {
+        pool = std::make_shared<UsbTransferBufferPool>(pipe, endpoint);
+    }
+    return pool;
+}
+
+void UsbTransferBufferPool::RemovePools(const USBDevicePipe &pipe)
+{
+    std::vector<std::shared_ptr<UsbTransferBufferPool>> removed;
+    {
+        std::lock_guard<std::mutex> guard(poolsMutex_);
+        uint32_t busDev = GetEndpointKey(pipe, 0);
+        for (auto it = pools_.begin(); it != pools_.end();) {
+            if ((it->first & POOL_KEY_BUS_DEV_MASK) == busDev) {
+                removed.emplace_back(std::move(it->second));
+                it = pools_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    /* buffers of in-flight transfers stay alive through the references held by their contexts */
+    for (auto &pool : removed) {
+        UsbSrvClient::GetInstance().UnRegSubmitTransferBuffers(pool->pipe_, pool->endpoint_);
+    }
+}
+
+int32_t UsbTransferBufferPool::GetSizeClass(int32_t length)
+{
+    if (length > MAX_POOLED_BUFFER_SIZE) {
+        return 0;
+    }
+    return RoundUpBufferSize(length, MIN_POOLED_BUFFER_SIZE);
+}
+
+int32_t UsbTransferBufferPool::ReserveSlot(int32_t size, sptr<Ashmem> &ashmem, bool &reuse)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    int32_t spare = -1;
+    for (size_t i = 0; i < slots_.size(); ++i) {
+        Slot &slot = slots_[i];
+        if (slot.busy) {
+            continue;
+        }
+        if (slot.size == size && slot.ashmem != nullptr) {
+            slot.busy = true;
+            ashmem = slot.ashmem;
+            reuse = true;
+            return static_cast<int32_t>(i);
+        }
+        if (spare < 0) {
+            spare = static_cast<int32_t>(i);
+        }
+    }
+    if (spare < 0 && slots_.size() < MAX_NUM_OF_SUBMIT_BUFFER_SLOT) {
+        spare = static_cast<int32_t>(slots_.size());
+        slots_.emplace_back();
+    }
+    if (spare >= 0) {
+        /* an idle slot of another size class is replaced, the service drops its old buffer on registration */
+        slots_[spare].busy = true;
+        slots_[spare].ashmem = nullptr;
+        slots_[spare].size = 0;
+    }
+    reuse = false;
+    return spare;
+}
+
+bool UsbTransferBufferPool::SetupSlot(int32_t slot, int32_t size, sptr<Ashmem> &ashmem)
+{
+    ashmem = Ashmem::CreateAshmem(POOL_ASHMEM_NAME, size);
+    if (ashmem == nullptr || !ashmem->MapReadAndWriteAshmem()) {
+        USB_HILOGE(MODULE_USB_NAPI, "create pooled ashmem failed, size:%{public}d", size);
+        return false;
+    }
+    int32_t ret = UsbSrvClient::GetInstance().RegSubmitTransferBuffer(pipe_, endpoint_, slot, ashmem);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_NAPI, "register pooled ashmem failed, ret:%{public}d", ret);
+        return false;
+    }
+    std::lock_guard<std::mutex> guard(mutex_);
+    slots_[slot].ashmem = ashmem;
+    slots_[slot].size = size;
+    return true;
+}
+
+int32_t UsbTransferBufferPool::Acquire(int32_t length, sptr<Ashmem> &ashmem)
+{
+    int32_t size = GetSizeClass(length);
+    if (size == 0) {
+        return -1;
+    }
+    bool reuse = false;
+    int32_t slot = ReserveSlot(size, ashmem, reuse);
+    if (slot < 0 || reuse) {
+        return slot;
+    }
+    if (!SetupSlot(slot, size, ashmem)) {
+        ashmem = nullptr;
+        Release(slot);
+        return -1;
+    }
+    return slot;
+}
+
+void UsbTransferBufferPool::Release(int32_t slot)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (slot >= 0 && static_cast<size_t>(slot) < slots_.size()) {
+        slots_[slot].busy = false;
+    }
+}
+
+void UsbTransferBufferPool::Invalidate()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    /* busy slots keep their buffer alive through the transfer context, only the slot bookkeeping is reset */
+    for (Slot &slot : slots_) {
+        slot.ashmem = nullptr;
+        slot.size = 0;
+    }
+}
+
+UsbBulkTransferBuffer::UsbBulkTransferBuffer(const USBDevicePipe &pipe, const USBEndpoint &endpoint)
+    : pipe_(pipe), endpoint_(endpoint)
+{
+}
+
+std::shared_ptr<UsbBulkTransferBuffer> UsbBulkTransferBuffer::GetBuffer(const USBDevicePipe &pipe,
+    const USBEndpoint &endpoint)
+{
+    std::lock_guard<std::mutex> guard(buffersMutex_);
+    auto &buffer = buffers_[GetEndpointKey(pipe, endpoint.GetAddress())];
+    if (buffer == nullptr) {
+        buffer = std::make_shared<UsbBulkTransferBuffer>(pipe, endpoint);
+    }
+    return buffer;
+}
+
+void UsbBulkTransferBuffer::RemoveBuffers(const USBDevicePipe &pipe)
+{
+    std::vector<std::shared_ptr<UsbBulkTransferBuffer>> removed;
+    {
+        std::lock_guard<std::mutex> guard(buffersMutex_);
+        uint32_t busDev = GetEndpointKey(pipe, 0);
+        for (auto it = buffers_.begin(); it != buffers_.end();) {
+            if ((it->first & POOL_KEY_BUS_DEV_MASK) == busDev) {
+                removed.emplace_back(std::move(it->second));
+                it = buffers_.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    for (auto &buffer : removed) {
+        std::lock_guard<std::mutex> guard(buffer->mutex_);
+        if (buffer->ashmem_ != nullptr) {
+            UsbSrvClient::GetInstance().UnRegBulkTransferBuffer(buffer->pipe_, buffer->endpoint_);
+        }
+    }
+}
+
+bool UsbBulkTransferBuffer::IsPooledLength(uint32_t length)
+{
+    return length > 0 && length <= static_cast<uint32_t>(MAX_BULK_BUFFER_SIZE);
+}
+
+int32_t UsbBulkTransferBuffer::Reserve(int32_t size)
+{
+    if (ashmem_ != nullptr && size_ >= size) {
+        return UEC_OK;
+    }
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem(BULK_ASHMEM_NAME, size);
+    if (ashmem == nullptr || !ashmem->MapReadAndWriteAshmem()) {
+        USB_HILOGE(MODULE_USB_NAPI, "create bulk ashmem failed, size:%{public}d", size);
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    /* registering again replaces the smaller buffer of this endpoint on the service side */
+    int32_t ret = UsbSrvClient::GetInstance().RegBulkTransferBuffer(pipe_, endpoint_, ashmem);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_NAPI, "register bulk ashmem failed, ret:%{public}d", ret);
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    ashmem_ = ashmem;
+    size_ = size;
+    return UEC_OK;
+}
+
+int32_t UsbBulkTransferBuffer::Transfer(uint8_t *buffer, uint32_t length, int32_t timeOut, int32_t &actualLength)
+{
+    actualLength = 0;
+    if (buffer == nullptr || !IsPooledLength(length)) {
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    int32_t len = static_cast<int32_t>(length);
+    /* transfers of one endpoint share the mapping, the device serializes them anyway */
+    std::lock_guard<std::mutex> guard(mutex_);
+    int32_t ret = Reserve(RoundUpBufferSize(len, MIN_BULK_BUFFER_SIZE));
+    if (ret != UEC_OK) {
+        return ret;
+    }
+    if (endpoint_.GetDirection() == USB_ENDPOINT_DIR_OUT && !ashmem_->WriteToAshmem(buffer, len, 0)) {
+        USB_HILOGE(MODULE_USB_NAPI, "write bulk ashmem failed");
+        return UEC_INTERFACE_NO_MEMORY;
+    }
+    ret = UsbSrvClient::GetInstance().BulkTransfer(pipe_, endpoint_, 0, len, actualLength, timeOut);
+    if (ret != UEC_OK || endpoint_.GetDirection() != USB_ENDPOINT_DIR_IN || actualLength <= 0) {
+        return ret;
+    }
+    actualLength = std::min(actualLength, len);
+    const void *data = ashmem_->ReadFromAshmem(actualLength, 0);
+    if (data == nullptr || memcpy_s(buffer, length, data, actualLength) != EOK) {
+        USB_HILOGE(MODULE_USB_NAPI, "read bulk ashmem failed");
+        return UEC_INTERFACE_INNER_ERR;
+    }
+    return UEC_OK;
+}
+} // namespace USB
+} // namespace OHOS
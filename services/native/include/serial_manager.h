@@ -18,6 +18,7 @@
 
 #include <algorithm>
 #include <map>
+#include <memory>
 #include <mutex>
 #include <string>
 #include <vector>
@@ -25,6 +26,9 @@
 #include "v1_0/iserial_interface.h"
 #include <ipc_skeleton.h>
 #include "usb_right_manager.h"
+#include "serial_port_stream.h"
+#include "serial_ring_transport.h"
+#include "serial_write_queue.h"
 #include "nlohmann/json.hpp"
 
 namespace OHOS {
@@ -47,12 +51,16 @@ public:
         uint32_t &actualSize, uint32_t timeout);
     int32_t SerialWrite(int32_t portId, const std::vector<uint8_t>& data, uint32_t size,
         uint32_t &actualSize, uint32_t timeout);
+    int32_t SerialSubscribe(int32_t portId, const sptr<IRemoteObject> &serialRemote);
+    int32_t SerialUnsubscribe(int32_t portId);
+    int32_t SerialAttachRing(int32_t portId, SerialRingFds &fds);
     int32_t SerialGetAttribute(int32_t portId, OHOS::HDI::Usb::Serial::V1_0::SerialAttribute& attribute);
     int32_t SerialSetAttribute(int32_t portId, const OHOS::HDI::Usb::Serial::V1_0::SerialAttribute& attribute);
     int32_t SerialGetPortList(std::vector<OHOS::HDI::Usb::Serial::V1_0::SerialPort>& serialPortList);
     void SerialPortListDump(int32_t fd, const std::vector<std::string>& args);
     void ListGetDumpHelp(int32_t fd);
     void SerialGetAttributeDump(int32_t fd, const std::vector<std::string>& args);
+    void SerialStreamDump(int32_t fd);
     bool IsPortIdExist(int32_t portId);
     void FreeTokenId(int32_t portId, uint32_t tokenId);
     bool GetSerialPort(int32_t portId, OHOS::HDI::Usb::Serial::V1_0::SerialPort& serialPort);
@@ -70,6 +78,12 @@ private:
     void ReportSerialOperateSetAttributeSysEvent(int32_t portId, uint32_t tokenId,
         const OHOS::HDI::Usb::Serial::V1_0::SerialAttribute& attribute);
     void ReportSerialOperationSecurityInfo(int32_t portId, std::string operationType, uint64_t time);
+    std::shared_ptr<SerialPortStream> GetStream(int32_t portId);
+    void StopStream(int32_t portId);
+    bool HasRing(int32_t portId);
+    std::shared_ptr<SerialWriteQueue> GetWriteQueue(int32_t portId);
+    void RemoveWriteQueue(int32_t portId);
+    void StopRing(int32_t portId);
 
     std::map<int32_t, uint32_t> portTokenMap_;
     std::map<int32_t, OHOS::HDI::Usb::Serial::V1_0::SerialPort> serialPortMap_;
@@ -82,6 +96,14 @@ private:
     std::unordered_set<int32_t> portsHasBeenWritten_;
     std::mutex readStatusMutex_;
     std::mutex writeStatusMutex_;
+    std::map<int32_t, std::shared_ptr<SerialPortStream>> streams_;
+    std::mutex streamsMutex_;
+    std::map<int32_t, std::shared_ptr<SerialRingTransport>> rings_;
+    std::mutex ringsMutex_;
+    std::map<int32_t, std::shared_ptr<SerialWriteQueue>> writeQueues_;
+    std::mutex writeQueuesMutex_;
+    uint32_t writeCoalesceWindowUs_ = 0;
+    uint32_t writeCoalesceMaxBytes_ = 0;
 };
 } // namespace SERIAL
 } // namespace OHOS
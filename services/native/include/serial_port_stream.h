@@ -0,0 +1,75 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_PORT_STREAM_H
+#define SERIAL_PORT_STREAM_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "iremote_object.h"
+#include "v1_0/iserial_interface.h"
+
+namespace OHOS {
+namespace SERIAL {
+/*
+ * Receive side of a subscribed port. A reader thread keeps pulling from the HDI into a ring buffer, so
+ * bytes arriving between two SerialRead calls are not lost. The client is told through its serialRemote
+ * when data becomes available, once per drain. A full ring stops the reader until the client catches up.
+ */
+class SerialPortStream {
+public:
+    SerialPortStream(const sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> &serial, int32_t portId,
+        const sptr<IRemoteObject> &notifier);
+    ~SerialPortStream();
+
+    void Start();
+    void Stop();
+    int32_t Read(std::vector<uint8_t> &data, uint32_t size, uint32_t &actualSize, uint32_t timeout);
+    void Dump(int32_t fd);
+
+private:
+    void ReadLoop();
+    bool WaitForSpace();
+    void Push(const uint8_t *data, size_t len);
+    void Notify(uint32_t available);
+
+    sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> serial_;
+    int32_t portId_;
+    sptr<IRemoteObject> notifier_;
+    std::thread reader_;
+    std::atomic<bool> running_ {false};
+
+    std::mutex mutex_;
+    std::condition_variable dataCond_;
+    std::condition_variable spaceCond_;
+    std::vector<uint8_t> ring_;
+    size_t head_ = 0;
+    size_t count_ = 0;
+    bool notifyArmed_ = true;
+
+    std::atomic<uint64_t> receivedBytes_ {0};
+    std::atomic<uint64_t> deliveredBytes_ {0};
+    std::atomic<uint64_t> backpressureCount_ {0};
+    std::atomic<uint64_t> overrunCount_ {0};
+    std::atomic<uint64_t> errorCount_ {0};
+};
+} // namespace SERIAL
+} // namespace OHOS
+
+#endif // SERIAL_PORT_STREAM_H
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_RING_TRANSPORT_H
+#define SERIAL_RING_TRANSPORT_H
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include "ashmem.h"
+#include "serial_shm_ring.h"
+#include "v1_0/iserial_interface.h"
+
+namespace OHOS {
+namespace SERIAL {
+struct SerialRingFds {
+    int32_t ringFd = -1;
+    int32_t rxDataFd = -1;
+    int32_t rxSpaceFd = -1;
+    int32_t txDataFd = -1;
+    int32_t txSpaceFd = -1;
+};
+
+/*
+ * Service end of the shared-memory transport of an open port. The RX pump moves device input into the RX
+ * ring, the TX pump drains the TX ring into the device. The client maps the same ashmem and talks to the
+ * rings directly, so a read or write costs a copy instead of a binder transaction.
+ */
+class SerialRingTransport {
+public:
+    SerialRingTransport(const sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> &serial, int32_t portId);
+    ~SerialRingTransport();
+
+    int32_t Init();
+    void Start();
+    void Stop();
+    /* descriptors stay owned by the transport, binder duplicates them for the client */
+    SerialRingFds GetFds() const;
+    void Dump(int32_t fd);
+
+private:
+    void RxLoop();
+    void TxLoop();
+    void Release();
+
+    sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> serial_;
+    int32_t portId_;
+    sptr<Ashmem> ashmem_;
+    void *base_ = nullptr;
+    SerialRingFds fds_;
+    USB::SerialShmRing rx_;
+    USB::SerialShmRing tx_;
+    std::thread rxPump_;
+    std::thread txPump_;
+    std::atomic<bool> running_ {false};
+
+    std::atomic<uint64_t> receivedBytes_ {0};
+    std::atomic<uint64_t> sentBytes_ {0};
+    std::atomic<uint64_t> backpressureCount_ {0};
+    std::atomic<uint64_t> overrunCount_ {0};
+    std::atomic<uint64_t> errorCount_ {0};
+};
+} // namespace SERIAL
+} // namespace OHOS
+
+#endif // SERIAL_RING_TRANSPORT_H
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_WRITE_QUEUE_H
+#define SERIAL_WRITE_QUEUE_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <vector>
+#include "v1_0/iserial_interface.h"
+
+namespace OHOS {
+namespace SERIAL {
+/*
+ * Write queue of one port. Concurrent writers line up in arrival order; the writer at the head turns leader,
+ * optionally lingers for the coalesce window, and hands every queued frame with the same timeout to the HDI
+ * as one write. Each writer still gets back its own byte count, and bytes reach the device in queue order.
+ * When the device takes only part of a batch, the frame it stopped in gets the short count and the frames
+ * behind it fail without being sent.
+ */
+class SerialWriteQueue {
+public:
+    SerialWriteQueue(const sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> &serial, int32_t portId,
+        uint32_t windowUs, uint32_t maxBytes);
+    ~SerialWriteQueue() = default;
+
+    /* same contract as the HDI SerialWrite: bytes written or a negative HDI error */
+    int32_t Write(const std::vector<uint8_t> &data, uint32_t size, uint32_t timeout);
+    void Dump(int32_t fd);
+
+private:
+    struct Request {
+        const uint8_t *data = nullptr;
+        uint32_t size = 0;
+        uint32_t timeout = 0;
+        int32_t ret = 0;
+        bool done = false;
+        bool leader = false;
+    };
+
+    void Lead(std::unique_lock<std::mutex> &lock, Request &self);
+    void TakeBatch(std::vector<Request *> &batch, std::vector<uint8_t> &buffer);
+    void Complete(std::vector<Request *> &batch, int32_t ret);
+
+    sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> serial_;
+    int32_t portId_;
+    uint32_t windowUs_;
+    uint32_t maxBytes_;
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::condition_variable fillCond_;
+    std::deque<Request *> pending_;
+    uint64_t pendingBytes_ = 0;
+    bool hasLeader_ = false;
+
+    std::atomic<uint64_t> requestCount_ {0};
+    std::atomic<uint64_t> flushCount_ {0};
+    std::atomic<uint64_t> writtenBytes_ {0};
+};
+} // namespace SERIAL
+} // namespace OHOS
+
+#endif // SERIAL_WRITE_QUEUE_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USBMGR_USB_BATCH_TRANSFER_CALLBACK_IMPL_H
+#define USBMGR_USB_BATCH_TRANSFER_CALLBACK_IMPL_H
+
+#include <mutex>
+#include <vector>
+#include <refbase.h>
+#include "ashmem.h"
+#include "iremote_object.h"
+#include "v1_2/iusbd_transfer_callback.h"
+#include "v1_2/usb_types.h"
+#ifdef USB_MANAGER_PASS_THROUGH
+#include "v2_0/iusbd_transfer_callback.h"
+#include "v2_0/usb_types.h"
+#endif // USB_MANAGER_PASS_THROUGH
+
+namespace OHOS {
+namespace USB {
+/*
+ * Collects the completions of one batched submission. Each sub-transfer owns a slice of the caller's
+ * shared region, results are reported back to the caller in a single callback once all have completed.
+ */
+class UsbBatchTransferCollector : public RefBase {
+public:
+    UsbBatchTransferCollector(const sptr<IRemoteObject> &cb, const sptr<Ashmem> &ashmem, size_t count);
+    ~UsbBatchTransferCollector() = default;
+
+    void SetSubTransfer(size_t index, int32_t offset, int32_t length, const sptr<Ashmem> &buffer);
+    void OnTransferDone(size_t index, int32_t status, int32_t actLength,
+        const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, uint64_t userData, bool isRead);
+    void Abort();
+    /* transfers from index on were never submitted, they complete at once with status */
+    void FailFrom(size_t index, int32_t status);
+
+private:
+    struct SubTransfer {
+        int32_t offset = 0;
+        int32_t length = 0;
+        sptr<Ashmem> buffer = nullptr;
+        bool done = false;
+        int32_t status = 0;
+        int32_t actLength = 0;
+        uint64_t userData = 0;
+        std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> isoInfo;
+    };
+    void CopyReadData(const SubTransfer &transfer);
+    int32_t SendBatchResult(const std::vector<SubTransfer> &transfers);
+
+    std::mutex mutex_;
+    sptr<IRemoteObject> remote_ = nullptr;
+    sptr<Ashmem> ashmem_ = nullptr;
+    std::vector<SubTransfer> transfers_;
+    size_t doneCount_ = 0;
+    bool aborted_ = false;
+};
+
+class UsbdBatchTransferCallbackImpl : public HDI::Usb::V1_2::IUsbdTransferCallback {
+public:
+    UsbdBatchTransferCallbackImpl(const sptr<UsbBatchTransferCollector> &collector, size_t index)
+        : collector_(collector), index_(index) {}
+
+    int32_t OnTransferWriteCallback(int32_t status, int32_t actLength,
+        const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData) override;
+    int32_t OnTransferReadCallback(int32_t status, int32_t actLength,
+        const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData) override;
+
+private:
+    sptr<UsbBatchTransferCollector> collector_ = nullptr;
+    size_t index_;
+};
+
+#ifdef USB_MANAGER_PASS_THROUGH
+class UsbBatchTransferCallbackImpl : public HDI::Usb::V2_0::IUsbdTransferCallback {
+public:
+    UsbBatchTransferCallbackImpl(const sptr<UsbBatchTransferCollector> &collector, size_t index)
+        : collector_(collector), index_(index) {}
+
+    int32_t OnTransferWriteCallback(int32_t status, int32_t actLength,
+        const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData) override;
+    int32_t OnTransferReadCallback(int32_t status, int32_t actLength,
+        const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData) override;
+
+private:
+    sptr<UsbBatchTransferCollector> collector_ = nullptr;
+    size_t index_;
+};
+#endif // USB_MANAGER_PASS_THROUGH
+} // namespace USB
+} // namespace OHOS
+#endif // USBMGR_USB_BATCH_TRANSFER_CALLBACK_IMPL_H
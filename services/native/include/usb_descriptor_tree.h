@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_DESCRIPTOR_TREE_H
+#define USB_DESCRIPTOR_TREE_H
+
+#include <cstdint>
+#include <vector>
+#include "usb_config.h"
+
+namespace OHOS {
+namespace USB {
+enum class DescriptorType {
+    DESCRIPTOR_TYPE_DEVICE = 1,
+    DESCRIPTOR_TYPE_CONFIG = 2,
+    DESCRIPTOR_TYPE_INTERFACE = 4,
+    DESCRIPTOR_TYPE_ENDPOINT = 5,
+    DESCRIPTOR_TYPE_SS_ENDPOINT_COMPANION = 0x30,
+    DESCRIPTOR_TYPE_SSP_ISOC_ENDPOINT_COMPANION = 0x31
+};
+
+/* a byte range of the tree's raw buffer, nodes refer to descriptors through it instead of copying them */
+struct UsbDescriptorView {
+    uint32_t offset = 0;
+    uint32_t length = 0;
+};
+
+struct UsbConfigNode {
+    UsbDescriptorView desc;
+    /* class-specific and unknown descriptors following the node up to the next standard one */
+    UsbDescriptorView extra;
+    uint32_t firstInterface = 0;
+    uint32_t interfaceCount = 0;
+};
+
+struct UsbInterfaceNode {
+    UsbDescriptorView desc;
+    UsbDescriptorView extra;
+    uint32_t firstEndpoint = 0;
+    uint32_t endpointCount = 0;
+};
+
+struct UsbEndpointNode {
+    UsbDescriptorView desc;
+    UsbDescriptorView extra;
+    UsbDescriptorView ssCompanion;
+    UsbDescriptorView sspIsocCompanion;
+    /* packets per burst, 1 below SuperSpeed */
+    uint8_t maxBurst = 1;
+    /* bursts per service interval of a SuperSpeed isochronous endpoint */
+    uint8_t mult = 1;
+    /* streams of a SuperSpeed bulk endpoint, 0 when streams are not supported */
+    uint32_t maxStreams = 0;
+    /* bytes per service interval of a periodic SuperSpeed endpoint */
+    uint32_t bytesPerInterval = 0;
+};
+
+/*
+ * Flat descriptor tree built in one pass over a single buffer. Configs, interfaces and endpoints live in one
+ * array each and refer to children by index range, and every node points back into the raw bytes.
+ * Class-specific descriptors, interface associations included, stay reachable through the extra views.
+ */
+class UsbDescriptorTree {
+public:
+    UsbDescriptorTree() = default;
+    ~UsbDescriptorTree() = default;
+
+    /* parses the config descriptors found from offset, the tree keeps a copy of the buffer */
+    int32_t Parse(const std::vector<uint8_t> &raw, uint32_t offset);
+    /* builds the legacy config objects, every vector is sized once */
+    void ToConfigs(std::vector<USBConfig> &configs) const;
+
+    const uint8_t *Data(const UsbDescriptorView &view) const;
+    const std::vector<uint8_t> &GetRaw() const;
+    const std::vector<UsbConfigNode> &GetConfigs() const;
+    const std::vector<UsbInterfaceNode> &GetInterfaces() const;
+    const std::vector<UsbEndpointNode> &GetEndpoints() const;
+
+private:
+    enum class Owner { NONE, CONFIG, INTERFACE, ENDPOINT };
+
+    int32_t AddConfig(uint32_t cursor, uint8_t length);
+    int32_t AddInterface(uint32_t cursor, uint8_t length);
+    int32_t AddEndpoint(uint32_t cursor, uint8_t length);
+    void AddSsCompanion(uint32_t cursor, uint8_t length);
+    void AddSspIsocCompanion(uint32_t cursor, uint8_t length);
+    void AddExtra(uint32_t cursor, uint8_t length);
+    UsbDescriptorView *GetOwnerExtra();
+
+    std::vector<uint8_t> raw_;
+    std::vector<UsbConfigNode> configs_;
+    std::vector<UsbInterfaceNode> interfaces_;
+    std::vector<UsbEndpointNode> endpoints_;
+    Owner owner_ = Owner::NONE;
+};
+} // namespace USB
+} // namespace OHOS
+#endif // USB_DESCRIPTOR_TREE_H
@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_DEVICE_EVENT_DISPATCHER_H
+#define USB_DEVICE_EVENT_DISPATCHER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+namespace OHOS {
+namespace USB {
+/*
+ * Runs hot-plug events on a bounded worker pool. Events with the same key (bus/dev) run in arrival
+ * order one at a time, events of different keys overlap. A burst is the interval in which at least
+ * one event is pending, its duration is kept as the settle time.
+ */
+class UsbDeviceEventDispatcher {
+public:
+    explicit UsbDeviceEventDispatcher(size_t workerNum);
+    ~UsbDeviceEventDispatcher();
+
+    void Dispatch(uint16_t key, std::function<void()> task);
+    int64_t GetLastSettleTimeMs();
+    int64_t GetMaxSettleTimeMs();
+    uint32_t GetLastBurstSize();
+    void Dump(int32_t fd);
+
+private:
+    void WorkLoop();
+    void OnTaskDone(uint16_t key);
+
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::vector<std::thread> workers_;
+    std::unordered_map<uint16_t, std::deque<std::function<void()>>> pendingTasks_;
+    std::deque<uint16_t> readyKeys_;
+    size_t pendingCount_ = 0;
+    bool stop_ = false;
+    std::chrono::steady_clock::time_point burstStart_;
+    uint32_t burstSize_ = 0;
+    uint32_t lastBurstSize_ = 0;
+    int64_t lastSettleTimeMs_ = 0;
+    int64_t maxSettleTimeMs_ = 0;
+};
+} // namespace USB
+} // namespace OHOS
+
+#endif // USB_DEVICE_EVENT_DISPATCHER_H
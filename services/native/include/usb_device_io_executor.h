@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_DEVICE_IO_EXECUTOR_H
+#define USB_DEVICE_IO_EXECUTOR_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace OHOS {
+namespace USB {
+/*
+ * Runs blocking host transfers off the binder threads. Every device gets one lane per endpoint, a lane runs
+ * its transfers in arrival order on a thread of its own, so a reader blocked on an IN endpoint never holds up
+ * the OUT endpoint of the same device. A lane thread exits once it is idle for a while and is started again
+ * by the next transfer.
+ */
+class UsbDeviceIoExecutor {
+public:
+    UsbDeviceIoExecutor(size_t laneLimit, size_t queueLimit, uint32_t idleTimeoutMs);
+    ~UsbDeviceIoExecutor();
+
+    /* false when the lane is full, all lanes are busy or the executor is stopping, the task is not run then */
+    bool Post(uint8_t busNum, uint8_t devAddr, uint8_t lane, std::function<void()> task);
+    size_t GetRunningLaneCount();
+
+private:
+    struct Lane {
+        std::thread worker;
+        std::condition_variable cond;
+        std::deque<std::function<void()>> tasks;
+        bool running = false;
+    };
+
+    void WorkLoop(Lane &lane);
+    void ReapIdleLanes();
+
+    size_t laneLimit_;
+    size_t queueLimit_;
+    uint32_t idleTimeoutMs_;
+    std::mutex mutex_;
+    std::unordered_map<uint32_t, std::unique_ptr<Lane>> lanes_;
+    size_t runningLanes_ = 0;
+    bool stop_ = false;
+};
+} // namespace USB
+} // namespace OHOS
+
+#endif // USB_DEVICE_IO_EXECUTOR_H
@@ -16,8 +16,13 @@
 #ifndef USB_HOST_MANAGER_H
 #define USB_HOST_MANAGER_H
 
+#include <atomic>
+#include <chrono>
+#include <deque>
 #include <map>
+#include <shared_mutex>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "system_ability.h"
@@ -25,6 +30,7 @@
 #include "usb_right_manager.h"
 #include "serial_manager.h"
 #include "usb_interface_type.h"
+#include "usb_policy_matcher.h"
 #include "v1_2/iusb_interface.h"
 #include "iremote_object.h"
 #include "system_ability_load_callback_stub.h"
@@ -37,6 +43,7 @@
 #include "usb_manager_subscriber.h"
 #include "usb_bulkcallback_impl.h"
 #include "usb_transfer_callback_impl.h"
+#include "usb_batch_transfer_callback_impl.h"
 #endif // USB_MANAGER_PASS_THROUGH
 
 namespace OHOS {
@@ -49,7 +56,8 @@ struct DeviceClassUsage {
         : usage(uage), description(des) {};
 };
 
-typedef std::map<std::string, UsbDevice *> MAP_STR_DEVICE;
+/* key is busNum << 8 | devAddr */
+typedef std::unordered_map<uint16_t, UsbDevice *> MAP_BUS_DEV_DEVICE;
 class UsbHostManager {
 public:
     explicit UsbHostManager(SystemAbility *systemAbility);
@@ -68,6 +76,16 @@ public:
     bool Dump(int fd, const std::string &args);
     void ExecuteStrategy();
     void SetSerialManager(std::shared_ptr<SERIAL::SerialManager> serialManager);
+    /* open session of caller tokenId on busNum-devAddr, identity is in VID-PID-SERIAL format, the session
+     * is no longer valid from expireTime on, the wall clock seconds at which the granting right expires */
+    void AddDeviceSession(uint32_t tokenId, uint8_t busNum, uint8_t devAddr, const std::string &identity,
+        uint64_t expireTime);
+    bool CheckDeviceSession(uint32_t tokenId, uint8_t busNum, uint8_t devAddr);
+    void RemoveDeviceSession(uint32_t tokenId, uint8_t busNum, uint8_t devAddr);
+    void RemoveDeviceSessions(uint32_t tokenId, const std::string &identity);
+    void RemoveDeviceSessions(const std::string &identity);
+    void RemoveDeviceSessions(uint8_t busNum, uint8_t devAddr);
+    void ClearDeviceSessions();
 
     int32_t OpenDevice(uint8_t busNum, uint8_t devAddr);
     int32_t Close(uint8_t busNum, uint8_t devAddr);
@@ -89,6 +107,10 @@ public:
         const HDI::Usb::V1_0::UsbDev &dev, uint8_t configId, uint8_t interfaceId, bool authorized);
 
     int32_t GetDevices(std::vector<UsbDevice> &deviceList);
+    int32_t GetDevicesSnapshot(int32_t &fd, uint32_t &size, uint64_t &sequence);
+    int32_t GetDeviceGeneration(uint64_t &generation);
+    int32_t GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync, std::vector<UsbDevice> &added,
+        std::vector<UsbDevice> &changed, std::vector<std::string> &removed);
     int32_t GetDeviceInfo(uint8_t busNum, uint8_t devAddr, UsbDevice &dev);
     int32_t GetDeviceInfoDescriptor(
         const HDI::Usb::V1_0::UsbDev &uDev, std::vector<uint8_t> &descriptor, UsbDevice &dev);
@@ -117,6 +139,9 @@ public:
     int32_t UsbCancelTransfer(const HDI::Usb::V1_0::UsbDev &devInfo, const int32_t &endpoint);
     int32_t UsbSubmitTransfer(const HDI::Usb::V1_0::UsbDev &devInfo, HDI::Usb::V1_2::USBTransferInfo &info,
         const sptr<IRemoteObject> &cb, sptr<Ashmem> &ashmem);
+    /* payloads of infos are laid out back to back in ashmem, in submission order */
+    int32_t UsbSubmitTransferBatch(const HDI::Usb::V1_0::UsbDev &devInfo,
+        std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos, const sptr<IRemoteObject> &cb, sptr<Ashmem> &ashmem);
     int32_t RegBulkCallback(const HDI::Usb::V1_0::UsbDev &devInfo, const HDI::Usb::V1_0::UsbPipe &pipe,
         const sptr<IRemoteObject> &cb);
     int32_t UnRegBulkCallback(const HDI::Usb::V1_0::UsbDev &devInfo, const HDI::Usb::V1_0::UsbPipe &pipe);
@@ -125,6 +150,23 @@ public:
     int32_t BulkWrite(
         const HDI::Usb::V1_0::UsbDev &devInfo, const HDI::Usb::V1_0::UsbPipe &pipe, sptr<Ashmem> &ashmem);
     int32_t BulkCancel(const HDI::Usb::V1_0::UsbDev &devInfo, const HDI::Usb::V1_0::UsbPipe &pipe);
+    /* shared memory registered by tokenId for synchronous bulk transfer on one pipe, the buffers of a token are
+     * dropped when its client object dies */
+    int32_t RegBulkTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+        const HDI::Usb::V1_0::UsbPipe &pipe, sptr<Ashmem> &ashmem, const sptr<IRemoteObject> &client);
+    int32_t UnRegBulkTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+        const HDI::Usb::V1_0::UsbPipe &pipe);
+    void RemoveBulkTransferBuffers(uint8_t busNum, uint8_t devAddr);
+    void RemoveTokenTransferBuffers(uint32_t tokenId);
+    int32_t RegSubmitTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo, int32_t endpoint,
+        int32_t slot, sptr<Ashmem> &ashmem);
+    int32_t UnRegSubmitTransferBuffers(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo, int32_t endpoint);
+    int32_t UsbSubmitTransferWithBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+        HDI::Usb::V1_2::USBTransferInfo &info, const sptr<IRemoteObject> &cb, int32_t slot);
+    int32_t BulkTransferReadWithBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+        const HDI::Usb::V1_0::UsbPipe &pipe, int32_t offset, int32_t length, int32_t &actualLength, int32_t timeOut);
+    int32_t BulkTransferWriteWithBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+        const HDI::Usb::V1_0::UsbPipe &pipe, int32_t offset, int32_t length, int32_t timeOut);
 
 private:
     bool PublishCommonEvent(const std::string &event, UsbDevice &dev);
@@ -135,9 +177,17 @@ private:
     std::string GetInterfaceUsageDescription(const UsbDeviceType &interfaceType);
     int32_t FillDevStrings(UsbDevice &dev);
     std::string GetDevStringValFromIdx(uint8_t busNum, uint8_t devAddr, uint8_t idx);
+    std::string GetDevStringValFromIdx(uint8_t busNum, uint8_t devAddr, uint8_t idx,
+        std::unordered_map<uint8_t, std::string> &strings, bool &complete);
+    static std::string GetDevStringCacheKey(UsbDevice &dev, const std::string &serial);
+    bool QueryDevStringCache(const std::string &key, std::unordered_map<uint8_t, std::string> &strings);
+    void UpdateDevStringCache(const std::string &key, const std::unordered_map<uint8_t, std::string> &strings);
     bool IsEdmEnabled();
     int32_t ExecuteManageDevicePolicy(std::vector<UsbDeviceId> &trustList);
+    int32_t ExecuteManageDevicePolicy(const UsbPolicyMatcher &matcher);
     int32_t ExecuteManageInterfaceType(const std::vector<UsbDeviceType> &disableType, bool disable);
+    int32_t ExecuteManageInterfaceType(const UsbPolicyMatcher &matcher, bool disable);
+    int32_t ExecuteManageInterfaceType(const UsbPolicyMatcher &matcher, bool disable, UsbDevice &device);
     int32_t GetEdmPolicy(bool &IsGlobalDisabled, std::vector<UsbDeviceType> &disableType,
         std::vector<UsbDeviceId> &trustUsbDeviceIds);
     int32_t GetUsbPolicy(bool &IsGlobalDisabled, std::vector<UsbDeviceType> &disableType,
@@ -147,22 +197,115 @@ private:
     int32_t GetEdmStroageTypePolicy(sptr<IRemoteObject> remote, std::vector<UsbDeviceType> &disableType);
     int32_t GetEdmTrustListPolicy(sptr<IRemoteObject> remote, std::vector<UsbDeviceId> &trustUsbDeviceIds);
     int32_t ManageInterface(const HDI::Usb::V1_0::UsbDev &dev, uint8_t interfaceId, bool disable);
-    void FindMatchingTypes(const std::unordered_map<InterfaceType, std::vector<int32_t>> &map, bool isDev,
-        std::vector<InterfaceType> &matchingTypes, const std::vector<UsbDeviceType> &disableType);
-    void ExecuteManageDeviceType(const std::vector<UsbDeviceType> &disableType, bool disable,
-        const std::unordered_map<InterfaceType, std::vector<int32_t>> &map, bool isDev);
     int32_t ManageGlobalInterfaceImpl(bool disable);
+    int32_t ManageGlobalInterfaceImpl(UsbDevice &device, bool disable);
     int32_t ManageDeviceImpl(int32_t vendorId, int32_t productId, bool disable);
-    int32_t ManageInterfaceTypeImpl(InterfaceType interfaceType, bool disable);
-    int32_t ManageDeviceTypeImpl(InterfaceType interfaceType, bool disable);
+    int32_t ManageDeviceImpl(UsbDevice &device, bool disable);
+    int32_t ManageInterfaceTypeImpl(UsbDevice &device, const UsbPolicyMatcher &matcher, bool disable);
+    int32_t ManageDeviceTypeImpl(UsbDevice &device, const UsbPolicyMatcher &matcher, bool disable);
     void AddUsbSerialDevice(UsbDevice &dev);
     bool IsUsbSerialDevice(UsbDevice &dev);
     bool IsUsbSerialDisable();
     void ReportManageDeviceInfo(const std::string &operationType, UsbDevice* device,
         const UsbInterface* interface, bool isInterfaceType);
     int32_t CheckDevPathIsExist(uint8_t busNum, uint8_t devAddr);
+    int32_t WaitDevPathReady(uint8_t busNum, uint8_t devAddr, int32_t timeoutMs);
+    int32_t WaitDevPathReadyByPoll(uint8_t busNum, uint8_t devAddr, int32_t timeoutMs);
     void LoadEdmService();
-    MAP_STR_DEVICE devices_;
+    static uint64_t GetDeviceSessionKey(uint32_t tokenId, uint8_t busNum, uint8_t devAddr);
+    static uint16_t GetBusDevKey(uint8_t busNum, uint8_t devAddr);
+    static bool GetBusDevKey(const std::string &deviceName, uint16_t &key);
+    static uint32_t GetVidPidKey(int32_t vendorId, int32_t productId);
+    void RemoveVidPidIndex(uint16_t busDev, const UsbDevice &dev);
+    void ExecuteAttachStrategy(uint16_t busDev);
+    /* EDM policy as last read from the EDM SA, dropped whenever EDM pushes a policy change */
+    struct UsbPolicySnapshot {
+        uint64_t version = 0;
+        bool isGlobalDisabled = false;
+        std::vector<UsbDeviceType> disableType;
+        std::vector<UsbDeviceId> trustUsbDeviceIds;
+        std::shared_ptr<const UsbPolicyMatcher> matcher;
+    };
+    int32_t GetUsbPolicySnapshot(UsbPolicySnapshot &policy);
+    void InvalidateUsbPolicySnapshot();
+    void BeginUsbPolicyChange();
+    void EndUsbPolicyChange();
+    /* devices_ sorted by bus number then device address, the caller holds devicesMutex_ */
+    void GetDevicesInBusDevOrder(std::vector<UsbDevice *> &devices);
+    MAP_BUS_DEV_DEVICE devices_;
+    enum class DeviceChangeType { ADDED, CHANGED, REMOVED };
+    /* bumps the device table generation and records which entry moved, callers may hold devicesMutex_ */
+    void MarkDevicesChanged(uint16_t busDev, DeviceChangeType type);
+    struct DevicesSnapshotCache {
+        sptr<Ashmem> ashmem;
+        uint32_t size = 0;
+        uint64_t sequence = 0;
+    };
+    /* indexed by whether the caller is a system app or SA, the two see different device tables */
+    DevicesSnapshotCache devicesSnapshots_[2];
+    std::mutex devicesSnapshotMutex_;
+    /* generations at which a device entered the table and last changed */
+    struct DeviceGeneration {
+        uint64_t added = 0;
+        uint64_t changed = 0;
+    };
+    /* seeded from the start time in the constructor, see GetDevicesGenerationSeed */
+    std::atomic<uint64_t> devicesGeneration_ {1};
+    std::unordered_map<uint16_t, DeviceGeneration> deviceGenerations_;
+    /* recently removed devices as (generation, busDev), older removals are only covered by a full sync */
+    std::deque<std::pair<uint64_t, uint16_t>> removedDevices_;
+    uint64_t removedDevicesFloor_ = 0;
+    std::mutex generationMutex_;
+    std::unordered_multimap<uint32_t, uint16_t> vidPidIndex_;
+    UsbPolicySnapshot policySnapshot_;
+    uint64_t policyVersion_ = 0;
+    bool policySnapshotValid_ = false;
+    uint32_t policyChangesInFlight_ = 0;
+    std::chrono::steady_clock::time_point policySettleTime_;
+    std::mutex policyMutex_;
+    std::mutex policyFetchMutex_;
+    struct UsbDeviceSession {
+        std::string identity;
+        uint64_t expireTime;
+    };
+    std::unordered_map<uint64_t, UsbDeviceSession> deviceSessions_;
+    /* string descriptors of known devices, keyed by vid/pid/bcdDevice/serial, least recently used evicted */
+    struct UsbDevStringCacheEntry {
+        std::unordered_map<uint8_t, std::string> strings;
+        uint64_t lastUsed;
+    };
+    std::unordered_map<std::string, UsbDevStringCacheEntry> devStringCache_;
+    uint64_t devStringCacheClock_ = 0;
+    std::mutex devStringCacheMutex_;
+    std::shared_mutex sessionMutex_;
+    sptr<Ashmem> PrepareBatchSubTransfer(const HDI::Usb::V1_2::USBTransferInfo &info,
+        const sptr<UsbBatchTransferCollector> &collector, size_t index, int32_t offset, sptr<Ashmem> &ashmem);
+    int32_t SubmitBatchSubTransfer(const HDI::Usb::V1_0::UsbDev &devInfo, HDI::Usb::V1_2::USBTransferInfo &info,
+        const sptr<UsbBatchTransferCollector> &collector, size_t index, sptr<Ashmem> &buffer);
+    sptr<Ashmem> GetBulkTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+        const HDI::Usb::V1_0::UsbPipe &pipe, int32_t offset, int32_t length);
+    size_t GetTokenBulkBufferCount(uint32_t tokenId);
+    void ReleaseBufferOwnerIfUnused(uint32_t tokenId);
+    std::unordered_map<uint64_t, sptr<Ashmem>> bulkTransferBuffers_;
+    /* pooled async transfer buffers of a caller's endpoint, indexed by slot */
+    std::unordered_map<uint64_t, std::vector<sptr<Ashmem>>> submitTransferBuffers_;
+    class UsbBufferOwnerDeathRecipient : public IRemoteObject::DeathRecipient {
+    public:
+        UsbBufferOwnerDeathRecipient(UsbHostManager *service, uint32_t tokenId)
+            : service_(service), tokenId_(tokenId) {};
+        ~UsbBufferOwnerDeathRecipient() {};
+        void OnRemoteDied(const wptr<IRemoteObject> &object) override;
+    private:
+        UsbHostManager *service_;
+        uint32_t tokenId_;
+    };
+    struct UsbBufferOwner {
+        sptr<IRemoteObject> client;
+        sptr<IRemoteObject::DeathRecipient> recipient;
+    };
+    /* client objects watched for the tokens that hold registered buffers */
+    std::unordered_map<uint32_t, UsbBufferOwner> bufferOwners_;
+    std::mutex bulkBufferMutex_;
     SystemAbility *systemAbility_;
     std::mutex mutex_;
     std::shared_mutex devicesMutex_;
@@ -176,12 +319,15 @@ private:
     public:
         UsbSubmitTransferDeathRecipient(const HDI::Usb::V1_0::UsbDev &devInfo, const int32_t endpoint,
             UsbHostManager *service, const sptr<IRemoteObject> cb)
-            : devInfo_(devInfo), endpoint_(endpoint), service_(service), cb_(cb) {};
+            : devInfo_(devInfo), endpoints_({endpoint}), service_(service), cb_(cb) {};
+        UsbSubmitTransferDeathRecipient(const HDI::Usb::V1_0::UsbDev &devInfo,
+            const std::vector<int32_t> &endpoints, UsbHostManager *service, const sptr<IRemoteObject> cb)
+            : devInfo_(devInfo), endpoints_(endpoints), service_(service), cb_(cb) {};
         ~UsbSubmitTransferDeathRecipient() {};
         void OnRemoteDied(const wptr<IRemoteObject> &object) override;
     private:
         const HDI::Usb::V1_0::UsbDev devInfo_;
-        const int32_t endpoint_;
+        const std::vector<int32_t> endpoints_;
         UsbHostManager *service_;
         const sptr<IRemoteObject> cb_;
     };
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_POLICY_MATCHER_H
+#define USB_POLICY_MATCHER_H
+
+#include <cstdint>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+#include "usb_interface_type.h"
+
+namespace OHOS {
+namespace USB {
+/*
+ * Type table of d_typeMap or g_typeMap indexed by (class, subclass, protocol). Table entries with -1
+ * subclass or protocol are stored under a wildcard key, so a lookup probes at most four keys.
+ */
+class UsbTypeTable {
+public:
+    explicit UsbTypeTable(const std::unordered_map<InterfaceType, std::vector<int32_t>> &map);
+
+    void Match(int32_t baseClass, int32_t subClass, int32_t protocol, std::vector<InterfaceType> &types) const;
+    bool MatchFirst(int32_t baseClass, int32_t subClass, int32_t protocol, InterfaceType &type) const;
+
+private:
+    static uint32_t GetKey(int32_t baseClass, int32_t subClass, int32_t protocol);
+
+    std::unordered_map<uint32_t, std::vector<InterfaceType>> table_;
+};
+
+/*
+ * Disable-type and trust-list policy compiled once per policy change. Matching a device or an interface
+ * costs a few hash lookups regardless of the number of policy entries.
+ */
+class UsbPolicyMatcher {
+public:
+    /* every table entry matching the triple, paired with whether the policy disables it */
+    using TypeDecision = std::pair<InterfaceType, bool>;
+
+    UsbPolicyMatcher() = default;
+    ~UsbPolicyMatcher() = default;
+
+    void CompileTypePolicy(const std::vector<UsbDeviceType> &disableType);
+    void CompileTrustList(const std::vector<UsbDeviceId> &trustList);
+    void MatchDeviceType(int32_t baseClass, int32_t subClass, int32_t protocol,
+        std::vector<TypeDecision> &decisions) const;
+    void MatchInterfaceType(int32_t baseClass, int32_t subClass, int32_t protocol,
+        std::vector<TypeDecision> &decisions) const;
+    bool IsTrusted(int32_t vendorId, int32_t productId) const;
+    bool IsTrustListEmpty() const;
+
+    static const UsbTypeTable &GetDeviceTypeTable();
+    static const UsbTypeTable &GetInterfaceTypeTable();
+
+private:
+    static void Decide(const UsbTypeTable &table, const std::unordered_set<InterfaceType> &disabled,
+        int32_t baseClass, int32_t subClass, int32_t protocol, std::vector<TypeDecision> &decisions);
+    static uint32_t GetVidPidKey(int32_t vendorId, int32_t productId);
+
+    std::unordered_set<InterfaceType> disabledDeviceTypes_;
+    std::unordered_set<InterfaceType> disabledInterfaceTypes_;
+    std::unordered_set<uint32_t> trustList_;
+};
+} // namespace USB
+} // namespace OHOS
+
+#endif // USB_POLICY_MATCHER_H
@@ -22,17 +22,17 @@
 #include "usb_device.h"
 #include "usb_host_manager.h"
 #include "usb_endpoint.h"
+#include "usb_transfer_fault_reporter.h"
 
 namespace OHOS {
 namespace USB {
-typedef std::map<std::string, UsbDevice *> MAP_STR_DEVICE;
 class UsbReportSysEvent {
 public:
     static void ReportTransferFaultSysEvent(const std::string transferType, UsbDevice &usbDev,
-        const HDI::Usb::V1_0::UsbPipe &tmpPipe, int32_t ret, const std::string description);
-    static void CheckAttributeReportTransferFaultSysEvent(const std::string transferType,
-        UsbDevice &usbDev, const HDI::Usb::V1_0::UsbPipe &tmpPipe, const USBEndpoint &ep,
-        int32_t ret, const std::string description);
+        const HDI::Usb::V1_0::UsbPipe &tmpPipe, int32_t ret, const std::string description, uint32_t count = 1);
+    /* writes a fault counted over an interval, its device and interface were captured when it was recorded */
+    static void ReportTransferFaultSysEvent(const UsbTransferFault &fault, uint32_t count);
+    static bool IsExpectedTransferFault(const USBEndpoint &ep, int32_t ret);
     static bool GetUsbInterfaceId(UsbDevice &usbDev, const HDI::Usb::V1_0::UsbPipe &tmpPipe,
         int32_t interfaceId, UsbInterface &itIF);
 };
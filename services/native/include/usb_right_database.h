@@ -34,7 +34,9 @@ static std::string USB_RIGHT_DB_PATH = "/data/service/el1/public/usb_service/";
 
 constexpr const char *USB_RIGHT_DB_NAME = "usbRight.db";
 constexpr const char *USB_RIGHT_TABLE_NAME = "usbRightInfoTable";
-constexpr int32_t DATABASE_OPEN_VERSION = 2;
+constexpr int32_t DATABASE_OPEN_VERSION = 3;
+constexpr int32_t DATABASE_VERSION_TOKEN_ID = 2;
+constexpr int32_t DATABASE_VERSION_INDEX = 3;
 
 constexpr const char *CREATE_USB_RIGHT_TABLE = "CREATE TABLE IF NOT EXISTS [usbRightInfoTable]("
                                                "[id] INTEGER PRIMARY KEY AUTOINCREMENT, "
@@ -47,6 +49,11 @@ constexpr const char *CREATE_USB_RIGHT_TABLE = "CREATE TABLE IF NOT EXISTS [usbR
                                                "[bundleName] TEXT,"
                                                "[tokenId] TEXT);";
 constexpr const char *SQL_ADD_TOKEN_ID = "ALTER TABLE usbRightInfoTable ADD COLUMN tokenId TEXT DEFAULT ''";
+/* right lookups filter on the leading columns, deleting the records of an app filters on (uid, bundleName) */
+constexpr const char *CREATE_USB_RIGHT_INDEX = "CREATE INDEX IF NOT EXISTS [usbRightInfoIndex] ON "
+                                               "[usbRightInfoTable]([uid], [deviceName], [bundleName], [tokenId]);";
+constexpr const char *CREATE_USB_RIGHT_APP_INDEX = "CREATE INDEX IF NOT EXISTS [usbRightInfoAppIndex] ON "
+                                                   "[usbRightInfoTable]([uid], [bundleName]);";
 
 class UsbRightDataBase {
 public:
@@ -81,6 +88,9 @@ public:
     int32_t OnCreate(OHOS::NativeRdb::RdbStore &rdbStore) override;
     int32_t OnUpgrade(OHOS::NativeRdb::RdbStore &rdbStore, int32_t oldVersion, int32_t newVersion) override;
     int32_t OnDowngrade(OHOS::NativeRdb::RdbStore &rdbStore, int32_t currentVersion, int32_t targetVersion) override;
+
+private:
+    int32_t CreateIndex(OHOS::NativeRdb::RdbStore &rdbStore);
 };
 
 } // namespace USB
@@ -41,19 +41,18 @@ struct UsbRightAppInfo {
     uint64_t updateTime;   /* app update time */
     uint64_t requestTime;  /* app request permission time */
     uint64_t validPeriod;  /* app permission valid period */
+    std::string bundleName; /* app bundle name */
 };
 
-struct UsbRightTableInfo {
-    int32_t rowCount;
-    int32_t columnCount;
-    int32_t primaryKeyIndex;
-    int32_t uidIndex;
-    int32_t installTimeIndex;
-    int32_t updateTimeIndex;
-    int32_t requestTimeIndex;
-    int32_t validPeriodIndex;
-    int32_t deviceNameIndex;
-    int32_t bundleNameIndex;
+/* records found stale by one sweep, deleted together in a single transaction */
+struct UsbRightSweep {
+    int32_t uid = -1;
+    /* records of uid with a normal valid period requested before this time are deleted, 0 keeps them */
+    uint64_t expiredTime = 0;
+    /* apps of uid whose records are deleted */
+    std::vector<std::string> bundleNames;
+    /* users whose records are deleted */
+    std::vector<int32_t> deletedUids;
 };
 
 class UsbRightDbHelper {
@@ -105,6 +104,8 @@ public:
     int32_t DeleteNormalExpiredRightRecord(int32_t uid, uint64_t expiredTime);
     /* delete (validTime, device) record */
     int32_t DeleteValidPeriodRightRecord(long validPeriod, const std::string &deviceName);
+    /* delete all records of a sweep */
+    int32_t DeleteSweptRightRecord(const struct UsbRightSweep &sweep);
 
 private:
     UsbRightDbHelper();
@@ -115,16 +116,15 @@ private:
     int32_t AddOrUpdateRightRecordEx(bool isUpdate, int32_t uid, const std::string &deviceName,
         const std::string &bundleName, const std::string &tokenId, struct UsbRightAppInfo &info);
     int32_t QueryRightRecordCount(void);
-    int32_t GetResultSetTableInfo(
-        const std::shared_ptr<OHOS::NativeRdb::ResultSet> &resultSet, struct UsbRightTableInfo &table);
     int32_t GetResultRightRecordEx(const std::shared_ptr<OHOS::NativeRdb::ResultSet> &resultSet,
         std::vector<struct UsbRightAppInfo> &infos);
-    int32_t QueryAndGetResult(const OHOS::NativeRdb::RdbPredicates &rdbPredicates,
-        const std::vector<std::string> &columns, std::vector<struct UsbRightAppInfo> &infos);
-    int32_t QueryAndGetResultColumnValues(const OHOS::NativeRdb::RdbPredicates &rdbPredicates,
-        const std::vector<std::string> &columns, const std::string &columnName, std::vector<std::string> &columnValues);
+    int32_t QueryAndGetResult(const std::string &whereClause, const std::vector<std::string> &whereArgs,
+        std::vector<struct UsbRightAppInfo> &infos);
+    int32_t QueryAndGetResultColumnValues(const std::string &sql, const std::vector<std::string> &selectionArgs,
+        std::vector<std::string> &columnValues);
     int32_t DeleteAndNoOtherOperation(const std::string &whereClause, const std::vector<std::string> &whereArgs);
     int32_t DeleteAndNoOtherOperation(const OHOS::NativeRdb::RdbPredicates &rdbPredicates);
+    static std::vector<std::string> GetNormalExpiredWhereArgs(int32_t uid, uint64_t expiredTime);
 
     static std::shared_ptr<UsbRightDbHelper> instance_;
     std::mutex databaseMutex_;
@@ -17,10 +17,14 @@
 #define USB_RIGHT_MANAGER_H
 
 #include <algorithm>
+#include <condition_variable>
+#include <list>
 #include <map>
 #include <mutex>
 #include <semaphore.h>
 #include <string>
+#include <thread>
+#include <unordered_map>
 #include <vector>
 
 #include "ability_connect_callback_stub.h"
@@ -32,13 +36,31 @@
 #include "serial_device_identity.h"
 namespace OHOS {
 namespace USB {
+struct UsbRightAppInfo;
+
+/* identity of an IPC caller, resolved once per full token id and cached until the app changes */
+struct UsbCallerIdentity {
+    bool isSystem = false;
+    int32_t tokenType = 0;
+    uint32_t tokenId = 0;
+    std::string tokenIdStr;
+    /* bundle information below is only valid for a hap caller */
+    bool isHap = false;
+    std::string bundleName;
+    int32_t userId = -1;
+    int32_t apiVersion = 0;
+};
 
 class UsbRightManager {
 public:
+    ~UsbRightManager();
     int32_t Init();
     /* deviceName is in VID-PID format */
     bool HasRight(const std::string &deviceName, const std::string &bundleName,
         const std::string &tokenId, const int32_t &userId);
+    /* expireTime is when the granting right runs out, in wall clock seconds, UINT64_MAX if it never does */
+    bool HasRight(const std::string &deviceName, const std::string &bundleName,
+        const std::string &tokenId, const int32_t &userId, uint64_t &expireTime);
     /* busDev is in busNum-devAddr format */
 #ifdef USB_MANAGER_FEATURE_HOST
     int32_t RequestRight(const std::string &busDev, const std::string &deviceName, const std::string &bundleName,
@@ -58,14 +80,56 @@ public:
     bool RemoveDeviceAllRight(const std::string &deviceName);
     bool IsSystemAppOrSa();
     bool VerifyPermission();
+    static void GetCallerIdentity(UsbCallerIdentity &identity);
+    static void EraseCallerIdentityByToken(uint32_t tokenId);
+    static void EraseCallerIdentityByApp(int32_t userId, const std::string &bundleName);
+    static void ClearCallerIdentityCache();
     int32_t CleanUpRightExpired(std::vector<std::string> &devices);
     static int32_t CleanUpRightUserDeleted(int32_t &totalUsers, int32_t &deleteUsers);
     static int32_t CleanUpRightUserStopped(int32_t uid);
     static int32_t IsOsAccountExists(int32_t id, bool &isAccountExists);
     static int32_t CleanUpRightAppUninstalled(int32_t uid, const std::string &bundleName);
     int32_t HasSetFuncRight(int32_t functions);
+    /* stale records are deleted by the right sweeper, periodically or when requested */
+    void RequestTidyUpRight(uint32_t choose);
+    /* apps of the records that are no longer installed, or were installed again after the right was granted */
+    static void FindStaleRightApps(const std::vector<struct UsbRightAppInfo> &infos,
+        const std::unordered_map<std::string, uint64_t> &installTimes, bool uninstalled, bool reinstalled,
+        std::vector<std::string> &bundleNames);
 
 private:
+    /* cached positive HasRight decision, valid in [requestTime, expireTime) */
+    struct UsbRightCacheEntry {
+        int32_t userId;
+        std::string deviceName;
+        std::string bundleName;
+        std::string tokenId;
+        uint64_t requestTime;
+        uint64_t expireTime;
+    };
+    static std::string GetRightCacheKey(const std::string &deviceName, const std::string &bundleName,
+        const std::string &tokenId, int32_t userId);
+    static bool QueryRightCache(const std::string &key, uint64_t nowTime, uint64_t &expireTime);
+    /* bumped by every invalidation, an entry read from the database under an older one is not cached */
+    static uint64_t GetRightCacheGeneration();
+    static void UpdateRightCache(const std::string &key, const UsbRightCacheEntry &entry, uint64_t generation);
+    static void EraseRightCache(const std::string &key);
+    static void EraseRightCacheByApp(int32_t userId, const std::string &bundleName);
+    static void EraseRightCacheByUser(int32_t userId);
+    static void ClearRightCache();
+    static std::unordered_map<std::string, UsbRightCacheEntry> rightCache_;
+    static uint64_t rightCacheGeneration_;
+    static std::mutex rightCacheMutex_;
+
+    /* least recently used caller identities, the most recent one in front */
+    using CallerIdentityList = std::list<std::pair<uint64_t, UsbCallerIdentity>>;
+    static bool QueryCallerIdentity(uint64_t fullTokenId, UsbCallerIdentity &identity);
+    static void ResolveCallerIdentity(uint64_t fullTokenId, UsbCallerIdentity &identity);
+    static void UpdateCallerIdentity(uint64_t fullTokenId, const UsbCallerIdentity &identity);
+    static CallerIdentityList callerIdentityList_;
+    static std::unordered_map<uint64_t, CallerIdentityList::iterator> callerIdentityIndex_;
+    static std::mutex callerIdentityMutex_;
+
 #ifdef USB_MANAGER_FEATURE_HOST
     bool GetUserAgreementByDiag(const std::string &busDev, const std::string &deviceName, const std::string &bundleName,
         const std::string &tokenId, const int32_t &userId);
@@ -110,21 +174,31 @@ private:
     sptr<UsbAbilityConn> usbAbilityConn_ = nullptr;
     static std::map<std::string, std::string> usbDialogParams_;
     static std::mutex usbDialogParamsMutex_;
-    bool IsAppInstalled(int32_t uid, const std::string &bundleName);
-    void GetCurrentUserId(int32_t &uid);
+    bool GetInstalledBundles(int32_t uid, std::unordered_map<std::string, uint64_t> &installTimes);
+    void GetActiveUserIds(std::vector<int32_t> &userIds);
     bool GetBundleInstallAndUpdateTime(
         int32_t uid, const std::string &bundleName, uint64_t &installTime, uint64_t &updateTime);
     uint64_t GetCurrentTimestamp();
-    void StringVectorSortAndUniq(std::vector<std::string> &strings);
+    static void StringVectorSortAndUniq(std::vector<std::string> &strings);
     static bool StringVectorFound(const std::vector<std::string> &strings, const std::string &value, int32_t &index);
 
-    int32_t CleanUpRightAppUninstalled(int32_t uid, int32_t &totalApps, int32_t &deleteApps);
+    int32_t CollectRightAppStale(int32_t uid, bool uninstalled, bool reinstalled,
+        std::vector<std::string> &bundleNames);
+    static int32_t CollectRightUserDeleted(std::vector<int32_t> &uids, int32_t &totalUsers);
     int32_t CleanUpRightTemporaryExpired(const std::string &deviceName);
     int32_t CleanUpRightNormalExpired(int32_t uid);
-    int32_t CleanUpRightAppReinstalled(int32_t uid, uint32_t &totalApps, uint32_t &deleteApps);
-    int32_t TidyUpRight(uint32_t choose);
+    int32_t TidyUpRight(uint32_t choose, int32_t userId);
+    void TidyUpRightForActiveUsers(uint32_t choose);
+    void StartRightSweeper();
+    void RightSweepLoop();
     bool UnShowUsbDialog();
     int32_t ConnectAbility(const int32_t userId);
+
+    std::thread rightSweeper_;
+    std::mutex rightSweepMutex_;
+    std::condition_variable rightSweepCond_;
+    uint32_t pendingTidyUp_ = 0;
+    bool rightSweepStop_ = false;
 };
 
 } // namespace USB
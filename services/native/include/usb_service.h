@@ -34,6 +34,9 @@
 #include "usb_device_manager.h"
 #include "usb_accessory_manager.h"
 #include "usb_host_manager.h"
+#include "usb_device_event_dispatcher.h"
+#include "usb_device_io_executor.h"
+#include "usb_transfer_fault_reporter.h"
 #include "usb_port_manager.h"
 #include "usb_right_manager.h"
 #include "usb_server_stub.h"
@@ -60,6 +63,7 @@ const std::string USB_PORT = "usb_port";
 const std::string USB_HELP = "-h";
 const std::string USB_LIST = "-l";
 const std::string USB_GETT = "-g";
+const std::string USB_STREAM = "-s";
 const int32_t ERRCODE_NEGATIVE_ONE = -1;
 const int32_t ERRCODE_NEGATIVE_TWO = -2;
 const int32_t ERRCODE_NEGATIVE_FOUR = -4;
@@ -112,6 +116,10 @@ public:
     bool AddDevice(uint8_t busNum, uint8_t devAddr);
     bool DelDevice(uint8_t busNum, uint8_t devAddr);
     int32_t GetDevices(std::vector<UsbDevice> &deviceList) override;
+    int32_t GetDevicesSnapshot(int32_t &fd, uint32_t &size, uint64_t &sequence) override;
+    int32_t GetDeviceGeneration(uint64_t &generation) override;
+    int32_t GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync, std::vector<UsbDevice> &added,
+        std::vector<UsbDevice> &changed, std::vector<std::string> &removed) override;
     int32_t GetDeviceInfo(uint8_t busNum, uint8_t devAddr, UsbDevice &dev);
     int32_t GetDeviceInfoDescriptor(
         const HDI::Usb::V1_0::UsbDev &uDev, std::vector<uint8_t> &descriptor, UsbDevice &dev);
@@ -133,14 +141,26 @@ public:
         std::vector<uint8_t> &bufferData) override;
     int32_t UsbControlTransfer(uint8_t busNum, uint8_t devAddr,
         const UsbCtlSetUp& ctrlParams, std::vector<uint8_t> &bufferData) override;
+    int32_t BulkTransferReadAsync(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t length,
+        int32_t timeOut, const sptr<IRemoteObject> &cb, uint64_t userData) override;
+    int32_t BulkTransferWriteAsync(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
+        const UsbBulkTransData &bufferData, int32_t timeOut, const sptr<IRemoteObject> &cb,
+        uint64_t userData) override;
+    int32_t ControlTransferAsync(uint8_t busNum, uint8_t devAddr, const UsbCtlSetUp &ctrlParams,
+        const std::vector<uint8_t> &bufferData, bool withLength, const sptr<IRemoteObject> &cb,
+        uint64_t userData) override;
     int32_t RequestQueue(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
         const std::vector<uint8_t> &clientData, const std::vector<uint8_t> &bufferData) override;
     int32_t RequestWait(uint8_t busNum, uint8_t devAddr, int32_t timeOut, std::vector<uint8_t> &clientData,
         std::vector<uint8_t> &bufferData) override;
+    int32_t RequestWaitAsync(uint8_t busNum, uint8_t devAddr, int32_t timeOut, const sptr<IRemoteObject> &cb,
+        uint64_t userData) override;
     int32_t RequestCancel(uint8_t busNum, uint8_t devAddr, uint8_t interfaceid, uint8_t endpointId) override;
     int32_t UsbCancelTransfer(uint8_t busNum, uint8_t devAddr, int32_t endpoint) override;
     int32_t UsbSubmitTransfer(uint8_t busNum, uint8_t devAddr, const UsbTransInfo &param,
         const sptr<IRemoteObject> &cb, int32_t fd, int32_t memSize) override;
+    int32_t UsbSubmitTransferBatch(uint8_t busNum, uint8_t devAddr, const std::vector<UsbTransInfo> &infos,
+        const sptr<IRemoteObject> &cb, int32_t fd, int32_t memSize) override;
     int32_t RegBulkCallback(uint8_t busNum, uint8_t devAddr, const USBEndpoint& ep,
             const sptr<IRemoteObject> &cb) override;
     int32_t UnRegBulkCallback(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep) override;
@@ -149,9 +169,26 @@ public:
     int32_t BulkWrite(
         uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t fd, int32_t memSize) override;
     int32_t BulkCancel(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep) override;
+    int32_t RegBulkTransferBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t fd,
+        int32_t memSize, const sptr<IRemoteObject> &client) override;
+    int32_t UnRegBulkTransferBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep) override;
+    int32_t BulkTransferReadWithBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t offset,
+        int32_t length, int32_t &actualLength, int32_t timeOut) override;
+    int32_t BulkTransferWriteWithBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t offset,
+        int32_t length, int32_t timeOut) override;
+    int32_t RegSubmitTransferBuffer(
+        uint8_t busNum, uint8_t devAddr, int32_t endpoint, int32_t slot, int32_t fd, int32_t memSize) override;
+    int32_t UnRegSubmitTransferBuffers(uint8_t busNum, uint8_t devAddr, int32_t endpoint) override;
+    int32_t UsbSubmitTransferWithBuffer(uint8_t busNum, uint8_t devAddr, const UsbTransInfo &param,
+        const sptr<IRemoteObject> &cb, int32_t slot) override;
 
     bool CheckDevicePermission(uint8_t busNum, uint8_t devAddr);
+    bool CheckDevicePermission(uint8_t busNum, uint8_t devAddr, uint64_t &expireTime);
+    void ClearDeviceSessions();
+    /* sessions opened under the right of tokenId on the device identity, of every token for the default token */
+    void RemoveDeviceSessions(const std::string &tokenId, const std::string &identity);
     bool HasRight(const std::string &deviceName);
+    bool HasRight(const std::string &deviceName, uint64_t &expireTime);
     int32_t HasRight(const std::string &deviceName, bool &hasRight) override;
     int32_t RequestRight(const std::string &deviceName) override;
     int32_t RemoveRight(const std::string &deviceName) override;
@@ -190,6 +227,10 @@ public:
         uint32_t &actualSize, uint32_t timeout) override;
     int32_t SerialWrite(int32_t portId, const std::vector<uint8_t>& data, uint32_t size,
         uint32_t &actualSize, uint32_t timeout) override;
+    int32_t SerialSubscribe(int32_t portId, const sptr<IRemoteObject> &serialRemote) override;
+    int32_t SerialUnsubscribe(int32_t portId) override;
+    int32_t SerialOpenRing(int32_t portId, const sptr<IRemoteObject> &serialRemote, int32_t &ringFd,
+        int32_t &rxDataFd, int32_t &rxSpaceFd, int32_t &txDataFd, int32_t &txSpaceFd) override;
     int32_t SerialGetAttribute(int32_t portId, UsbSerialAttr& attribute) override;
     int32_t SerialSetAttribute(int32_t portId, const UsbSerialAttr& attribute) override;
     int32_t SerialGetPortList(std::vector<UsbSerialPort>& serialPortList) override;
@@ -280,6 +321,10 @@ private:
     void UsbDeviceTypeChange(std::vector<UsbDeviceType> &disableType,
         const std::vector<UsbDeviceTypeInfo> &deviceTypes);
     void UsbTransInfoChange(HDI::Usb::V1_2::USBTransferInfo &info, const UsbTransInfo &param);
+    /* runs the transfer on an io lane of the device and replies its result to cb, the caller checks the right */
+    int32_t PostTransfer(uint8_t busNum, uint8_t devAddr, uint8_t lane, const sptr<IRemoteObject> &cb,
+        uint64_t userData, std::function<int32_t(std::vector<uint8_t> &, std::vector<uint8_t> &)> transfer);
+    bool ResolveTransferFault(UsbTransferFault &fault);
     std::string GetDeviceVidPidSerialNumber(const std::string &deviceName);
     int32_t GetDeviceVidPidSerialNumber(const std::string &deviceName, std::string& strDesc);
 #endif // USB_MANAGER_FEATURE_HOST
@@ -294,6 +339,9 @@ private:
     std::mutex unloadSelfTimerMutex_;
 #ifdef USB_MANAGER_FEATURE_HOST
     std::shared_ptr<UsbHostManager> usbHostManager_;
+    std::shared_ptr<UsbDeviceEventDispatcher> deviceEventDispatcher_;
+    std::shared_ptr<UsbTransferFaultReporter> transferFaultReporter_;
+    std::shared_ptr<UsbDeviceIoExecutor> transferExecutor_;
 #endif // USB_MANAGER_FEATURE_HOST
 #ifdef USB_MANAGER_FEATURE_DEVICE
     std::shared_ptr<UsbDeviceManager> usbDeviceManager_;
@@ -309,7 +357,7 @@ private:
 #endif // USB_MANAGER_PASS_THROUGH
     std::shared_ptr<SERIAL::SerialManager> usbSerialManager_;
     sptr<HDI::Usb::V1_2::IUsbInterface> usbd_ = nullptr;
-    std::map<std::string, std::string> deviceVidPidMap_;
+    std::unordered_map<std::string, std::string> deviceVidPidMap_;
     std::map<int32_t, std::pair<std::string, std::string>> serialVidPidMap_;
     sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> seriald_ = nullptr;
     Utils::Timer unloadSelfTimer_ {"unLoadTimer"};
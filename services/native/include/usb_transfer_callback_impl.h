@@ -20,12 +20,16 @@
 #include "iremote_object.h"
 #include "v2_0/iusbd_transfer_callback.h"
 #include "v2_0/usb_types.h"
+#include "usb_transfer_stats.h"
 
 namespace OHOS {
 namespace USB {
 class UsbTransferCallbackImpl : public HDI::Usb::V2_0::IUsbdTransferCallback {
 public:
     explicit UsbTransferCallbackImpl(const OHOS::sptr<OHOS::IRemoteObject> &cb) : remote_(cb) {}
+    /* the probe starts at submission, the completion records the submit to callback latency */
+    UsbTransferCallbackImpl(const OHOS::sptr<OHOS::IRemoteObject> &cb, const UsbTransferProbe &probe)
+        : remote_(cb), probe_(probe) {}
     UsbTransferCallbackImpl() = default;
 
     int32_t OnTransferWriteCallback(int32_t status, int32_t actLength,
@@ -33,7 +37,10 @@ public:
     int32_t OnTransferReadCallback(int32_t status, int32_t actLength,
         const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData) override;
 private:
+    void RecordCompletion(int32_t status, int32_t actLength);
+
     sptr<IRemoteObject> remote_ = nullptr;
+    UsbTransferProbe probe_;
 };
 } // namespace USB
 } // namespace OHOS
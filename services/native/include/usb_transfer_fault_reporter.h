@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_TRANSFER_FAULT_REPORTER_H
+#define USB_TRANSFER_FAULT_REPORTER_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include "usb_endpoint.h"
+#include "v1_0/usb_types.h"
+
+namespace OHOS {
+namespace USB {
+/* one kind of transfer fault, the description is a literal of the caller and is never copied */
+struct UsbTransferFault {
+    /* empty for a submitted transfer until the resolver names it from submitType and the endpoint */
+    std::string transferType;
+    const char *description = nullptr;
+    int32_t ret = 0;
+    int32_t submitType = 0;
+    uint8_t busNum = 0;
+    uint8_t devAddr = 0;
+    HDI::Usb::V1_0::UsbPipe pipe = {0, 0};
+    /* captured when the fault is recorded, by the end of the interval the address may name another device */
+    int32_t vendorId = 0;
+    int32_t productId = 0;
+    int32_t interfaceClass = 0;
+    int32_t interfaceSubClass = 0;
+    int32_t interfaceProtocol = 0;
+
+    bool operator==(const UsbTransferFault &other) const;
+};
+
+struct UsbTransferFaultHash {
+    size_t operator()(const UsbTransferFault &fault) const;
+};
+
+/*
+ * Counts transfer faults per device, endpoint, error and call site and writes one TRANSFER_FAULT sys event per
+ * kind and interval from a background thread. The device and interface are looked up the first time a fault is
+ * recorded and remembered until the device is detached, the event write happens once per kind when the interval is
+ * flushed.
+ */
+class UsbTransferFaultReporter {
+public:
+    /* fills the device and interface fields of a fault, for a submitted transfer the interface id and type too */
+    using Resolver = std::function<bool(UsbTransferFault &fault)>;
+
+    UsbTransferFaultReporter(Resolver resolver, uint32_t intervalMs);
+    ~UsbTransferFaultReporter();
+
+    void Report(const char *transferType, uint8_t busNum, uint8_t devAddr, const HDI::Usb::V1_0::UsbPipe &pipe,
+        int32_t ret, const char *description);
+    /* skips the faults the endpoint is expected to produce, a timeout of an interrupt endpoint */
+    void ReportEndpoint(const char *transferType, uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
+        int32_t ret, const char *description);
+    void ReportSubmit(int32_t submitType, uint8_t busNum, uint8_t devAddr, int32_t endpoint, int32_t ret,
+        const char *description);
+    /* drops the identities remembered for a detached device, its address may be given to another device */
+    void ForgetDevice(uint8_t busNum, uint8_t devAddr);
+
+private:
+    void Record(UsbTransferFault &fault);
+    bool FindResolved(const UsbTransferFault &fault, UsbTransferFault &resolved);
+    void AddPending(UsbTransferFault &&fault);
+    void FlushLoop();
+    void Flush(const std::unordered_map<UsbTransferFault, uint32_t, UsbTransferFaultHash> &faults, uint64_t dropped);
+
+    Resolver resolver_;
+    uint32_t intervalMs_;
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::thread flusher_;
+    std::unordered_map<UsbTransferFault, uint32_t, UsbTransferFaultHash> pendingFaults_;
+    /* fault as reported to fault with the device and interface filled in, spares the resolver on a repeat */
+    std::unordered_map<UsbTransferFault, UsbTransferFault, UsbTransferFaultHash> resolvedFaults_;
+    uint64_t droppedFaults_ = 0;
+    uint64_t forgetGeneration_ = 0;
+    bool stop_ = false;
+};
+} // namespace USB
+} // namespace OHOS
+#endif // USB_TRANSFER_FAULT_REPORTER_H
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_TRANSFER_STATS_H
+#define USB_TRANSFER_STATS_H
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace OHOS {
+namespace USB {
+enum class UsbTransferKind : uint8_t {
+    CONTROL = 0,
+    ISOCHRONOUS,
+    BULK,
+    INTERRUPT,
+    KIND_COUNT
+};
+
+enum class UsbLatencyStage : uint8_t {
+    PERMISSION = 0,
+    HDI,
+    SUBMIT_TO_CALLBACK,
+    STAGE_COUNT
+};
+
+/* identifies the endpoint a transfer runs on and when the stage being timed started */
+struct UsbTransferProbe {
+    uint8_t busNum = 0;
+    uint8_t devAddr = 0;
+    uint8_t endpoint = 0;
+    UsbTransferKind kind = UsbTransferKind::BULK;
+    uint64_t startNs = 0;
+};
+
+/*
+ * Per endpoint counters and log-linear latency histograms of the transfer path. Every thread records into a
+ * shard of its own with plain relaxed stores, the shards are only merged when the statistics are dumped.
+ */
+class UsbTransferStats {
+public:
+    /* log-linear buckets in microseconds, 4 per power of two, the last one also takes everything longer */
+    static constexpr uint32_t SUB_BUCKET_BITS = 2;
+    static constexpr uint32_t SUB_BUCKET_COUNT = 1 << SUB_BUCKET_BITS;
+    static constexpr uint32_t MAX_BUCKET_EXPONENT = 31;
+    static constexpr uint32_t BUCKET_COUNT = MAX_BUCKET_EXPONENT * SUB_BUCKET_COUNT;
+
+    static UsbTransferProbe Begin(uint8_t busNum, uint8_t devAddr, uint8_t endpoint, UsbTransferKind kind);
+    /* records the time since the probe started and restarts it, so consecutive stages can be chained */
+    static void End(UsbTransferProbe &probe, UsbLatencyStage stage, int32_t ret, uint64_t bytes = 0);
+    /* maps the type of a submitted transfer, which follows the endpoint attributes encoding */
+    static UsbTransferKind KindOfType(int32_t type);
+    static void Dump(int32_t fd);
+    /* drops the entries of a detached device, so the slots can be reused by the devices plugged in later */
+    static void ForgetDevice(uint8_t busNum, uint8_t devAddr);
+
+    static uint64_t NowNs();
+    static uint32_t BucketOf(uint64_t us);
+    static uint64_t BucketLowerBound(uint32_t bucket);
+
+private:
+    struct Slot {
+        std::atomic<uint64_t> key {0};
+        std::atomic<uint64_t> count {0};
+        std::atomic<uint64_t> errors {0};
+        std::atomic<uint64_t> bytes {0};
+        std::atomic<uint64_t> sumUs {0};
+        std::atomic<uint64_t> maxUs {0};
+        std::array<std::atomic<uint32_t>, BUCKET_COUNT> buckets {};
+    };
+    static constexpr uint32_t SHARD_SLOT_COUNT = 64;
+    struct Shard {
+        std::array<Slot, SHARD_SLOT_COUNT> slots;
+        std::atomic<uint64_t> dropped {0};
+    };
+    class ShardLease;
+
+    static UsbTransferStats &GetInstance();
+    Shard *AcquireShard();
+    void ReleaseShard(Shard *shard);
+    void Record(const UsbTransferProbe &probe, UsbLatencyStage stage, uint64_t us, bool failed, uint64_t bytes);
+    static Slot *FindSlot(Shard &shard, uint64_t key);
+    static void ClaimSlot(Slot &slot, uint64_t key);
+
+    std::mutex shardsMutex_;
+    std::vector<std::unique_ptr<Shard>> shards_;
+    std::vector<Shard *> freeShards_;
+};
+} // namespace USB
+} // namespace OHOS
+#endif // USB_TRANSFER_STATS_H
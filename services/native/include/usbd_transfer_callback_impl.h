@@ -20,12 +20,16 @@
 #include "iremote_object.h"
 #include "v1_2/iusbd_transfer_callback.h"
 #include "v1_2/usb_types.h"
+#include "usb_transfer_stats.h"
 
 namespace OHOS {
 namespace USB {
 class UsbdTransferCallbackImpl : public HDI::Usb::V1_2::IUsbdTransferCallback {
 public:
     explicit UsbdTransferCallbackImpl(const OHOS::sptr<OHOS::IRemoteObject> &cb) : remote_(cb) {}
+    /* the probe starts at submission, the completion records the submit to callback latency */
+    UsbdTransferCallbackImpl(const OHOS::sptr<OHOS::IRemoteObject> &cb, const UsbTransferProbe &probe)
+        : remote_(cb), probe_(probe) {}
     UsbdTransferCallbackImpl() = default;
 
     int32_t OnTransferWriteCallback(int32_t status, int32_t actLength,
@@ -34,7 +38,10 @@ public:
         const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData) override;
 
 private:
+    void RecordCompletion(int32_t status, int32_t actLength);
+
     sptr<IRemoteObject> remote_ = nullptr;
+    UsbTransferProbe probe_;
 };
 } // namespace USB
 } // namespace OHOS
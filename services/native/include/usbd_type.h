@@ -82,4 +82,19 @@ struct UsbdEndpointDescriptor {
     uint8_t bInterval;
 } __attribute__((packed));
 
+struct UsbdSsEndpointCompanionDescriptor {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint8_t bMaxBurst;
+    uint8_t bmAttributes;
+    uint16_t wBytesPerInterval;
+} __attribute__((packed));
+
+struct UsbdSspIsocEndpointCompanionDescriptor {
+    uint8_t bLength;
+    uint8_t bDescriptorType;
+    uint16_t wReserved;
+    uint32_t dwBytesPerInterval;
+} __attribute__((packed));
+
 #endif // USBD_TYPE_H
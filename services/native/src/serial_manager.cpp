@@ -23,6 +23,7 @@
 #include "hilog_wrapper.h"
 #include "tokenid_kit.h"
 #include "accesstoken_kit.h"
+#include "parameters.h"
 
 #define DUMP_PARAMS_NUM_2 2
 
@@ -38,6 +39,11 @@ constexpr int32_t ERR_CODE_IOEXCEPTION = -1;
 constexpr int32_t ERR_CODE_DEVICENOTOPEN = -6;
 constexpr int32_t ERR_CODE_TIMEOUT = -7;
 constexpr int32_t ERR_CODE_ERROR_OVERFLOW = -8;
+constexpr const char *WRITE_COALESCE_WINDOW_PARAM = "persist.usb.serial.write_coalesce_window_us";
+constexpr const char *WRITE_COALESCE_MAX_BYTES_PARAM = "persist.usb.serial.write_coalesce_max_bytes";
+constexpr uint32_t WRITE_COALESCE_WINDOW_MAX_US = 100000;
+constexpr uint32_t WRITE_COALESCE_MAX_BYTES_DEFAULT = 4096;
+constexpr uint32_t WRITE_COALESCE_MAX_BYTES_LIMIT = 65536;
 
 SerialManager::SerialManager()
 {
@@ -49,6 +55,10 @@ SerialManager::SerialManager()
     }
 
     usbRightManager_ = std::make_shared<USB::UsbRightManager>();
+    writeCoalesceWindowUs_ = OHOS::system::GetUintParameter<uint32_t>(WRITE_COALESCE_WINDOW_PARAM, 0,
+        WRITE_COALESCE_WINDOW_MAX_US);
+    writeCoalesceMaxBytes_ = OHOS::system::GetUintParameter<uint32_t>(WRITE_COALESCE_MAX_BYTES_PARAM,
+        WRITE_COALESCE_MAX_BYTES_DEFAULT, WRITE_COALESCE_MAX_BYTES_LIMIT);
 }
 
 SerialManager::~SerialManager()
@@ -120,6 +130,9 @@ int32_t SerialManager::SerialClose(int32_t portId)
         return ret;
     }
 
+    StopStream(portId);
+    StopRing(portId);
+    RemoveWriteQueue(portId);
     uint64_t timeMs = USB::UsbSecurityReport::GetCurrentTime();
     ret = serial_->SerialClose(portId);
     if (ret != UEC_OK) {
@@ -145,7 +158,19 @@ int32_t SerialManager::SerialRead(int32_t portId, std::vector<uint8_t> &data, ui
         return ret;
     }
 
+    if (HasRing(portId)) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: port %{public}d is served by its ring", __func__, portId);
+        return USB::UEC_SERIAL_PORT_OCCUPIED;
+    }
     uint64_t timeMs = USB::UsbSecurityReport::GetCurrentTime();
+    auto stream = GetStream(portId);
+    if (stream != nullptr) {
+        ret = stream->Read(data, size, actualSize, timeout);
+        if (ret == UEC_OK && QueryAndRecordFirstRead(portId)) {
+            ReportSerialOperationSecurityInfo(portId, SERIAL_READ, timeMs);
+        }
+        return ret;
+    }
     ret = serial_->SerialRead(portId, data, size, timeout);
     if (ret < UEC_OK) {
         USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: SerialRead failed ret = %{public}d", __func__, ret);
@@ -168,8 +193,12 @@ int32_t SerialManager::SerialWrite(int32_t portId, const std::vector<uint8_t>& d
         return ret;
     }
 
+    if (HasRing(portId)) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: port %{public}d is served by its ring", __func__, portId);
+        return USB::UEC_SERIAL_PORT_OCCUPIED;
+    }
     uint64_t timeMs = USB::UsbSecurityReport::GetCurrentTime();
-    ret = serial_->SerialWrite(portId, data, size, timeout);
+    ret = GetWriteQueue(portId)->Write(data, size, timeout);
     if (ret < UEC_OK) {
         USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: SerialWrite failed ret = %{public}d", __func__, ret);
         return ErrorCodeWrap(ret);
@@ -181,6 +210,131 @@ int32_t SerialManager::SerialWrite(int32_t portId, const std::vector<uint8_t>& d
     return UEC_OK;
 }
 
+int32_t SerialManager::SerialSubscribe(int32_t portId, const sptr<IRemoteObject> &serialRemote)
+{
+    USB_HILOGI(MODULE_USB_SERIAL, "%{public}s: start", __func__);
+    int32_t ret = CheckPortAndTokenId(portId);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: CheckPortAndTokenId failed", __func__);
+        return ret;
+    }
+
+    if (HasRing(portId)) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: port %{public}d is served by its ring", __func__, portId);
+        return USB::UEC_SERIAL_PORT_OCCUPIED;
+    }
+    std::lock_guard<std::mutex> guard(streamsMutex_);
+    if (streams_.find(portId) != streams_.end()) {
+        return UEC_OK;
+    }
+    auto stream = std::make_shared<SerialPortStream>(serial_, portId, serialRemote);
+    stream->Start();
+    streams_[portId] = stream;
+    return UEC_OK;
+}
+
+int32_t SerialManager::SerialUnsubscribe(int32_t portId)
+{
+    USB_HILOGI(MODULE_USB_SERIAL, "%{public}s: start", __func__);
+    int32_t ret = CheckPortAndTokenId(portId);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: CheckPortAndTokenId failed", __func__);
+        return ret;
+    }
+
+    StopStream(portId);
+    return UEC_OK;
+}
+
+std::shared_ptr<SerialPortStream> SerialManager::GetStream(int32_t portId)
+{
+    std::lock_guard<std::mutex> guard(streamsMutex_);
+    auto it = streams_.find(portId);
+    return it == streams_.end() ? nullptr : it->second;
+}
+
+void SerialManager::StopStream(int32_t portId)
+{
+    std::shared_ptr<SerialPortStream> stream;
+    {
+        std::lock_guard<std::mutex> guard(streamsMutex_);
+        auto it = streams_.find(portId);
+        if (it == streams_.end()) {
+            return;
+        }
+        stream = it->second;
+        streams_.erase(it);
+    }
+    stream->Stop();
+}
+
+int32_t SerialManager::SerialAttachRing(int32_t portId, SerialRingFds &fds)
+{
+    USB_HILOGI(MODULE_USB_SERIAL, "%{public}s: start", __func__);
+    int32_t ret = CheckPortAndTokenId(portId);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: CheckPortAndTokenId failed", __func__);
+        return ret;
+    }
+    if (GetStream(portId) != nullptr) {
+        USB_HILOGE(MODULE_USB_SERIAL, "%{public}s: port %{public}d is subscribed", __func__, portId);
+        return USB::UEC_SERIAL_PORT_OCCUPIED;
+    }
+
+    std::lock_guard<std::mutex> guard(ringsMutex_);
+    auto it = rings_.find(portId);
+    if (it != rings_.end()) {
+        fds = it->second->GetFds();
+        return UEC_OK;
+    }
+    auto ring = std::make_shared<SerialRingTransport>(serial_, portId);
+    ret = ring->Init();
+    if (ret != UEC_OK) {
+        return ret;
+    }
+    ring->Start();
+    fds = ring->GetFds();
+    rings_[portId] = ring;
+    return UEC_OK;
+}
+
+bool SerialManager::HasRing(int32_t portId)
+{
+    std::lock_guard<std::mutex> guard(ringsMutex_);
+    return rings_.find(portId) != rings_.end();
+}
+
+std::shared_ptr<SerialWriteQueue> SerialManager::GetWriteQueue(int32_t portId)
+{
+    std::lock_guard<std::mutex> guard(writeQueuesMutex_);
+    auto &queue = writeQueues_[portId];
+    if (queue == nullptr) {
+        queue = std::make_shared<SerialWriteQueue>(serial_, portId, writeCoalesceWindowUs_, writeCoalesceMaxBytes_);
+    }
+    return queue;
+}
+
+void SerialManager::RemoveWriteQueue(int32_t portId)
+{
+    std::lock_guard<std::mutex> guard(writeQueuesMutex_);
+    writeQueues_.erase(portId);
+}
+
+void SerialManager::StopRing(int32_t portId)
+{
+    std::shared_ptr<SerialRingTransport> ring;
+    {
+        std::lock_guard<std::mutex> guard(ringsMutex_);
+        auto it = rings_.find(portId);
+        if (it == rings_.end()) {
+            return;
+        }
+        ring = it->second;
+        rings_.erase(it);
+    }
+    ring->Stop();
+}
+
 int32_t SerialManager::SerialGetAttribute(int32_t portId, OHOS::HDI::Usb::Serial::V1_0::SerialAttribute& attribute)
 {
     USB_HILOGI(MODULE_USB_SERIAL, "%{public}s: start", __func__);
@@ -281,6 +435,9 @@ void SerialManager::FreeTokenId(int32_t portId, uint32_t tokenId)
         return;
     }
 
+    StopStream(portId);
+    StopRing(portId);
+    RemoveWriteQueue(portId);
     if (serial_ != nullptr) {
         serial_->SerialClose(portId);
     }
@@ -376,6 +533,42 @@ void SerialManager::SerialGetAttributeDump(int32_t fd, const std::vector<std::st
     }
 }
 
+void SerialManager::SerialStreamDump(int32_t fd)
+{
+    std::vector<std::shared_ptr<SerialPortStream>> streams;
+    {
+        std::lock_guard<std::mutex> guard(streamsMutex_);
+        for (auto &it : streams_) {
+            streams.emplace_back(it.second);
+        }
+    }
+    std::vector<std::shared_ptr<SerialWriteQueue>> writeQueues;
+    {
+        std::lock_guard<std::mutex> guard(writeQueuesMutex_);
+        for (auto &it : writeQueues_) {
+            writeQueues.emplace_back(it.second);
+        }
+    }
+    std::vector<std::shared_ptr<SerialRingTransport>> rings;
+    {
+        std::lock_guard<std::mutex> guard(ringsMutex_);
+        for (auto &it : rings_) {
+            rings.emplace_back(it.second);
+        }
+    }
+    dprintf(fd, "=========== dump the serial receive streams ===========\n");
+    for (auto &stream : streams) {
+        stream->Dump(fd);
+    }
+    for (auto &ring : rings) {
+        ring->Dump(fd);
+    }
+    for (auto &queue : writeQueues) {
+        queue->Dump(fd);
+    }
+    dprintf(fd, "------------------------------------------------\n");
+}
+
 void SerialManager::ListGetDumpHelp(int32_t fd)
 {
     dprintf(fd, "=========== dump the serial port information ===========\n");
@@ -383,6 +576,7 @@ void SerialManager::ListGetDumpHelp(int32_t fd)
     dprintf(fd, "serial -h: Serial port help\n");
     dprintf(fd, "serial -g : Gets the properties of all ports\n");
     dprintf(fd, "serial \"-g [port number]\": Gets the properties of the specified port\n");
+    dprintf(fd, "serial -s : Gets the stream, shared ring and write queue counters of open ports\n");
     dprintf(fd, "------------------------------------------------\n");
 }
 
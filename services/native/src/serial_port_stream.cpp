@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_port_stream.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <pthread.h>
+#include <string>
+#include "hilog_wrapper.h"
+#include "message_option.h"
+#include "message_parcel.h"
+#include "securec.h"
+#include "usb_common.h"
+#include "usb_errors.h"
+
+using OHOS::USB::USB_MGR_LABEL;
+using OHOS::USB::MODULE_USB_SERIAL;
+using OHOS::USB::UEC_OK;
+
+namespace OHOS {
+namespace SERIAL {
+constexpr size_t STREAM_RING_SIZE = 256 * 1024;
+constexpr uint32_t STREAM_READ_CHUNK = 4096;
+constexpr uint32_t STREAM_READ_TIMEOUT_MS = 50;
+constexpr int32_t ERR_CODE_DEVICENOTOPEN = -6;
+constexpr int32_t ERR_CODE_TIMEOUT = -7;
+constexpr int32_t ERR_CODE_ERROR_OVERFLOW = -8;
+constexpr const char *STREAM_THREAD_PREFIX = "serial_rx_";
+
+SerialPortStream::SerialPortStream(const sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> &serial,
+    int32_t portId, const sptr<IRemoteObject> &notifier)
+    : serial_(serial), portId_(portId), notifier_(notifier), ring_(STREAM_RING_SIZE)
+{
+}
+
+SerialPortStream::~SerialPortStream()
+{
+    Stop();
+}
+
+void SerialPortStream::Start()
+{
+    if (reader_.joinable() || running_.exchange(true)) {
+        return;
+    }
+    reader_ = std::thread([this]() {
+        std::string name = STREAM_THREAD_PREFIX + std::to_string(portId_);
+        pthread_setname_np(pthread_self(), name.c_str());
+        ReadLoop();
+    });
+}
+
+void SerialPortStream::Stop()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        running_ = false;
+    }
+    dataCond_.notify_all();
+    spaceCond_.notify_all();
+    if (!reader_.joinable()) {
+        return;
+    }
+    reader_.join();
+    USB_HILOGI(MODULE_USB_SERIAL, "stream of port %{public}d stopped, rx:%{public}" PRIu64 " overrun:%{public}"
+        PRIu64 " backpressure:%{public}" PRIu64, portId_, receivedBytes_.load(), overrunCount_.load(),
+        backpressureCount_.load());
+}
+
+bool SerialPortStream::WaitForSpace()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (ring_.size() - count_ >= STREAM_READ_CHUNK) {
+        return true;
+    }
+    /* the reader stops pulling from the device until the client drains, flow control applies below us */
+    ++backpressureCount_;
+    spaceCond_.wait(lock, [this]() { return !running_ || ring_.size() - count_ >= STREAM_READ_CHUNK; });
+    return running_;
+}
+
+void SerialPortStream::ReadLoop()
+{
+    std::vector<uint8_t> chunk;
+    while (running_) {
+        if (!WaitForSpace()) {
+            break;
+        }
+        chunk.clear();
+        int32_t ret = serial_->SerialRead(portId_, chunk, STREAM_READ_CHUNK, STREAM_READ_TIMEOUT_MS);
+        if (ret == ERR_CODE_ERROR_OVERFLOW) {
+            ++overrunCount_;
+            continue;
+        }
+        if (ret == ERR_CODE_DEVICENOTOPEN) {
+            USB_HILOGE(MODULE_USB_SERIAL, "port %{public}d closed under stream", portId_);
+            break;
+        }
+        if (ret < UEC_OK && ret != ERR_CODE_TIMEOUT) {
+            ++errorCount_;
+            std::this_thread::sleep_for(std::chrono::milliseconds(STREAM_READ_TIMEOUT_MS));
+            continue;
+        }
+        size_t len = std::min(static_cast<size_t>(std::max(ret, 0)), chunk.size());
+        if (len > 0) {
+            Push(chunk.data(), len);
+        }
+    }
+    bool closedUnder = false;
+    uint32_t available = 0;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        closedUnder = running_;
+        running_ = false;
+        available = static_cast<uint32_t>(count_);
+    }
+    dataCond_.notify_all();
+    /* a client waiting for the next notification learns from its Read that the port is gone */
+    if (closedUnder) {
+        Notify(available);
+    }
+}
+
+void SerialPortStream::Push(const uint8_t *data, size_t len)
+{
+    uint32_t available = 0;
+    bool notify = false;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        size_t tail = (head_ + count_) % ring_.size();
+        size_t first = std::min(len, ring_.size() - tail);
+        (void)memcpy_s(ring_.data() + tail, ring_.size() - tail, data, first);
+        if (len > first) {
+            (void)memcpy_s(ring_.data(), ring_.size(), data + first, len - first);
+        }
+        count_ += len;
+        receivedBytes_ += len;
+        available = static_cast<uint32_t>(count_);
+        notify = notifyArmed_;
+        notifyArmed_ = false;
+    }
+    dataCond_.notify_one();
+    if (notify) {
+        Notify(available);
+    }
+}
+
+void SerialPortStream::Notify(uint32_t available)
+{
+    if (notifier_ == nullptr) {
+        return;
+    }
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    if (!data.WriteInt32(portId_) || !data.WriteUint32(available) || !data.WriteUint64(overrunCount_.load())) {
+        USB_HILOGE(MODULE_USB_SERIAL, "write stream notification failed");
+        return;
+    }
+    int32_t ret = notifier_->SendRequest(USB::SERIAL_NOTIFY_DATA_AVAILABLE, data, reply, option);
+    if (ret != UEC_OK) {
+        USB_HILOGW(MODULE_USB_SERIAL, "notify port %{public}d failed, ret:%{public}d", portId_, ret);
+    }
+}
+
+int32_t SerialPortStream::Read(std::vector<uint8_t> &data, uint32_t size, uint32_t &actualSize, uint32_t timeout)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    auto ready = [this]() { return count_ > 0 || !running_; };
+    if (timeout == 0) {
+        dataCond_.wait(lock, ready);
+    } else {
+        dataCond_.wait_for(lock, std::chrono::milliseconds(timeout), ready);
+    }
+    size_t len = std::min(static_cast<size_t>(size), count_);
+    data.resize(len);
+    size_t first = std::min(len, ring_.size() - head_);
+    if (len > 0) {
+        (void)memcpy_s(data.data(), len, ring_.data() + head_, first);
+        if (len > first) {
+            (void)memcpy_s(data.data() + first, len - first, ring_.data(), len - first);
+        }
+    }
+    head_ = (head_ + len) % ring_.size();
+    count_ -= len;
+    /* an emptied ring waits for the next byte, bytes left behind are announced right away */
+    uint32_t remaining = static_cast<uint32_t>(count_);
+    notifyArmed_ = remaining == 0;
+    lock.unlock();
+    spaceCond_.notify_one();
+    if (remaining > 0) {
+        Notify(remaining);
+    }
+    deliveredBytes_ += len;
+    actualSize = static_cast<uint32_t>(len);
+    if (len == 0) {
+        return running_ ? USB::UEC_INTERFACE_TIMED_OUT : USB::UEC_SERIAL_IO_EXCEPTION;
+    }
+    return UEC_OK;
+}
+
+void SerialPortStream::Dump(int32_t fd)
+{
+    size_t buffered = 0;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        buffered = count_;
+    }
+    dprintf(fd, "port %d: %s buffered:%zu/%zu rx:%" PRIu64 " delivered:%" PRIu64 " backpressure:%" PRIu64
+        " overrun:%" PRIu64 " error:%" PRIu64 "\n", portId_, running_ ? "running" : "stopped", buffered,
+        ring_.size(), receivedBytes_.load(), deliveredBytes_.load(), backpressureCount_.load(),
+        overrunCount_.load(), errorCount_.load());
+}
+} // namespace SERIAL
+} // namespace OHOS
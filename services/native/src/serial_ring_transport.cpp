@@ -0,0 +1,249 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_ring_transport.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <pthread.h>
+#include <string>
+#include <sys/eventfd.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#include <vector>
+#include "hilog_wrapper.h"
+#include "usb_errors.h"
+
+using OHOS::USB::USB_MGR_LABEL;
+using OHOS::USB::MODULE_USB_SERIAL;
+using OHOS::USB::UEC_OK;
+
+namespace OHOS {
+namespace SERIAL {
+constexpr uint32_t RING_IO_CHUNK = 4096;
+constexpr uint32_t RING_READ_TIMEOUT_MS = 50;
+constexpr uint32_t RING_WRITE_TIMEOUT_MS = 1000;
+constexpr uint32_t RING_PUMP_WAIT_MS = 100;
+constexpr int32_t ERR_CODE_DEVICENOTOPEN = -6;
+constexpr int32_t ERR_CODE_TIMEOUT = -7;
+constexpr int32_t ERR_CODE_ERROR_OVERFLOW = -8;
+constexpr const char *RING_ASHMEM_PREFIX = "serial_ring_";
+constexpr const char *RING_RX_THREAD_PREFIX = "serial_rrx_";
+constexpr const char *RING_TX_THREAD_PREFIX = "serial_rtx_";
+
+/* the closed flag lives in memory the client can write, a pump rechecks its own running flag between short waits */
+template <typename Wait>
+static bool WaitWhileRunning(const std::atomic<bool> &running, const USB::SerialShmRing &ring, Wait wait)
+{
+    while (running) {
+        if (wait()) {
+            return true;
+        }
+        if (ring.IsClosed()) {
+            return false;
+        }
+    }
+    return false;
+}
+
+SerialRingTransport::SerialRingTransport(const sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> &serial,
+    int32_t portId) : serial_(serial), portId_(portId)
+{
+}
+
+SerialRingTransport::~SerialRingTransport()
+{
+    Stop();
+    Release();
+}
+
+int32_t SerialRingTransport::Init()
+{
+    std::string name = RING_ASHMEM_PREFIX + std::to_string(portId_);
+    ashmem_ = Ashmem::CreateAshmem(name.c_str(), USB::SERIAL_SHM_REGION_SIZE);
+    if (ashmem_ == nullptr) {
+        USB_HILOGE(MODULE_USB_SERIAL, "create ring ashmem of port %{public}d failed", portId_);
+        return USB::UEC_SERVICE_NO_MEMORY;
+    }
+    base_ = mmap(nullptr, USB::SERIAL_SHM_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+        ashmem_->GetAshmemFd(), 0);
+    if (base_ == MAP_FAILED) {
+        USB_HILOGE(MODULE_USB_SERIAL, "map ring of port %{public}d failed, errno:%{public}d", portId_, errno);
+        base_ = nullptr;
+        Release();
+        return USB::UEC_SERVICE_NO_MEMORY;
+    }
+    int32_t *doorbells[] = {&fds_.rxDataFd, &fds_.rxSpaceFd, &fds_.txDataFd, &fds_.txSpaceFd};
+    for (int32_t *doorbell : doorbells) {
+        *doorbell = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        if (*doorbell < 0) {
+            USB_HILOGE(MODULE_USB_SERIAL, "create doorbell of port %{public}d failed, errno:%{public}d",
+                portId_, errno);
+            Release();
+            return USB::UEC_SERVICE_NO_MEMORY;
+        }
+    }
+    fds_.ringFd = ashmem_->GetAshmemFd();
+    uint8_t *base = static_cast<uint8_t *>(base_);
+    rx_ = USB::SerialShmRing(base + USB::SERIAL_SHM_RX_OFFSET, fds_.rxDataFd, fds_.rxSpaceFd);
+    tx_ = USB::SerialShmRing(base + USB::SERIAL_SHM_TX_OFFSET, fds_.txDataFd, fds_.txSpaceFd);
+    rx_.Reset();
+    tx_.Reset();
+    return UEC_OK;
+}
+
+void SerialRingTransport::Start()
+{
+    if (base_ == nullptr || running_.exchange(true)) {
+        return;
+    }
+    rxPump_ = std::thread([this]() {
+        std::string name = RING_RX_THREAD_PREFIX + std::to_string(portId_);
+        pthread_setname_np(pthread_self(), name.c_str());
+        RxLoop();
+    });
+    txPump_ = std::thread([this]() {
+        std::string name = RING_TX_THREAD_PREFIX + std::to_string(portId_);
+        pthread_setname_np(pthread_self(), name.c_str());
+        TxLoop();
+    });
+}
+
+void SerialRingTransport::Stop()
+{
+    running_ = false;
+    if (base_ != nullptr) {
+        rx_.Close();
+        tx_.Close();
+    }
+    if (!rxPump_.joinable() && !txPump_.joinable()) {
+        return;
+    }
+    if (rxPump_.joinable()) {
+        rxPump_.join();
+    }
+    if (txPump_.joinable()) {
+        txPump_.join();
+    }
+    USB_HILOGI(MODULE_USB_SERIAL, "ring of port %{public}d stopped, rx:%{public}" PRIu64 " tx:%{public}" PRIu64
+        " overrun:%{public}" PRIu64, portId_, receivedBytes_.load(), sentBytes_.load(), overrunCount_.load());
+}
+
+void SerialRingTransport::Release()
+{
+    if (base_ != nullptr) {
+        munmap(base_, USB::SERIAL_SHM_REGION_SIZE);
+        base_ = nullptr;
+    }
+    int32_t *doorbells[] = {&fds_.rxDataFd, &fds_.rxSpaceFd, &fds_.txDataFd, &fds_.txSpaceFd};
+    for (int32_t *doorbell : doorbells) {
+        if (*doorbell >= 0) {
+            close(*doorbell);
+            *doorbell = -1;
+        }
+    }
+    if (ashmem_ != nullptr) {
+        ashmem_->CloseAshmem();
+        ashmem_ = nullptr;
+    }
+    fds_.ringFd = -1;
+}
+
+SerialRingFds SerialRingTransport::GetFds() const
+{
+    return fds_;
+}
+
+void SerialRingTransport::RxLoop()
+{
+    std::vector<uint8_t> chunk;
+    while (running_) {
+        if (rx_.Writable() < RING_IO_CHUNK) {
+            /* the client is behind, stop pulling from the device until it drains */
+            ++backpressureCount_;
+            auto writable = [this]() { return rx_.WaitWritable(RING_IO_CHUNK, RING_PUMP_WAIT_MS); };
+            if (!WaitWhileRunning(running_, rx_, writable)) {
+                break;
+            }
+        }
+        chunk.clear();
+        int32_t ret = serial_->SerialRead(portId_, chunk, RING_IO_CHUNK, RING_READ_TIMEOUT_MS);
+        if (ret == ERR_CODE_ERROR_OVERFLOW) {
+            ++overrunCount_;
+            continue;
+        }
+        if (ret == ERR_CODE_DEVICENOTOPEN) {
+            USB_HILOGE(MODULE_USB_SERIAL, "port %{public}d closed under ring", portId_);
+            break;
+        }
+        if (ret < UEC_OK && ret != ERR_CODE_TIMEOUT) {
+            ++errorCount_;
+            std::this_thread::sleep_for(std::chrono::milliseconds(RING_READ_TIMEOUT_MS));
+            continue;
+        }
+        uint32_t len = static_cast<uint32_t>(std::min(static_cast<size_t>(std::max(ret, 0)), chunk.size()));
+        if (len > 0) {
+            rx_.Push(chunk.data(), len);
+            receivedBytes_ += len;
+        }
+    }
+    /* a reader of the client must not wait for data that will never come */
+    rx_.Close();
+}
+
+void SerialRingTransport::TxLoop()
+{
+    std::vector<uint8_t> pending;
+    while (running_) {
+        if (!WaitWhileRunning(running_, tx_, [this]() { return tx_.WaitReadable(RING_PUMP_WAIT_MS); })) {
+            break;
+        }
+        pending.resize(RING_IO_CHUNK);
+        pending.resize(tx_.Pop(pending.data(), RING_IO_CHUNK));
+        while (!pending.empty() && running_) {
+            int32_t ret = serial_->SerialWrite(portId_, pending, pending.size(), RING_WRITE_TIMEOUT_MS);
+            if (ret == ERR_CODE_DEVICENOTOPEN) {
+                USB_HILOGE(MODULE_USB_SERIAL, "port %{public}d closed under ring", portId_);
+                tx_.ReportFailure();
+                tx_.Close();
+                return;
+            }
+            if (ret <= 0) {
+                ++errorCount_;
+                USB_HILOGW(MODULE_USB_SERIAL, "port %{public}d drops %{public}zu bytes, ret:%{public}d", portId_,
+                    pending.size(), ret);
+                /* the writer returned long ago, its next write or close reports the loss */
+                tx_.ReportFailure();
+                break;
+            }
+            size_t written = std::min(static_cast<size_t>(ret), pending.size());
+            sentBytes_ += written;
+            pending.erase(pending.begin(), pending.begin() + written);
+        }
+    }
+}
+
+void SerialRingTransport::Dump(int32_t fd)
+{
+    uint32_t rxBuffered = base_ == nullptr ? 0 : rx_.Readable();
+    uint32_t txBuffered = base_ == nullptr ? 0 : tx_.Readable();
+    dprintf(fd, "port %d: ring %s rx buffered:%u tx buffered:%u capacity:%u rx:%" PRIu64 " tx:%" PRIu64
+        " backpressure:%" PRIu64 " overrun:%" PRIu64 " error:%" PRIu64 "\n", portId_,
+        running_ ? "running" : "stopped", rxBuffered, txBuffered, USB::SERIAL_SHM_RING_CAPACITY,
+        receivedBytes_.load(), sentBytes_.load(), backpressureCount_.load(), overrunCount_.load(),
+        errorCount_.load());
+}
+} // namespace SERIAL
+} // namespace OHOS
@@ -0,0 +1,139 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ * http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_write_queue.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <unistd.h>
+
+namespace OHOS {
+namespace SERIAL {
+constexpr int32_t ERR_CODE_IOEXCEPTION = -1;
+
+SerialWriteQueue::SerialWriteQueue(const sptr<OHOS::HDI::Usb::Serial::V1_0::ISerialInterface> &serial,
+    int32_t portId, uint32_t windowUs, uint32_t maxBytes)
+    : serial_(serial), portId_(portId), windowUs_(windowUs), maxBytes_(std::max(maxBytes, 1U))
+{
+}
+
+int32_t SerialWriteQueue::Write(const std::vector<uint8_t> &data, uint32_t size, uint32_t timeout)
+{
+    Request self;
+    self.data = data.data();
+    self.size = std::min(size, static_cast<uint32_t>(data.size()));
+    self.timeout = timeout;
+    ++requestCount_;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    pending_.push_back(&self);
+    pendingBytes_ += self.size;
+    if (hasLeader_) {
+        fillCond_.notify_one();
+        cond_.wait(lock, [&self]() { return self.done || self.leader; });
+        if (self.done) {
+            return self.ret;
+        }
+    } else {
+        hasLeader_ = true;
+        self.leader = true;
+    }
+    Lead(lock, self);
+    return self.ret;
+}
+
+void SerialWriteQueue::Lead(std::unique_lock<std::mutex> &lock, Request &self)
+{
+    /* the leader is always the oldest pending request, so each round completes at least its own bytes */
+    while (!self.done) {
+        if (windowUs_ > 0 && pendingBytes_ < maxBytes_) {
+            fillCond_.wait_for(lock, std::chrono::microseconds(windowUs_),
+                [this]() { return pendingBytes_ >= maxBytes_; });
+        }
+        std::vector<Request *> batch;
+        std::vector<uint8_t> buffer;
+        TakeBatch(batch, buffer);
+        uint32_t timeout = batch.front()->timeout;
+        lock.unlock();
+        int32_t ret = serial_->SerialWrite(portId_, buffer, buffer.size(), timeout);
+        ++flushCount_;
+        if (ret > 0) {
+            writtenBytes_ += static_cast<uint64_t>(ret);
+        }
+        lock.lock();
+        Complete(batch, ret);
+        cond_.notify_all();
+    }
+    self.leader = false;
+    if (pending_.empty()) {
+        hasLeader_ = false;
+        return;
+    }
+    pending_.front()->leader = true;
+    cond_.notify_all();
+}
+
+void SerialWriteQueue::TakeBatch(std::vector<Request *> &batch, std::vector<uint8_t> &buffer)
+{
+    uint32_t timeout = pending_.front()->timeout;
+    while (!pending_.empty()) {
+        Request *req = pending_.front();
+        if (!batch.empty() && (req->timeout != timeout || buffer.size() + req->size > maxBytes_)) {
+            break;
+        }
+        buffer.insert(buffer.end(), req->data, req->data + req->size);
+        pendingBytes_ -= req->size;
+        batch.push_back(req);
+        pending_.pop_front();
+    }
+}
+
+void SerialWriteQueue::Complete(std::vector<Request *> &batch, int32_t ret)
+{
+    if (ret <= 0) {
+        for (auto req : batch) {
+            req->ret = ret;
+            req->done = true;
+        }
+        return;
+    }
+    uint32_t written = static_cast<uint32_t>(ret);
+    uint32_t offset = 0;
+    bool cut = false;
+    for (Request *req : batch) {
+        req->done = true;
+        if (cut) {
+            req->ret = ERR_CODE_IOEXCEPTION;
+            continue;
+        }
+        uint32_t taken = std::min(req->size, written > offset ? written - offset : 0);
+        req->ret = static_cast<int32_t>(taken);
+        offset += req->size;
+        /* bytes sent after a cut frame would follow its missing tail, so the frames behind it fail instead */
+        cut = taken < req->size;
+    }
+}
+
+void SerialWriteQueue::Dump(int32_t fd)
+{
+    uint64_t flushes = flushCount_.load();
+    uint64_t requests = requestCount_.load();
+    dprintf(fd, "port %d: write queue window:%uus max:%u requests:%" PRIu64 " flushes:%" PRIu64 " written:%"
+        PRIu64 " frames/flush:%.2f\n", portId_, windowUs_, maxBytes_, requests, flushes, writtenBytes_.load(),
+        flushes == 0 ? 0.0 : static_cast<double>(requests) / flushes);
+}
+} // namespace SERIAL
+} // namespace OHOS
@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_batch_transfer_callback_impl.h"
+#include "usbd_callback_stub.h"
+#include "message_option.h"
+#include "message_parcel.h"
+#include "usb_errors.h"
+#include "hilog_wrapper.h"
+#include "struct_parcel.h"
+
+namespace OHOS {
+namespace USB {
+UsbBatchTransferCollector::UsbBatchTransferCollector(
+    const sptr<IRemoteObject> &cb, const sptr<Ashmem> &ashmem, size_t count)
+    : remote_(cb), ashmem_(ashmem), transfers_(count)
+{
+}
+
+void UsbBatchTransferCollector::SetSubTransfer(size_t index, int32_t offset, int32_t length,
+    const sptr<Ashmem> &buffer)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (index >= transfers_.size()) {
+        return;
+    }
+    transfers_[index].offset = offset;
+    transfers_[index].length = length;
+    transfers_[index].buffer = buffer;
+}
+
+void UsbBatchTransferCollector::Abort()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    aborted_ = true;
+}
+
+void UsbBatchTransferCollector::FailFrom(size_t index, int32_t status)
+{
+    std::vector<SubTransfer> transfers;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (aborted_) {
+            return;
+        }
+        for (size_t i = index; i < transfers_.size(); ++i) {
+            if (transfers_[i].done) {
+                continue;
+            }
+            transfers_[i].done = true;
+            transfers_[i].status = status;
+            transfers_[i].buffer = nullptr;
+            ++doneCount_;
+        }
+        if (transfers_.empty() || doneCount_ < transfers_.size()) {
+            return;
+        }
+        transfers.swap(transfers_);
+    }
+    SendBatchResult(transfers);
+}
+
+void UsbBatchTransferCollector::CopyReadData(const SubTransfer &transfer)
+{
+    if (ashmem_ == nullptr || transfer.buffer == nullptr) {
+        return;
+    }
+    /* iso packets keep their nominal offsets, so the whole slice is copied back for them */
+    int32_t copyLen = transfer.isoInfo.empty() ? transfer.actLength : transfer.length;
+    if (copyLen <= 0 || copyLen > transfer.length) {
+        return;
+    }
+    const void *data = transfer.buffer->ReadFromAshmem(copyLen, 0);
+    if (data == nullptr || !ashmem_->WriteToAshmem(data, copyLen, transfer.offset)) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: copy read data failed", __func__);
+    }
+}
+
+void UsbBatchTransferCollector::OnTransferDone(size_t index, int32_t status, int32_t actLength,
+    const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, uint64_t userData, bool isRead)
+{
+    std::vector<SubTransfer> transfers;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (aborted_ || index >= transfers_.size() || transfers_[index].done) {
+            return;
+        }
+        SubTransfer &transfer = transfers_[index];
+        transfer.done = true;
+        transfer.status = status;
+        transfer.actLength = actLength;
+        transfer.userData = userData;
+        transfer.isoInfo = isoInfo;
+        if (isRead && status == UEC_OK) {
+            CopyReadData(transfer);
+        }
+        transfer.buffer = nullptr;
+        if (++doneCount_ < transfers_.size()) {
+            return;
+        }
+        transfers.swap(transfers_);
+    }
+    SendBatchResult(transfers);
+}
+
+int32_t UsbBatchTransferCollector::SendBatchResult(const std::vector<SubTransfer> &transfers)
+{
+    if (remote_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: remote_ is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    OHOS::MessageParcel data;
+    OHOS::MessageParcel reply;
+    OHOS::MessageOption option;
+    if (!data.WriteInterfaceToken(remote_->GetInterfaceDescriptor())) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: write token failed", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (!data.WriteUint32(static_cast<uint32_t>(transfers.size()))) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: write count failed", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    for (const auto &transfer : transfers) {
+        UsbIsoVecParcel usbIsoVecParcel;
+        usbIsoVecParcel.isoInfoVec = transfer.isoInfo;
+        if (!data.WriteParcelable(&usbIsoVecParcel) || !data.WriteInt32(transfer.status) ||
+            !data.WriteInt32(transfer.actLength) || !data.WriteUint64(transfer.userData)) {
+            USB_HILOGE(MODULE_USB_HOST, "%{public}s: write transfer result failed", __func__);
+            return UEC_SERVICE_INVALID_VALUE;
+        }
+    }
+    int32_t ret = remote_->SendRequest(UsbdStubCallBack::CMD_USBD_TRANSFER_CALLBACK_BATCH, data, reply, option);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s UsbdStubCallBack failed, error code is %{public}d", __func__, ret);
+        return ret;
+    }
+    return UEC_OK;
+}
+
+int32_t UsbdBatchTransferCallbackImpl::OnTransferWriteCallback(int32_t status, int32_t actLength,
+    const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData)
+{
+    if (collector_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: collector_ is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    collector_->OnTransferDone(index_, status, actLength, isoInfo, userData, false);
+    return UEC_OK;
+}
+
+int32_t UsbdBatchTransferCallbackImpl::OnTransferReadCallback(int32_t status, int32_t actLength,
+    const std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData)
+{
+    if (collector_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: collector_ is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    collector_->OnTransferDone(index_, status, actLength, isoInfo, userData, true);
+    return UEC_OK;
+}
+
+#ifdef USB_MANAGER_PASS_THROUGH
+static std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> ConvertIsoInfo(
+    const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo)
+{
+    std::vector<HDI::Usb::V1_2::UsbIsoPacketDescriptor> result(isoInfo.size());
+    for (size_t i = 0; i < isoInfo.size(); ++i) {
+        result[i].isoLength = isoInfo[i].isoLength;
+        result[i].isoActualLength = isoInfo[i].isoActualLength;
+        result[i].isoStatus = isoInfo[i].isoStatus;
+    }
+    return result;
+}
+
+int32_t UsbBatchTransferCallbackImpl::OnTransferWriteCallback(int32_t status, int32_t actLength,
+    const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData)
+{
+    if (collector_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: collector_ is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    collector_->OnTransferDone(index_, status, actLength, ConvertIsoInfo(isoInfo), userData, false);
+    return UEC_OK;
+}
+
+int32_t UsbBatchTransferCallbackImpl::OnTransferReadCallback(int32_t status, int32_t actLength,
+    const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData)
+{
+    if (collector_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: collector_ is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    collector_->OnTransferDone(index_, status, actLength, ConvertIsoInfo(isoInfo), userData, true);
+    return UEC_OK;
+}
+#endif // USB_MANAGER_PASS_THROUGH
+} // namespace USB
+} // namespace OHOS
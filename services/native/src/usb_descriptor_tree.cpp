@@ -0,0 +1,288 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_descriptor_tree.h"
+
+#include "hilog_wrapper.h"
+#include "usb_endpoint.h"
+#include "usb_errors.h"
+#include "usb_interface.h"
+#include "usbd_type.h"
+
+namespace OHOS {
+namespace USB {
+constexpr uint8_t NORMAL_ENDPOINT_DESCRIPTOR = 7;
+constexpr uint8_t AUDIO_ENDPOINT_DESCRIPTOR = 9;
+constexpr uint8_t ENDPOINT_XFER_TYPE_MASK = 0x03;
+constexpr uint8_t ENDPOINT_XFER_ISOC = 0x01;
+constexpr uint8_t ENDPOINT_XFER_BULK = 0x02;
+constexpr uint8_t SS_BULK_MAX_STREAMS_MASK = 0x1F;
+constexpr uint8_t SS_ISOC_MULT_MASK = 0x03;
+
+int32_t UsbDescriptorTree::Parse(const std::vector<uint8_t> &raw, uint32_t offset)
+{
+    raw_ = raw;
+    configs_.clear();
+    interfaces_.clear();
+    endpoints_.clear();
+    owner_ = Owner::NONE;
+
+    uint32_t length = static_cast<uint32_t>(raw_.size());
+    uint32_t cursor = offset;
+    while (cursor < length) {
+        if ((length - cursor) < sizeof(UsbdDescriptorHeader)) {
+            USB_HILOGW(MODULE_USB_HOST, "invalid desc data, length=%{public}u, cursor=%{public}u", length, cursor);
+            break;
+        }
+        const UsbdDescriptorHeader *header = reinterpret_cast<const UsbdDescriptorHeader *>(raw_.data() + cursor);
+        uint8_t bLength = header->bLength;
+        if (bLength < sizeof(UsbdDescriptorHeader) || bLength > (length - cursor)) {
+            USB_HILOGW(MODULE_USB_HOST, "invalid data length, bLen=%{public}u, length=%{public}u, cursor=%{public}u",
+                bLength, length, cursor);
+            break;
+        }
+        int32_t ret = UEC_OK;
+        switch (header->bDescriptorType) {
+            case static_cast<uint8_t>(DescriptorType::DESCRIPTOR_TYPE_CONFIG):
+                ret = AddConfig(cursor, bLength);
+                break;
+            case static_cast<uint8_t>(DescriptorType::DESCRIPTOR_TYPE_INTERFACE):
+                ret = AddInterface(cursor, bLength);
+                break;
+            case static_cast<uint8_t>(DescriptorType::DESCRIPTOR_TYPE_ENDPOINT):
+                ret = AddEndpoint(cursor, bLength);
+                break;
+            case static_cast<uint8_t>(DescriptorType::DESCRIPTOR_TYPE_SS_ENDPOINT_COMPANION):
+                AddSsCompanion(cursor, bLength);
+                break;
+            case static_cast<uint8_t>(DescriptorType::DESCRIPTOR_TYPE_SSP_ISOC_ENDPOINT_COMPANION):
+                AddSspIsocCompanion(cursor, bLength);
+                break;
+            default:
+                AddExtra(cursor, bLength);
+                break;
+        }
+        if (ret != UEC_OK) {
+            return ret;
+        }
+        cursor += bLength;
+    }
+    return UEC_OK;
+}
+
+int32_t UsbDescriptorTree::AddConfig(uint32_t cursor, uint8_t length)
+{
+    if (length != sizeof(UsbdConfigDescriptor)) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid config, length=%{public}u", length);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    const UsbdConfigDescriptor *desc = reinterpret_cast<const UsbdConfigDescriptor *>(raw_.data() + cursor);
+    UsbConfigNode node;
+    node.desc = {cursor, length};
+    node.firstInterface = static_cast<uint32_t>(interfaces_.size());
+    configs_.emplace_back(node);
+    owner_ = Owner::CONFIG;
+    USB_HILOGD(MODULE_USB_HOST, "add config, interfaces=%{public}u", desc->bNumInterfaces);
+    return UEC_OK;
+}
+
+int32_t UsbDescriptorTree::AddInterface(uint32_t cursor, uint8_t length)
+{
+    if (length != sizeof(UsbdInterfaceDescriptor)) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid interface, length=%{public}u", length);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (configs_.empty()) {
+        USB_HILOGE(MODULE_USB_HOST, "config descriptor not found");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    const UsbdInterfaceDescriptor *desc = reinterpret_cast<const UsbdInterfaceDescriptor *>(raw_.data() + cursor);
+    UsbConfigNode &config = configs_.back();
+    UsbInterfaceNode node;
+    node.desc = {cursor, length};
+    node.firstEndpoint = static_cast<uint32_t>(endpoints_.size());
+    interfaces_.emplace_back(node);
+    ++config.interfaceCount;
+    owner_ = Owner::INTERFACE;
+    USB_HILOGD(MODULE_USB_HOST, "add interface, endpoints=%{public}u", desc->bNumEndpoints);
+    return UEC_OK;
+}
+
+int32_t UsbDescriptorTree::AddEndpoint(uint32_t cursor, uint8_t length)
+{
+    if (length != NORMAL_ENDPOINT_DESCRIPTOR && length != AUDIO_ENDPOINT_DESCRIPTOR) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid endpoint, length=%{public}u", length);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (configs_.empty() || configs_.back().interfaceCount == 0) {
+        USB_HILOGE(MODULE_USB_HOST, "interface descriptor not found");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    const UsbdEndpointDescriptor *desc = reinterpret_cast<const UsbdEndpointDescriptor *>(raw_.data() + cursor);
+    UsbEndpointNode node;
+    node.desc = {cursor, length};
+    endpoints_.emplace_back(node);
+    ++interfaces_.back().endpointCount;
+    owner_ = Owner::ENDPOINT;
+    USB_HILOGD(MODULE_USB_HOST, "add endpoint, address=%{public}u", desc->bEndpointAddress);
+    return UEC_OK;
+}
+
+void UsbDescriptorTree::AddSsCompanion(uint32_t cursor, uint8_t length)
+{
+    AddExtra(cursor, length);
+    if (owner_ != Owner::ENDPOINT || length < sizeof(UsbdSsEndpointCompanionDescriptor)) {
+        USB_HILOGW(MODULE_USB_HOST, "stray ss endpoint companion, length=%{public}u", length);
+        return;
+    }
+    const UsbdSsEndpointCompanionDescriptor *desc =
+        reinterpret_cast<const UsbdSsEndpointCompanionDescriptor *>(raw_.data() + cursor);
+    UsbEndpointNode &ep = endpoints_.back();
+    const UsbdEndpointDescriptor *epDesc = reinterpret_cast<const UsbdEndpointDescriptor *>(raw_.data() +
+        ep.desc.offset);
+    ep.ssCompanion = {cursor, length};
+    ep.maxBurst = static_cast<uint8_t>(desc->bMaxBurst + 1);
+    uint8_t type = epDesc->bmAttributes & ENDPOINT_XFER_TYPE_MASK;
+    if (type == ENDPOINT_XFER_BULK) {
+        uint8_t streams = desc->bmAttributes & SS_BULK_MAX_STREAMS_MASK;
+        ep.maxStreams = streams == 0 ? 0 : (1U << streams);
+    } else if (type == ENDPOINT_XFER_ISOC) {
+        ep.mult = static_cast<uint8_t>((desc->bmAttributes & SS_ISOC_MULT_MASK) + 1);
+    }
+    if (type != ENDPOINT_XFER_BULK) {
+        ep.bytesPerInterval = desc->wBytesPerInterval;
+    }
+}
+
+void UsbDescriptorTree::AddSspIsocCompanion(uint32_t cursor, uint8_t length)
+{
+    AddExtra(cursor, length);
+    if (owner_ != Owner::ENDPOINT || length < sizeof(UsbdSspIsocEndpointCompanionDescriptor)) {
+        USB_HILOGW(MODULE_USB_HOST, "stray ssp isoc companion, length=%{public}u", length);
+        return;
+    }
+    const UsbdSspIsocEndpointCompanionDescriptor *desc =
+        reinterpret_cast<const UsbdSspIsocEndpointCompanionDescriptor *>(raw_.data() + cursor);
+    UsbEndpointNode &ep = endpoints_.back();
+    ep.sspIsocCompanion = {cursor, length};
+    /* SuperSpeedPlus isochronous bandwidth no longer fits the 16-bit companion field */
+    ep.bytesPerInterval = desc->dwBytesPerInterval;
+}
+
+UsbDescriptorView *UsbDescriptorTree::GetOwnerExtra()
+{
+    switch (owner_) {
+        case Owner::CONFIG:
+            return &configs_.back().extra;
+        case Owner::INTERFACE:
+            return &interfaces_.back().extra;
+        case Owner::ENDPOINT:
+            return &endpoints_.back().extra;
+        default:
+            return nullptr;
+    }
+}
+
+void UsbDescriptorTree::AddExtra(uint32_t cursor, uint8_t length)
+{
+    UsbDescriptorView *extra = GetOwnerExtra();
+    if (extra == nullptr) {
+        USB_HILOGW(MODULE_USB_HOST, "unowned descriptor, type=%{public}u", raw_[cursor + 1]);
+        return;
+    }
+    /* descriptors of one owner are contiguous, so the view only grows */
+    if (extra->length == 0) {
+        extra->offset = cursor;
+    }
+    extra->length = cursor + length - extra->offset;
+}
+
+void UsbDescriptorTree::ToConfigs(std::vector<USBConfig> &configs) const
+{
+    configs.reserve(configs.size() + configs_.size());
+    for (const UsbConfigNode &configNode : configs_) {
+        const UsbdConfigDescriptor *configDesc = reinterpret_cast<const UsbdConfigDescriptor *>(Data(configNode.desc));
+        configs.emplace_back();
+        USBConfig &config = configs.back();
+        config.SetId(configDesc->bConfigurationValue);
+        config.SetAttribute(configDesc->bmAttributes);
+        config.SetMaxPower(configDesc->bMaxPower);
+        config.SetiConfiguration(configDesc->iConfiguration);
+        std::vector<UsbInterface> &interfaces = config.GetInterfaces();
+        interfaces.reserve(configNode.interfaceCount);
+        for (uint32_t i = configNode.firstInterface; i < configNode.firstInterface + configNode.interfaceCount; ++i) {
+            const UsbInterfaceNode &interfaceNode = interfaces_[i];
+            const UsbdInterfaceDescriptor *interfaceDesc =
+                reinterpret_cast<const UsbdInterfaceDescriptor *>(Data(interfaceNode.desc));
+            interfaces.emplace_back();
+            UsbInterface &interface = interfaces.back();
+            interface.SetId(interfaceDesc->bInterfaceNumber);
+            interface.SetProtocol(interfaceDesc->bInterfaceProtocol);
+            interface.SetAlternateSetting(interfaceDesc->bAlternateSetting);
+            interface.SetClass(interfaceDesc->bInterfaceClass);
+            interface.SetSubClass(interfaceDesc->bInterfaceSubClass);
+            interface.SetiInterface(interfaceDesc->iInterface);
+            std::vector<USBEndpoint> &eps = interface.GetEndpoints();
+            eps.reserve(interfaceNode.endpointCount);
+            for (uint32_t j = interfaceNode.firstEndpoint;
+                j < interfaceNode.firstEndpoint + interfaceNode.endpointCount; ++j) {
+                const UsbEndpointNode &epNode = endpoints_[j];
+                const UsbdEndpointDescriptor *epDesc =
+                    reinterpret_cast<const UsbdEndpointDescriptor *>(Data(epNode.desc));
+                eps.emplace_back();
+                USBEndpoint &ep = eps.back();
+                ep.SetAddr(epDesc->bEndpointAddress);
+                ep.SetAttr(epDesc->bmAttributes);
+                ep.SetInterval(epDesc->bInterval);
+                ep.SetMaxPacketSize(epDesc->wMaxPacketSize);
+                ep.SetInterfaceId(interfaceDesc->bInterfaceNumber);
+                ep.SetMaxBurst(epNode.maxBurst);
+                ep.SetMaxStreams(epNode.maxStreams);
+                ep.SetMult(epNode.mult);
+                ep.SetBytesPerInterval(epNode.bytesPerInterval);
+            }
+        }
+    }
+}
+
+const uint8_t *UsbDescriptorTree::Data(const UsbDescriptorView &view) const
+{
+    if (view.length == 0 || view.offset + view.length > raw_.size()) {
+        return nullptr;
+    }
+    return raw_.data() + view.offset;
+}
+
+const std::vector<uint8_t> &UsbDescriptorTree::GetRaw() const
+{
+    return raw_;
+}
+
+const std::vector<UsbConfigNode> &UsbDescriptorTree::GetConfigs() const
+{
+    return configs_;
+}
+
+const std::vector<UsbInterfaceNode> &UsbDescriptorTree::GetInterfaces() const
+{
+    return interfaces_;
+}
+
+const std::vector<UsbEndpointNode> &UsbDescriptorTree::GetEndpoints() const
+{
+    return endpoints_;
+}
+} // namespace USB
+} // namespace OHOS
@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_event_dispatcher.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstdio>
+#include <pthread.h>
+#include <string>
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace USB {
+constexpr const char *WORKER_NAME_PREFIX = "usb_dev_evt_";
+
+UsbDeviceEventDispatcher::UsbDeviceEventDispatcher(size_t workerNum)
+{
+    for (size_t i = 0; i < workerNum; ++i) {
+        workers_.emplace_back([this, i]() {
+            std::string name = WORKER_NAME_PREFIX + std::to_string(i);
+            pthread_setname_np(pthread_self(), name.c_str());
+            WorkLoop();
+        });
+    }
+}
+
+UsbDeviceEventDispatcher::~UsbDeviceEventDispatcher()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    for (auto &worker : workers_) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+void UsbDeviceEventDispatcher::Dispatch(uint16_t key, std::function<void()> task)
+{
+    if (task == nullptr) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        if (pendingCount_ == 0) {
+            burstStart_ = std::chrono::steady_clock::now();
+            burstSize_ = 0;
+        }
+        ++pendingCount_;
+        ++burstSize_;
+        auto &queue = pendingTasks_[key];
+        queue.push_back(std::move(task));
+        if (queue.size() > 1) {
+            /* a worker is busy with this key, it reschedules the key when done */
+            return;
+        }
+        readyKeys_.push_back(key);
+    }
+    cond_.notify_one();
+}
+
+void UsbDeviceEventDispatcher::WorkLoop()
+{
+    while (true) {
+        uint16_t key = 0;
+        std::function<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cond_.wait(lock, [this]() { return stop_ || !readyKeys_.empty(); });
+            if (stop_) {
+                return;
+            }
+            key = readyKeys_.front();
+            readyKeys_.pop_front();
+            task = pendingTasks_[key].front();
+        }
+        task();
+        OnTaskDone(key);
+    }
+}
+
+void UsbDeviceEventDispatcher::OnTaskDone(uint16_t key)
+{
+    bool rescheduled = false;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = pendingTasks_.find(key);
+        if (it != pendingTasks_.end()) {
+            it->second.pop_front();
+            if (it->second.empty()) {
+                pendingTasks_.erase(it);
+            } else {
+                readyKeys_.push_back(key);
+                rescheduled = true;
+            }
+        }
+        if (--pendingCount_ == 0) {
+            lastSettleTimeMs_ = std::chrono::duration_cast<std::chrono::milliseconds>(
+                std::chrono::steady_clock::now() - burstStart_).count();
+            maxSettleTimeMs_ = std::max(maxSettleTimeMs_, lastSettleTimeMs_);
+            lastBurstSize_ = burstSize_;
+            USB_HILOGI(MODULE_USB_SERVICE, "device event burst settled, events:%{public}u cost:%{public}" PRId64 "ms",
+                lastBurstSize_, lastSettleTimeMs_);
+        }
+    }
+    if (rescheduled) {
+        cond_.notify_one();
+    }
+}
+
+int64_t UsbDeviceEventDispatcher::GetLastSettleTimeMs()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return lastSettleTimeMs_;
+}
+
+int64_t UsbDeviceEventDispatcher::GetMaxSettleTimeMs()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return maxSettleTimeMs_;
+}
+
+uint32_t UsbDeviceEventDispatcher::GetLastBurstSize()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return lastBurstSize_;
+}
+
+void UsbDeviceEventDispatcher::Dump(int32_t fd)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    dprintf(fd, "hot-plug events: pending %zu, last burst %u events settled in %" PRId64 " ms, "
+        "max settle %" PRId64 " ms\n", pendingCount_, lastBurstSize_, lastSettleTimeMs_, maxSettleTimeMs_);
+}
+} // namespace USB
+} // namespace OHOS
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_io_executor.h"
+
+#include <chrono>
+#include <cstdio>
+#include <pthread.h>
+#include <vector>
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace USB {
+constexpr uint32_t LANE_KEY_BUS_SHIFT = 16;
+constexpr uint32_t LANE_KEY_DEV_SHIFT = 8;
+constexpr size_t LANE_NAME_SIZE = 16;
+
+static uint32_t GetLaneKey(uint8_t busNum, uint8_t devAddr, uint8_t lane)
+{
+    return (static_cast<uint32_t>(busNum) << LANE_KEY_BUS_SHIFT) |
+        (static_cast<uint32_t>(devAddr) << LANE_KEY_DEV_SHIFT) | lane;
+}
+
+UsbDeviceIoExecutor::UsbDeviceIoExecutor(size_t laneLimit, size_t queueLimit, uint32_t idleTimeoutMs)
+    : laneLimit_(laneLimit), queueLimit_(queueLimit), idleTimeoutMs_(idleTimeoutMs)
+{
+}
+
+UsbDeviceIoExecutor::~UsbDeviceIoExecutor()
+{
+    std::vector<Lane *> lanes;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+        for (auto &[key, lane] : lanes_) {
+            lane->cond.notify_all();
+            lanes.push_back(lane.get());
+        }
+    }
+    /* no lane is added or removed once stop_ is set, the workers need the lock to leave their loop */
+    for (Lane *lane : lanes) {
+        if (lane->worker.joinable()) {
+            lane->worker.join();
+        }
+    }
+}
+
+bool UsbDeviceIoExecutor::Post(uint8_t busNum, uint8_t devAddr, uint8_t lane, std::function<void()> task)
+{
+    if (task == nullptr) {
+        return false;
+    }
+    uint32_t key = GetLaneKey(busNum, devAddr, lane);
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (stop_) {
+        return false;
+    }
+    auto it = lanes_.find(key);
+    if (it != lanes_.end() && it->second->running) {
+        if (it->second->tasks.size() >= queueLimit_) {
+            return false;
+        }
+        it->second->tasks.push_back(std::move(task));
+        it->second->cond.notify_one();
+        return true;
+    }
+    ReapIdleLanes();
+    if (runningLanes_ >= laneLimit_) {
+        USB_HILOGW(MODULE_USB_SERVICE, "all %{public}zu io lanes are busy, %{public}u-%{public}u lane:0x%{public}02x",
+            runningLanes_, busNum, devAddr, lane);
+        return false;
+    }
+    auto newLane = std::make_unique<Lane>();
+    Lane *raw = newLane.get();
+    raw->tasks.push_back(std::move(task));
+    raw->running = true;
+    ++runningLanes_;
+    raw->worker = std::thread([this, key, raw]() {
+        char name[LANE_NAME_SIZE] = {0};
+        (void)snprintf(name, sizeof(name), "usbio_%06x", key);
+        pthread_setname_np(pthread_self(), name);
+        WorkLoop(*raw);
+    });
+    lanes_.emplace(key, std::move(newLane));
+    return true;
+}
+
+void UsbDeviceIoExecutor::WorkLoop(Lane &lane)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+        bool woken = lane.cond.wait_for(lock, std::chrono::milliseconds(idleTimeoutMs_),
+            [this, &lane]() { return stop_ || !lane.tasks.empty(); });
+        if (!woken || stop_) {
+            break;
+        }
+        std::function<void()> task = std::move(lane.tasks.front());
+        lane.tasks.pop_front();
+        lock.unlock();
+        task();
+        lock.lock();
+    }
+    /* the tasks left behind on stop are dropped, their callers find the service gone */
+    lane.tasks.clear();
+    lane.running = false;
+    --runningLanes_;
+}
+
+void UsbDeviceIoExecutor::ReapIdleLanes()
+{
+    for (auto it = lanes_.begin(); it != lanes_.end();) {
+        if (it->second->running) {
+            ++it;
+            continue;
+        }
+        /* the worker left its loop under the lock and touches nothing after, joining here cannot block on it */
+        if (it->second->worker.joinable()) {
+            it->second->worker.join();
+        }
+        it = lanes_.erase(it);
+    }
+}
+
+size_t UsbDeviceIoExecutor::GetRunningLaneCount()
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    return runningLanes_;
+}
+} // namespace USB
+} // namespace OHOS
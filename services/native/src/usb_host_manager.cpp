@@ -12,6 +12,8 @@
  * See the License for the specific language governing permissions and
  * limitations under the License.
  */
+#include <algorithm>
+#include <chrono>
 #include <iostream>
 #include <sstream>
 #include <iomanip>
@@ -20,7 +22,12 @@
 #include <set>
 #include <thread>
 #include <ipc_skeleton.h>
-#include <iconv.h>
+#include <cerrno>
+#include <cinttypes>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <sys/mman.h>
+#include <unistd.h>
 
 #include "usb_host_manager.h"
 #include "common_event_data.h"
@@ -40,10 +47,15 @@
 #include "usbd_bulkcallback_impl.h"
 #include "usb_descriptor_parser.h"
 #include "usbd_transfer_callback_impl.h"
+#include "usb_batch_transfer_callback_impl.h"
 #include "usb_napi_errors.h"
 #include "accesstoken_kit.h"
 #include "usb_connection_notifier.h"
 #include "securec.h"
+#include "string_ex.h"
+#include "struct_parcel.h"
+#include "usb_device_snapshot.h"
+#include "usb_transfer_stats.h"
 
 using namespace OHOS::AAFwk;
 using namespace OHOS::EventFwk;
@@ -58,8 +70,23 @@ constexpr uint8_t DES_USAGE_IN_INTERFACE = 0x02;
 constexpr int32_t BCD_HEX_DIGITS = 4;
 constexpr int LAST_FIVE = 5;
 constexpr int BOM_BYTE_COUNT = 2;
-constexpr int INVALID_RET = -1;
-constexpr int BYTES_PER_UTF8_CHAR = 4;
+constexpr size_t UTF8_MAX_BYTES = 4;
+constexpr uint32_t UTF8_CONT_MASK = 0x3F;
+constexpr uint32_t UTF8_CONT_MARK = 0x80;
+constexpr uint32_t UTF8_CONT_BITS = 6;
+constexpr uint32_t BITS_PER_BYTE = 8;
+constexpr uint32_t UTF16_HIGH_SURROGATE_START = 0xD800;
+constexpr uint32_t UTF16_HIGH_SURROGATE_END = 0xDBFF;
+constexpr uint32_t UTF16_LOW_SURROGATE_START = 0xDC00;
+constexpr uint32_t UTF16_LOW_SURROGATE_END = 0xDFFF;
+constexpr uint32_t UTF16_SURROGATE_BASE = 0x10000;
+constexpr uint32_t UTF16_SURROGATE_BITS = 10;
+constexpr uint32_t UNICODE_REPLACEMENT_CHAR = 0xFFFD;
+constexpr size_t DEV_STRING_CACHE_MAX_SIZE = 64;
+constexpr const char *DEV_STRING_PLACEHOLDER = " ";
+constexpr const char *DEVICES_SNAPSHOT_ASHMEM_NAME = "usb_devices_snapshot";
+constexpr size_t REMOVED_DEVICES_MAX_SIZE = 64;
+constexpr uint32_t DEVICES_GENERATION_EPOCH_SHIFT = 32;
 std::map<int32_t, DeviceClassUsage> deviceUsageMap = {
     {0x00, {DeviceClassUsage(2, "Use class information in the Interface Descriptors")}},
     {0x01, {DeviceClassUsage(2, "Audio")}},
@@ -101,9 +128,6 @@ constexpr uint32_t USB_STORAGE_DEVICE_ACCESS_POLICY = 1026;
 constexpr uint32_t USB_DEVICE_ACCESS_POLICY = 1059;
 constexpr int32_t TRUSTLIST_POLICY_MAX_DEVICES = 1000;
 constexpr uint32_t EDM_SA_TIME_OUT_CODE = 9200007;
-constexpr int32_t BASECLASS_INDEX = 0;
-constexpr int32_t SUBCLASS_INDEX = 1;
-constexpr int32_t PROTOCAL_INDEX = 2;
 constexpr int32_t STORAGE_BASE_CLASS = 8;
 constexpr int32_t GET_EDM_STORAGE_DISABLE_TYPE = 2;
 constexpr int32_t RANDOM_VALUE_INDICATE = -1;
@@ -111,15 +135,43 @@ constexpr int32_t BASE_CLASS_AUDIO = 0x01;
 constexpr int32_t BASE_CLASS_HUB = 0x09;
 constexpr int32_t RETRY_NUM = 10;
 constexpr uint32_t RETRY_INTERVAL = 100;
+constexpr int32_t DEV_PATH_WAIT_TIMEOUT = RETRY_NUM * RETRY_INTERVAL;
+constexpr uint32_t DEV_PATH_WATCH_MASK = IN_CREATE | IN_ATTRIB | IN_MOVED_TO;
+constexpr size_t INOTIFY_EVENT_BUF_SIZE = 4096;
 constexpr uint32_t USB_PATH_LENGTH = 64;
 constexpr const char* USB_DEV_FS_PATH = "/dev/bus/usb";
+constexpr uint32_t SESSION_KEY_TOKEN_SHIFT = 16;
+constexpr uint32_t SESSION_KEY_BUS_SHIFT = 8;
+constexpr uint64_t SESSION_KEY_BUS_DEV_MASK = 0xFFFF;
+constexpr uint32_t BULK_BUFFER_KEY_TOKEN_SHIFT = 24;
+constexpr uint32_t BULK_BUFFER_KEY_BUS_SHIFT = 16;
+constexpr uint32_t BULK_BUFFER_KEY_DEV_SHIFT = 8;
+constexpr uint64_t BULK_BUFFER_KEY_BUS_DEV_MASK = 0xFFFF00;
+constexpr size_t BULK_BUFFER_MAX_PER_TOKEN = 32;
+constexpr uint32_t BUS_DEV_KEY_BUS_SHIFT = 8;
+constexpr uint32_t VID_PID_KEY_VID_SHIFT = 16;
+constexpr uint32_t VID_PID_KEY_MASK = 0xFFFF;
+constexpr const char* BATCH_TRANSFER_ASHMEM_NAME = "usb_batch_transfer";
+constexpr uint32_t POLICY_SETTLE_MS = 1000;
 #ifdef USB_MANAGER_PASS_THROUGH
 const std::string SERVICE_NAME = "usb_host_interface_service";
 #endif // USB_MANAGER_PASS_THROUGH
+/* the start time in seconds goes into the high half, generations of an earlier start then compare lower */
+static uint64_t GetDevicesGenerationSeed()
+{
+    uint64_t epoch = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count()) & UINT32_MAX;
+    return (epoch << DEVICES_GENERATION_EPOCH_SHIFT) | 1;
+}
+
 UsbHostManager::UsbHostManager(SystemAbility *systemAbility)
 {
     systemAbility_ = systemAbility;
     usbRightManager_ = std::make_shared<UsbRightManager>();
+    uint64_t seed = GetDevicesGenerationSeed();
+    devicesGeneration_.store(seed);
+    /* removals before this start are not logged, a caller that last synced before it needs a full sync */
+    removedDevicesFloor_ = seed;
 #ifndef USB_MANAGER_PASS_THROUGH
     usbd_ = OHOS::HDI::Usb::V1_2::IUsbInterface::Get();
     USB_HILOGI(MODULE_USB_HOST, "%{public}s:%{public}d usbd_ == nullptr: %{public}d",
@@ -134,6 +186,7 @@ UsbHostManager::~UsbHostManager()
         delete pair.second;
     }
     devices_.clear();
+    vidPidIndex_.clear();
 }
 
 #ifdef USB_MANAGER_PASS_THROUGH
@@ -193,17 +246,27 @@ int32_t UsbHostManager::UnbindUsbdSubscriber(const sptr<HDI::Usb::V2_0::IUsbdSub
 void UsbHostManager::UsbSubmitTransferDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &object)
 {
     USB_HILOGI(MODULE_USB_HOST, "UsbHostManager UsbSubmitTransferDeathRecipient enter");
-    int32_t ret = service_->UsbCancelTransfer(devInfo_, endpoint_);
-    if (ret == UEC_OK) {
+    bool cancelled = false;
+    for (int32_t endpoint : endpoints_) {
+        cancelled = (service_->UsbCancelTransfer(devInfo_, endpoint) == UEC_OK) || cancelled;
+    }
+    if (cancelled) {
         USB_HILOGI(MODULE_USB_HOST, "UsbHostManager OnRemoteDied Close.");
         service_->Close(devInfo_.busNum, devInfo_.devAddr);
     }
 }
 
+void UsbHostManager::UsbBufferOwnerDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &object)
+{
+    USB_HILOGI(MODULE_USB_HOST, "UsbHostManager UsbBufferOwnerDeathRecipient enter");
+    service_->RemoveTokenTransferBuffers(tokenId_);
+}
+
 void UsbHostManager::UsbEdmLoadCallback::OnLoadSystemAbilitySuccess(
     int32_t systemAbilityId, const sptr<IRemoteObject>& remoteObject)
 {
     USB_HILOGI(MODULE_USB_HOST, "UsbHostManager Load SA success, systemAbilityId = [%{public}d]", systemAbilityId);
+    usbHostManager_ -> InvalidateUsbPolicySnapshot();
     usbHostManager_ -> ExecuteStrategy();
 }
 
@@ -220,18 +283,15 @@ void UsbHostManager::ExecuteStrategy()
         USB_HILOGE(MODULE_USB_HOST, "edm is not activate, skip");
         return;
     }
-    bool isGlobalDisabled = false;
-    std::vector<UsbDeviceType> disableType{};
-    std::vector<UsbDeviceId> trustUsbDeviceIds{};
-
-    int32_t ret = GetUsbPolicy(isGlobalDisabled, disableType, trustUsbDeviceIds);
+    UsbPolicySnapshot policy;
+    int32_t ret = GetUsbPolicySnapshot(policy);
     if (ret == UEC_SERVICE_EDM_SA_TIME_OUT_FAILED || ret == UEC_SERVICE_PREPARE_EDM_SA_FAILED) {
         USB_HILOGE(MODULE_USB_HOST, "EDM sa time out or prepare failed, ret = %{public}d", ret);
         return;
     }
 
-    if (isGlobalDisabled) {
-        ret = ManageGlobalInterfaceImpl(isGlobalDisabled);
+    if (policy.isGlobalDisabled) {
+        ret = ManageGlobalInterfaceImpl(policy.isGlobalDisabled);
         if (ret != UEC_OK) {
             USB_HILOGE(MODULE_USB_HOST, "ManageGlobalInterface failed");
         }
@@ -245,19 +305,19 @@ void UsbHostManager::ExecuteStrategy()
         }
     }
 
-    if (!disableType.empty()) {
-        ret = ExecuteManageInterfaceType(disableType, true);
+    if (!policy.disableType.empty()) {
+        ret = ExecuteManageInterfaceType(*policy.matcher, true);
         if (ret != UEC_OK) {
             USB_HILOGE(MODULE_USB_HOST, "ExecuteManageInterfaceType failed");
         }
         return;
     }
 
-    if (trustUsbDeviceIds.empty()) {
+    if (policy.trustUsbDeviceIds.empty()) {
         USB_HILOGI(MODULE_USB_HOST, "trustUsbDeviceIds is empty, no devices disable");
         return;
     }
-    ret = ExecuteManageDevicePolicy(trustUsbDeviceIds);
+    ret = ExecuteManageDevicePolicy(*policy.matcher);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_HOST, "ExecuteManageDevicePolicy failed");
     }
@@ -399,23 +459,38 @@ int32_t UsbHostManager::SetActiveConfig(uint8_t busNum, uint8_t devAddr, uint8_t
 
 int32_t UsbHostManager::ManageGlobalInterface(bool disable)
 {
-    return ManageGlobalInterfaceImpl(disable);
+    BeginUsbPolicyChange();
+    int32_t ret = ManageGlobalInterfaceImpl(disable);
+    EndUsbPolicyChange();
+    return ret;
 }
 
 int32_t UsbHostManager::ManageDevice(int32_t vendorId, int32_t productId, bool disable)
 {
-    std::shared_lock lock(devicesMutex_);
-    return ManageDeviceImpl(vendorId, productId, disable);
+    BeginUsbPolicyChange();
+    int32_t ret = UEC_OK;
+    {
+        std::shared_lock lock(devicesMutex_);
+        ret = ManageDeviceImpl(vendorId, productId, disable);
+    }
+    EndUsbPolicyChange();
+    return ret;
 }
 
 int32_t UsbHostManager::ManageDevicePolicy(std::vector<UsbDeviceId> &trustList)
 {
-    return ExecuteManageDevicePolicy(trustList);
+    BeginUsbPolicyChange();
+    int32_t ret = ExecuteManageDevicePolicy(trustList);
+    EndUsbPolicyChange();
+    return ret;
 }
 
 int32_t UsbHostManager::ManageInterfaceType(const std::vector<UsbDeviceType> &disableType, bool disable)
 {
-    return ExecuteManageInterfaceType(disableType, disable);
+    BeginUsbPolicyChange();
+    int32_t ret = ExecuteManageInterfaceType(disableType, disable);
+    EndUsbPolicyChange();
+    return ret;
 }
 
 int32_t UsbHostManager::UsbAttachKernelDriver(uint8_t busNum, uint8_t devAddr, uint8_t interfaceid)
@@ -479,17 +554,30 @@ int32_t UsbHostManager::ClearHalt(uint8_t busNum, uint8_t devAddr, uint8_t inter
 #endif // USB_MANAGER_PASS_THROUGH
 }
 
+void UsbHostManager::GetDevicesInBusDevOrder(std::vector<UsbDevice *> &devices)
+{
+    std::vector<std::pair<uint16_t, UsbDevice *>> entries(devices_.begin(), devices_.end());
+    /* the table is hashed, callers have always seen the devices listed by bus and address */
+    std::sort(entries.begin(), entries.end(),
+        [](const auto &lhs, const auto &rhs) { return lhs.first < rhs.first; });
+    devices.reserve(entries.size());
+    for (const auto &entry : entries) {
+        devices.push_back(entry.second);
+    }
+}
+
 int32_t UsbHostManager::GetDevices(std::vector<UsbDevice> &deviceList)
 {
     std::shared_lock lock(devicesMutex_);
     USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu", devices_.size());
     bool isSystemAppOrSa = usbRightManager_->IsSystemAppOrSa();
-    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        if ((it->second->GetClass() == BASE_CLASS_HUB && !isSystemAppOrSa) ||
-            it->second->GetAuthorizeStatus() != ENABLED) {
+    std::vector<UsbDevice *> devices;
+    GetDevicesInBusDevOrder(devices);
+    for (UsbDevice *device : devices) {
+        if ((device->GetClass() == BASE_CLASS_HUB && !isSystemAppOrSa) || device->GetAuthorizeStatus() != ENABLED) {
             continue;
         }
-        auto dev = UsbDevice(*it->second);
+        auto dev = UsbDevice(*device);
         if (!(isSystemAppOrSa)) {
             dev.SetmSerial("");
         }
@@ -498,6 +586,135 @@ int32_t UsbHostManager::GetDevices(std::vector<UsbDevice> &deviceList)
     return UEC_OK;
 }
 
+void UsbHostManager::MarkDevicesChanged(uint16_t busDev, DeviceChangeType type)
+{
+    std::lock_guard<std::mutex> guard(generationMutex_);
+    uint64_t generation = devicesGeneration_.fetch_add(1) + 1;
+    switch (type) {
+        case DeviceChangeType::ADDED:
+            deviceGenerations_[busDev] = {generation, generation};
+            break;
+        case DeviceChangeType::CHANGED:
+            deviceGenerations_[busDev].changed = generation;
+            break;
+        case DeviceChangeType::REMOVED:
+            deviceGenerations_.erase(busDev);
+            removedDevices_.emplace_back(generation, busDev);
+            if (removedDevices_.size() > REMOVED_DEVICES_MAX_SIZE) {
+                removedDevicesFloor_ = removedDevices_.front().first;
+                removedDevices_.pop_front();
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+int32_t UsbHostManager::GetDeviceGeneration(uint64_t &generation)
+{
+    generation = devicesGeneration_.load();
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync,
+    std::vector<UsbDevice> &added, std::vector<UsbDevice> &changed, std::vector<std::string> &removed)
+{
+    bool isSystemAppOrSa = usbRightManager_->IsSystemAppOrSa();
+    std::shared_lock lock(devicesMutex_);
+    std::lock_guard<std::mutex> guard(generationMutex_);
+    generation = devicesGeneration_.load();
+    /* a generation from before a service restart or older than the removal log cannot be answered as a delta */
+    fullSync = since == 0 || since > generation || since < removedDevicesFloor_;
+    if (!fullSync && since == generation) {
+        return UEC_OK;
+    }
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        UsbDevice *dev = it->second;
+        if (dev == nullptr || (dev->GetClass() == BASE_CLASS_HUB && !isSystemAppOrSa)) {
+            continue;
+        }
+        auto genIter = deviceGenerations_.find(it->first);
+        DeviceGeneration gen = genIter == deviceGenerations_.end() ? DeviceGeneration {generation, generation} :
+            genIter->second;
+        if (!fullSync && gen.changed <= since) {
+            continue;
+        }
+        if (dev->GetAuthorizeStatus() != ENABLED) {
+            // a device that turned invisible is gone as far as the caller is concerned
+            if (!fullSync) {
+                removed.push_back(dev->GetName());
+            }
+            continue;
+        }
+        std::vector<UsbDevice> &target = (fullSync || gen.added > since) ? added : changed;
+        target.push_back(*dev);
+        if (!isSystemAppOrSa) {
+            target.back().SetmSerial("");
+        }
+    }
+    if (!fullSync) {
+        for (auto it = removedDevices_.rbegin(); it != removedDevices_.rend() && it->first > since; ++it) {
+            removed.push_back(std::to_string(it->second >> BUS_DEV_KEY_BUS_SHIFT) + "-" +
+                std::to_string(it->second & UINT8_MAX));
+        }
+    }
+    USB_HILOGD(MODULE_USB_HOST, "since %{public}" PRIu64 " to %{public}" PRIu64 " full:%{public}d added:%{public}zu"
+        " changed:%{public}zu removed:%{public}zu", since, generation, fullSync, added.size(), changed.size(),
+        removed.size());
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::GetDevicesSnapshot(int32_t &fd, uint32_t &size, uint64_t &sequence)
+{
+    bool isSystemAppOrSa = usbRightManager_->IsSystemAppOrSa();
+    std::lock_guard<std::mutex> guard(devicesSnapshotMutex_);
+    DevicesSnapshotCache &cache = devicesSnapshots_[isSystemAppOrSa ? 1 : 0];
+    uint64_t current = devicesGeneration_.load();
+    if (cache.ashmem == nullptr || cache.sequence != current) {
+        UsbDeviceSnapshotWriter writer;
+        {
+            std::shared_lock lock(devicesMutex_);
+            /* sample under the lock so a change racing with the build forces the next call to rebuild */
+            current = devicesGeneration_.load();
+            std::vector<UsbDevice *> devices;
+            GetDevicesInBusDevOrder(devices);
+            for (UsbDevice *device : devices) {
+                if ((device->GetClass() == BASE_CLASS_HUB && !isSystemAppOrSa) ||
+                    device->GetAuthorizeStatus() != ENABLED) {
+                    continue;
+                }
+                writer.AddDevice(*device, isSystemAppOrSa);
+            }
+        }
+        std::vector<uint8_t> encoded = writer.Finish(current);
+        sptr<Ashmem> ashmem = Ashmem::CreateAshmem(DEVICES_SNAPSHOT_ASHMEM_NAME, encoded.size());
+        if (ashmem == nullptr || !ashmem->MapReadAndWriteAshmem()) {
+            USB_HILOGE(MODULE_USB_HOST, "create devices snapshot failed, size:%{public}zu", encoded.size());
+            return UEC_SERVICE_NO_MEMORY;
+        }
+        bool written = ashmem->WriteToAshmem(encoded.data(), encoded.size(), 0);
+        ashmem->UnmapAshmem();
+        /* published snapshots never change, clients may keep an old mapping for as long as they like */
+        if (!written || !ashmem->SetProtection(PROT_READ)) {
+            USB_HILOGE(MODULE_USB_HOST, "seal devices snapshot failed");
+            ashmem->CloseAshmem();
+            return UEC_SERVICE_INNER_ERR;
+        }
+        if (cache.ashmem != nullptr) {
+            cache.ashmem->CloseAshmem();
+        }
+        cache.ashmem = ashmem;
+        cache.size = static_cast<uint32_t>(encoded.size());
+        cache.sequence = current;
+        USB_HILOGI(MODULE_USB_HOST, "devices snapshot rebuilt, sequence:%{public}" PRIu64 " size:%{public}u",
+            current, cache.size);
+    }
+    fd = cache.ashmem->GetAshmemFd();
+    size = cache.size;
+    sequence = cache.sequence;
+    return UEC_OK;
+}
+
 int32_t UsbHostManager::CheckDevPathIsExist(uint8_t busNum, uint8_t devAddr)
 {
     char path[USB_PATH_LENGTH] = {"\0"};
@@ -524,19 +741,82 @@ int32_t UsbHostManager::CheckDevPathIsExist(uint8_t busNum, uint8_t devAddr)
     return UEC_OK;
 }
 
+int32_t UsbHostManager::WaitDevPathReadyByPoll(uint8_t busNum, uint8_t devAddr, int32_t timeoutMs)
+{
+    int32_t ret = CheckDevPathIsExist(busNum, devAddr);
+    for (int32_t waited = 0; ret != UEC_OK && waited < timeoutMs; waited += static_cast<int32_t>(RETRY_INTERVAL)) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(RETRY_INTERVAL));
+        ret = CheckDevPathIsExist(busNum, devAddr);
+    }
+    return ret;
+}
+
+int32_t UsbHostManager::WaitDevPathReady(uint8_t busNum, uint8_t devAddr, int32_t timeoutMs)
+{
+    if (CheckDevPathIsExist(busNum, devAddr) == UEC_OK) {
+        return UEC_OK;
+    }
+    char busPath[USB_PATH_LENGTH] = {"\0"};
+    if (sprintf_s(busPath, sizeof(busPath), "%s/%03u", USB_DEV_FS_PATH, busNum) < 0) {
+        return WaitDevPathReadyByPoll(busNum, devAddr, timeoutMs);
+    }
+    int32_t fd = inotify_init1(IN_CLOEXEC | IN_NONBLOCK);
+    if (fd < 0) {
+        USB_HILOGW(MODULE_USB_HOST, "inotify_init1 failed, errno: %{public}d", errno);
+        return WaitDevPathReadyByPoll(busNum, devAddr, timeoutMs);
+    }
+    /* the bus directory itself may not exist yet when the first device on a bus attaches */
+    int32_t rootWd = inotify_add_watch(fd, USB_DEV_FS_PATH, IN_CREATE | IN_MOVED_TO);
+    int32_t busWd = inotify_add_watch(fd, busPath, DEV_PATH_WATCH_MASK);
+    /* with the bus directory present but unwatched no event would ever arrive for the device node */
+    if ((rootWd < 0 && busWd < 0) || (busWd < 0 && access(busPath, F_OK) == 0)) {
+        USB_HILOGW(MODULE_USB_HOST, "inotify_add_watch failed, errno: %{public}d", errno);
+        close(fd);
+        return WaitDevPathReadyByPoll(busNum, devAddr, timeoutMs);
+    }
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+    int32_t ret = CheckDevPathIsExist(busNum, devAddr);
+    char buf[INOTIFY_EVENT_BUF_SIZE] __attribute__((aligned(__alignof__(struct inotify_event))));
+    while (ret != UEC_OK) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+            deadline - std::chrono::steady_clock::now()).count();
+        if (remaining <= 0) {
+            break;
+        }
+        struct pollfd pfd = {fd, POLLIN, 0};
+        int32_t pollRet = poll(&pfd, 1, static_cast<int32_t>(remaining));
+        if (pollRet < 0 && errno != EINTR) {
+            USB_HILOGW(MODULE_USB_HOST, "poll failed, errno: %{public}d", errno);
+            break;
+        }
+        if (pollRet > 0) {
+            while (read(fd, buf, sizeof(buf)) > 0) {}
+        }
+        if (busWd < 0) {
+            busWd = inotify_add_watch(fd, busPath, DEV_PATH_WATCH_MASK);
+        }
+        ret = CheckDevPathIsExist(busNum, devAddr);
+        if (ret != UEC_OK && busWd < 0 && access(busPath, F_OK) == 0) {
+            USB_HILOGW(MODULE_USB_HOST, "watch bus dir failed, errno: %{public}d", errno);
+            remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+                deadline - std::chrono::steady_clock::now()).count();
+            close(fd);
+            return WaitDevPathReadyByPoll(busNum, devAddr, static_cast<int32_t>(std::max<int64_t>(remaining, 0)));
+        }
+    }
+    close(fd);
+    return ret;
+}
+
 int32_t UsbHostManager::GetDeviceInfo(uint8_t busNum, uint8_t devAddr, UsbDevice &dev)
 {
     const UsbDev uDev = {busNum, devAddr};
     std::vector<uint8_t> descriptor;
 
     int32_t res = UEC_OK;
-    int32_t ret = UEC_OK;
-    for (int32_t i = 0; i < RETRY_NUM; i++) {
-        ret = CheckDevPathIsExist(busNum, devAddr);
-        if (ret == UEC_OK) {
-            break;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(RETRY_INTERVAL));
+    int32_t ret = WaitDevPathReady(busNum, devAddr, DEV_PATH_WAIT_TIMEOUT);
+    if (ret != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "GetDeviceInfo dev path not ready ret=%{public}d", ret);
     }
     ret = OpenDevice(busNum, devAddr);
     if (ret != UEC_OK) {
@@ -956,6 +1236,8 @@ int32_t UsbHostManager::UsbSubmitTransfer(const HDI::Usb::V1_0::UsbDev &devInfo,
     const sptr<IRemoteObject> &cb, sptr<Ashmem> &ashmem)
 {
     int32_t ret = UEC_SERVICE_INVALID_VALUE;
+    UsbTransferProbe probe = UsbTransferStats::Begin(devInfo.busNum, devInfo.devAddr,
+        static_cast<uint8_t>(info.endpoint), UsbTransferStats::KindOfType(info.type));
 #ifdef USB_MANAGER_PASS_THROUGH
     if (usbHostInterface_ == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "UsbHostManager::UsbSubmitTransfer usbHostInterface_ is nullptr");
@@ -967,7 +1249,7 @@ int32_t UsbHostManager::UsbSubmitTransfer(const HDI::Usb::V1_0::UsbDev &devInfo,
         USB_HILOGE(MODULE_USB_HOST, "add DeathRecipient failed");
         return UEC_SERVICE_INVALID_VALUE;
     }
-    sptr<UsbTransferCallbackImpl> callbackImpl = new UsbTransferCallbackImpl(cb);
+    sptr<UsbTransferCallbackImpl> callbackImpl = new UsbTransferCallbackImpl(cb, probe);
     const HDI::Usb::V2_0::UsbDev &usbDev_ = reinterpret_cast<const HDI::Usb::V2_0::UsbDev &>(devInfo);
     const HDI::Usb::V2_0::USBTransferInfo &usbInfo = reinterpret_cast<const HDI::Usb::V2_0::USBTransferInfo &>(info);
     ret = usbHostInterface_->UsbSubmitTransfer(usbDev_, usbInfo, callbackImpl, ashmem);
@@ -982,7 +1264,7 @@ int32_t UsbHostManager::UsbSubmitTransfer(const HDI::Usb::V1_0::UsbDev &devInfo,
         USB_HILOGE(MODULE_USB_HOST, "add DeathRecipient failed");
         return UEC_SERVICE_INVALID_VALUE;
     }
-    sptr<UsbdTransferCallbackImpl> callbackImpl = new UsbdTransferCallbackImpl(cb);
+    sptr<UsbdTransferCallbackImpl> callbackImpl = new UsbdTransferCallbackImpl(cb, probe);
     ret = usbd_->UsbSubmitTransfer(devInfo, info, callbackImpl, ashmem);
 #endif // USB_MANAGER_PASS_THROUGH
     if (ret != UEC_OK) {
@@ -994,6 +1276,111 @@ int32_t UsbHostManager::UsbSubmitTransfer(const HDI::Usb::V1_0::UsbDev &devInfo,
     return ret;
 }
 
+sptr<Ashmem> UsbHostManager::PrepareBatchSubTransfer(const HDI::Usb::V1_2::USBTransferInfo &info,
+    const sptr<UsbBatchTransferCollector> &collector, size_t index, int32_t offset, sptr<Ashmem> &ashmem)
+{
+    /* the HDI reads and writes a transfer buffer from its start, so each sub-transfer gets its own region */
+    sptr<Ashmem> buffer = Ashmem::CreateAshmem(BATCH_TRANSFER_ASHMEM_NAME, info.length);
+    if (buffer == nullptr || !buffer->MapReadAndWriteAshmem()) {
+        USB_HILOGE(MODULE_USB_HOST, "create sub transfer buffer failed, index=%{public}zu", index);
+        return nullptr;
+    }
+    if ((static_cast<uint32_t>(info.endpoint) & USB_ENDPOINT_DIR_MASK) == USB_ENDPOINT_DIR_OUT) {
+        const void *data = ashmem->ReadFromAshmem(info.length, offset);
+        if (data == nullptr || !buffer->WriteToAshmem(data, info.length, 0)) {
+            USB_HILOGE(MODULE_USB_HOST, "copy sub transfer data failed, index=%{public}zu", index);
+            return nullptr;
+        }
+    }
+    collector->SetSubTransfer(index, offset, info.length, buffer);
+    return buffer;
+}
+
+int32_t UsbHostManager::SubmitBatchSubTransfer(const HDI::Usb::V1_0::UsbDev &devInfo,
+    HDI::Usb::V1_2::USBTransferInfo &info, const sptr<UsbBatchTransferCollector> &collector, size_t index,
+    sptr<Ashmem> &buffer)
+{
+#ifdef USB_MANAGER_PASS_THROUGH
+    sptr<UsbBatchTransferCallbackImpl> callbackImpl = new UsbBatchTransferCallbackImpl(collector, index);
+    const HDI::Usb::V2_0::UsbDev &usbDev_ = reinterpret_cast<const HDI::Usb::V2_0::UsbDev &>(devInfo);
+    const HDI::Usb::V2_0::USBTransferInfo &usbInfo = reinterpret_cast<const HDI::Usb::V2_0::USBTransferInfo &>(info);
+    return usbHostInterface_->UsbSubmitTransfer(usbDev_, usbInfo, callbackImpl, buffer);
+#else
+    sptr<UsbdBatchTransferCallbackImpl> callbackImpl = new UsbdBatchTransferCallbackImpl(collector, index);
+    return usbd_->UsbSubmitTransfer(devInfo, info, callbackImpl, buffer);
+#endif // USB_MANAGER_PASS_THROUGH
+}
+
+int32_t UsbHostManager::UsbSubmitTransferBatch(const HDI::Usb::V1_0::UsbDev &devInfo,
+    std::vector<HDI::Usb::V1_2::USBTransferInfo> &infos, const sptr<IRemoteObject> &cb, sptr<Ashmem> &ashmem)
+{
+#ifdef USB_MANAGER_PASS_THROUGH
+    if (usbHostInterface_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbHostManager::UsbSubmitTransferBatch usbHostInterface_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+#else
+    if (usbd_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbHostManager::UsbSubmitTransferBatch usbd_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+#endif // USB_MANAGER_PASS_THROUGH
+    if (cb == nullptr || ashmem == nullptr || infos.empty() || !ashmem->MapReadAndWriteAshmem()) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbHostManager::UsbSubmitTransferBatch invalid param");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    std::vector<int32_t> endpoints;
+    for (const auto &info : infos) {
+        if (std::find(endpoints.begin(), endpoints.end(), info.endpoint) == endpoints.end()) {
+            endpoints.push_back(info.endpoint);
+        }
+    }
+    sptr<UsbHostManager::UsbSubmitTransferDeathRecipient> submitRecipient =
+        new UsbSubmitTransferDeathRecipient(devInfo, endpoints, this, cb);
+    if (!cb->AddDeathRecipient(submitRecipient)) {
+        USB_HILOGE(MODULE_USB_HOST, "add DeathRecipient failed");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    sptr<UsbBatchTransferCollector> collector = new UsbBatchTransferCollector(cb, ashmem, infos.size());
+    /* every buffer is ready before the first submission, a failure here leaves nothing in flight */
+    std::vector<sptr<Ashmem>> buffers(infos.size());
+    int32_t offset = 0;
+    for (size_t i = 0; i < infos.size(); ++i) {
+        buffers[i] = PrepareBatchSubTransfer(infos[i], collector, i, offset, ashmem);
+        if (buffers[i] == nullptr) {
+            collector->Abort();
+            cb->RemoveDeathRecipient(submitRecipient);
+            submitRecipient.clear();
+            return UEC_SERVICE_INVALID_VALUE;
+        }
+        offset += infos[i].length;
+    }
+    int32_t ret = UEC_OK;
+    size_t submitted = 0;
+    for (; submitted < infos.size(); ++submitted) {
+        ret = SubmitBatchSubTransfer(devInfo, infos[submitted], collector, submitted, buffers[submitted]);
+        if (ret != UEC_OK) {
+            break;
+        }
+    }
+    if (ret == UEC_OK) {
+        return UEC_OK;
+    }
+    USB_HILOGE(MODULE_USB_HOST, "UsbSubmitTransferBatch error ret:%{public}d, submitted:%{public}zu", ret, submitted);
+    if (submitted == 0) {
+        collector->Abort();
+        cb->RemoveDeathRecipient(submitRecipient);
+        submitRecipient.clear();
+        return ret;
+    }
+    /*
+     * the HDI cancels whole endpoints only, which would take down transfers this batch does not own. The ones
+     * already in flight run to completion instead, the rest are reported failed in the same batch result.
+     */
+    collector->FailFrom(submitted, ret);
+    return UEC_OK;
+}
+
 int32_t UsbHostManager::RegBulkCallback(const HDI::Usb::V1_0::UsbDev &devInfo, const HDI::Usb::V1_0::UsbPipe &pipe,
     const sptr<IRemoteObject> &cb)
 {
@@ -1120,19 +1507,367 @@ int32_t UsbHostManager::BulkCancel(const HDI::Usb::V1_0::UsbDev &devInfo, const
 #endif // USB_MANAGER_PASS_THROUGH
 }
 
+uint16_t UsbHostManager::GetBusDevKey(uint8_t busNum, uint8_t devAddr)
+{
+    return static_cast<uint16_t>((static_cast<uint16_t>(busNum) << BUS_DEV_KEY_BUS_SHIFT) | devAddr);
+}
+
+bool UsbHostManager::GetBusDevKey(const std::string &deviceName, uint16_t &key)
+{
+    // deviceName is in busNum-devAddr format
+    size_t pos = deviceName.find('-');
+    if (pos == std::string::npos) {
+        return false;
+    }
+    int32_t busNum = 0;
+    int32_t devAddr = 0;
+    if (!StrToInt(deviceName.substr(0, pos), busNum) || !StrToInt(deviceName.substr(pos + 1), devAddr) ||
+        busNum < 0 || busNum > UINT8_MAX || devAddr < 0 || devAddr > UINT8_MAX) {
+        return false;
+    }
+    key = GetBusDevKey(static_cast<uint8_t>(busNum), static_cast<uint8_t>(devAddr));
+    return true;
+}
+
+uint32_t UsbHostManager::GetVidPidKey(int32_t vendorId, int32_t productId)
+{
+    return ((static_cast<uint32_t>(vendorId) & VID_PID_KEY_MASK) << VID_PID_KEY_VID_SHIFT) |
+        (static_cast<uint32_t>(productId) & VID_PID_KEY_MASK);
+}
+
+void UsbHostManager::RemoveVidPidIndex(uint16_t busDev, const UsbDevice &dev)
+{
+    auto range = vidPidIndex_.equal_range(GetVidPidKey(dev.GetVendorId(), dev.GetProductId()));
+    for (auto it = range.first; it != range.second; ++it) {
+        if (it->second == busDev) {
+            vidPidIndex_.erase(it);
+            return;
+        }
+    }
+}
+
+static uint64_t GetBulkTransferBufferKey(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    const HDI::Usb::V1_0::UsbPipe &pipe)
+{
+    return (static_cast<uint64_t>(tokenId) << BULK_BUFFER_KEY_TOKEN_SHIFT) |
+        (static_cast<uint64_t>(devInfo.busNum) << BULK_BUFFER_KEY_BUS_SHIFT) |
+        (static_cast<uint64_t>(devInfo.devAddr) << BULK_BUFFER_KEY_DEV_SHIFT) | pipe.endpointId;
+}
+
+size_t UsbHostManager::GetTokenBulkBufferCount(uint32_t tokenId)
+{
+    size_t count = 0;
+    for (const auto &[key, buffer] : bulkTransferBuffers_) {
+        if ((key >> BULK_BUFFER_KEY_TOKEN_SHIFT) == tokenId) {
+            ++count;
+        }
+    }
+    return count;
+}
+
+void UsbHostManager::ReleaseBufferOwnerIfUnused(uint32_t tokenId)
+{
+    auto owner = bufferOwners_.find(tokenId);
+    if (owner == bufferOwners_.end() || GetTokenBulkBufferCount(tokenId) != 0) {
+        return;
+    }
+    owner->second.client->RemoveDeathRecipient(owner->second.recipient);
+    bufferOwners_.erase(owner);
+}
+
+int32_t UsbHostManager::RegBulkTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    const HDI::Usb::V1_0::UsbPipe &pipe, sptr<Ashmem> &ashmem, const sptr<IRemoteObject> &client)
+{
+    if (ashmem == nullptr || client == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "RegBulkTransferBuffer invalid param");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    uint64_t key = GetBulkTransferBufferKey(tokenId, devInfo, pipe);
+    std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+    if (bulkTransferBuffers_.find(key) == bulkTransferBuffers_.end() &&
+        GetTokenBulkBufferCount(tokenId) >= BULK_BUFFER_MAX_PER_TOKEN) {
+        USB_HILOGE(MODULE_USB_HOST, "bulk buffers of token reach limit %{public}zu", BULK_BUFFER_MAX_PER_TOKEN);
+        return UEC_SERVICE_NO_MEMORY;
+    }
+    if (bufferOwners_.find(tokenId) == bufferOwners_.end()) {
+        sptr<IRemoteObject::DeathRecipient> recipient = new (std::nothrow) UsbBufferOwnerDeathRecipient(this, tokenId);
+        if (recipient == nullptr || !client->AddDeathRecipient(recipient)) {
+            USB_HILOGE(MODULE_USB_HOST, "add DeathRecipient failed");
+            return UEC_SERVICE_INVALID_VALUE;
+        }
+        bufferOwners_[tokenId] = {client, recipient};
+    }
+    if (!ashmem->MapReadAndWriteAshmem()) {
+        USB_HILOGE(MODULE_USB_HOST, "RegBulkTransferBuffer map ashmem failed");
+        ReleaseBufferOwnerIfUnused(tokenId);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    bulkTransferBuffers_[key] = ashmem;
+    USB_HILOGI(MODULE_USB_HOST, "bulk buffer+: ep:%{public}hhu size:%{public}d, cur buffer size: %{public}zu",
+        pipe.endpointId, ashmem->GetAshmemSize(), bulkTransferBuffers_.size());
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::UnRegBulkTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    const HDI::Usb::V1_0::UsbPipe &pipe)
+{
+    std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+    if (bulkTransferBuffers_.erase(GetBulkTransferBufferKey(tokenId, devInfo, pipe)) == 0) {
+        USB_HILOGW(MODULE_USB_HOST, "bulk buffer of ep:%{public}hhu not registered", pipe.endpointId);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    ReleaseBufferOwnerIfUnused(tokenId);
+    return UEC_OK;
+}
+
+void UsbHostManager::RemoveTokenTransferBuffers(uint32_t tokenId)
+{
+    std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+    for (auto it = bulkTransferBuffers_.begin(); it != bulkTransferBuffers_.end();) {
+        if ((it->first >> BULK_BUFFER_KEY_TOKEN_SHIFT) == tokenId) {
+            it = bulkTransferBuffers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = submitTransferBuffers_.begin(); it != submitTransferBuffers_.end();) {
+        if ((it->first >> BULK_BUFFER_KEY_TOKEN_SHIFT) == tokenId) {
+            it = submitTransferBuffers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    /* the client is dead, its object cannot report again */
+    bufferOwners_.erase(tokenId);
+    USB_HILOGI(MODULE_USB_HOST, "transfer buffers of dead client dropped, cur buffer size: %{public}zu",
+        bulkTransferBuffers_.size());
+}
+
+void UsbHostManager::RemoveBulkTransferBuffers(uint8_t busNum, uint8_t devAddr)
+{
+    const HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    const HDI::Usb::V1_0::UsbPipe pipe = {0, 0};
+    uint64_t busDev = GetBulkTransferBufferKey(0, devInfo, pipe);
+    std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+    for (auto it = bulkTransferBuffers_.begin(); it != bulkTransferBuffers_.end();) {
+        if ((it->first & BULK_BUFFER_KEY_BUS_DEV_MASK) == busDev) {
+            it = bulkTransferBuffers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+    for (auto it = submitTransferBuffers_.begin(); it != submitTransferBuffers_.end();) {
+        if ((it->first & BULK_BUFFER_KEY_BUS_DEV_MASK) == busDev) {
+            it = submitTransferBuffers_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+int32_t UsbHostManager::RegSubmitTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    int32_t endpoint, int32_t slot, sptr<Ashmem> &ashmem)
+{
+    if (ashmem == nullptr || slot < 0 || static_cast<uint32_t>(slot) >= MAX_NUM_OF_SUBMIT_BUFFER_SLOT) {
+        USB_HILOGE(MODULE_USB_HOST, "RegSubmitTransferBuffer invalid param, slot:%{public}d", slot);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    const HDI::Usb::V1_0::UsbPipe pipe = {0, static_cast<uint8_t>(endpoint)};
+    std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+    auto &slots = submitTransferBuffers_[GetBulkTransferBufferKey(tokenId, devInfo, pipe)];
+    if (slots.size() <= static_cast<size_t>(slot)) {
+        slots.resize(slot + 1);
+    }
+    slots[slot] = ashmem;
+    USB_HILOGI(MODULE_USB_HOST, "submit buffer+: ep:%{public}d slot:%{public}d size:%{public}d", endpoint, slot,
+        ashmem->GetAshmemSize());
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::UnRegSubmitTransferBuffers(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    int32_t endpoint)
+{
+    const HDI::Usb::V1_0::UsbPipe pipe = {0, static_cast<uint8_t>(endpoint)};
+    std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+    if (submitTransferBuffers_.erase(GetBulkTransferBufferKey(tokenId, devInfo, pipe)) == 0) {
+        USB_HILOGW(MODULE_USB_HOST, "submit buffers of ep:%{public}d not registered", endpoint);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::UsbSubmitTransferWithBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    HDI::Usb::V1_2::USBTransferInfo &info, const sptr<IRemoteObject> &cb, int32_t slot)
+{
+    const HDI::Usb::V1_0::UsbPipe pipe = {0, static_cast<uint8_t>(info.endpoint)};
+    sptr<Ashmem> ashmem = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+        auto it = submitTransferBuffers_.find(GetBulkTransferBufferKey(tokenId, devInfo, pipe));
+        if (it == submitTransferBuffers_.end() || static_cast<size_t>(slot) >= it->second.size() ||
+            it->second[slot] == nullptr) {
+            USB_HILOGE(MODULE_USB_HOST, "submit buffer of ep:%{public}d slot:%{public}d not registered",
+                info.endpoint, slot);
+            return UEC_SERVICE_INVALID_VALUE;
+        }
+        ashmem = it->second[slot];
+    }
+    if (info.length <= 0 || info.length > ashmem->GetAshmemSize()) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid length:%{public}d size:%{public}d", info.length,
+            ashmem->GetAshmemSize());
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    return UsbSubmitTransfer(devInfo, info, cb, ashmem);
+}
+
+sptr<Ashmem> UsbHostManager::GetBulkTransferBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    const HDI::Usb::V1_0::UsbPipe &pipe, int32_t offset, int32_t length)
+{
+    sptr<Ashmem> ashmem = nullptr;
+    {
+        std::lock_guard<std::mutex> guard(bulkBufferMutex_);
+        auto it = bulkTransferBuffers_.find(GetBulkTransferBufferKey(tokenId, devInfo, pipe));
+        if (it == bulkTransferBuffers_.end()) {
+            USB_HILOGE(MODULE_USB_HOST, "bulk buffer of ep:%{public}hhu not registered", pipe.endpointId);
+            return nullptr;
+        }
+        ashmem = it->second;
+    }
+    if (offset < 0 || length <= 0 || offset > ashmem->GetAshmemSize() - length) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid range, offset:%{public}d length:%{public}d size:%{public}d",
+            offset, length, ashmem->GetAshmemSize());
+        return nullptr;
+    }
+    return ashmem;
+}
+
+int32_t UsbHostManager::BulkTransferReadWithBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    const HDI::Usb::V1_0::UsbPipe &pipe, int32_t offset, int32_t length, int32_t &actualLength, int32_t timeOut)
+{
+    actualLength = 0;
+    sptr<Ashmem> ashmem = GetBulkTransferBuffer(tokenId, devInfo, pipe, offset, length);
+    if (ashmem == nullptr) {
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    std::vector<uint8_t> bufferData;
+    int32_t ret = BulkTransferReadwithLength(devInfo, pipe, length, bufferData, timeOut);
+    if (ret != UEC_OK) {
+        return ret;
+    }
+    if (bufferData.size() > static_cast<size_t>(length)) {
+        USB_HILOGE(MODULE_USB_HOST, "read %{public}zu bytes exceed length %{public}d", bufferData.size(), length);
+        return UEC_SERVICE_INNER_ERR;
+    }
+    if (!bufferData.empty() &&
+        !ashmem->WriteToAshmem(bufferData.data(), static_cast<int32_t>(bufferData.size()), offset)) {
+        USB_HILOGE(MODULE_USB_HOST, "write bulk data to ashmem failed");
+        return UEC_SERVICE_INNER_ERR;
+    }
+    actualLength = static_cast<int32_t>(bufferData.size());
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::BulkTransferWriteWithBuffer(uint32_t tokenId, const HDI::Usb::V1_0::UsbDev &devInfo,
+    const HDI::Usb::V1_0::UsbPipe &pipe, int32_t offset, int32_t length, int32_t timeOut)
+{
+    sptr<Ashmem> ashmem = GetBulkTransferBuffer(tokenId, devInfo, pipe, offset, length);
+    if (ashmem == nullptr) {
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    const uint8_t *data = static_cast<const uint8_t *>(ashmem->ReadFromAshmem(length, offset));
+    if (data == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "read bulk data from ashmem failed");
+        return UEC_SERVICE_INNER_ERR;
+    }
+    return BulkTransferWrite(devInfo, pipe, std::vector<uint8_t>(data, data + length), timeOut);
+}
+
 bool UsbHostManager::GetTargetDevice(uint8_t busNum, uint8_t devAddr, UsbDevice &dev)
 {
     std::shared_lock lock(devicesMutex_);
-    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        if ((it->second->GetBusNum() == busNum) && (it->second->GetDevAddr() == devAddr)) {
-            dev = *it->second;
-            return true;
-        }
+    auto iter = devices_.find(GetBusDevKey(busNum, devAddr));
+    if (iter != devices_.end() && iter->second != nullptr) {
+        dev = *iter->second;
+        return true;
     }
     USB_HILOGE(MODULE_USB_HOST, "UsbHostManager: target device not found");
     return false;
 }
 
+uint64_t UsbHostManager::GetDeviceSessionKey(uint32_t tokenId, uint8_t busNum, uint8_t devAddr)
+{
+    return (static_cast<uint64_t>(tokenId) << SESSION_KEY_TOKEN_SHIFT) |
+        (static_cast<uint64_t>(busNum) << SESSION_KEY_BUS_SHIFT) | devAddr;
+}
+
+void UsbHostManager::AddDeviceSession(uint32_t tokenId, uint8_t busNum, uint8_t devAddr, const std::string &identity,
+    uint64_t expireTime)
+{
+    std::unique_lock lock(sessionMutex_);
+    deviceSessions_[GetDeviceSessionKey(tokenId, busNum, devAddr)] = {identity, expireTime};
+    USB_HILOGI(MODULE_USB_HOST, "session+: bus:%{public}hhu dev:%{public}hhu, cur session size: %{public}zu",
+        busNum, devAddr, deviceSessions_.size());
+}
+
+bool UsbHostManager::CheckDeviceSession(uint32_t tokenId, uint8_t busNum, uint8_t devAddr)
+{
+    uint64_t nowTime = static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+    std::shared_lock lock(sessionMutex_);
+    auto it = deviceSessions_.find(GetDeviceSessionKey(tokenId, busNum, devAddr));
+    /* an expired session stays until it is replaced or removed, the right is queried again meanwhile */
+    return it != deviceSessions_.end() && nowTime < it->second.expireTime;
+}
+
+void UsbHostManager::RemoveDeviceSession(uint32_t tokenId, uint8_t busNum, uint8_t devAddr)
+{
+    std::unique_lock lock(sessionMutex_);
+    deviceSessions_.erase(GetDeviceSessionKey(tokenId, busNum, devAddr));
+}
+
+void UsbHostManager::RemoveDeviceSessions(uint32_t tokenId, const std::string &identity)
+{
+    std::unique_lock lock(sessionMutex_);
+    for (auto it = deviceSessions_.begin(); it != deviceSessions_.end();) {
+        if ((it->first >> SESSION_KEY_TOKEN_SHIFT) == tokenId && it->second.identity == identity) {
+            it = deviceSessions_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UsbHostManager::RemoveDeviceSessions(const std::string &identity)
+{
+    std::unique_lock lock(sessionMutex_);
+    for (auto it = deviceSessions_.begin(); it != deviceSessions_.end();) {
+        if (it->second.identity == identity) {
+            it = deviceSessions_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UsbHostManager::RemoveDeviceSessions(uint8_t busNum, uint8_t devAddr)
+{
+    uint64_t busDev = GetDeviceSessionKey(0, busNum, devAddr);
+    std::unique_lock lock(sessionMutex_);
+    for (auto it = deviceSessions_.begin(); it != deviceSessions_.end();) {
+        if ((it->first & SESSION_KEY_BUS_DEV_MASK) == busDev) {
+            it = deviceSessions_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UsbHostManager::ClearDeviceSessions()
+{
+    std::unique_lock lock(sessionMutex_);
+    deviceSessions_.clear();
+}
+
 bool UsbHostManager::GetEndpointFromId(UsbDevice dev, int32_t endpointId, USBEndpoint &endpoint)
 {
     // get USBEndpoint based on endpoint address(id); return false if not found
@@ -1153,8 +1888,13 @@ bool UsbHostManager::GetEndpointFromId(UsbDevice dev, int32_t endpointId, USBEnd
 
 bool UsbHostManager::GetProductName(const std::string &deviceName, std::string &productName)
 {
+    uint16_t busDev = 0;
+    if (!GetBusDevKey(deviceName, busDev)) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid deviceName %{public}s", deviceName.c_str());
+        return false;
+    }
     std::shared_lock lock(devicesMutex_);
-    auto iter = devices_.find(deviceName);
+    auto iter = devices_.find(busDev);
     if (iter == devices_.end()) {
         return false;
     }
@@ -1170,12 +1910,14 @@ bool UsbHostManager::GetProductName(const std::string &deviceName, std::string &
 
 bool UsbHostManager::DelDevice(uint8_t busNum, uint8_t devNum)
 {
-    std::string name = std::to_string(busNum) + "-" + std::to_string(devNum);
+    RemoveDeviceSessions(busNum, devNum);
+    RemoveBulkTransferBuffers(busNum, devNum);
+    UsbTransferStats::ForgetDevice(busNum, devNum);
+    uint16_t busDev = GetBusDevKey(busNum, devNum);
     std::unique_lock lock(devicesMutex_);
-    MAP_STR_DEVICE::iterator iter = devices_.find(name);
+    MAP_BUS_DEV_DEVICE::iterator iter = devices_.find(busDev);
     if (iter == devices_.end()) {
-        USB_HILOGF(MODULE_USB_HOST, "name:%{public}s bus:%{public}hhu dev:%{public}hhu not exist", name.c_str(), busNum,
-            devNum);
+        USB_HILOGF(MODULE_USB_HOST, "bus:%{public}hhu dev:%{public}hhu not exist", busNum, devNum);
         return false;
     }
     UsbDevice *devOld = iter->second;
@@ -1198,14 +1940,56 @@ bool UsbHostManager::DelDevice(uint8_t busNum, uint8_t devNum)
             break;
         }
     }
+    RemoveVidPidIndex(busDev, *devOld);
     delete devOld;
     devices_.erase(iter);
-    USB_HILOGI(MODULE_USB_HOST,
-        "device:%{public}s bus:%{public}hhu dev:%{public}hhu erase, cur device size: %{public}zu",
-        name.c_str(), busNum, devNum, devices_.size());
+    MarkDevicesChanged(busDev, DeviceChangeType::REMOVED);
+    USB_HILOGI(MODULE_USB_HOST, "bus:%{public}hhu dev:%{public}hhu erase, cur device size: %{public}zu",
+        busNum, devNum, devices_.size());
     return true;
 }
 
+void UsbHostManager::ExecuteAttachStrategy(uint16_t busDev)
+{
+    if (!IsEdmEnabled()) {
+        return;
+    }
+    UsbPolicySnapshot policy;
+    int32_t ret = GetUsbPolicySnapshot(policy);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: get policy failed, ret = %{public}d", __func__, ret);
+        return;
+    }
+    // devices already attached were handled when they arrived or when the policy last changed
+    std::shared_lock lock(devicesMutex_);
+    auto iter = devices_.find(busDev);
+    if (iter == devices_.end() || iter->second == nullptr) {
+        USB_HILOGW(MODULE_USB_HOST, "%{public}s: device removed before strategy", __func__);
+        return;
+    }
+    UsbDevice &device = *iter->second;
+    USB_HILOGI(MODULE_USB_HOST, "%{public}s: bus:%{public}hhu dev:%{public}hhu policy version %{public}" PRIu64,
+        __func__, device.GetBusNum(), device.GetDevAddr(), policy.version);
+    if (policy.isGlobalDisabled) {
+        (void)ManageGlobalInterfaceImpl(device, true);
+        return;
+    }
+    if (IsUsbSerialDisable() && IsUsbSerialDevice(device)) {
+        (void)UsbDeviceAuthorize(device.GetBusNum(), device.GetDevAddr(), false, "UsbSerialType");
+    }
+    if (!policy.disableType.empty()) {
+        (void)ExecuteManageInterfaceType(*policy.matcher, true, device);
+        return;
+    }
+    if (policy.trustUsbDeviceIds.empty()) {
+        return;
+    }
+    ret = ManageDeviceImpl(device, !policy.matcher->IsTrusted(device.GetVendorId(), device.GetProductId()));
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: ManageDevice failed, ret = %{public}d", __func__, ret);
+    }
+}
+
 bool UsbHostManager::AddDevice(UsbDevice *dev)
 {
     if (dev == nullptr) {
@@ -1215,31 +1999,34 @@ bool UsbHostManager::AddDevice(UsbDevice *dev)
 
     uint8_t busNum = dev->GetBusNum();
     uint8_t devNum = dev->GetDevAddr();
-    std::string name = std::to_string(busNum) + "-" + std::to_string(devNum);
+    uint16_t busDev = GetBusDevKey(busNum, devNum);
     std::unique_lock lock(devicesMutex_);
-    MAP_STR_DEVICE::iterator iter = devices_.find(name);
+    MAP_BUS_DEV_DEVICE::iterator iter = devices_.find(busDev);
     if (iter != devices_.end()) {
-        USB_HILOGF(MODULE_USB_HOST, "device:%{public}s bus:%{public}hhu dev:%{public}hhu already exist", name.c_str(),
-            busNum, devNum);
+        USB_HILOGF(MODULE_USB_HOST, "bus:%{public}hhu dev:%{public}hhu already exist", busNum, devNum);
         UsbDevice *devOld = iter->second;
+        if (devOld != nullptr) {
+            RemoveVidPidIndex(busDev, *devOld);
+        }
         if (devOld != nullptr && devOld != dev) {
             delete devOld;
         }
         devices_.erase(iter);
     }
-    devices_.insert(std::pair<std::string, UsbDevice *>(name, dev));
+    devices_.emplace(busDev, dev);
+    MarkDevicesChanged(busDev, DeviceChangeType::ADDED);
+    vidPidIndex_.emplace(GetVidPidKey(dev->GetVendorId(), dev->GetProductId()), busDev);
     dev->SetAuthorizeStatus(NEW_ARRIVED);   // will be updated in ExecuteStrategy
-    USB_HILOGI(MODULE_USB_HOST,
-        "device:%{public}s bus:%{public}hhu dev:%{public}hhu insert, cur device size: %{public}zu",
-        name.c_str(), busNum, devNum, devices_.size());
+    USB_HILOGI(MODULE_USB_HOST, "bus:%{public}hhu dev:%{public}hhu insert, cur device size: %{public}zu",
+        busNum, devNum, devices_.size());
     AddUsbSerialDevice(*dev);
     lock.unlock();
 
     // DONT hold unique_lock here: ExecuteStratgy quiries policy (requires the same lock with policy execution in MDM)
-    ExecuteStrategy();
+    ExecuteAttachStrategy(busDev);
 
     std::shared_lock sharedLock(devicesMutex_);
-    iter = devices_.find(name);
+    iter = devices_.find(busDev);
     if (iter == devices_.end()) {
         USB_HILOGW(MODULE_USB_HOST, "%{public}s: device removed before publish common event", __func__);
         return false;
@@ -1249,6 +2036,7 @@ bool UsbHostManager::AddDevice(UsbDevice *dev)
         USB_HILOGI(MODULE_USB_HOST, "device is disallowed by EDM, skip common event broadcast");
     } else {
         dev->SetAuthorizeStatus(ENABLED);
+        MarkDevicesChanged(busDev, DeviceChangeType::CHANGED);
         auto isSuccess = PublishCommonEvent(CommonEventSupport::COMMON_EVENT_USB_DEVICE_ATTACHED, *dev);
         if (!isSuccess) {
             USB_HILOGW(MODULE_USB_HOST, "send device attached broadcast failed");
@@ -1293,8 +2081,12 @@ bool UsbHostManager::PublishCommonEvent(const std::string &event, UsbDevice &dev
 
 bool UsbHostManager::Dump(int fd, const std::string &args)
 {
+    if (args.compare("-perf") == 0) {
+        UsbTransferStats::Dump(fd);
+        return true;
+    }
     if (args.compare("-a") != 0) {
-        dprintf(fd, "args is not -a\n");
+        dprintf(fd, "args is not -a or -perf\n");
         return false;
     }
 
@@ -1398,6 +2190,44 @@ static std::string BcdToString(uint16_t bcdUsb)
     return oss.str();
 }
 
+std::string UsbHostManager::GetDevStringCacheKey(UsbDevice &dev, const std::string &serial)
+{
+    std::string key = std::to_string(dev.GetVendorId()) + "-" + std::to_string(dev.GetProductId()) + "-" +
+        std::to_string(dev.GetbcdDevice()) + "-";
+    /* devices without a serial cannot be told apart by their ids, their strings stay with the port */
+    if (serial.empty() || serial == DEV_STRING_PLACEHOLDER) {
+        return key + "bus" + std::to_string(dev.GetBusNum()) + "-" + std::to_string(dev.GetDevAddr());
+    }
+    return key + serial;
+}
+
+bool UsbHostManager::QueryDevStringCache(const std::string &key, std::unordered_map<uint8_t, std::string> &strings)
+{
+    std::lock_guard<std::mutex> guard(devStringCacheMutex_);
+    auto it = devStringCache_.find(key);
+    if (it == devStringCache_.end()) {
+        return false;
+    }
+    it->second.lastUsed = ++devStringCacheClock_;
+    strings = it->second.strings;
+    return true;
+}
+
+void UsbHostManager::UpdateDevStringCache(
+    const std::string &key, const std::unordered_map<uint8_t, std::string> &strings)
+{
+    std::lock_guard<std::mutex> guard(devStringCacheMutex_);
+    auto it = devStringCache_.find(key);
+    if (it == devStringCache_.end() && devStringCache_.size() >= DEV_STRING_CACHE_MAX_SIZE) {
+        auto oldest = std::min_element(devStringCache_.begin(), devStringCache_.end(),
+            [](const auto &lhs, const auto &rhs) { return lhs.second.lastUsed < rhs.second.lastUsed; });
+        devStringCache_.erase(oldest);
+    }
+    UsbDevStringCacheEntry &entry = devStringCache_[key];
+    entry.strings = strings;
+    entry.lastUsed = ++devStringCacheClock_;
+}
+
 int32_t UsbHostManager::FillDevStrings(UsbDevice &dev)
 {
     uint8_t busNum;
@@ -1407,34 +2237,61 @@ int32_t UsbHostManager::FillDevStrings(UsbDevice &dev)
     devAddr = dev.GetDevAddr();
     uint16_t bcdUsb = dev.GetbcdUSB();
     dev.SetVersion(BcdToString(bcdUsb));
-    dev.SetManufacturerName(GetDevStringValFromIdx(busNum, devAddr, dev.GetiManufacturer()));
-    dev.SetProductName(GetDevStringValFromIdx(busNum, devAddr, dev.GetiProduct()));
     dev.SetmSerial(GetDevStringValFromIdx(busNum, devAddr, dev.GetiSerialNumber()));
+
+    std::unordered_map<uint8_t, std::string> strings;
+    std::string cacheKey = GetDevStringCacheKey(dev, dev.GetmSerial());
+    bool cached = QueryDevStringCache(cacheKey, strings);
+    size_t cachedCount = strings.size();
+    /* a failed serial read would file the strings under the wrong key */
+    bool complete = dev.GetiSerialNumber() == 0 || dev.GetmSerial() != DEV_STRING_PLACEHOLDER;
+    dev.SetManufacturerName(GetDevStringValFromIdx(busNum, devAddr, dev.GetiManufacturer(), strings, complete));
+    dev.SetProductName(GetDevStringValFromIdx(busNum, devAddr, dev.GetiProduct(), strings, complete));
     USB_HILOGI(MODULE_USB_HOST,
         "iSerial:%{public}d Manufactur:%{public}s product:%{public}s "
-        "version:%{public}s",
+        "version:%{public}s cached:%{public}d",
         dev.GetiSerialNumber(), dev.GetManufacturerName().c_str(), dev.GetProductName().c_str(),
-        dev.GetVersion().c_str());
+        dev.GetVersion().c_str(), cached);
 
     std::vector<USBConfig> configs;
     configs = dev.GetConfigs();
     for (auto it = configs.begin(); it != configs.end(); ++it) {
-        it->SetName(GetDevStringValFromIdx(busNum, devAddr, it->GetiConfiguration()));
+        it->SetName(GetDevStringValFromIdx(busNum, devAddr, it->GetiConfiguration(), strings, complete));
         USB_HILOGI(MODULE_USB_HOST, "Config:%{public}d %{public}s", it->GetiConfiguration(), it->GetName().c_str());
         std::vector<UsbInterface> interfaces = it->GetInterfaces();
         for (auto itIF = interfaces.begin(); itIF != interfaces.end(); ++itIF) {
-            itIF->SetName(GetDevStringValFromIdx(busNum, devAddr, itIF->GetiInterface()));
+            itIF->SetName(GetDevStringValFromIdx(busNum, devAddr, itIF->GetiInterface(), strings, complete));
             USB_HILOGI(MODULE_USB_HOST, "interface:%{public}hhu %{public}s", itIF->GetiInterface(),
                 itIF->GetName().c_str());
         }
         it->SetInterfaces(interfaces);
     }
     dev.SetConfigs(configs);
+    if (complete && (!cached || strings.size() != cachedCount)) {
+        UpdateDevStringCache(cacheKey, strings);
+    }
 
     return UEC_OK;
 }
 
-static std::string Utf16leToUtf8(char *utf16leBytes, size_t length)
+static void AppendUtf8(uint32_t codePoint, std::string &out)
+{
+    static const uint8_t firstByteMark[UTF8_MAX_BYTES + 1] = {0x00, 0x00, 0xC0, 0xE0, 0xF0};
+    static const uint32_t byteLimit[UTF8_MAX_BYTES] = {0x80, 0x800, 0x10000, 0x110000};
+    size_t bytes = 1;
+    while (bytes < UTF8_MAX_BYTES && codePoint >= byteLimit[bytes - 1]) {
+        ++bytes;
+    }
+    char buf[UTF8_MAX_BYTES] = {0};
+    for (size_t i = bytes - 1; i > 0; --i) {
+        buf[i] = static_cast<char>((codePoint & UTF8_CONT_MASK) | UTF8_CONT_MARK);
+        codePoint >>= UTF8_CONT_BITS;
+    }
+    buf[0] = static_cast<char>(codePoint | firstByteMark[bytes]);
+    out.append(buf, bytes);
+}
+
+static std::string Utf16leToUtf8(const uint8_t *utf16leBytes, size_t length)
 {
     if (utf16leBytes == nullptr || length % HALF) {
         USB_HILOGE(MODULE_USB_HOST, "Utf16leToUtf8: invalid length: %{public}zu", length);
@@ -1445,33 +2302,55 @@ static std::string Utf16leToUtf8(char *utf16leBytes, size_t length)
     if (charCount > 0 && utf16leBytes[0] == 0xFF && utf16leBytes[1] == 0xFE) {
         charCount--;
         utf16leBytes += BOM_BYTE_COUNT;
-        length -= BOM_BYTE_COUNT;
     }
     if (charCount == 0) {
         USB_HILOGE(MODULE_USB_HOST, "empty string");
         return " ";
     }
-    iconv_t cd = iconv_open("UTF-8", "UTF-16LE");
-    if (cd == reinterpret_cast<iconv_t>(INVALID_RET)) {
-        USB_HILOGE(MODULE_USB_HOST, "iconv_open failed");
-        return " ";
+    std::string str;
+    str.reserve(charCount * UTF8_MAX_BYTES);
+    for (size_t i = 0; i < charCount; ++i) {
+        uint32_t unit = utf16leBytes[i * HALF] | (static_cast<uint32_t>(utf16leBytes[i * HALF + 1]) << BITS_PER_BYTE);
+        if (unit == 0) {
+            break;
+        }
+        if (unit >= UTF16_HIGH_SURROGATE_START && unit <= UTF16_HIGH_SURROGATE_END && i + 1 < charCount) {
+            uint32_t low = utf16leBytes[(i + 1) * HALF] |
+                (static_cast<uint32_t>(utf16leBytes[(i + 1) * HALF + 1]) << BITS_PER_BYTE);
+            if (low >= UTF16_LOW_SURROGATE_START && low <= UTF16_LOW_SURROGATE_END) {
+                unit = UTF16_SURROGATE_BASE + ((unit - UTF16_HIGH_SURROGATE_START) << UTF16_SURROGATE_BITS) +
+                    (low - UTF16_LOW_SURROGATE_START);
+                ++i;
+                AppendUtf8(unit, str);
+                continue;
+            }
+        }
+        if (unit >= UTF16_HIGH_SURROGATE_START && unit <= UTF16_LOW_SURROGATE_END) {
+            unit = UNICODE_REPLACEMENT_CHAR;
+        }
+        AppendUtf8(unit, str);
     }
-    std::vector<char> outbuf(charCount * BYTES_PER_UTF8_CHAR + 1, 0);
-    char *outptr = outbuf.data();
-    size_t outBytesLeft = outbuf.size();
-    size_t inBytesLeft = length;
-    size_t result = iconv(cd, &utf16leBytes, &inBytesLeft, &outptr, &outBytesLeft);
-    iconv_close(cd);
-    if (result == static_cast<size_t>(INVALID_RET)) {
-        USB_HILOGE(MODULE_USB_HOST, "iconv failed: %{public}zu", result);
-        return " ";
+    return str;
+}
+
+std::string UsbHostManager::GetDevStringValFromIdx(uint8_t busNum, uint8_t devAddr, uint8_t idx,
+    std::unordered_map<uint8_t, std::string> &strings, bool &complete)
+{
+    if (idx == 0) {
+        return DEV_STRING_PLACEHOLDER;
     }
-    std::string str = std::string(outbuf.data(), outptr - outbuf.data());
-    auto iter = str.find('\0');
-    if (iter != std::string::npos) {
-        str = str.substr(0, iter);
+    auto it = strings.find(idx);
+    if (it != strings.end()) {
+        return it->second;
     }
-    return str;
+    std::string strDesc = GetDevStringValFromIdx(busNum, devAddr, idx);
+    /* the placeholder stands for a failed read, it is retried on the next attach instead of being kept */
+    if (strDesc == DEV_STRING_PLACEHOLDER) {
+        complete = false;
+        return strDesc;
+    }
+    strings.emplace(idx, strDesc);
+    return strDesc;
 }
 
 std::string UsbHostManager::GetDevStringValFromIdx(uint8_t busNum, uint8_t devAddr, uint8_t idx)
@@ -1508,20 +2387,9 @@ std::string UsbHostManager::GetDevStringValFromIdx(uint8_t busNum, uint8_t devAd
         return strDesc;
     }
 
-    char *tbuf = new (std::nothrow) char[length - DESCRIPTOR_VALUE_START_OFFSET]();
-    if (tbuf == nullptr) {
-        USB_HILOGI(MODULE_USB_HOST, "new failed");
-        return strDesc;
-    }
-
-    for (uint32_t i = 0; i < length - DESCRIPTOR_VALUE_START_OFFSET; ++i) {
-        tbuf[i] = strV[i + DESCRIPTOR_VALUE_START_OFFSET];
-    }
-
-    strDesc = Utf16leToUtf8(tbuf, length - DESCRIPTOR_VALUE_START_OFFSET);
+    strDesc = Utf16leToUtf8(strV.data() + DESCRIPTOR_VALUE_START_OFFSET, length - DESCRIPTOR_VALUE_START_OFFSET);
     USB_HILOGI(MODULE_USB_HOST, "getString idx: %{public}d length:%{public}zu, str: %{public}s",
         idx, strDesc.length(), strDesc.c_str());
-    delete[] tbuf;
     return strDesc;
 }
 
@@ -1542,7 +2410,7 @@ int32_t UsbHostManager::UsbDeviceAuthorize(
         return UEC_SERVICE_INVALID_VALUE;
     }
     std::string name = std::to_string(busNum) + "-" + std::to_string(devAddr);
-    auto iterDev = devices_.find(name);
+    auto iterDev = devices_.find(GetBusDevKey(busNum, devAddr));
     if (iterDev == devices_.end()) {
         USB_HILOGE(MODULE_USB_HOST, "UsbDeviceAuthorize: dev %{public}s not found", name.c_str());
         return UEC_SERVICE_INVALID_VALUE;
@@ -1573,6 +2441,7 @@ int32_t UsbHostManager::UsbDeviceAuthorize(
         }
     }
     iterDev->second->SetAuthorizeStatus(authorized? ENABLED : DISABLED); // authorized==true -> ENABLED
+    MarkDevicesChanged(iterDev->first, DeviceChangeType::CHANGED);
     std::this_thread::sleep_for(std::chrono::milliseconds(MANAGE_INTERFACE_INTERVAL));
     return UEC_OK;
 }
@@ -1597,23 +2466,21 @@ int32_t UsbHostManager::UsbInterfaceAuthorize(
 }
 
 int32_t UsbHostManager::ExecuteManageDevicePolicy(std::vector<UsbDeviceId> &trustList)
+{
+    UsbPolicyMatcher matcher;
+    matcher.CompileTrustList(trustList);
+    return ExecuteManageDevicePolicy(matcher);
+}
+
+int32_t UsbHostManager::ExecuteManageDevicePolicy(const UsbPolicyMatcher &matcher)
 {
     int32_t ret = UEC_OK;
     USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu", devices_.size());
     std::shared_lock lock(devicesMutex_);
     for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        bool inTrustList = false;
-        for (auto dev : trustList) {
-            if (it->second->GetProductId() == dev.productId && it->second->GetVendorId() == dev.vendorId) {
-                inTrustList = true;
-                break;
-            }
-        }
-        if (inTrustList || trustList.empty()) {
-            ret = ManageDeviceImpl(it->second->GetVendorId(), it->second->GetProductId(), false);
-        } else {
-            ret = ManageDeviceImpl(it->second->GetVendorId(), it->second->GetProductId(), true);
-        }
+        bool inTrustList = matcher.IsTrustListEmpty() ||
+            matcher.IsTrusted(it->second->GetVendorId(), it->second->GetProductId());
+        ret = ManageDeviceImpl(*it->second, !inTrustList);
         std::this_thread::sleep_for(std::chrono::milliseconds(MANAGE_INTERFACE_INTERVAL));
     }
     if (ret != UEC_OK) {
@@ -1624,6 +2491,13 @@ int32_t UsbHostManager::ExecuteManageDevicePolicy(std::vector<UsbDeviceId> &trus
 }
 
 int32_t UsbHostManager::ExecuteManageInterfaceType(const std::vector<UsbDeviceType> &disableType, bool disable)
+{
+    UsbPolicyMatcher matcher;
+    matcher.CompileTypePolicy(disableType);
+    return ExecuteManageInterfaceType(matcher, disable);
+}
+
+int32_t UsbHostManager::ExecuteManageInterfaceType(const UsbPolicyMatcher &matcher, bool disable)
 {
     std::shared_lock lock(devicesMutex_);
     for (auto it = devices_.begin(); it != devices_.end(); ++it) {
@@ -1633,8 +2507,12 @@ int32_t UsbHostManager::ExecuteManageInterfaceType(const std::vector<UsbDeviceTy
             USB_HILOGW(MODULE_USB_HOST, "ExecuteManageInterfaceType open fail ret = %{public}d", ret);
         }
     }
-    ExecuteManageDeviceType(disableType, disable, d_typeMap, true);
-    ExecuteManageDeviceType(disableType, disable, g_typeMap, false);
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        (void)ManageDeviceTypeImpl(*it->second, matcher, disable);
+    }
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        (void)ManageInterfaceTypeImpl(*it->second, matcher, disable);
+    }
     for (auto it = devices_.begin(); it != devices_.end(); ++it) {
         UsbDev dev = {it->second->GetBusNum(), it->second->GetDevAddr()};
         int32_t ret = Close(dev.busNum, dev.devAddr);
@@ -1645,6 +2523,22 @@ int32_t UsbHostManager::ExecuteManageInterfaceType(const std::vector<UsbDeviceTy
     return UEC_OK;
 }
 
+int32_t UsbHostManager::ExecuteManageInterfaceType(const UsbPolicyMatcher &matcher, bool disable,
+    UsbDevice &device)
+{
+    int32_t ret = OpenDevice(device.GetBusNum(), device.GetDevAddr());
+    if (ret != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "ExecuteManageInterfaceType open fail ret = %{public}d", ret);
+    }
+    (void)ManageDeviceTypeImpl(device, matcher, disable);
+    (void)ManageInterfaceTypeImpl(device, matcher, disable);
+    ret = Close(device.GetBusNum(), device.GetDevAddr());
+    if (ret != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "ExecuteManageInterfaceType close fail ret = %{public}d", ret);
+    }
+    return UEC_OK;
+}
+
 int32_t UsbHostManager::GetEdmPolicy(bool &IsGlobalDisabled, std::vector<UsbDeviceType> &disableType,
     std::vector<UsbDeviceId> &trustUsbDeviceIds)
 {
@@ -1700,6 +2594,77 @@ void UsbHostManager::LoadEdmService()
     }
 }
 
+int32_t UsbHostManager::GetUsbPolicySnapshot(UsbPolicySnapshot &policy)
+{
+    {
+        std::lock_guard<std::mutex> guard(policyMutex_);
+        if (policySnapshotValid_) {
+            policy = policySnapshot_;
+            return UEC_OK;
+        }
+    }
+    // a single caller queries EDM, concurrent attaches wait for its result
+    std::lock_guard<std::mutex> fetchGuard(policyFetchMutex_);
+    uint64_t version = 0;
+    {
+        std::lock_guard<std::mutex> guard(policyMutex_);
+        if (policySnapshotValid_) {
+            policy = policySnapshot_;
+            return UEC_OK;
+        }
+        version = policyVersion_;
+    }
+    auto fetchTime = std::chrono::steady_clock::now();
+    UsbPolicySnapshot fetched;
+    int32_t ret = GetUsbPolicy(fetched.isGlobalDisabled, fetched.disableType, fetched.trustUsbDeviceIds);
+    if (ret != UEC_OK) {
+        return ret;
+    }
+    fetched.version = version;
+    auto matcher = std::make_shared<UsbPolicyMatcher>();
+    matcher->CompileTypePolicy(fetched.disableType);
+    matcher->CompileTrustList(fetched.trustUsbDeviceIds);
+    fetched.matcher = matcher;
+    {
+        std::lock_guard<std::mutex> guard(policyMutex_);
+        // a policy change pushed while querying makes the result stale, use it once but do not keep it.
+        // EDM saves the new policy only after Manage* returns, so a query overlapping a change or issued
+        // right after one may still read the old policy
+        if (policyVersion_ == version && policyChangesInFlight_ == 0 && fetchTime >= policySettleTime_) {
+            policySnapshot_ = fetched;
+            policySnapshotValid_ = true;
+        }
+    }
+    policy = std::move(fetched);
+    return UEC_OK;
+}
+
+void UsbHostManager::InvalidateUsbPolicySnapshot()
+{
+    std::lock_guard<std::mutex> guard(policyMutex_);
+    ++policyVersion_;
+    policySnapshotValid_ = false;
+}
+
+void UsbHostManager::BeginUsbPolicyChange()
+{
+    std::lock_guard<std::mutex> guard(policyMutex_);
+    ++policyChangesInFlight_;
+    ++policyVersion_;
+    policySnapshotValid_ = false;
+}
+
+void UsbHostManager::EndUsbPolicyChange()
+{
+    std::lock_guard<std::mutex> guard(policyMutex_);
+    if (policyChangesInFlight_ > 0) {
+        --policyChangesInFlight_;
+    }
+    ++policyVersion_;
+    policySnapshotValid_ = false;
+    policySettleTime_ = std::chrono::steady_clock::now() + std::chrono::milliseconds(POLICY_SETTLE_MS);
+}
+
 int32_t UsbHostManager::GetUsbPolicy(bool &IsGlobalDisabled, std::vector<UsbDeviceType> &disableType,
     std::vector<UsbDeviceId> &trustUsbDeviceIds)
 {
@@ -1883,92 +2848,51 @@ int32_t UsbHostManager::ManageInterface(const HDI::Usb::V1_0::UsbDev &dev, uint8
 #endif // USB_MANAGER_PASS_THROUGH
 }
 
-void UsbHostManager::ExecuteManageDeviceType(const std::vector<UsbDeviceType> &disableType, bool disable,
-    const std::unordered_map<InterfaceType, std::vector<int32_t>> &map, bool isDev)
+int32_t UsbHostManager::ManageGlobalInterfaceImpl(bool disable)
 {
-    std::vector<InterfaceType> interfaceTypes;
-    FindMatchingTypes(map, isDev, interfaceTypes, disableType);
-
-    for (auto& [interfaceTypeValues, typeValues] : map) {
-        bool canFind = false;
-        for (auto disallowedValues : interfaceTypes) {
-            if (interfaceTypeValues == disallowedValues) {
-                canFind = true;
-                break;
-            }
-        }
-        bool execDisable = canFind? disable : !disable;
-        if (isDev) {
-            ManageDeviceTypeImpl(interfaceTypeValues, execDisable);
-        } else {
-            ManageInterfaceTypeImpl(interfaceTypeValues, execDisable);
-        }
+    USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu", devices_.size());
+    std::shared_lock lock(devicesMutex_);
+    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
+        (void)ManageGlobalInterfaceImpl(*it->second, disable);
     }
+    return UEC_OK;
 }
 
-void UsbHostManager::FindMatchingTypes(const std::unordered_map<InterfaceType, std::vector<int32_t>> &map,
-    bool isDev, std::vector<InterfaceType> &matchingTypes, const std::vector<UsbDeviceType> &disableType)
+int32_t UsbHostManager::ManageGlobalInterfaceImpl(UsbDevice &device, bool disable)
 {
-    for (const auto &dev : disableType) {
-        bool isMatch = false;
-        if (dev.isDeviceType != isDev) {
-            continue;
-        }
-        for (auto& [interfaceTypeValues, typeValues] : map) {
-            if ((typeValues[BASECLASS_INDEX] == dev.baseClass) &&
-                (typeValues[SUBCLASS_INDEX] == -1 || typeValues[SUBCLASS_INDEX] == dev.subClass) &&
-                (typeValues[PROTOCAL_INDEX] == -1 || typeValues[PROTOCAL_INDEX] == dev.protocol)) {
-                    isMatch = true;
-                    matchingTypes.emplace_back(interfaceTypeValues);
-                    break;
-            }
-        }
-        if (!isMatch) {
-            USB_HILOGE(MODULE_USB_HOST, "is not in the type list, %{public}d, %{public}d, %{public}d",
-                dev.baseClass, dev.subClass, dev.protocol);
-        }
+    if ((disable && device.GetClass() != BASE_CLASS_HUB) || (IsUsbSerialDisable() && IsUsbSerialDevice(device))) {
+        return UEC_OK;
     }
-}
-
-int32_t UsbHostManager::ManageGlobalInterfaceImpl(bool disable)
-{
-    USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu", devices_.size());
-    std::shared_lock lock(devicesMutex_);
-    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        if ((disable && it->second->GetClass() != BASE_CLASS_HUB) ||
-            (IsUsbSerialDisable() && IsUsbSerialDevice(*it->second))) {
-            continue;
-        }
-        UsbDev dev = {it->second->GetBusNum(), it->second->GetDevAddr()};
-        int32_t ret = UsbDeviceAuthorize(dev.busNum, dev.devAddr, !disable, "GlobalType");
-        USB_HILOGI(MODULE_USB_HOST, "UsbDeviceAuthorize ret = %{public}d", ret);
-        if (!disable) {
-            ret = OpenDevice(dev.busNum, dev.devAddr);
-            if (ret != UEC_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "ManageGlobalInterfaceImpl open fail ret = %{public}d", ret);
-                continue;
-            }
-            // global authorization need to enable all interfaces
-            uint8_t configIndex = 0;
-            if (GetActiveConfig(dev.busNum, dev.devAddr, configIndex) || (configIndex < 1)) {
-                USB_HILOGW(MODULE_USB_HOST, "get device active config failed.");
-                (void)Close(dev.busNum, dev.devAddr);
-                continue;
-            }
-            uint8_t index = static_cast<uint8_t>(configIndex) - 1;
-            if (index >= it->second->GetConfigs().size()) {
-                USB_HILOGW(MODULE_USB_HOST, "get device config info failed.");
-                (void)Close(dev.busNum, dev.devAddr);
-                continue;
-            }
-            for (auto &interface : it->second->GetConfigs()[index].GetInterfaces()) {
-                UsbInterfaceAuthorize(dev, it->second->GetConfigs()[index].GetId(), interface.GetId(), !disable);
-                interface.SetAuthorizeStatus(!disable);
-            }
-            if (Close(dev.busNum, dev.devAddr) != UEC_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "ManageGlobalInterfaceImpl CloseDevice fail");
-            }
-        }
+    UsbDev dev = {device.GetBusNum(), device.GetDevAddr()};
+    int32_t ret = UsbDeviceAuthorize(dev.busNum, dev.devAddr, !disable, "GlobalType");
+    USB_HILOGI(MODULE_USB_HOST, "UsbDeviceAuthorize ret = %{public}d", ret);
+    if (disable) {
+        return ret;
+    }
+    ret = OpenDevice(dev.busNum, dev.devAddr);
+    if (ret != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "ManageGlobalInterfaceImpl open fail ret = %{public}d", ret);
+        return ret;
+    }
+    // global authorization need to enable all interfaces
+    uint8_t configIndex = 0;
+    if (GetActiveConfig(dev.busNum, dev.devAddr, configIndex) || (configIndex < 1)) {
+        USB_HILOGW(MODULE_USB_HOST, "get device active config failed.");
+        (void)Close(dev.busNum, dev.devAddr);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    uint8_t index = static_cast<uint8_t>(configIndex) - 1;
+    if (index >= device.GetConfigs().size()) {
+        USB_HILOGW(MODULE_USB_HOST, "get device config info failed.");
+        (void)Close(dev.busNum, dev.devAddr);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    for (auto &interface : device.GetConfigs()[index].GetInterfaces()) {
+        UsbInterfaceAuthorize(dev, device.GetConfigs()[index].GetId(), interface.GetId(), !disable);
+        interface.SetAuthorizeStatus(!disable);
+    }
+    if (Close(dev.busNum, dev.devAddr) != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "ManageGlobalInterfaceImpl CloseDevice fail");
     }
     return UEC_OK;
 }
@@ -1977,103 +2901,98 @@ int32_t UsbHostManager::ManageDeviceImpl(int32_t vendorId, int32_t productId, bo
 {
     USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu, vId: %{public}d, pId: %{public}d, b: %{public}d",
         devices_.size(), vendorId, productId, disable);
-    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        if (it->second->GetClass() == BASE_CLASS_HUB) {
+    auto range = vidPidIndex_.equal_range(GetVidPidKey(vendorId, productId));
+    for (auto index = range.first; index != range.second; ++index) {
+        auto it = devices_.find(index->second);
+        if (it == devices_.end()) {
             continue;
         }
         if ((it->second->GetVendorId() == vendorId) && (it->second->GetProductId() == productId)) {
-            int32_t ret = OpenDevice(it->second->GetBusNum(), it->second->GetDevAddr());
+            int32_t ret = ManageDeviceImpl(*it->second, disable);
             if (ret != UEC_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "ManageDeviceImpl open fail ret = %{public}d", ret);
                 return ret;
             }
-            ret = UsbDeviceAuthorize(it->second->GetBusNum(), it->second->GetDevAddr(), !disable, "DeviceType");
-            USB_HILOGI(MODULE_USB_HOST, "UsbDeviceAuthorize ret = %{public}d", ret);
-            if (Close(it->second->GetBusNum(), it->second->GetDevAddr()) != UEC_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "ManageDeviceImpl Close fail");
-            }
         }
     }
     return UEC_OK;
 }
 
-int32_t UsbHostManager::ManageInterfaceTypeImpl(InterfaceType interfaceType, bool disable)
+int32_t UsbHostManager::ManageDeviceImpl(UsbDevice &device, bool disable)
 {
-    auto iterInterface = g_typeMap.find(interfaceType);
-    if (iterInterface == g_typeMap.end()) {
-        USB_HILOGE(MODULE_USB_HOST, "UsbHostManager::not find interface type");
-        return UEC_SERVICE_INVALID_VALUE;
+    if (device.GetClass() == BASE_CLASS_HUB) {
+        return UEC_OK;
     }
-    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        if (it->second->GetClass() == BASE_CLASS_HUB || it->second->GetAuthorizeStatus() == DISABLED) {
-            continue;
-        }
-        UsbDev dev = {it->second->GetBusNum(), it->second->GetDevAddr()};
-        uint8_t configIndex = 0;
-        if (GetActiveConfig(dev.busNum, dev.devAddr, configIndex)) {
-            USB_HILOGW(MODULE_USB_HOST, "get device active config failed.");
-            continue;
-        }
-        uint8_t index = static_cast<uint8_t>(configIndex) - 1;
-        if (index >= it->second->GetConfigs().size()) {
-            USB_HILOGW(MODULE_USB_HOST, "get device config info failed.");
-            continue;
-        }
-        for (auto &interface : it->second->GetConfigs()[index].GetInterfaces()) {
-            int32_t ret = RANDOM_VALUE_INDICATE;
-            bool needReport = true;
-            if (interface.GetAuthorizeStatus() == !disable) {
-                needReport = false;
-            }
-            // 0 indicate base class, 1 indicate subclass, 2 indicate protocal. -1 indicate any value.
-            if ((interface.GetClass() == iterInterface->second[BASECLASS_INDEX]) &&
-                (interface.GetSubClass() == iterInterface->second[SUBCLASS_INDEX] ||
-                iterInterface->second[SUBCLASS_INDEX] == RANDOM_VALUE_INDICATE) &&
-                (interface.GetProtocol() == iterInterface->second[PROTOCAL_INDEX] ||
-                iterInterface->second[PROTOCAL_INDEX] == RANDOM_VALUE_INDICATE)) {
-                USB_HILOGI(MODULE_USB_HOST, "size %{public}zu, interfaceType: %{public}d, disable: %{public}d",
-                    devices_.size(), static_cast<int32_t>(interfaceType), disable);
-                ret = UsbInterfaceAuthorize(dev, it->second->GetConfigs()[index].GetId(), interface.GetId(), !disable);
-                interface.SetAuthorizeStatus(disable ? DISABLED : ENABLED);
-                USB_HILOGI(MODULE_USB_HOST, "UsbInterfaceAuthorize ret = %{public}d", ret);
-            }
-            if (disable && needReport && ret == UEC_OK) {
-                ReportManageDeviceInfo("InterfaceType", it->second, &interface, true);
+    int32_t ret = OpenDevice(device.GetBusNum(), device.GetDevAddr());
+    if (ret != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "ManageDeviceImpl open fail ret = %{public}d", ret);
+        return ret;
+    }
+    ret = UsbDeviceAuthorize(device.GetBusNum(), device.GetDevAddr(), !disable, "DeviceType");
+    USB_HILOGI(MODULE_USB_HOST, "UsbDeviceAuthorize ret = %{public}d", ret);
+    if (Close(device.GetBusNum(), device.GetDevAddr()) != UEC_OK) {
+        USB_HILOGW(MODULE_USB_HOST, "ManageDeviceImpl Close fail");
+    }
+    return UEC_OK;
+}
+
+int32_t UsbHostManager::ManageInterfaceTypeImpl(UsbDevice &device, const UsbPolicyMatcher &matcher, bool disable)
+{
+    if (device.GetClass() == BASE_CLASS_HUB || device.GetAuthorizeStatus() == DISABLED) {
+        return UEC_OK;
+    }
+    UsbDev dev = {device.GetBusNum(), device.GetDevAddr()};
+    uint8_t configIndex = 0;
+    if (GetActiveConfig(dev.busNum, dev.devAddr, configIndex)) {
+        USB_HILOGW(MODULE_USB_HOST, "get device active config failed.");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    uint8_t index = static_cast<uint8_t>(configIndex) - 1;
+    if (index >= device.GetConfigs().size()) {
+        USB_HILOGW(MODULE_USB_HOST, "get device config info failed.");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    std::vector<UsbPolicyMatcher::TypeDecision> decisions;
+    for (auto &interface : device.GetConfigs()[index].GetInterfaces()) {
+        decisions.clear();
+        matcher.MatchInterfaceType(interface.GetClass(), interface.GetSubClass(), interface.GetProtocol(), decisions);
+        for (auto &[interfaceType, inPolicy] : decisions) {
+            // types listed by the policy follow disable, the others are set the opposite way
+            bool execDisable = inPolicy ? disable : !disable;
+            bool needReport = interface.GetAuthorizeStatus() != !execDisable;
+            USB_HILOGI(MODULE_USB_HOST, "size %{public}zu, interfaceType: %{public}d, disable: %{public}d",
+                devices_.size(), static_cast<int32_t>(interfaceType), execDisable);
+            int32_t ret = UsbInterfaceAuthorize(dev, device.GetConfigs()[index].GetId(), interface.GetId(),
+                !execDisable);
+            interface.SetAuthorizeStatus(execDisable ? DISABLED : ENABLED);
+            USB_HILOGI(MODULE_USB_HOST, "UsbInterfaceAuthorize ret = %{public}d", ret);
+            if (execDisable && needReport && ret == UEC_OK) {
+                ReportManageDeviceInfo("InterfaceType", &device, &interface, true);
             }
         }
     }
     return UEC_OK;
 }
 
-int32_t UsbHostManager::ManageDeviceTypeImpl(InterfaceType interfaceType, bool disable)
+int32_t UsbHostManager::ManageDeviceTypeImpl(UsbDevice &device, const UsbPolicyMatcher &matcher, bool disable)
 {
-    auto iterInterface = d_typeMap.find(interfaceType);
-    int32_t ret;
-    if (iterInterface == d_typeMap.end()) {
-        USB_HILOGE(MODULE_USB_HOST, "UsbHostManager::not find interface type");
-        return UEC_SERVICE_INVALID_VALUE;
+    if (IsUsbSerialDisable() && IsUsbSerialDevice(device)) {
+        return UEC_OK;   // managed by usb serial policy
     }
-    for (auto it = devices_.begin(); it != devices_.end(); ++it) {
-        if (IsUsbSerialDisable() && IsUsbSerialDevice(*it->second)) {
-            continue;   // managed by usb serial policy
-        }
-        if ((it->second->GetClass() == iterInterface->second[BASECLASS_INDEX]) &&
-            (it->second->GetSubclass() == iterInterface->second[SUBCLASS_INDEX] ||
-            iterInterface->second[SUBCLASS_INDEX] == RANDOM_VALUE_INDICATE) &&
-            (it->second->GetProtocol() == iterInterface->second[PROTOCAL_INDEX] ||
-            iterInterface->second[PROTOCAL_INDEX] == RANDOM_VALUE_INDICATE)) {
-            USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu, interfaceType: %{public}d, disable: %{public}d",
-                devices_.size(), static_cast<int32_t>(interfaceType), disable);
-            ret = OpenDevice(it->second->GetBusNum(), it->second->GetDevAddr());
-            if (ret != UEC_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "ManageDeviceTypeImpl open fail ret = %{public}d", ret);
-                continue;
-            }
-            ret = UsbDeviceAuthorize(it->second->GetBusNum(), it->second->GetDevAddr(), !disable, "InterfaceType");
-            USB_HILOGI(MODULE_USB_HOST, "UsbDeviceAuthorize ret = %{public}d", ret);
-            if (Close(it->second->GetBusNum(), it->second->GetDevAddr()) != UEC_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "ManageDeviceTypeImpl CloseDevice fail");
-            }
+    std::vector<UsbPolicyMatcher::TypeDecision> decisions;
+    matcher.MatchDeviceType(device.GetClass(), device.GetSubclass(), device.GetProtocol(), decisions);
+    for (auto &[interfaceType, inPolicy] : decisions) {
+        bool execDisable = inPolicy ? disable : !disable;
+        USB_HILOGI(MODULE_USB_HOST, "list size %{public}zu, interfaceType: %{public}d, disable: %{public}d",
+            devices_.size(), static_cast<int32_t>(interfaceType), execDisable);
+        int32_t ret = OpenDevice(device.GetBusNum(), device.GetDevAddr());
+        if (ret != UEC_OK) {
+            USB_HILOGW(MODULE_USB_HOST, "ManageDeviceTypeImpl open fail ret = %{public}d", ret);
+            return ret;
+        }
+        ret = UsbDeviceAuthorize(device.GetBusNum(), device.GetDevAddr(), !execDisable, "InterfaceType");
+        USB_HILOGI(MODULE_USB_HOST, "UsbDeviceAuthorize ret = %{public}d", ret);
+        if (Close(device.GetBusNum(), device.GetDevAddr()) != UEC_OK) {
+            USB_HILOGW(MODULE_USB_HOST, "ManageDeviceTypeImpl CloseDevice fail");
         }
     }
     return UEC_OK;
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_policy_matcher.h"
+
+#include <iterator>
+
+#include "hilog_wrapper.h"
+
+namespace OHOS {
+namespace USB {
+constexpr int32_t BASECLASS_INDEX = 0;
+constexpr int32_t SUBCLASS_INDEX = 1;
+constexpr int32_t PROTOCAL_INDEX = 2;
+constexpr int32_t TYPE_VALUE_SIZE = 3;
+constexpr int32_t RANDOM_VALUE_INDICATE = -1;
+constexpr int32_t TYPE_VALUE_MAX = 0xFF;
+constexpr uint32_t TYPE_KEY_BITS = 9;
+constexpr uint32_t TYPE_KEY_INVALID = UINT32_MAX;
+constexpr uint32_t VID_PID_SHIFT = 16;
+constexpr uint32_t VID_PID_MASK = 0xFFFF;
+
+UsbTypeTable::UsbTypeTable(const std::unordered_map<InterfaceType, std::vector<int32_t>> &map)
+{
+    for (auto &[interfaceType, typeValues] : map) {
+        if (typeValues.size() < TYPE_VALUE_SIZE) {
+            continue;
+        }
+        uint32_t key = GetKey(typeValues[BASECLASS_INDEX], typeValues[SUBCLASS_INDEX], typeValues[PROTOCAL_INDEX]);
+        if (key != TYPE_KEY_INVALID) {
+            table_[key].emplace_back(interfaceType);
+        }
+    }
+}
+
+uint32_t UsbTypeTable::GetKey(int32_t baseClass, int32_t subClass, int32_t protocol)
+{
+    auto valid = [](int32_t value) { return value >= RANDOM_VALUE_INDICATE && value <= TYPE_VALUE_MAX; };
+    if (!valid(baseClass) || !valid(subClass) || !valid(protocol)) {
+        return TYPE_KEY_INVALID;
+    }
+    // shift by one so that the -1 wildcard gets its own slot
+    return (static_cast<uint32_t>(baseClass + 1) << (TYPE_KEY_BITS + TYPE_KEY_BITS)) |
+        (static_cast<uint32_t>(subClass + 1) << TYPE_KEY_BITS) | static_cast<uint32_t>(protocol + 1);
+}
+
+void UsbTypeTable::Match(int32_t baseClass, int32_t subClass, int32_t protocol,
+    std::vector<InterfaceType> &types) const
+{
+    const int32_t subClasses[] = {subClass, RANDOM_VALUE_INDICATE};
+    const int32_t protocols[] = {protocol, RANDOM_VALUE_INDICATE};
+    for (size_t i = 0; i < std::size(subClasses); ++i) {
+        for (size_t j = 0; j < std::size(protocols); ++j) {
+            if ((i > 0 && subClass == RANDOM_VALUE_INDICATE) || (j > 0 && protocol == RANDOM_VALUE_INDICATE)) {
+                continue;
+            }
+            auto it = table_.find(GetKey(baseClass, subClasses[i], protocols[j]));
+            if (it != table_.end()) {
+                types.insert(types.end(), it->second.begin(), it->second.end());
+            }
+        }
+    }
+}
+
+bool UsbTypeTable::MatchFirst(int32_t baseClass, int32_t subClass, int32_t protocol, InterfaceType &type) const
+{
+    std::vector<InterfaceType> types;
+    Match(baseClass, subClass, protocol, types);
+    if (types.empty()) {
+        return false;
+    }
+    type = types.front();
+    return true;
+}
+
+const UsbTypeTable &UsbPolicyMatcher::GetDeviceTypeTable()
+{
+    static const UsbTypeTable table(d_typeMap);
+    return table;
+}
+
+const UsbTypeTable &UsbPolicyMatcher::GetInterfaceTypeTable()
+{
+    static const UsbTypeTable table(g_typeMap);
+    return table;
+}
+
+void UsbPolicyMatcher::CompileTypePolicy(const std::vector<UsbDeviceType> &disableType)
+{
+    disabledDeviceTypes_.clear();
+    disabledInterfaceTypes_.clear();
+    for (const auto &dev : disableType) {
+        const UsbTypeTable &table = dev.isDeviceType ? GetDeviceTypeTable() : GetInterfaceTypeTable();
+        InterfaceType interfaceType;
+        if (!table.MatchFirst(dev.baseClass, dev.subClass, dev.protocol, interfaceType)) {
+            USB_HILOGE(MODULE_USB_HOST, "is not in the type list, %{public}d, %{public}d, %{public}d",
+                dev.baseClass, dev.subClass, dev.protocol);
+            continue;
+        }
+        if (dev.isDeviceType) {
+            disabledDeviceTypes_.insert(interfaceType);
+        } else {
+            disabledInterfaceTypes_.insert(interfaceType);
+        }
+    }
+}
+
+void UsbPolicyMatcher::CompileTrustList(const std::vector<UsbDeviceId> &trustList)
+{
+    trustList_.clear();
+    trustList_.reserve(trustList.size());
+    for (const auto &id : trustList) {
+        trustList_.insert(GetVidPidKey(id.vendorId, id.productId));
+    }
+}
+
+void UsbPolicyMatcher::Decide(const UsbTypeTable &table, const std::unordered_set<InterfaceType> &disabled,
+    int32_t baseClass, int32_t subClass, int32_t protocol, std::vector<TypeDecision> &decisions)
+{
+    std::vector<InterfaceType> types;
+    table.Match(baseClass, subClass, protocol, types);
+    for (auto interfaceType : types) {
+        decisions.emplace_back(interfaceType, disabled.count(interfaceType) != 0);
+    }
+}
+
+void UsbPolicyMatcher::MatchDeviceType(int32_t baseClass, int32_t subClass, int32_t protocol,
+    std::vector<TypeDecision> &decisions) const
+{
+    Decide(GetDeviceTypeTable(), disabledDeviceTypes_, baseClass, subClass, protocol, decisions);
+}
+
+void UsbPolicyMatcher::MatchInterfaceType(int32_t baseClass, int32_t subClass, int32_t protocol,
+    std::vector<TypeDecision> &decisions) const
+{
+    Decide(GetInterfaceTypeTable(), disabledInterfaceTypes_, baseClass, subClass, protocol, decisions);
+}
+
+bool UsbPolicyMatcher::IsTrusted(int32_t vendorId, int32_t productId) const
+{
+    return trustList_.count(GetVidPidKey(vendorId, productId)) != 0;
+}
+
+bool UsbPolicyMatcher::IsTrustListEmpty() const
+{
+    return trustList_.empty();
+}
+
+uint32_t UsbPolicyMatcher::GetVidPidKey(int32_t vendorId, int32_t productId)
+{
+    return ((static_cast<uint32_t>(vendorId) & VID_PID_MASK) << VID_PID_SHIFT) |
+        (static_cast<uint32_t>(productId) & VID_PID_MASK);
+}
+} // namespace USB
+} // namespace OHOS
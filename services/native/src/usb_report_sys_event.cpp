@@ -35,52 +35,37 @@ namespace USB {
 constexpr int32_t ERR_CODE_TIMEOUT = -7;
 
 void UsbReportSysEvent::ReportTransferFaultSysEvent(const std::string transferType, UsbDevice &usbDev,
-    const HDI::Usb::V1_0::UsbPipe &tmpPipe, int32_t ret, const std::string description)
+    const HDI::Usb::V1_0::UsbPipe &tmpPipe, int32_t ret, const std::string description, uint32_t count)
 {
     UsbInterface itIF;
-    USB_HILOGI(MODULE_USB_UTILS, "report transfor fault sys event");
     if (!GetUsbInterfaceId(usbDev, tmpPipe, tmpPipe.intfId, itIF)) {
         USB_HILOGE(MODULE_USB_UTILS, "GetUsbConfigs failed");
         return;
     }
-    int32_t hiRet = HiSysEventWrite(HiSysEvent::Domain::USB, "TRANSFER_FAULT",
-        HiSysEvent::EventType::FAULT, "TRANSFER_TYPE", transferType,
-        "VENDOR_ID", usbDev.GetVendorId(), "PRODUCT_ID", usbDev.GetProductId(),
-        "INTERFACE_CLASS", itIF.GetClass(), "INTERFACE_SUBCLASS", itIF.GetSubClass(),
-        "INTERFACE_PROTOCOL", itIF.GetProtocol(),
-        "INTF_ID", tmpPipe.intfId, "ENDPOINTT_ID", tmpPipe.endpointId,
-        "FAIL_REASON", ret, "FAIL_DESCRIPTION", description);
-    if (hiRet != UEC_OK) {
-        USB_HILOGE(MODULE_USB_UTILS, "HiSysEventWrite ret: %{public}d", hiRet);
-    }
-
-#ifdef USB_PERIPHERAL_FAULT_NOTIFY
-    ExternalDeviceManager::DriverExtMgrClient::GetInstance().NotifyUsbPeripheralFault(
-        HiSysEvent::Domain::USB, "TRANSFOR_FAULT"); // "TRANSFOR" in external_device code
-#endif
+    UsbTransferFault fault;
+    fault.transferType = transferType;
+    fault.description = description.c_str();
+    fault.ret = ret;
+    fault.pipe = tmpPipe;
+    fault.vendorId = usbDev.GetVendorId();
+    fault.productId = usbDev.GetProductId();
+    fault.interfaceClass = itIF.GetClass();
+    fault.interfaceSubClass = itIF.GetSubClass();
+    fault.interfaceProtocol = itIF.GetProtocol();
+    ReportTransferFaultSysEvent(fault, count);
 }
 
-void UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent(const std::string transferType,
-    UsbDevice &usbDev, const HDI::Usb::V1_0::UsbPipe &tmpPipe, const USBEndpoint &ep,
-    int32_t ret, const std::string description)
+void UsbReportSysEvent::ReportTransferFaultSysEvent(const UsbTransferFault &fault, uint32_t count)
 {
-    UsbInterface itIF;
     USB_HILOGI(MODULE_USB_UTILS, "report transfor fault sys event");
-    if (ep.GetAttributes() == 0x03 && ret == ERR_CODE_TIMEOUT) {
-        USB_HILOGE(MODULE_USB_UTILS, "submitTransfer is timeout");
-        return;
-    }
-    if (!GetUsbInterfaceId(usbDev, tmpPipe, tmpPipe.intfId, itIF)) {
-        USB_HILOGE(MODULE_USB_UTILS, "GetUsbConfigs failed");
-        return;
-    }
     int32_t hiRet = HiSysEventWrite(HiSysEvent::Domain::USB, "TRANSFER_FAULT",
-        HiSysEvent::EventType::FAULT, "TRANSFER_TYPE", transferType,
-        "VENDOR_ID", usbDev.GetVendorId(), "PRODUCT_ID", usbDev.GetProductId(),
-        "INTERFACE_CLASS", itIF.GetClass(), "INTERFACE_SUBCLASS", itIF.GetSubClass(),
-        "INTERFACE_PROTOCOL", itIF.GetProtocol(),
-        "INTF_ID", tmpPipe.intfId, "ENDPOINTT_ID", tmpPipe.endpointId,
-        "FAIL_REASON", ret, "FAIL_DESCRIPTION", description);
+        HiSysEvent::EventType::FAULT, "TRANSFER_TYPE", fault.transferType,
+        "VENDOR_ID", fault.vendorId, "PRODUCT_ID", fault.productId,
+        "INTERFACE_CLASS", fault.interfaceClass, "INTERFACE_SUBCLASS", fault.interfaceSubClass,
+        "INTERFACE_PROTOCOL", fault.interfaceProtocol,
+        "INTF_ID", fault.pipe.intfId, "ENDPOINTT_ID", fault.pipe.endpointId,
+        "FAIL_REASON", fault.ret,
+        "FAIL_DESCRIPTION", std::string(fault.description == nullptr ? "" : fault.description), "FAIL_COUNT", count);
     if (hiRet != UEC_OK) {
         USB_HILOGE(MODULE_USB_UTILS, "HiSysEventWrite ret: %{public}d", hiRet);
     }
@@ -91,6 +76,12 @@ void UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent(const std::str
 #endif
 }
 
+bool UsbReportSysEvent::IsExpectedTransferFault(const USBEndpoint &ep, int32_t ret)
+{
+    // an interrupt endpoint times out whenever the device has nothing to report
+    return ep.GetAttributes() == 0x03 && ret == ERR_CODE_TIMEOUT;
+}
+
 bool UsbReportSysEvent::GetUsbInterfaceId(UsbDevice &usbDev, const HDI::Usb::V1_0::UsbPipe &tmpPipe,
     int32_t interfaceId, UsbInterface &itIF)
 {
@@ -189,7 +189,7 @@ std::shared_ptr<OHOS::NativeRdb::ResultSet> UsbRightDataBase::QuerySql(
         USB_HILOGE(MODULE_USB_HOST, "QuerySql(sql) store_ is nullptr");
         return nullptr;
     }
-    return store_->QuerySql(sql);
+    return store_->QuerySql(sql, selectionArgs);
 }
 
 std::shared_ptr<OHOS::NativeRdb::ResultSet> UsbRightDataBase::Query(
@@ -210,6 +210,7 @@ int32_t UsbRightDataBaseCallBack::OnCreate(OHOS::NativeRdb::RdbStore &store)
         USB_HILOGE(MODULE_USB_HOST, "OnCreate failed: %{public}d", ret);
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
+    (void)CreateIndex(store);
     USB_HILOGI(MODULE_USB_HOST, "DB OnCreate Done: %{public}d", ret);
     return USB_RIGHT_OK;
 }
@@ -221,11 +222,29 @@ int32_t UsbRightDataBaseCallBack::OnUpgrade(OHOS::NativeRdb::RdbStore &store, in
         return USB_RIGHT_OK;
     }
 
-    std::string sql = SQL_ADD_TOKEN_ID;
-    int32_t ret = store.ExecuteSql(sql);
-    if (ret != OHOS::NativeRdb::E_OK) {
-        // ignore sql error when tokenId is already exists
-        USB_HILOGW(MODULE_USB_HOST, "DB OnUpgrade failed: %{public}d", ret);
+    if (oldVersion < DATABASE_VERSION_TOKEN_ID) {
+        std::string sql = SQL_ADD_TOKEN_ID;
+        int32_t ret = store.ExecuteSql(sql);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            // ignore sql error when tokenId is already exists
+            USB_HILOGW(MODULE_USB_HOST, "DB OnUpgrade failed: %{public}d", ret);
+        }
+    }
+    if (oldVersion < DATABASE_VERSION_INDEX) {
+        (void)CreateIndex(store);
+    }
+    return USB_RIGHT_OK;
+}
+
+int32_t UsbRightDataBaseCallBack::CreateIndex(OHOS::NativeRdb::RdbStore &store)
+{
+    for (const char *sql : {CREATE_USB_RIGHT_INDEX, CREATE_USB_RIGHT_APP_INDEX}) {
+        int32_t ret = store.ExecuteSql(sql);
+        if (ret != OHOS::NativeRdb::E_OK) {
+            // lookups still work without the index, only slower
+            USB_HILOGW(MODULE_USB_HOST, "create index failed: %{public}d", ret);
+            return USB_RIGHT_RDB_EXECUTE_FAILTURE;
+        }
     }
     return USB_RIGHT_OK;
 }
@@ -26,6 +26,35 @@ using namespace OHOS::NativeRdb;
 
 namespace OHOS {
 namespace USB {
+/*
+ * Every query is a constant statement with bound arguments, so the store compiles it once, and selects the
+ * columns in the order of RightColumn, so reading a row needs no column lookup.
+ */
+constexpr const char *SQL_SELECT_RIGHT = "SELECT id, uid, installTime, updateTime, requestTime, validPeriod, "
+                                         "bundleName FROM usbRightInfoTable WHERE ";
+constexpr const char *SQL_WHERE_RIGHT = "uid = ? AND deviceName = ? AND bundleName = ? AND tokenId = ?";
+constexpr const char *SQL_WHERE_USER = "uid = ?";
+constexpr const char *SQL_WHERE_DEVICE = "uid = ? AND deviceName = ?";
+constexpr const char *SQL_WHERE_APP = "uid = ? AND bundleName = ?";
+constexpr const char *SQL_WHERE_NORMAL_EXPIRED = "uid = ? AND requestTime < ? AND validPeriod NOT IN (?, ?)";
+constexpr const char *SQL_SELECT_RIGHT_EXISTS = "SELECT id FROM usbRightInfoTable "
+                                                "WHERE uid = ? AND deviceName = ? AND bundleName = ? AND tokenId = ? "
+                                                "LIMIT 1";
+constexpr const char *SQL_SELECT_UIDS = "SELECT DISTINCT uid FROM usbRightInfoTable";
+constexpr const char *SQL_SELECT_APPS = "SELECT DISTINCT bundleName FROM usbRightInfoTable WHERE uid = ?";
+constexpr const char *SQL_SELECT_COUNT = "SELECT COUNT(*) FROM usbRightInfoTable";
+
+enum RightColumn : int32_t {
+    RIGHT_COLUMN_ID = 0,
+    RIGHT_COLUMN_UID,
+    RIGHT_COLUMN_INSTALL_TIME,
+    RIGHT_COLUMN_UPDATE_TIME,
+    RIGHT_COLUMN_REQUEST_TIME,
+    RIGHT_COLUMN_VALID_PERIOD,
+    RIGHT_COLUMN_BUNDLE_NAME,
+};
+constexpr int32_t FIRST_COLUMN = 0;
+
 std::shared_ptr<UsbRightDbHelper> UsbRightDbHelper::instance_;
 
 UsbRightDbHelper::UsbRightDbHelper()
@@ -133,30 +162,18 @@ int32_t UsbRightDbHelper::AddRightRecord(
     return ret;
 }
 
-int32_t UsbRightDbHelper::QueryAndGetResult(const RdbPredicates &rdbPredicates, const std::vector<std::string> &columns,
+int32_t UsbRightDbHelper::QueryAndGetResult(const std::string &whereClause, const std::vector<std::string> &whereArgs,
     std::vector<struct UsbRightAppInfo> &infos)
 {
     if (rightDatabase_ == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "rightDatabase_ is null");
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    int32_t ret = rightDatabase_->BeginTransaction();
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "BeginTransaction error: %{public}d", ret);
-        return ret;
-    }
-    auto resultSet = rightDatabase_->Query(rdbPredicates, columns);
+    auto resultSet = rightDatabase_->QuerySql(std::string(SQL_SELECT_RIGHT) + whereClause, whereArgs);
     if (resultSet == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "Query error");
-        (void)rightDatabase_->RollBack();
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    ret = rightDatabase_->Commit();
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "Commit error: %{public}d", ret);
-        (void)rightDatabase_->RollBack();
-        return ret;
-    }
     return GetResultRightRecordEx(resultSet, infos);
 }
 
@@ -165,28 +182,14 @@ int32_t UsbRightDbHelper::QueryRightRecord(int32_t uid, const std::string &devic
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
     USB_HILOGI(MODULE_USB_HOST, "Query detail: uid=%{public}d app=%{public}s", uid, bundleName.c_str());
-    std::vector<std::string> columns;
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.BeginWrap()
-        ->EqualTo("uid", std::to_string(uid))
-        ->And()
-        ->EqualTo("deviceName", deviceName)
-        ->And()
-        ->EqualTo("bundleName", bundleName)
-        ->And()
-        ->EqualTo("tokenId", tokenId)
-        ->EndWrap();
-    return QueryAndGetResult(rdbPredicates, columns, infos);
+    return QueryAndGetResult(SQL_WHERE_RIGHT, {std::to_string(uid), deviceName, bundleName, tokenId}, infos);
 }
 
 int32_t UsbRightDbHelper::QueryUserRightRecord(int32_t uid, std::vector<struct UsbRightAppInfo> &infos)
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
     USB_HILOGD(MODULE_USB_HOST, "Query detail: uid=%{public}d", uid);
-    std::vector<std::string> columns;
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.EqualTo("uid", std::to_string(uid));
-    return QueryAndGetResult(rdbPredicates, columns, infos);
+    return QueryAndGetResult(SQL_WHERE_USER, {std::to_string(uid)}, infos);
 }
 
 int32_t UsbRightDbHelper::QueryDeviceRightRecord(
@@ -194,10 +197,7 @@ int32_t UsbRightDbHelper::QueryDeviceRightRecord(
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
     USB_HILOGD(MODULE_USB_HOST, "Query detail: uid=%{public}d", uid);
-    std::vector<std::string> columns;
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.BeginWrap()->EqualTo("uid", std::to_string(uid))->And()->EqualTo("deviceName", deviceName)->EndWrap();
-    return QueryAndGetResult(rdbPredicates, columns, infos);
+    return QueryAndGetResult(SQL_WHERE_DEVICE, {std::to_string(uid), deviceName}, infos);
 }
 
 int32_t UsbRightDbHelper::QueryAppRightRecord(
@@ -205,77 +205,41 @@ int32_t UsbRightDbHelper::QueryAppRightRecord(
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
     USB_HILOGD(MODULE_USB_HOST, "Query detail: uid=%{public}d dev=%{public}s", uid, bundleName.c_str());
-    std::vector<std::string> columns;
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.BeginWrap()->EqualTo("uid", std::to_string(uid))->And()->EqualTo("bundleName", bundleName)->EndWrap();
-    return QueryAndGetResult(rdbPredicates, columns, infos);
+    return QueryAndGetResult(SQL_WHERE_APP, {std::to_string(uid), bundleName}, infos);
 }
 
 int32_t UsbRightDbHelper::QueryRightRecordUids(std::vector<std::string> &uids)
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
-    std::vector<std::string> columns = {"uid"};
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.Distinct();
-    return QueryAndGetResultColumnValues(rdbPredicates, columns, "uid", uids);
+    return QueryAndGetResultColumnValues(SQL_SELECT_UIDS, {}, uids);
 }
 
 int32_t UsbRightDbHelper::QueryRightRecordApps(int32_t uid, std::vector<std::string> &apps)
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
-    std::vector<std::string> columns = {"bundleName"};
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.EqualTo("uid", std::to_string(uid))->Distinct();
-    return QueryAndGetResultColumnValues(rdbPredicates, columns, "bundleName", apps);
+    return QueryAndGetResultColumnValues(SQL_SELECT_APPS, {std::to_string(uid)}, apps);
 }
 
-int32_t UsbRightDbHelper::QueryAndGetResultColumnValues(const RdbPredicates &rdbPredicates,
-    const std::vector<std::string> &columns, const std::string &columnName, std::vector<std::string> &columnValues)
+int32_t UsbRightDbHelper::QueryAndGetResultColumnValues(
+    const std::string &sql, const std::vector<std::string> &selectionArgs, std::vector<std::string> &columnValues)
 {
     if (rightDatabase_ == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "rightDatabase_ is null");
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    int32_t ret = rightDatabase_->BeginTransaction();
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "BeginTransaction error: %{public}d", ret);
-        return ret;
-    }
-    auto resultSet = rightDatabase_->Query(rdbPredicates, columns);
+    auto resultSet = rightDatabase_->QuerySql(sql, selectionArgs);
     if (resultSet == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "Query error");
-        (void)rightDatabase_->RollBack();
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    ret = rightDatabase_->Commit();
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "Commit error: %{public}d", ret);
-        (void)rightDatabase_->RollBack();
-        return ret;
-    }
-    int32_t rowCount = 0;
-    int32_t columnIndex = 0;
-    if (resultSet->GetRowCount(rowCount) != E_OK || resultSet->GetColumnIndex(columnName, columnIndex) != E_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "get table info failed");
-        return USB_RIGHT_RDB_EXECUTE_FAILTURE;
-    }
-    bool endFlag = false;
-    for (int32_t i = 0; (i < rowCount) && !endFlag; i++) {
-        if (resultSet->GoToRow(i) != E_OK) {
-            USB_HILOGE(MODULE_USB_HOST, "GoToRow %{public}d", i);
-            return USB_RIGHT_RDB_EXECUTE_FAILTURE;
-        }
+    while (resultSet->GoToNextRow() == E_OK) {
         std::string tempStr;
-        if (resultSet->GetString(columnIndex, tempStr) == E_OK) {
+        if (resultSet->GetString(FIRST_COLUMN, tempStr) == E_OK) {
             columnValues.push_back(tempStr);
         }
-        resultSet->IsEnded(endFlag);
     }
-    int32_t position = 0;
-    resultSet->GetRowIndex(position);
-    resultSet->IsEnded(endFlag);
-    USB_HILOGD(MODULE_USB_HOST, "idx=%{public}d rows=%{public}d pos=%{public}d ret=%{public}zu end=%{public}s",
-        columnIndex, rowCount, position, columnValues.size(), (endFlag ? "yes" : "no"));
+    resultSet->Close();
+    USB_HILOGD(MODULE_USB_HOST, "ret=%{public}zu", columnValues.size());
     return columnValues.size();
 }
 
@@ -438,17 +402,66 @@ int32_t UsbRightDbHelper::DeleteUidRightRecord(int32_t uid)
 int32_t UsbRightDbHelper::DeleteNormalExpiredRightRecord(int32_t uid, uint64_t expiredTime)
 {
     std::lock_guard<std::mutex> guard(databaseMutex_);
-    std::string whereClause = {"uid = ? AND requestTime < ? AND validPeriod NOT IN (?, ?)"};
+    int32_t ret = DeleteAndNoOtherOperation(SQL_WHERE_NORMAL_EXPIRED, GetNormalExpiredWhereArgs(uid, expiredTime));
+    if (ret != USB_RIGHT_OK) {
+        USB_HILOGE(MODULE_USB_HOST,
+        "failed: delete(uid=%{public}d, expr<%{public}" PRIu64 "): %{public}d", uid, expiredTime, ret);
+    }
+    return ret;
+}
 
+std::vector<std::string> UsbRightDbHelper::GetNormalExpiredWhereArgs(int32_t uid, uint64_t expiredTime)
+{
     uint64_t relativeExpiredTime = (expiredTime <= USB_RIGHT_VALID_PERIOD_SET) ? 0 :
         (expiredTime - USB_RIGHT_VALID_PERIOD_SET);
-    std::vector<std::string> whereArgs = {std::to_string(uid), std::to_string(relativeExpiredTime),
+    return {std::to_string(uid), std::to_string(relativeExpiredTime),
         std::to_string(USB_RIGHT_VALID_PERIOD_MIN), std::to_string(USB_RIGHT_VALID_PERIOD_MAX)};
-    int32_t ret = DeleteAndNoOtherOperation(whereClause, whereArgs);
-    if (ret != USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST,
-        "failed: delete(uid=%{public}d, expr<%{public}" PRIu64 "): %{public}d", uid, expiredTime, ret);
+}
+
+int32_t UsbRightDbHelper::DeleteSweptRightRecord(const struct UsbRightSweep &sweep)
+{
+    if (rightDatabase_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "rightDatabase_ is null");
+        return USB_RIGHT_RDB_EXECUTE_FAILTURE;
+    }
+    std::vector<std::pair<const char *, std::vector<std::string>>> deletes;
+    if (sweep.expiredTime != 0) {
+        deletes.emplace_back(SQL_WHERE_NORMAL_EXPIRED, GetNormalExpiredWhereArgs(sweep.uid, sweep.expiredTime));
+    }
+    for (const auto &bundleName : sweep.bundleNames) {
+        deletes.emplace_back(SQL_WHERE_APP, std::vector<std::string> {std::to_string(sweep.uid), bundleName});
+    }
+    for (int32_t uid : sweep.deletedUids) {
+        deletes.emplace_back(SQL_WHERE_USER, std::vector<std::string> {std::to_string(uid)});
     }
+    if (deletes.empty()) {
+        return USB_RIGHT_NOP;
+    }
+    std::lock_guard<std::mutex> guard(databaseMutex_);
+    int32_t ret = rightDatabase_->BeginTransaction();
+    if (ret < USB_RIGHT_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "BeginTransaction error: %{public}d", ret);
+        return ret;
+    }
+    int32_t totalRows = 0;
+    for (const auto &[whereClause, whereArgs] : deletes) {
+        int32_t changedRows = 0;
+        ret = rightDatabase_->Delete(changedRows, whereClause, whereArgs);
+        if (ret < USB_RIGHT_OK) {
+            USB_HILOGE(MODULE_USB_HOST, "Delete error: %{public}d", ret);
+            (void)rightDatabase_->RollBack();
+            return ret;
+        }
+        totalRows += changedRows;
+    }
+    ret = rightDatabase_->Commit();
+    if (ret < USB_RIGHT_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "Commit error: %{public}d", ret);
+        (void)rightDatabase_->RollBack();
+        return ret;
+    }
+    USB_HILOGI(MODULE_USB_HOST, "sweep deleted %{public}d records by %{public}zu statements", totalRows,
+        deletes.size());
     return ret;
 }
 
@@ -464,86 +477,23 @@ int32_t UsbRightDbHelper::DeleteValidPeriodRightRecord(long validPeriod, const s
     return ret;
 }
 
-int32_t UsbRightDbHelper::GetResultSetTableInfo(
-    const std::shared_ptr<OHOS::NativeRdb::ResultSet> &resultSet, struct UsbRightTableInfo &table)
-{
-    if (resultSet == nullptr) {
-        USB_HILOGE(MODULE_USB_HOST, "resultSet is null");
-        return USB_RIGHT_RDB_EXECUTE_FAILTURE;
-    }
-    int32_t rowCount = 0;
-    int32_t columnCount = 0;
-    std::vector<std::string> columnNames;
-    if (resultSet->GetRowCount(rowCount) != E_OK || resultSet->GetColumnCount(columnCount) != E_OK ||
-        resultSet->GetAllColumnNames(columnNames) != E_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "get table info failed");
-        return USB_RIGHT_RDB_EXECUTE_FAILTURE;
-    }
-    int32_t columnNamesCount = static_cast<int32_t>(columnNames.size());
-    for (int32_t i = 0; i < columnNamesCount; i++) {
-        std::string &columnName = columnNames.at(i);
-        if (columnName == "id") {
-            table.primaryKeyIndex = i;
-        }
-        if (columnName == "uid") {
-            table.uidIndex = i;
-        }
-        if (columnName == "installTime") {
-            table.installTimeIndex = i;
-        }
-        if (columnName == "updateTime") {
-            table.updateTimeIndex = i;
-        }
-        if (columnName == "requestTime") {
-            table.requestTimeIndex = i;
-        }
-        if (columnName == "validPeriod") {
-            table.validPeriodIndex = i;
-        }
-        if (columnName == "bundleName") {
-            table.bundleNameIndex = i;
-        }
-        if (columnName == "deviceName") {
-            table.deviceNameIndex = i;
-        }
-    }
-    table.rowCount = rowCount;
-    table.columnCount = columnCount;
-    USB_HILOGD(MODULE_USB_HOST,
-        "info[%{public}d/%{public}d]: "
-        "%{public}d/%{public}d/%{public}d/%{public}d/%{public}d/%{public}d/%{public}d/%{public}d",
-        rowCount, columnCount, table.primaryKeyIndex, table.uidIndex, table.installTimeIndex, table.updateTimeIndex,
-        table.requestTimeIndex, table.validPeriodIndex, table.deviceNameIndex, table.bundleNameIndex);
-    return USB_RIGHT_OK;
-}
-
 int32_t UsbRightDbHelper::GetResultRightRecordEx(
     const std::shared_ptr<OHOS::NativeRdb::ResultSet> &resultSet, std::vector<struct UsbRightAppInfo> &infos)
 {
-    struct UsbRightTableInfo table;
-    int32_t ret = GetResultSetTableInfo(resultSet, table);
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "GetResultSetTableInfo failed");
-        return ret;
-    }
-    bool endFlag = false;
     int32_t primaryKeyId = 0;
     int64_t installTime = 0;
     int64_t updateTime = 0;
     int64_t requestTime = 0;
     int64_t validPeriod = 0;
-    for (int32_t i = 0; (i < table.rowCount) && !endFlag; i++) {
-        if (resultSet->GoToRow(i) != E_OK) {
-            USB_HILOGE(MODULE_USB_HOST, "GoToRow %{public}d", i);
-            break;
-        }
+    while (resultSet->GoToNextRow() == E_OK) {
         struct UsbRightAppInfo info;
-        if (resultSet->GetInt(table.primaryKeyIndex, primaryKeyId) == E_OK &&
-            resultSet->GetInt(table.uidIndex, info.uid) == E_OK &&
-            resultSet->GetLong(table.installTimeIndex, installTime) == E_OK &&
-            resultSet->GetLong(table.updateTimeIndex, updateTime) == E_OK &&
-            resultSet->GetLong(table.requestTimeIndex, requestTime) == E_OK &&
-            resultSet->GetLong(table.validPeriodIndex, validPeriod) == E_OK) {
+        if (resultSet->GetInt(RIGHT_COLUMN_ID, primaryKeyId) == E_OK &&
+            resultSet->GetInt(RIGHT_COLUMN_UID, info.uid) == E_OK &&
+            resultSet->GetLong(RIGHT_COLUMN_INSTALL_TIME, installTime) == E_OK &&
+            resultSet->GetLong(RIGHT_COLUMN_UPDATE_TIME, updateTime) == E_OK &&
+            resultSet->GetLong(RIGHT_COLUMN_REQUEST_TIME, requestTime) == E_OK &&
+            resultSet->GetLong(RIGHT_COLUMN_VALID_PERIOD, validPeriod) == E_OK &&
+            resultSet->GetString(RIGHT_COLUMN_BUNDLE_NAME, info.bundleName) == E_OK) {
             info.primaryKeyId = static_cast<uint32_t>(primaryKeyId);
             info.installTime = static_cast<uint64_t>(installTime);
             info.updateTime = static_cast<uint64_t>(updateTime);
@@ -551,13 +501,9 @@ int32_t UsbRightDbHelper::GetResultRightRecordEx(
             info.validPeriod = static_cast<uint64_t>(validPeriod);
             infos.push_back(info);
         }
-        resultSet->IsEnded(endFlag);
     }
-    int32_t position = 0;
-    resultSet->GetRowIndex(position);
-    resultSet->IsEnded(endFlag);
-    USB_HILOGD(MODULE_USB_HOST, "row=%{public}d col=%{public}d pos=%{public}d ret=%{public}zu end=%{public}s",
-        table.rowCount, table.columnCount, position, infos.size(), (endFlag ? "yes" : "no"));
+    resultSet->Close();
+    USB_HILOGD(MODULE_USB_HOST, "ret=%{public}zu", infos.size());
     return infos.size();
 }
 
@@ -600,30 +546,15 @@ int32_t UsbRightDbHelper::CheckIfNeedUpdateEx(bool &isUpdate, int32_t uid, const
         USB_HILOGE(MODULE_USB_HOST, "rightDatabase_ is null");
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    std::vector<std::string> columns;
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    rdbPredicates.BeginWrap()
-        ->EqualTo("uid", std::to_string(uid))
-        ->And()
-        ->EqualTo("deviceName", deviceName)
-        ->And()
-        ->EqualTo("bundleName", bundleName)
-        ->And()
-        ->EqualTo("tokenId", tokenId)
-        ->EndWrap();
-    auto resultSet = rightDatabase_->Query(rdbPredicates, columns);
+    auto resultSet = rightDatabase_->QuerySql(SQL_SELECT_RIGHT_EXISTS,
+        std::vector<std::string> {std::to_string(uid), deviceName, bundleName, tokenId});
     if (resultSet == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "Query error");
         (void)rightDatabase_->RollBack();
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    int32_t rowCount = 0;
-    if (resultSet->GetRowCount(rowCount) != E_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "GetRowCount error");
-        (void)rightDatabase_->RollBack();
-        return USB_RIGHT_RDB_EXECUTE_FAILTURE;
-    }
-    isUpdate = (rowCount > 0 ? true : false);
+    isUpdate = (resultSet->GoToFirstRow() == E_OK);
+    resultSet->Close();
     return USB_RIGHT_OK;
 }
 
@@ -667,30 +598,17 @@ int32_t UsbRightDbHelper::QueryRightRecordCount()
         USB_HILOGE(MODULE_USB_HOST, "rightDatabase_ is null");
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    int32_t ret = rightDatabase_->BeginTransaction();
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "BeginTransaction error :%{public}d", ret);
-        return ret;
-    }
-    std::vector<std::string> columns;
-    RdbPredicates rdbPredicates(USB_RIGHT_TABLE_NAME);
-    auto resultSet = rightDatabase_->Query(rdbPredicates, columns);
+    auto resultSet = rightDatabase_->QuerySql(SQL_SELECT_COUNT, {});
     if (resultSet == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "Query error");
-        (void)rightDatabase_->RollBack();
         return USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
-    ret = rightDatabase_->Commit();
-    if (ret < USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "Commit error: %{public}d", ret);
-        (void)rightDatabase_->RollBack();
-        return ret;
-    }
     int32_t rowCount = 0;
-    if (resultSet->GetRowCount(rowCount) != E_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "GetRowCount error");
-        return USB_RIGHT_RDB_EXECUTE_FAILTURE;
+    if (resultSet->GoToFirstRow() != E_OK || resultSet->GetInt(FIRST_COLUMN, rowCount) != E_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "get count error");
+        rowCount = USB_RIGHT_RDB_EXECUTE_FAILTURE;
     }
+    resultSet->Close();
     return rowCount;
 }
 
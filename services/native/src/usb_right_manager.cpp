@@ -16,6 +16,8 @@
 #include "usb_right_manager.h"
 
 #include <algorithm>
+#include <chrono>
+#include <pthread.h>
 #include <semaphore.h>
 #include <sys/types.h>
 #include <unistd.h>
@@ -54,6 +56,9 @@ constexpr int32_t DECIMAL_BASE = 10;
 constexpr int32_t MAX_RETRY_TIMES = 30;
 constexpr int32_t RETRY_INTERVAL_SECONDS = 1;
 constexpr int32_t MESSAGE_PARCEL_KEY_SIZE = 3;
+constexpr size_t CALLER_IDENTITY_CACHE_SIZE = 64;
+constexpr int32_t RIGHT_SWEEP_INTERVAL_SECONDS = 30 * 60;
+constexpr const char *RIGHT_SWEEPER_NAME = "usb_right_sweep";
 const std::string USB_MANAGE_ACCESS_USB_DEVICE = "ohos.permission.MANAGE_USB_CONFIG";
 const std::string DEVELOPERMODE_STATE = "const.security.developermode.state";
 const std::string DEFAULT_SERIAL_BUNDLE_NAME = "com.example.serial";
@@ -73,6 +78,13 @@ constexpr uint32_t TIGHT_UP_USB_RIGHT_RECORD_ALL =
 sem_t UsbRightManager::waitDialogDisappear_ {0};
 std::mutex UsbRightManager::usbDialogParamsMutex_;
 std::map<std::string, std::string> UsbRightManager::usbDialogParams_ = {};
+std::mutex UsbRightManager::rightCacheMutex_;
+std::unordered_map<std::string, UsbRightManager::UsbRightCacheEntry> UsbRightManager::rightCache_ = {};
+uint64_t UsbRightManager::rightCacheGeneration_ = 0;
+std::mutex UsbRightManager::callerIdentityMutex_;
+UsbRightManager::CallerIdentityList UsbRightManager::callerIdentityList_ = {};
+std::unordered_map<uint64_t, UsbRightManager::CallerIdentityList::iterator>
+    UsbRightManager::callerIdentityIndex_ = {};
 
 class RightSubscriber : public CommonEventSubscriber {
 public:
@@ -84,6 +96,10 @@ public:
         std::string wantAction = want.GetAction();
 
         USB_HILOGI(MODULE_USB_HOST, "%{public}s wantAction %{public}s", __func__, wantAction.c_str());
+        EraseCallerIdentityIfNeeded(data);
+#ifdef USB_MANAGER_FEATURE_HOST
+        ClearDeviceSessionsIfNeeded(wantAction);
+#endif // USB_MANAGER_FEATURE_HOST
         if (wantAction == CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED ||
             wantAction == CommonEventSupport::COMMON_EVENT_BUNDLE_REMOVED ||
             wantAction == CommonEventSupport::COMMON_EVENT_PACKAGE_FULLY_REMOVED) {
@@ -130,16 +146,59 @@ public:
 #endif // USB_MANAGER_FEATURE_DEVICE
         }
     }
+
+private:
+    void EraseCallerIdentityIfNeeded(const CommonEventData &data)
+    {
+        auto &want = data.GetWant();
+        std::string wantAction = want.GetAction();
+        if (wantAction == CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED ||
+            wantAction == CommonEventSupport::COMMON_EVENT_BUNDLE_REMOVED ||
+            wantAction == CommonEventSupport::COMMON_EVENT_PACKAGE_FULLY_REMOVED ||
+            wantAction == CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED ||
+            wantAction == CommonEventSupport::COMMON_EVENT_PACKAGE_REPLACED) {
+            /* an updated app may come back with another api version or system app attribute */
+            int32_t uid = want.GetParams().GetIntParam("userId", USB_RIGHT_USERID_DEFAULT);
+            UsbRightManager::EraseCallerIdentityByApp(uid, want.GetBundle());
+        } else if (wantAction == CommonEventSupport::COMMON_EVENT_UID_REMOVED ||
+            wantAction == CommonEventSupport::COMMON_EVENT_USER_REMOVED ||
+            wantAction == CommonEventSupport::COMMON_EVENT_USER_STOPPED) {
+            UsbRightManager::ClearCallerIdentityCache();
+        }
+    }
+
+#ifdef USB_MANAGER_FEATURE_HOST
+    void ClearDeviceSessionsIfNeeded(const std::string &wantAction)
+    {
+        if (wantAction != CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED &&
+            wantAction != CommonEventSupport::COMMON_EVENT_BUNDLE_REMOVED &&
+            wantAction != CommonEventSupport::COMMON_EVENT_PACKAGE_FULLY_REMOVED &&
+            wantAction != CommonEventSupport::COMMON_EVENT_UID_REMOVED &&
+            wantAction != CommonEventSupport::COMMON_EVENT_USER_REMOVED &&
+            wantAction != CommonEventSupport::COMMON_EVENT_USER_STOPPED) {
+            return;
+        }
+        /* rights may be deleted, opened device sessions must query rights again */
+        auto usbService = UsbService::GetGlobalInstance();
+        if (usbService != nullptr) {
+            usbService->ClearDeviceSessions();
+        }
+    }
+#endif // USB_MANAGER_FEATURE_HOST
 };
 
 int32_t UsbRightManager::Init()
 {
+    StartRightSweeper();
     USB_HILOGI(MODULE_USB_HOST, "subscriber app/bundle remove event and uid/user remove event");
     MatchingSkills matchingSkills;
     /* subscribe app/bundle remove event, need permission: ohos.permission.LISTEN_BUNDLE_CHANGE */
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_PACKAGE_REMOVED);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_BUNDLE_REMOVED);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_PACKAGE_FULLY_REMOVED);
+    /* subscribe app update event, the cached caller identity of the app is outdated */
+    matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_PACKAGE_CHANGED);
+    matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_PACKAGE_REPLACED);
     /* subscribe uid/user remove event */
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_UID_REMOVED);
     matchingSkills.AddEvent(CommonEventSupport::COMMON_EVENT_USER_REMOVED);
@@ -171,15 +230,29 @@ int32_t UsbRightManager::Init()
 
 bool UsbRightManager::HasRight(const std::string &deviceName, const std::string &bundleName,
     const std::string &tokenId, const int32_t &userId)
+{
+    uint64_t expireTime = UINT64_MAX;
+    return HasRight(deviceName, bundleName, tokenId, userId, expireTime);
+}
+
+bool UsbRightManager::HasRight(const std::string &deviceName, const std::string &bundleName,
+    const std::string &tokenId, const int32_t &userId, uint64_t &expireTime)
 {
     USB_HILOGI(MODULE_USB_HOST, "HasRight: uid=%{public}d app=%{public}s",
         userId, bundleName.c_str());
+    expireTime = UINT64_MAX;
     if (userId == USB_RIGHT_USERID_CONSOLE) {
         USB_HILOGW(MODULE_USB_HOST, "console called, bypass");
         return true;
     }
     uint64_t nowTime = GetCurrentTimestamp();
-    (void)TidyUpRight(TIGHT_UP_USB_RIGHT_RECORD_EXPIRED);
+    std::string cacheKey = GetRightCacheKey(deviceName, bundleName, tokenId, userId);
+    if (QueryRightCache(cacheKey, nowTime, expireTime)) {
+        return true;
+    }
+    /* taken before the query, an invalidation that races with it keeps the result out of the cache */
+    uint64_t generation = GetRightCacheGeneration();
+    /* expired records are skipped below and deleted by the right sweeper, the check itself writes nothing */
     std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
     // no record or expired record: expired true, has right false, add right next time
     // valid record: expired false, has right true, no need add right
@@ -187,7 +260,199 @@ bool UsbRightManager::HasRight(const std::string &deviceName, const std::string
         USB_HILOGE(MODULE_USB_HOST, "helper is nullptr, false");
         return false;
     }
-    return !helper->IsRecordExpired(userId, deviceName, bundleName, tokenId, nowTime);
+    std::vector<struct UsbRightAppInfo> infos;
+    int32_t ret = helper->QueryRightRecord(userId, deviceName, bundleName, tokenId, infos);
+    if (ret <= 0) {
+        USB_HILOGI(MODULE_USB_HOST, "usb query no record/error: %{public}d", ret);
+        return false;
+    }
+    for (const auto &info : infos) {
+        if (helper->IsRecordExpired(info, nowTime)) {
+            continue;
+        }
+        if (info.validPeriod != USB_RIGHT_VALID_PERIOD_MIN && info.validPeriod != USB_RIGHT_VALID_PERIOD_MAX) {
+            expireTime = info.requestTime + info.validPeriod;
+        }
+        UpdateRightCache(cacheKey, {userId, deviceName, bundleName, tokenId, info.requestTime, expireTime},
+            generation);
+        return true;
+    }
+    return false;
+}
+
+std::string UsbRightManager::GetRightCacheKey(const std::string &deviceName, const std::string &bundleName,
+    const std::string &tokenId, int32_t userId)
+{
+    return std::to_string(userId) + "|" + tokenId + "|" + bundleName + "|" + deviceName;
+}
+
+bool UsbRightManager::QueryRightCache(const std::string &key, uint64_t nowTime, uint64_t &expireTime)
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    auto iter = rightCache_.find(key);
+    if (iter == rightCache_.end()) {
+        return false;
+    }
+    if (nowTime < iter->second.requestTime || nowTime >= iter->second.expireTime) {
+        /* expired or system time changed, fall back to database */
+        rightCache_.erase(iter);
+        return false;
+    }
+    expireTime = iter->second.expireTime;
+    return true;
+}
+
+uint64_t UsbRightManager::GetRightCacheGeneration()
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    return rightCacheGeneration_;
+}
+
+void UsbRightManager::UpdateRightCache(const std::string &key, const UsbRightCacheEntry &entry, uint64_t generation)
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    if (generation != rightCacheGeneration_) {
+        /* the records were changed while they were read, the next check reads them again */
+        return;
+    }
+    rightCache_[key] = entry;
+}
+
+void UsbRightManager::EraseRightCache(const std::string &key)
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    ++rightCacheGeneration_;
+    rightCache_.erase(key);
+}
+
+void UsbRightManager::EraseRightCacheByApp(int32_t userId, const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    ++rightCacheGeneration_;
+    for (auto iter = rightCache_.begin(); iter != rightCache_.end();) {
+        if (iter->second.userId == userId && iter->second.bundleName == bundleName) {
+            iter = rightCache_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void UsbRightManager::EraseRightCacheByUser(int32_t userId)
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    ++rightCacheGeneration_;
+    for (auto iter = rightCache_.begin(); iter != rightCache_.end();) {
+        if (iter->second.userId == userId) {
+            iter = rightCache_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void UsbRightManager::ClearRightCache()
+{
+    std::lock_guard<std::mutex> guard(rightCacheMutex_);
+    ++rightCacheGeneration_;
+    rightCache_.clear();
+}
+
+void UsbRightManager::GetCallerIdentity(UsbCallerIdentity &identity)
+{
+    uint64_t fullTokenId = IPCSkeleton::GetCallingFullTokenID();
+    if (QueryCallerIdentity(fullTokenId, identity)) {
+        return;
+    }
+    ResolveCallerIdentity(fullTokenId, identity);
+    /* a hap whose token info can not be read now is resolved again by the next call */
+    if (identity.tokenType != TOKEN_HAP || identity.isHap) {
+        UpdateCallerIdentity(fullTokenId, identity);
+    }
+}
+
+bool UsbRightManager::QueryCallerIdentity(uint64_t fullTokenId, UsbCallerIdentity &identity)
+{
+    std::lock_guard<std::mutex> guard(callerIdentityMutex_);
+    auto iter = callerIdentityIndex_.find(fullTokenId);
+    if (iter == callerIdentityIndex_.end()) {
+        return false;
+    }
+    callerIdentityList_.splice(callerIdentityList_.begin(), callerIdentityList_, iter->second);
+    identity = iter->second->second;
+    return true;
+}
+
+void UsbRightManager::ResolveCallerIdentity(uint64_t fullTokenId, UsbCallerIdentity &identity)
+{
+    AccessTokenID tokenId = IPCSkeleton::GetCallingTokenID();
+    identity.tokenId = tokenId;
+    identity.tokenIdStr = std::to_string(tokenId);
+    identity.tokenType = static_cast<int32_t>(AccessTokenKit::GetTokenTypeFlag(tokenId));
+    identity.isSystem = TokenIdKit::IsSystemAppByFullTokenID(fullTokenId) || identity.tokenType == TOKEN_NATIVE;
+    if (identity.tokenType != TOKEN_HAP) {
+        return;
+    }
+    HapTokenInfo hapTokenInfoRes;
+    int32_t ret = AccessTokenKit::GetHapTokenInfo(tokenId, hapTokenInfoRes);
+    if (ret != ERR_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "GetHapTokenInfo failed: %{public}d", ret);
+        return;
+    }
+    identity.isHap = true;
+    identity.bundleName = hapTokenInfoRes.bundleName;
+    identity.userId = hapTokenInfoRes.userID;
+    identity.apiVersion = hapTokenInfoRes.apiVersion;
+}
+
+void UsbRightManager::UpdateCallerIdentity(uint64_t fullTokenId, const UsbCallerIdentity &identity)
+{
+    std::lock_guard<std::mutex> guard(callerIdentityMutex_);
+    auto iter = callerIdentityIndex_.find(fullTokenId);
+    if (iter != callerIdentityIndex_.end()) {
+        iter->second->second = identity;
+        callerIdentityList_.splice(callerIdentityList_.begin(), callerIdentityList_, iter->second);
+        return;
+    }
+    if (callerIdentityList_.size() >= CALLER_IDENTITY_CACHE_SIZE) {
+        callerIdentityIndex_.erase(callerIdentityList_.back().first);
+        callerIdentityList_.pop_back();
+    }
+    callerIdentityList_.emplace_front(fullTokenId, identity);
+    callerIdentityIndex_[fullTokenId] = callerIdentityList_.begin();
+}
+
+void UsbRightManager::EraseCallerIdentityByToken(uint32_t tokenId)
+{
+    std::lock_guard<std::mutex> guard(callerIdentityMutex_);
+    for (auto iter = callerIdentityList_.begin(); iter != callerIdentityList_.end();) {
+        if (iter->second.tokenId == tokenId) {
+            callerIdentityIndex_.erase(iter->first);
+            iter = callerIdentityList_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void UsbRightManager::EraseCallerIdentityByApp(int32_t userId, const std::string &bundleName)
+{
+    std::lock_guard<std::mutex> guard(callerIdentityMutex_);
+    for (auto iter = callerIdentityList_.begin(); iter != callerIdentityList_.end();) {
+        if (iter->second.isHap && iter->second.userId == userId && iter->second.bundleName == bundleName) {
+            callerIdentityIndex_.erase(iter->first);
+            iter = callerIdentityList_.erase(iter);
+        } else {
+            ++iter;
+        }
+    }
+}
+
+void UsbRightManager::ClearCallerIdentityCache()
+{
+    std::lock_guard<std::mutex> guard(callerIdentityMutex_);
+    callerIdentityIndex_.clear();
+    callerIdentityList_.clear();
 }
 
 int32_t UsbRightManager::ConnectAbility(const int32_t userId)
@@ -391,6 +656,7 @@ bool UsbRightManager::AddDeviceRight(const std::string &deviceName, const std::s
         return false;
     }
     ret = helper->AddOrUpdateRightRecord(uid, deviceName, hapTokenInfoRes.bundleName, tokenIdStr, info);
+    EraseRightCache(GetRightCacheKey(deviceName, hapTokenInfoRes.bundleName, tokenIdStr, uid));
     if (ret < 0) {
         USB_HILOGE(MODULE_USB_HOST, "add or update failed: %{public}s/%{public}d, ret=%{public}d",
             deviceName.c_str(), uid, ret);
@@ -426,6 +692,7 @@ bool UsbRightManager::AddDeviceRight(const std::string &deviceName, const std::s
         return false;
     }
     int32_t ret = helper->AddOrUpdateRightRecord(userId, deviceName, bundleName, tokenId, info);
+    EraseRightCache(GetRightCacheKey(deviceName, bundleName, tokenId, userId));
     if (ret < 0) {
         USB_HILOGE(MODULE_USB_HOST, "add or update failed: %{public}s/%{public}s/%{public}d, ret=%{public}d",
             deviceName.c_str(), bundleName.c_str(), userId, ret);
@@ -434,6 +701,27 @@ bool UsbRightManager::AddDeviceRight(const std::string &deviceName, const std::s
     return true;
 }
 
+/* an opened device skips the right check, its session must go with the right that granted it */
+static void RevokeDeviceSessions(const std::string &deviceName, const std::string &tokenId)
+{
+#ifdef USB_MANAGER_FEATURE_HOST
+    auto usbService = UsbService::GetGlobalInstance();
+    if (usbService != nullptr) {
+        usbService->RemoveDeviceSessions(tokenId, deviceName);
+    }
+#endif // USB_MANAGER_FEATURE_HOST
+}
+
+static void RevokeAllDeviceSessions()
+{
+#ifdef USB_MANAGER_FEATURE_HOST
+    auto usbService = UsbService::GetGlobalInstance();
+    if (usbService != nullptr) {
+        usbService->ClearDeviceSessions();
+    }
+#endif // USB_MANAGER_FEATURE_HOST
+}
+
 bool UsbRightManager::RemoveDeviceRight(const std::string &deviceName, const std::string &bundleName,
     const std::string &tokenId, const int32_t &userId)
 {
@@ -447,6 +735,8 @@ bool UsbRightManager::RemoveDeviceRight(const std::string &deviceName, const std
         return false;
     }
     int32_t ret = helper->DeleteRightRecord(userId, deviceName, bundleName, tokenId);
+    EraseRightCache(GetRightCacheKey(deviceName, bundleName, tokenId, userId));
+    RevokeDeviceSessions(deviceName, tokenId);
     if (ret < 0) {
         USB_HILOGE(MODULE_USB_HOST, "delete failed: %{public}s/%{public}s/%{public}d", deviceName.c_str(),
             bundleName.c_str(), userId);
@@ -468,6 +758,8 @@ int32_t UsbRightManager::CancelDeviceRight(const std::string &deviceName, const
         return UEC_SERVICE_INNER_ERR;
     }
     int32_t ret = helper->DeleteRightRecord(userId, deviceName, bundleName, tokenId);
+    EraseRightCache(GetRightCacheKey(deviceName, bundleName, tokenId, userId));
+    RevokeDeviceSessions(deviceName, tokenId);
     if (ret < 0) {
         USB_HILOGW(MODULE_USB_HOST, "delete failed: %{public}s/%{public}s/%{public}d", deviceName.c_str(),
             bundleName.c_str(), userId);
@@ -480,7 +772,8 @@ bool UsbRightManager::RemoveDeviceAllRight(const std::string &deviceName)
 {
     USB_HILOGD(MODULE_USB_HOST, "device %{private}s detached, process right", deviceName.c_str());
     CleanUpRightTemporaryExpired(deviceName);
-    TidyUpRight(TIGHT_UP_USB_RIGHT_RECORD_ALL);
+    ClearRightCache();
+    RequestTidyUpRight(TIGHT_UP_USB_RIGHT_RECORD_ALL);
     UnShowUsbDialog();
     return true;
 }
@@ -651,15 +944,9 @@ bool UsbRightManager::GetAppName(const std::string &bundleName, std::string &app
 
 bool UsbRightManager::IsSystemAppOrSa()
 {
-    uint64_t tokenid = IPCSkeleton::GetCallingFullTokenID();
-    bool isSystemApp = TokenIdKit::IsSystemAppByFullTokenID(tokenid);
-    if (isSystemApp) {
-        return true;
-    }
-
-    AccessTokenID accessTokenId = IPCSkeleton::GetCallingTokenID();
-    ATokenTypeEnum tokenType = AccessTokenKit::GetTokenTypeFlag(accessTokenId);
-    if (tokenType == TOKEN_NATIVE) {
+    UsbCallerIdentity identity;
+    GetCallerIdentity(identity);
+    if (identity.isSystem) {
         return true;
     }
 
@@ -678,21 +965,6 @@ bool UsbRightManager::VerifyPermission()
     return true;
 }
 
-bool UsbRightManager::IsAppInstalled(int32_t uid, const std::string &bundleName)
-{
-    auto bundleMgr = GetBundleMgr();
-    if (bundleMgr == nullptr) {
-        USB_HILOGE(MODULE_USB_HOST, "BundleMgr is nullptr, return false");
-        return false;
-    }
-    ApplicationInfo appInfo;
-    if (!bundleMgr->GetApplicationInfo(bundleName, GET_BASIC_APPLICATION_INFO, uid, appInfo)) {
-        USB_HILOGE(MODULE_USB_HOST, "BundleMgr GetApplicationInfo failed");
-        return false;
-    }
-    return true;
-}
-
 bool UsbRightManager::GetBundleInstallAndUpdateTime(
     int32_t uid, const std::string &bundleName, uint64_t &installTime, uint64_t &updateTime)
 {
@@ -718,14 +990,15 @@ uint64_t UsbRightManager::GetCurrentTimestamp()
     return static_cast<uint64_t>(time);
 }
 
-void UsbRightManager::GetCurrentUserId(int32_t &uid)
+void UsbRightManager::GetActiveUserIds(std::vector<int32_t> &userIds)
 {
-    int32_t ret = AccountSA::OsAccountManager::GetOsAccountLocalIdFromUid(IPCSkeleton::GetCallingUid(), uid);
-    if (ret != UEC_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "GetOsAccountLocalIdFromUid failed: %{public}d, set to defult", ret);
-        uid = USB_RIGHT_USERID_DEFAULT; /* default user id */
+    /* not tied to a caller, the sweeper thread and service init have no calling uid of an app */
+    int32_t ret = AccountSA::OsAccountManager::QueryActiveOsAccountIds(userIds);
+    if (ret != UEC_OK || userIds.empty()) {
+        USB_HILOGE(MODULE_USB_HOST, "QueryActiveOsAccountIds failed: %{public}d, set to default", ret);
+        userIds = {USB_RIGHT_USERID_DEFAULT};
     }
-    USB_HILOGD(MODULE_USB_HOST, "usb get userid success: %{public}d, uid: %{public}d", ret, uid);
+    USB_HILOGD(MODULE_USB_HOST, "usb get active userids: %{public}zu", userIds.size());
 }
 
 int32_t UsbRightManager::IsOsAccountExists(int32_t id, bool &isAccountExists)
@@ -776,44 +1049,74 @@ int32_t UsbRightManager::CleanUpRightExpired(std::vector<std::string> &devices)
             continue;
         }
     }
-    int32_t uid = USB_RIGHT_USERID_INVALID;
-    GetCurrentUserId(uid);
-    ret = CleanUpRightNormalExpired(uid);
-    if (ret != USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "delete expired record with uid(%{public}d) failed: %{public}d", uid, ret);
+    std::vector<int32_t> userIds;
+    GetActiveUserIds(userIds);
+    for (int32_t uid : userIds) {
+        ret = CleanUpRightNormalExpired(uid);
+        if (ret != USB_RIGHT_OK) {
+            USB_HILOGE(MODULE_USB_HOST, "delete expired record with uid(%{public}d) failed: %{public}d", uid, ret);
+        }
     }
+    ClearRightCache();
     return ret;
 }
 
-int32_t UsbRightManager::CleanUpRightAppUninstalled(int32_t uid, int32_t &totalApps, int32_t &deleteApps)
+bool UsbRightManager::GetInstalledBundles(int32_t uid, std::unordered_map<std::string, uint64_t> &installTimes)
+{
+    auto bundleMgr = GetBundleMgr();
+    if (bundleMgr == nullptr) {
+        USB_HILOGW(MODULE_USB_HOST, "BundleMgr is nullptr, return false");
+        return false;
+    }
+    std::vector<BundleInfo> bundleInfos;
+    if (!bundleMgr->GetBundleInfos(BundleFlag::GET_BUNDLE_DEFAULT, bundleInfos, uid)) {
+        USB_HILOGW(MODULE_USB_HOST, "BundleMgr GetBundleInfos(uid) failed");
+        return false;
+    }
+    installTimes.reserve(bundleInfos.size());
+    for (const auto &bundleInfo : bundleInfos) {
+        installTimes.emplace(bundleInfo.name, static_cast<uint64_t>(bundleInfo.installTime));
+    }
+    return true;
+}
+
+void UsbRightManager::FindStaleRightApps(const std::vector<struct UsbRightAppInfo> &infos,
+    const std::unordered_map<std::string, uint64_t> &installTimes, bool uninstalled, bool reinstalled,
+    std::vector<std::string> &bundleNames)
+{
+    for (const auto &info : infos) {
+        auto iter = installTimes.find(info.bundleName);
+        if (iter == installTimes.end() ? uninstalled : (reinstalled && iter->second != info.installTime)) {
+            bundleNames.push_back(info.bundleName);
+        }
+    }
+    StringVectorSortAndUniq(bundleNames);
+}
+
+int32_t UsbRightManager::CollectRightAppStale(int32_t uid, bool uninstalled, bool reinstalled,
+    std::vector<std::string> &bundleNames)
 {
-    std::vector<std::string> apps;
     std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
     if (helper == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "helper is nullptr, false");
-        return false;
+        return USB_RIGHT_FAILURE;
     }
-    int32_t ret = helper->QueryRightRecordApps(uid, apps);
+    std::vector<struct UsbRightAppInfo> infos;
+    int32_t ret = helper->QueryUserRightRecord(uid, infos);
     if (ret <= 0) {
         /* error or empty record */
         return USB_RIGHT_NOP;
     }
-    totalApps = static_cast<int32_t>(apps.size());
-    deleteApps = 0;
-    for (int32_t i = 0; i < totalApps; i++) {
-        std::string app = apps.at(i);
-        if (!IsAppInstalled(uid, app)) {
-            ret = helper->DeleteAppRightRecord(uid, app);
-            if (ret != USB_RIGHT_OK) {
-                USB_HILOGW(MODULE_USB_HOST, "clean failed: app=%{public}s, ret=%{public}d", app.c_str(), ret);
-                continue;
-            }
-            deleteApps++;
-        }
+    /* one bundle manager call for all apps of the user, an app missing from a failed call is not uninstalled */
+    std::unordered_map<std::string, uint64_t> installTimes;
+    if (!GetInstalledBundles(uid, installTimes)) {
+        USB_HILOGE(MODULE_USB_HOST, "get installed apps failed: uid=%{public}d", uid);
+        return USB_RIGHT_FAILURE;
     }
-    USB_HILOGD(MODULE_USB_HOST, "clean uninstall app record[%{public}d/%{public}d]: uid=%{public}d", deleteApps,
-        totalApps, uid);
-    return ret;
+    FindStaleRightApps(infos, installTimes, uninstalled, reinstalled, bundleNames);
+    USB_HILOGD(MODULE_USB_HOST, "stale app record[%{public}zu/%{public}zu]: uid=%{public}d", bundleNames.size(),
+        infos.size(), uid);
+    return USB_RIGHT_OK;
 }
 
 int32_t UsbRightManager::CleanUpRightAppUninstalled(int32_t uid, const std::string &bundleName)
@@ -835,6 +1138,7 @@ int32_t UsbRightManager::CleanUpRightAppUninstalled(int32_t uid, const std::stri
         return USB_RIGHT_NOP;
     }
     ret = helper->DeleteAppRightRecord(uid, apps.at(index));
+    EraseRightCacheByApp(uid, bundleName);
     USB_HILOGD(MODULE_USB_HOST, "clean[%{public}d/%{public}zu]: uid=%{public}d, app=%{public}s, ret=%{public}d",
         index, apps.size(), uid, bundleName.c_str(), ret);
     return ret;
@@ -860,76 +1164,44 @@ bool UsbRightManager::StringVectorFound(
     return false;
 }
 
-int32_t UsbRightManager::CleanUpRightAppReinstalled(int32_t uid, uint32_t &totalApps, uint32_t &deleteApps)
+int32_t UsbRightManager::CleanUpRightUserDeleted(int32_t &totalUsers, int32_t &deleteUsers)
 {
-    std::vector<std::string> apps;
     std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
     if (helper == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "helper is nullptr, false");
         return false;
     }
-    int32_t ret = helper->QueryRightRecordApps(uid, apps);
-    if (ret <= 0) {
-        USB_HILOGE(MODULE_USB_HOST, "query apps failed or empty: %{public}d", ret);
-        return USB_RIGHT_NOP;
-    }
-    StringVectorSortAndUniq(apps);
-    deleteApps = 0;
-    totalApps = apps.size();
-    std::vector<std::string> deleteBundleNames;
-    for (size_t i = 0; i < apps.size(); i++) {
-        std::string bundleName = apps.at(i);
-        std::vector<struct UsbRightAppInfo> infos;
-        ret = helper->QueryAppRightRecord(uid, bundleName, infos);
-        if (ret < 0) {
-            USB_HILOGE(MODULE_USB_HOST, "query app info %{public}s failed: %{public}d", bundleName.c_str(), ret);
-            return USB_RIGHT_FAILURE;
-        }
-        uint64_t installTime = 0;
-        uint64_t updateTime = 0;
-        if (!GetBundleInstallAndUpdateTime(uid, bundleName, installTime, updateTime)) {
-            USB_HILOGE(MODULE_USB_HOST, "get app install time and update time failed: app=%{public}s uid=%{public}d",
-                bundleName.c_str(), uid);
-            return USB_RIGHT_FAILURE;
-        }
-        for (size_t j = 0; j < infos.size(); j++) {
-            struct UsbRightAppInfo info = infos.at(j);
-            if (info.installTime != installTime) {
-                deleteBundleNames.push_back(bundleName);
-                break;
-            }
-        }
-    }
-    StringVectorSortAndUniq(deleteBundleNames);
-    ret = helper->DeleteAppsRightRecord(uid, deleteBundleNames);
+    struct UsbRightSweep sweep;
+    int32_t ret = CollectRightUserDeleted(sweep.deletedUids, totalUsers);
     if (ret != USB_RIGHT_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "delete apps failed: %{public}d", ret);
-    } else {
-        deleteApps = deleteBundleNames.size();
+        return ret;
     }
-    return ret;
+    deleteUsers = static_cast<int32_t>(sweep.deletedUids.size());
+    ret = helper->DeleteSweptRightRecord(sweep);
+    for (int32_t uid : sweep.deletedUids) {
+        EraseRightCacheByUser(uid);
+    }
+    return ret == USB_RIGHT_NOP ? USB_RIGHT_OK : ret;
 }
 
-int32_t UsbRightManager::CleanUpRightUserDeleted(int32_t &totalUsers, int32_t &deleteUsers)
+int32_t UsbRightManager::CollectRightUserDeleted(std::vector<int32_t> &uids, int32_t &totalUsers)
 {
     std::vector<std::string> rightRecordUids;
     bool isAccountExists = false;
     std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
     if (helper == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "helper is nullptr, false");
-        return false;
+        return USB_RIGHT_FAILURE;
     }
     int32_t ret = helper->QueryRightRecordUids(rightRecordUids);
     if (ret <= 0) {
         USB_HILOGE(MODULE_USB_HOST, "query apps failed or empty: %{public}d", ret);
         return USB_RIGHT_NOP;
     }
-    size_t len = rightRecordUids.size();
-    deleteUsers = 0;
-    for (size_t i = 0; i < len; i++) {
+    for (const auto &rightRecordUid : rightRecordUids) {
         int32_t uid = 0;
-        if (!StrToInt(rightRecordUids.at(i), uid)) {
-            USB_HILOGE(MODULE_USB_HOST, "convert failed: %{public}s", rightRecordUids.at(i).c_str());
+        if (!StrToInt(rightRecordUid, uid)) {
+            USB_HILOGE(MODULE_USB_HOST, "convert failed: %{public}s", rightRecordUid.c_str());
             continue;
         }
         ret = IsOsAccountExists(uid, isAccountExists);
@@ -938,11 +1210,9 @@ int32_t UsbRightManager::CleanUpRightUserDeleted(int32_t &totalUsers, int32_t &d
             continue;
         }
         if (!isAccountExists) {
-            ret = helper->DeleteUidRightRecord(uid);
-            USB_HILOGE(MODULE_USB_HOST, "detecte delete uid=%{public}d: %{public}d", uid, ret);
-            deleteUsers++;
+            USB_HILOGI(MODULE_USB_HOST, "detect deleted uid=%{public}d", uid);
+            uids.push_back(uid);
         }
-        USB_HILOGD(MODULE_USB_HOST, "uid exist, ignore: %{public}d", uid);
     }
     totalUsers = static_cast<int32_t>(rightRecordUids.size());
     return USB_RIGHT_OK;
@@ -956,7 +1226,9 @@ int32_t UsbRightManager::CleanUpRightUserStopped(int32_t uid)
         return false;
     }
 
-    return helper->DeleteUidRightRecord(uid);
+    int32_t ret = helper->DeleteUidRightRecord(uid);
+    EraseRightCacheByUser(uid);
+    return ret;
 }
 
 int32_t UsbRightManager::CleanUpRightTemporaryExpired(const std::string &deviceName)
@@ -984,7 +1256,7 @@ int32_t UsbRightManager::CleanUpRightNormalExpired(int32_t uid)
     return ret;
 }
 
-int32_t UsbRightManager::TidyUpRight(uint32_t choose)
+int32_t UsbRightManager::TidyUpRight(uint32_t choose, int32_t userId)
 {
     if (choose == TIGHT_UP_USB_RIGHT_RECORD_NONE) {
         /* ignore */
@@ -994,41 +1266,109 @@ int32_t UsbRightManager::TidyUpRight(uint32_t choose)
         USB_HILOGE(MODULE_USB_HOST, "choose invalid");
         return UEC_SERVICE_INVALID_VALUE;
     }
-    int32_t uid = USB_RIGHT_USERID_INVALID;
-    GetCurrentUserId(uid);
-    if (uid == USB_RIGHT_USERID_CONSOLE) {
+    std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
+    if (helper == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "helper is nullptr, false");
+        return USB_RIGHT_FAILURE;
+    }
+    struct UsbRightSweep sweep;
+    sweep.uid = userId;
+    if (sweep.uid == USB_RIGHT_USERID_CONSOLE) {
         USB_HILOGE(MODULE_USB_HOST, "console called, bypass");
         return true;
     }
-    int32_t ret = 0;
-    if ((choose & TIGHT_UP_USB_RIGHT_RECORD_APP_UNINSTALLED) != 0) {
-        int32_t totalUninstalledApps = 0;
-        int32_t deleteUninstalledApps = 0;
-        ret = CleanUpRightAppUninstalled(uid, totalUninstalledApps, deleteUninstalledApps);
-        USB_HILOGD(MODULE_USB_HOST, "delete app uninstalled record[%{public}d/%{public}d]: %{public}d",
-            deleteUninstalledApps, totalUninstalledApps, ret);
+    /* find the stale records first, then delete them together in one transaction */
+    bool uninstalled = (choose & TIGHT_UP_USB_RIGHT_RECORD_APP_UNINSTALLED) != 0;
+    bool reinstalled = (choose & TIGHT_UP_USB_RIGHT_RECORD_APP_REINSTALLED) != 0;
+    if (uninstalled || reinstalled) {
+        (void)CollectRightAppStale(sweep.uid, uninstalled, reinstalled, sweep.bundleNames);
     }
     if ((choose & TIGHT_UP_USB_RIGHT_RECORD_USER_DELETED) != 0) {
         int32_t totalUsers = 0;
-        int32_t deleteUsers = 0;
-        ret = CleanUpRightUserDeleted(totalUsers, deleteUsers);
-        USB_HILOGD(MODULE_USB_HOST, "delete user deleted record[%{public}d/%{public}d]: %{public}d", deleteUsers,
-            totalUsers, ret);
+        (void)CollectRightUserDeleted(sweep.deletedUids, totalUsers);
     }
     if ((choose & TIGHT_UP_USB_RIGHT_RECORD_EXPIRED) != 0) {
-        ret = CleanUpRightNormalExpired(uid);
-        USB_HILOGD(MODULE_USB_HOST, "delete expired record: %{public}d", ret);
+        sweep.expiredTime = GetCurrentTimestamp();
+    }
+    int32_t ret = helper->DeleteSweptRightRecord(sweep);
+    for (const auto &bundleName : sweep.bundleNames) {
+        EraseRightCacheByApp(sweep.uid, bundleName);
+    }
+    for (int32_t uid : sweep.deletedUids) {
+        EraseRightCacheByUser(uid);
     }
-    if ((choose & TIGHT_UP_USB_RIGHT_RECORD_APP_REINSTALLED) != 0) {
-        uint32_t totalReinstalledApps = 0;
-        uint32_t deleteReinstalledApps = 0;
-        ret = CleanUpRightAppReinstalled(uid, totalReinstalledApps, deleteReinstalledApps);
-        USB_HILOGD(MODULE_USB_HOST, "delete app reinstalled record[%{public}u/%{public}u]: %{public}d",
-            deleteReinstalledApps, totalReinstalledApps, ret);
+    if (!sweep.bundleNames.empty() || !sweep.deletedUids.empty()) {
+        RevokeAllDeviceSessions();
     }
+    USB_HILOGD(MODULE_USB_HOST, "tidy up 0x%{public}x of %{public}d: apps=%{public}zu users=%{public}zu ret=%{public}d",
+        choose, userId, sweep.bundleNames.size(), sweep.deletedUids.size(), ret);
     return ret;
 }
 
+void UsbRightManager::TidyUpRightForActiveUsers(uint32_t choose)
+{
+    std::vector<int32_t> userIds;
+    GetActiveUserIds(userIds);
+    for (int32_t userId : userIds) {
+        if (userId == USB_RIGHT_USERID_CONSOLE) {
+            continue;
+        }
+        (void)TidyUpRight(choose, userId);
+        /* the deleted users do not depend on the active user, one pass finds them all */
+        choose &= ~static_cast<uint32_t>(TIGHT_UP_USB_RIGHT_RECORD_USER_DELETED);
+    }
+}
+
+void UsbRightManager::RequestTidyUpRight(uint32_t choose)
+{
+    {
+        std::lock_guard<std::mutex> guard(rightSweepMutex_);
+        pendingTidyUp_ |= choose;
+    }
+    rightSweepCond_.notify_one();
+}
+
+void UsbRightManager::StartRightSweeper()
+{
+    std::lock_guard<std::mutex> guard(rightSweepMutex_);
+    if (rightSweeper_.joinable() || rightSweepStop_) {
+        return;
+    }
+    rightSweeper_ = std::thread([this]() {
+        pthread_setname_np(pthread_self(), RIGHT_SWEEPER_NAME);
+        RightSweepLoop();
+    });
+}
+
+void UsbRightManager::RightSweepLoop()
+{
+    std::unique_lock<std::mutex> lock(rightSweepMutex_);
+    while (!rightSweepStop_) {
+        bool requested = rightSweepCond_.wait_for(lock, std::chrono::seconds(RIGHT_SWEEP_INTERVAL_SECONDS),
+            [this]() { return rightSweepStop_ || pendingTidyUp_ != TIGHT_UP_USB_RIGHT_RECORD_NONE; });
+        if (rightSweepStop_) {
+            break;
+        }
+        uint32_t choose = requested ? pendingTidyUp_ : TIGHT_UP_USB_RIGHT_RECORD_ALL;
+        pendingTidyUp_ = TIGHT_UP_USB_RIGHT_RECORD_NONE;
+        lock.unlock();
+        TidyUpRightForActiveUsers(choose);
+        lock.lock();
+    }
+}
+
+UsbRightManager::~UsbRightManager()
+{
+    {
+        std::lock_guard<std::mutex> guard(rightSweepMutex_);
+        rightSweepStop_ = true;
+    }
+    rightSweepCond_.notify_all();
+    if (rightSweeper_.joinable()) {
+        rightSweeper_.join();
+    }
+}
+
 bool UsbRightManager::IsAllDigits(const std::string &bundleName)
 {
     size_t len = bundleName.length();
@@ -15,7 +15,9 @@
 
 #include "usb_service.h"
 
+#include <cerrno>
 #include <cstdio>
+#include <cstdlib>
 #include <iostream>
 #include <ipc_skeleton.h>
 #include <sstream>
@@ -40,8 +42,9 @@
 #include "usb_napi_errors.h"
 #include "usb_port_manager.h"
 #include "usb_right_manager.h"
-#include "usb_right_db_helper.h"
 #include "usb_report_sys_event.h"
+#include "usb_right_db_helper.h"
+#include "struct_parcel.h"
 #include "usb_settings_datashare.h"
 #include "tokenid_kit.h"
 #include "accesstoken_kit.h"
@@ -49,7 +52,9 @@
 #include "mem_mgr_client.h"
 #include "uri.h"
 #include "usb_function_switch_window.h"
+#include "usbd_callback_stub.h"
 #include "usbd_transfer_callback_impl.h"
+#include "usb_transfer_stats.h"
 #include "hitrace_meter.h"
 #include "hisysevent.h"
 
@@ -71,7 +76,16 @@ constexpr int32_t ISO_TRANSFER_TYPE = 1;
 constexpr int32_t BULK_TRANSFER_TYPE = 2;
 constexpr int32_t INTP_TRANSFER_TYPE = 3;
 constexpr uint32_t MEMSIZE_MAX = 512 * 1024 * 1024;
+constexpr size_t DEVICE_EVENT_WORKER_NUM = 4;
+constexpr uint32_t DEVICE_EVENT_KEY_BUS_SHIFT = 8;
 constexpr uint32_t ARGLIST_SIZE_MIN = 2;
+constexpr uint32_t TRANSFER_FAULT_REPORT_INTERVAL_MS = 10 * 1000;
+constexpr size_t TRANSFER_LANE_LIMIT = 32;
+constexpr size_t TRANSFER_LANE_QUEUE_LIMIT = 16;
+constexpr uint32_t TRANSFER_LANE_IDLE_TIMEOUT_MS = 10 * 1000;
+constexpr uint8_t CONTROL_TRANSFER_LANE = 0;
+constexpr uint8_t REQUEST_WAIT_LANE = 0xFF;
+constexpr int32_t DECIMAL_BASE = 10;
 #endif // USB_MANAGER_FEATURE_HOST
 #if defined(USB_MANAGER_FEATURE_HOST) || defined(USB_MANAGER_FEATURE_DEVICE)
 constexpr int32_t USB_RIGHT_USERID_INVALID = -1;
@@ -81,6 +95,54 @@ constexpr int32_t API_VERSION_ID_18 = 18;
 static const std::filesystem::path TTYUSB_PATH = "/sys/bus/usb-serial/devices";
 constexpr const pid_t ROOT_UID = 0;
 constexpr const pid_t EDM_UID = 3057;
+#ifdef USB_MANAGER_FEATURE_HOST
+// the bulk calls serve interrupt endpoints as well
+UsbTransferKind GetBulkTransferKind(const USBEndpoint &ep)
+{
+    return ep.GetType() == static_cast<uint32_t>(INTP_TRANSFER_TYPE) ? UsbTransferKind::INTERRUPT :
+        UsbTransferKind::BULK;
+}
+
+// one way, a slow client never holds up the io lane
+int32_t ReplyTransferData(const sptr<IRemoteObject> &cb, int32_t status, const std::vector<uint8_t> &clientData,
+    const std::vector<uint8_t> &bufferData, uint64_t userData)
+{
+    OHOS::MessageParcel data;
+    if (!data.WriteInterfaceToken(cb->GetInterfaceDescriptor())) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: write token failed", __func__);
+        return UEC_SERVICE_WRITE_PARCEL_ERROR;
+    }
+    if (!data.WriteInt32(status) || !data.WriteUInt8Vector(clientData) || !data.WriteUInt8Vector(bufferData) ||
+        !data.WriteUint64(userData)) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: write transfer result failed", __func__);
+        return UEC_SERVICE_WRITE_PARCEL_ERROR;
+    }
+    OHOS::MessageParcel reply;
+    OHOS::MessageOption option(OHOS::MessageOption::TF_ASYNC);
+    int32_t ret = cb->SendRequest(UsbdStubCallBack::CMD_USBD_TRANSFER_CALLBACK_DATA, data, reply, option);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s UsbdStubCallBack failed, error code is %{public}d", __func__, ret);
+    }
+    return ret;
+}
+
+// tiny and sent before the transfer, the caller starts its deadline on it
+int32_t ReplyTransferStarted(const sptr<IRemoteObject> &cb, uint64_t userData)
+{
+    OHOS::MessageParcel data;
+    if (!data.WriteInterfaceToken(cb->GetInterfaceDescriptor()) || !data.WriteUint64(userData)) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: write transfer start failed", __func__);
+        return UEC_SERVICE_WRITE_PARCEL_ERROR;
+    }
+    OHOS::MessageParcel reply;
+    OHOS::MessageOption option(OHOS::MessageOption::TF_ASYNC);
+    int32_t ret = cb->SendRequest(UsbdStubCallBack::CMD_USBD_TRANSFER_CALLBACK_STARTED, data, reply, option);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s UsbdStubCallBack failed, error code is %{public}d", __func__, ret);
+    }
+    return ret;
+}
+#endif // USB_MANAGER_FEATURE_HOST
 } // namespace
 auto g_serviceInstance = DelayedSpSingleton<UsbService>::GetInstance();
 const bool G_REGISTER_RESULT =
@@ -89,6 +151,14 @@ const bool G_REGISTER_RESULT =
 UsbService::UsbService() : SystemAbility(USB_SYSTEM_ABILITY_ID, true)
 {
     usbRightManager_ = std::make_shared<UsbRightManager>();
+#ifdef USB_MANAGER_FEATURE_HOST
+    deviceEventDispatcher_ = std::make_shared<UsbDeviceEventDispatcher>(DEVICE_EVENT_WORKER_NUM);
+    transferFaultReporter_ = std::make_shared<UsbTransferFaultReporter>(
+        [this](UsbTransferFault &fault) { return ResolveTransferFault(fault); },
+        TRANSFER_FAULT_REPORT_INTERVAL_MS);
+    transferExecutor_ = std::make_shared<UsbDeviceIoExecutor>(
+        TRANSFER_LANE_LIMIT, TRANSFER_LANE_QUEUE_LIMIT, TRANSFER_LANE_IDLE_TIMEOUT_MS);
+#endif // USB_MANAGER_FEATURE_HOST
 #ifdef USB_MANAGER_PASS_THROUGH
 
 #ifdef USB_MANAGER_FEATURE_HOST
@@ -502,7 +572,8 @@ bool UsbService::IsCommonEventServiceAbilityExist()
 #ifdef USB_MANAGER_FEATURE_HOST
 int32_t UsbService::OpenDevice(uint8_t busNum, uint8_t devAddr)
 {
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
+    uint64_t expireTime = UINT64_MAX;
+    if (!UsbService::CheckDevicePermission(busNum, devAddr, expireTime)) {
         ReportUsbOperationFaultSysEvent("OpenDevice", UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
@@ -515,8 +586,11 @@ int32_t UsbService::OpenDevice(uint8_t busNum, uint8_t devAddr)
     int32_t ret = usbHostManager_->OpenDevice(busNum, devAddr);
     if (ret != UEC_OK) {
         USB_HILOGE(MODULE_USB_HOST, "OpenDevice failed ret:%{public}d", ret);
+        return ret;
     }
-
+    std::string name = std::to_string(busNum) + "-" + std::to_string(devAddr);
+    usbHostManager_->AddDeviceSession(IPCSkeleton::GetCallingTokenID(), busNum, devAddr,
+        GetDeviceVidPidSerialNumber(name), expireTime);
     return ret;
     // LCOV_EXCL_STOP
 }
@@ -532,6 +606,7 @@ int32_t UsbService::Close(uint8_t busNum, uint8_t devAddr)
         USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
         return UEC_SERVICE_INVALID_VALUE;
     }
+    usbHostManager_->RemoveDeviceSession(IPCSkeleton::GetCallingTokenID(), busNum, devAddr);
     return usbHostManager_->Close(busNum, devAddr);
     // LCOV_EXCL_STOP
 }
@@ -824,15 +899,14 @@ bool UsbService::DelDevice(uint8_t busNum, uint8_t devAddr)
 
     {
         std::lock_guard<std::mutex> guard(mutex_);
-        for (auto it = deviceVidPidMap_.begin(); it != deviceVidPidMap_.end(); ++it) {
-            if (it->first == name) {
-                deviceVidPidMap_.erase(it);
-                break;
-            }
-        }
+        deviceVidPidMap_.erase(name);
     }
 
-    return usbHostManager_->DelDevice(busNum, devAddr);
+    bool deleted = usbHostManager_->DelDevice(busNum, devAddr);
+    if (transferFaultReporter_ != nullptr) {
+        transferFaultReporter_->ForgetDevice(busNum, devAddr);
+    }
+    return deleted;
 }
 // LCOV_EXCL_STOP
 
@@ -845,6 +919,34 @@ int32_t UsbService::GetDevices(std::vector<UsbDevice> &deviceList)
     return usbHostManager_->GetDevices(deviceList);
 }
 
+int32_t UsbService::GetDevicesSnapshot(int32_t &fd, uint32_t &size, uint64_t &sequence)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    return usbHostManager_->GetDevicesSnapshot(fd, size, sequence);
+}
+
+int32_t UsbService::GetDeviceGeneration(uint64_t &generation)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    return usbHostManager_->GetDeviceGeneration(generation);
+}
+
+int32_t UsbService::GetDevicesSince(uint64_t since, uint64_t &generation, bool &fullSync,
+    std::vector<UsbDevice> &added, std::vector<UsbDevice> &changed, std::vector<std::string> &removed)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    return usbHostManager_->GetDevicesSince(since, generation, fullSync, added, changed, removed);
+}
+
 // LCOV_EXCL_START
 int32_t UsbService::GetDeviceInfo(uint8_t busNum, uint8_t devAddr, UsbDevice &dev)
 {
@@ -987,21 +1089,18 @@ int32_t UsbService::BulkTransferRead(
 
     HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
     UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("BulkRead", usbDev, pipe,
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkRead", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     int32_t ret = usbHostManager_->BulkTransferRead(devInfo, pipe, bufferData.data_, timeOut);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, bufferData.data_.size());
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent("BulkRead", usbDev, pipe, ep,
-                ret, "BulkTransferReadFail");
-        }
+        transferFaultReporter_->ReportEndpoint("BulkRead", busNum, devAddr, ep, ret, "BulkTransferReadFail");
         USB_HILOGE(MODULE_USB_HOST, "BulkTransferRead error ret:%{public}d", ret);
     }
     return ret;
@@ -1019,21 +1118,18 @@ int32_t UsbService::BulkTransferReadwithLength(uint8_t busNum, uint8_t devAddr,
 
     HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
     UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("BulkRead", usbDev, pipe,
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkRead", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     int32_t ret = usbHostManager_->BulkTransferReadwithLength(devInfo, pipe, length, bufferData.data_, timeOut);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, bufferData.data_.size());
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent("BulkRead", usbDev, pipe, ep,
-                ret, "BulkTransferReadFail");
-        }
+        transferFaultReporter_->ReportEndpoint("BulkRead", busNum, devAddr, ep, ret, "BulkTransferReadFail");
         USB_HILOGE(MODULE_USB_HOST, "BulkTransferReadWithLength error ret:%{public}d", ret);
     }
     return ret;
@@ -1050,21 +1146,18 @@ int32_t UsbService::BulkTransferWrite(
 
     HDI::Usb::V1_0::UsbDev dev = {busNum, devAddr};
     UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("BulkWrite", usbDev, pipe,
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkWrite", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     int32_t ret = usbHostManager_->BulkTransferWrite(dev, pipe, bufferData.data_, timeOut);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, bufferData.data_.size());
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent("BulkWrite", usbDev, pipe, ep,
-                ret, "BulkTransferWriteFail");
-        }
+        transferFaultReporter_->ReportEndpoint("BulkWrite", busNum, devAddr, ep, ret, "BulkTransferWriteFail");
         USB_HILOGE(MODULE_USB_HOST, "BulkTransferWrite error ret:%{public}d", ret);
     }
     return ret;
@@ -1079,23 +1172,20 @@ int32_t UsbService::ControlTransfer(uint8_t busNum, uint8_t devAddr,
     }
 
     HDI::Usb::V1_0::UsbDev dev = {busNum, devAddr};
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("ControlTransfer", usbDev, {0, 0},
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, 0, UsbTransferKind::CONTROL);
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("ControlTransfer", busNum, devAddr,
+            {0, 0}, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     HDI::Usb::V1_0::UsbCtrlTransfer ctrl;
     UsbCtrlTransferChange(ctrl, ctrlParams);
     int32_t ret = usbHostManager_->ControlTransfer(dev, ctrl, bufferData);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, bufferData.size());
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("ControlTransfer", usbDev, {0, 0},
-                ret, "ControlTransferFail");
-        }
+        transferFaultReporter_->Report("ControlTransfer", busNum, devAddr, {0, 0}, ret, "ControlTransferFail");
         USB_HILOGE(MODULE_USB_HOST, "ControlTransfer error ret:%{public}d", ret);
     }
     return ret;
@@ -1136,29 +1226,138 @@ int32_t UsbService::UsbControlTransfer(
     }
 
     HDI::Usb::V1_0::UsbDev dev = {busNum, devAddr};
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("ControlTransfer", usbDev, {0, 0},
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, 0, UsbTransferKind::CONTROL);
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("ControlTransfer", busNum, devAddr,
+            {0, 0}, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     HDI::Usb::V1_2::UsbCtrlTransferParams ctlSetUp;
     UsbCtrlTransferChange(ctlSetUp, ctrlParams);
     int32_t ret = usbHostManager_->UsbControlTransfer(dev, ctlSetUp, bufferData);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, bufferData.size());
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("ControlTransfer", usbDev, {0, 0},
-                ret, "UsbControlTransferFail");
-        }
+        transferFaultReporter_->Report("ControlTransfer", busNum, devAddr, {0, 0}, ret, "UsbControlTransferFail");
         USB_HILOGE(MODULE_USB_HOST, "UsbControlTransfer error ret:%{public}d", ret);
     }
     return ret;
 }
 // LCOV_EXCL_STOP
 
+// LCOV_EXCL_START
+int32_t UsbService::BulkTransferReadAsync(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t length,
+    int32_t timeOut, const sptr<IRemoteObject> &cb, uint64_t userData)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+
+    UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkRead", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    return PostTransfer(busNum, devAddr, static_cast<uint8_t>(ep.GetAddress()), cb, userData,
+        [this, busNum, devAddr, ep, pipe, length, timeOut, probe](std::vector<uint8_t> &clientData,
+            std::vector<uint8_t> &bufferData) mutable {
+            HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+            probe.startNs = UsbTransferStats::NowNs();
+            int32_t ret = usbHostManager_->BulkTransferReadwithLength(devInfo, pipe, length, bufferData, timeOut);
+            UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, bufferData.size());
+            if (ret != UEC_OK) {
+                transferFaultReporter_->ReportEndpoint("BulkRead", busNum, devAddr, ep, ret, "BulkTransferReadFail");
+                USB_HILOGE(MODULE_USB_HOST, "BulkTransferReadAsync error ret:%{public}d", ret);
+            }
+            return ret;
+        });
+}
+// LCOV_EXCL_STOP
+
+// LCOV_EXCL_START
+int32_t UsbService::BulkTransferWriteAsync(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
+    const UsbBulkTransData &bufferData, int32_t timeOut, const sptr<IRemoteObject> &cb, uint64_t userData)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+
+    UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkWrite", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    return PostTransfer(busNum, devAddr, static_cast<uint8_t>(ep.GetAddress()), cb, userData,
+        [this, busNum, devAddr, ep, pipe, data = bufferData.data_, timeOut, probe](std::vector<uint8_t> &clientData,
+            std::vector<uint8_t> &replyData) mutable {
+            HDI::Usb::V1_0::UsbDev dev = {busNum, devAddr};
+            probe.startNs = UsbTransferStats::NowNs();
+            int32_t ret = usbHostManager_->BulkTransferWrite(dev, pipe, data, timeOut);
+            UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, data.size());
+            if (ret != UEC_OK) {
+                transferFaultReporter_->ReportEndpoint("BulkWrite", busNum, devAddr, ep, ret, "BulkTransferWriteFail");
+                USB_HILOGE(MODULE_USB_HOST, "BulkTransferWriteAsync error ret:%{public}d", ret);
+            }
+            return ret;
+        });
+}
+// LCOV_EXCL_STOP
+
+// LCOV_EXCL_START
+int32_t UsbService::ControlTransferAsync(uint8_t busNum, uint8_t devAddr, const UsbCtlSetUp &ctrlParams,
+    const std::vector<uint8_t> &bufferData, bool withLength, const sptr<IRemoteObject> &cb, uint64_t userData)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, 0, UsbTransferKind::CONTROL);
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("ControlTransfer", busNum, devAddr,
+            {0, 0}, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    return PostTransfer(busNum, devAddr, CONTROL_TRANSFER_LANE, cb, userData,
+        [this, busNum, devAddr, ctrlParams, data = bufferData, withLength, probe](std::vector<uint8_t> &clientData,
+            std::vector<uint8_t> &replyData) mutable {
+            HDI::Usb::V1_0::UsbDev dev = {busNum, devAddr};
+            replyData.swap(data);
+            probe.startNs = UsbTransferStats::NowNs();
+            int32_t ret = UEC_OK;
+            if (withLength) {
+                HDI::Usb::V1_2::UsbCtrlTransferParams ctlSetUp;
+                UsbCtrlTransferChange(ctlSetUp, ctrlParams);
+                ret = usbHostManager_->UsbControlTransfer(dev, ctlSetUp, replyData);
+            } else {
+                HDI::Usb::V1_0::UsbCtrlTransfer ctrl;
+                UsbCtrlTransferChange(ctrl, ctrlParams);
+                ret = usbHostManager_->ControlTransfer(dev, ctrl, replyData);
+            }
+            UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, replyData.size());
+            if (ret != UEC_OK) {
+                transferFaultReporter_->Report("ControlTransfer", busNum, devAddr, {0, 0}, ret,
+                    withLength ? "UsbControlTransferFail" : "ControlTransferFail");
+                USB_HILOGE(MODULE_USB_HOST, "ControlTransferAsync error ret:%{public}d", ret);
+            }
+            return ret;
+        });
+}
+// LCOV_EXCL_STOP
+
 int32_t UsbService::RequestQueue(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
     const std::vector<uint8_t> &clientData, const std::vector<uint8_t> &bufferData)
 {
@@ -1202,6 +1401,57 @@ int32_t UsbService::RequestWait(uint8_t busNum, uint8_t devAddr, int32_t timeOut
 }
 // LCOV_EXCL_STOP
 
+// LCOV_EXCL_START
+int32_t UsbService::RequestWaitAsync(uint8_t busNum, uint8_t devAddr, int32_t timeOut,
+    const sptr<IRemoteObject> &cb, uint64_t userData)
+{
+    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    return PostTransfer(busNum, devAddr, REQUEST_WAIT_LANE, cb, userData,
+        [this, busNum, devAddr, timeOut](std::vector<uint8_t> &clientData, std::vector<uint8_t> &bufferData) {
+            HDI::Usb::V1_0::UsbDev dev = {busNum, devAddr};
+            int32_t ret = usbHostManager_->RequestWait(dev, timeOut, clientData, bufferData);
+            if (ret != UEC_OK) {
+                USB_HILOGE(MODULE_USB_HOST, "RequestWaitAsync error ret:%{public}d", ret);
+            }
+            return ret;
+        });
+}
+// LCOV_EXCL_STOP
+
+// LCOV_EXCL_START
+int32_t UsbService::PostTransfer(uint8_t busNum, uint8_t devAddr, uint8_t lane, const sptr<IRemoteObject> &cb,
+    uint64_t userData, std::function<int32_t(std::vector<uint8_t> &, std::vector<uint8_t> &)> transfer)
+{
+    if (cb == nullptr || transferExecutor_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "%{public}s: invalid callback or executor", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    bool posted = transferExecutor_->Post(busNum, devAddr, lane,
+        [cb, userData, transfer = std::move(transfer)]() {
+            (void)ReplyTransferStarted(cb, userData);
+            std::vector<uint8_t> clientData;
+            std::vector<uint8_t> bufferData;
+            int32_t ret = transfer(clientData, bufferData);
+            if (ReplyTransferData(cb, ret, clientData, bufferData, userData) != UEC_OK) {
+                /* the data did not fit or did not go out, the caller still gets a status to stop waiting */
+                (void)ReplyTransferData(cb, ret != UEC_OK ? ret : UEC_SERVICE_WRITE_PARCEL_ERROR, {}, {}, userData);
+            }
+        });
+    if (!posted) {
+        USB_HILOGW(MODULE_USB_HOST, "io lane 0x%{public}02x of %{public}u-%{public}u is full", lane, busNum, devAddr);
+        return UEC_SERVICE_WOULD_BLOCK;
+    }
+    return UEC_OK;
+}
+// LCOV_EXCL_STOP
+
 int32_t UsbService::RequestCancel(uint8_t busNum, uint8_t devAddr, uint8_t interfaceId, uint8_t endpointId)
 {
     if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
@@ -1288,6 +1538,34 @@ void UsbService::GetTransferTypeString(const UsbTransInfo &transInfo, USBEndpoin
     }
 }
 
+bool UsbService::ResolveTransferFault(UsbTransferFault &fault)
+{
+    UsbDevice device;
+    if (usbHostManager_ == nullptr || !usbHostManager_->GetTargetDevice(fault.busNum, fault.devAddr, device)) {
+        return false;
+    }
+    if (fault.transferType.empty()) {
+        USBEndpoint ep;
+        if (!usbHostManager_->GetEndpointFromId(device, fault.pipe.endpointId, ep)) {
+            return false;
+        }
+        UsbTransInfo transInfo = {};
+        transInfo.type = fault.submitType;
+        GetTransferTypeString(transInfo, ep, fault.transferType);
+        fault.pipe.intfId = ep.GetInterfaceId();
+    }
+    UsbInterface itIF;
+    if (!UsbReportSysEvent::GetUsbInterfaceId(device, fault.pipe, fault.pipe.intfId, itIF)) {
+        return false;
+    }
+    fault.vendorId = device.GetVendorId();
+    fault.productId = device.GetProductId();
+    fault.interfaceClass = itIF.GetClass();
+    fault.interfaceSubClass = itIF.GetSubClass();
+    fault.interfaceProtocol = itIF.GetProtocol();
+    return true;
+}
+
 // LCOV_EXCL_START
 int32_t UsbService::UsbSubmitTransfer(uint8_t busNum, uint8_t devAddr, const UsbTransInfo &param,
     const sptr<IRemoteObject> &cb, int32_t fd, int32_t memSize)
@@ -1312,35 +1590,81 @@ int32_t UsbService::UsbSubmitTransfer(uint8_t busNum, uint8_t devAddr, const Usb
     }
 
     HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
-    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
-        UsbDevice usbDev;
-        USBEndpoint ep;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev) &&
-            usbHostManager_->GetEndpointFromId(usbDev, param.endpoint, ep)) {
-            std::string transferType;
-            GetTransferTypeString(param, ep, transferType);
-            UsbReportSysEvent::ReportTransferFaultSysEvent(transferType.c_str(), usbDev,
-                {ep.GetInterfaceId(), param.endpoint}, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, static_cast<uint8_t>(param.endpoint),
+        UsbTransferStats::KindOfType(param.type));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->ReportSubmit(param.type, busNum, devAddr,
+            param.endpoint, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     int32_t ret = usbHostManager_->UsbSubmitTransfer(devInfo, info, cb, ashmem);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret);
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        USBEndpoint ep;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev) &&
-            usbHostManager_->GetEndpointFromId(usbDev, param.endpoint, ep)) {
-            std::string transferType;
-            GetTransferTypeString(param, ep, transferType);
-            UsbReportSysEvent::ReportTransferFaultSysEvent(transferType.c_str(), usbDev,
-                {ep.GetInterfaceId(), param.endpoint}, ret, "UsbSubmitTransferFail");
-        }
+        transferFaultReporter_->ReportSubmit(param.type, busNum, devAddr, param.endpoint, ret, "UsbSubmitTransferFail");
         USB_HILOGE(MODULE_USB_HOST, "UsbSubmitTransfer error ret:%{public}d", ret);
     }
     return ret;
 }
 // LCOV_EXCL_STOP
 
+// LCOV_EXCL_START
+int32_t UsbService::UsbSubmitTransferBatch(uint8_t busNum, uint8_t devAddr, const std::vector<UsbTransInfo> &infos,
+    const sptr<IRemoteObject> &cb, int32_t fd, int32_t memSize)
+{
+    USB_HILOGI(MODULE_USB_HOST, "UsbService UsbSubmitTransferBatch enter, count=%{public}zu", infos.size());
+    if (cb == nullptr || fd <= 0 || memSize <= 0 || memSize >= MEMSIZE_MAX || infos.empty() ||
+        infos.size() > MAX_NUM_OF_BATCH_TRANSFER) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "invalid param, fd=[%{public}d],memSize=[%{public}d]", fd, memSize);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    std::vector<HDI::Usb::V1_2::USBTransferInfo> transferInfos(infos.size());
+    int64_t totalLength = 0;
+    for (size_t i = 0; i < infos.size(); ++i) {
+        if (infos[i].length <= 0) {
+            ::close(fd);
+            USB_HILOGE(MODULE_USB_HOST, "invalid length, index=%{public}zu", i);
+            return UEC_SERVICE_INVALID_VALUE;
+        }
+        totalLength += infos[i].length;
+        UsbTransInfoChange(transferInfos[i], infos[i]);
+    }
+    /* memSize comes from the caller, the region behind fd must really be that large */
+    int32_t realSize = AshmemGetSize(fd);
+    if (totalLength > memSize || realSize < memSize) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "buffer too small, memSize=%{public}d, realSize=%{public}d", memSize, realSize);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    sptr<Ashmem> ashmem = new (std::nothrow) Ashmem(fd, memSize);
+    if (ashmem == nullptr) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "UsbService UsbSubmitTransferBatch error ashmem");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
+        transferFaultReporter_->ReportSubmit(infos[0].type, busNum, devAddr,
+            infos[0].endpoint, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    int32_t ret = usbHostManager_->UsbSubmitTransferBatch(devInfo, transferInfos, cb, ashmem);
+    if (ret != UEC_OK) {
+        transferFaultReporter_->ReportSubmit(infos[0].type, busNum, devAddr,
+            infos[0].endpoint, ret, "UsbSubmitTransferBatchFail");
+        USB_HILOGE(MODULE_USB_HOST, "UsbSubmitTransferBatch error ret:%{public}d", ret);
+    }
+    return ret;
+}
+// LCOV_EXCL_STOP
+
 int32_t UsbService::UnRegBulkCallback(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep)
 {
     if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
@@ -1374,11 +1698,8 @@ int32_t UsbService::BulkRead(uint8_t busNum, uint8_t devAddr, const USBEndpoint
     UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
     if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
         ::close(fd);
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("BulkRead", usbDev, pipe,
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+        transferFaultReporter_->Report("BulkRead", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     sptr<Ashmem> ashmem = new (std::nothrow) Ashmem(fd, memSize);
@@ -1389,11 +1710,7 @@ int32_t UsbService::BulkRead(uint8_t busNum, uint8_t devAddr, const USBEndpoint
     }
     int32_t ret = usbHostManager_->BulkRead(devInfo, pipe, ashmem);
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent("BulkRead", usbDev, pipe, ep,
-                ret, "BulkReadFail");
-        }
+        transferFaultReporter_->ReportEndpoint("BulkRead", busNum, devAddr, ep, ret, "BulkReadFail");
         USB_HILOGE(MODULE_USB_HOST, "BulkRead error ret:%{public}d", ret);
     }
     return ret;
@@ -1411,11 +1728,8 @@ int32_t UsbService::BulkWrite(uint8_t busNum, uint8_t devAddr, const USBEndpoint
     UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
     if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
         ::close(fd);
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::ReportTransferFaultSysEvent("BulkWrite", usbDev, pipe,
-                UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
-        }
+        transferFaultReporter_->Report("BulkWrite", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
         return UEC_SERVICE_PERMISSION_DENIED;
     }
     sptr<Ashmem> ashmem = new (std::nothrow) Ashmem(fd, memSize);
@@ -1426,11 +1740,7 @@ int32_t UsbService::BulkWrite(uint8_t busNum, uint8_t devAddr, const USBEndpoint
     }
     int32_t ret = usbHostManager_->BulkWrite(devInfo, pipe, ashmem);
     if (ret != UEC_OK) {
-        UsbDevice usbDev;
-        if (usbHostManager_->GetTargetDevice(busNum, devAddr, usbDev)) {
-            UsbReportSysEvent::CheckAttributeReportTransferFaultSysEvent("BulkWrite", usbDev, pipe, ep,
-                ret, "BulkWriteFail");
-        }
+        transferFaultReporter_->ReportEndpoint("BulkWrite", busNum, devAddr, ep, ret, "BulkWriteFail");
         USB_HILOGE(MODULE_USB_HOST, "BulkWrite error ret:%{public}d", ret);
     }
     return ret;
@@ -1457,16 +1767,241 @@ int32_t UsbService::BulkCancel(uint8_t busNum, uint8_t devAddr, const USBEndpoin
     // LCOV_EXCL_STOP
 }
 
+int32_t UsbService::RegBulkTransferBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep, int32_t fd,
+    int32_t memSize, const sptr<IRemoteObject> &client)
+{
+    if (usbHostManager_ == nullptr || client == nullptr || fd <= 0 || memSize <= 0 || memSize >= MEMSIZE_MAX) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "invalid param, fd=[%{public}d],memSize=[%{public}d]", fd, memSize);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    /* the buffer is kept and mapped for long, memSize must not run past the real region */
+    int32_t realSize = AshmemGetSize(fd);
+    if (realSize < memSize) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "memSize %{public}d exceeds ashmem size %{public}d", memSize, realSize);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
+        ::close(fd);
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    sptr<Ashmem> ashmem = new (std::nothrow) Ashmem(fd, memSize);
+    if (ashmem == nullptr) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "UsbService RegBulkTransferBuffer error ashmem");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
+    int32_t ret = usbHostManager_->RegBulkTransferBuffer(IPCSkeleton::GetCallingTokenID(), devInfo, pipe, ashmem,
+        client);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "RegBulkTransferBuffer error ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t UsbService::UnRegBulkTransferBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
+    return usbHostManager_->UnRegBulkTransferBuffer(IPCSkeleton::GetCallingTokenID(), devInfo, pipe);
+}
+
+int32_t UsbService::BulkTransferReadWithBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
+    int32_t offset, int32_t length, int32_t &actualLength, int32_t timeOut)
+{
+    actualLength = 0;
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkRead", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    int32_t ret = usbHostManager_->BulkTransferReadWithBuffer(IPCSkeleton::GetCallingTokenID(), devInfo, pipe,
+        offset, length, actualLength, timeOut);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret, static_cast<uint64_t>(std::max(actualLength, 0)));
+    if (ret != UEC_OK) {
+        transferFaultReporter_->ReportEndpoint("BulkRead", busNum, devAddr, ep, ret, "BulkTransferReadFail");
+        USB_HILOGE(MODULE_USB_HOST, "BulkTransferReadWithBuffer error ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t UsbService::BulkTransferWriteWithBuffer(uint8_t busNum, uint8_t devAddr, const USBEndpoint &ep,
+    int32_t offset, int32_t length, int32_t timeOut)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    UsbPipe pipe = {ep.GetInterfaceId(), ep.GetAddress()};
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, ep.GetAddress(), GetBulkTransferKind(ep));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->Report("BulkWrite", busNum, devAddr,
+            pipe, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    int32_t ret = usbHostManager_->BulkTransferWriteWithBuffer(IPCSkeleton::GetCallingTokenID(), devInfo, pipe,
+        offset, length, timeOut);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret,
+        ret == UEC_OK ? static_cast<uint64_t>(std::max(length, 0)) : 0);
+    if (ret != UEC_OK) {
+        transferFaultReporter_->ReportEndpoint("BulkWrite", busNum, devAddr, ep, ret, "BulkTransferWriteFail");
+        USB_HILOGE(MODULE_USB_HOST, "BulkTransferWriteWithBuffer error ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t UsbService::RegSubmitTransferBuffer(
+    uint8_t busNum, uint8_t devAddr, int32_t endpoint, int32_t slot, int32_t fd, int32_t memSize)
+{
+    if (usbHostManager_ == nullptr || fd <= 0 || memSize <= 0 || memSize >= MEMSIZE_MAX || slot < 0 ||
+        static_cast<uint32_t>(slot) >= MAX_NUM_OF_SUBMIT_BUFFER_SLOT) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "invalid param, slot=[%{public}d],fd=[%{public}d],memSize=[%{public}d]",
+            slot, fd, memSize);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    /* later transfers are checked against memSize only, it must not run past the real region */
+    int32_t realSize = AshmemGetSize(fd);
+    if (realSize < memSize) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "memSize %{public}d exceeds ashmem size %{public}d", memSize, realSize);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (!UsbService::CheckDevicePermission(busNum, devAddr)) {
+        ::close(fd);
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    sptr<Ashmem> ashmem = new (std::nothrow) Ashmem(fd, memSize);
+    if (ashmem == nullptr) {
+        ::close(fd);
+        USB_HILOGE(MODULE_USB_HOST, "UsbService RegSubmitTransferBuffer error ashmem");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    int32_t ret = usbHostManager_->RegSubmitTransferBuffer(IPCSkeleton::GetCallingTokenID(), devInfo,
+        endpoint, slot, ashmem);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_HOST, "RegSubmitTransferBuffer error ret:%{public}d", ret);
+    }
+    return ret;
+}
+
+int32_t UsbService::UnRegSubmitTransferBuffers(uint8_t busNum, uint8_t devAddr, int32_t endpoint)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    return usbHostManager_->UnRegSubmitTransferBuffers(IPCSkeleton::GetCallingTokenID(), devInfo, endpoint);
+}
+
+// LCOV_EXCL_START
+int32_t UsbService::UsbSubmitTransferWithBuffer(uint8_t busNum, uint8_t devAddr, const UsbTransInfo &param,
+    const sptr<IRemoteObject> &cb, int32_t slot)
+{
+    if (cb == nullptr || slot < 0 || static_cast<uint32_t>(slot) >= MAX_NUM_OF_SUBMIT_BUFFER_SLOT) {
+        USB_HILOGE(MODULE_USB_HOST, "invalid param, slot=[%{public}d]", slot);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    HDI::Usb::V1_2::USBTransferInfo info;
+    UsbTransInfoChange(info, param);
+    HDI::Usb::V1_0::UsbDev devInfo = {busNum, devAddr};
+    UsbTransferProbe probe = UsbTransferStats::Begin(busNum, devAddr, static_cast<uint8_t>(param.endpoint),
+        UsbTransferStats::KindOfType(param.type));
+    bool permitted = UsbService::CheckDevicePermission(busNum, devAddr);
+    UsbTransferStats::End(probe, UsbLatencyStage::PERMISSION, permitted ? UEC_OK : UEC_SERVICE_PERMISSION_DENIED);
+    if (!permitted) {
+        transferFaultReporter_->ReportSubmit(param.type, busNum, devAddr,
+            param.endpoint, UEC_SERVICE_PERMISSION_DENIED, "CheckDevicePermission failed");
+        return UEC_SERVICE_PERMISSION_DENIED;
+    }
+    int32_t ret = usbHostManager_->UsbSubmitTransferWithBuffer(IPCSkeleton::GetCallingTokenID(), devInfo, info,
+        cb, slot);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, ret);
+    if (ret != UEC_OK) {
+        transferFaultReporter_->ReportSubmit(param.type, busNum, devAddr, param.endpoint, ret, "UsbSubmitTransferFail");
+        USB_HILOGE(MODULE_USB_HOST, "UsbSubmitTransferWithBuffer error ret:%{public}d", ret);
+    }
+    return ret;
+}
+// LCOV_EXCL_STOP
+
 bool UsbService::CheckDevicePermission(uint8_t busNum, uint8_t devAddr)
+{
+    // device opened by the same caller and not revoked or expired since: skip the right query
+    if (usbHostManager_ != nullptr &&
+        usbHostManager_->CheckDeviceSession(IPCSkeleton::GetCallingTokenID(), busNum, devAddr)) {
+        return true;
+    }
+    uint64_t expireTime = UINT64_MAX;
+    return CheckDevicePermission(busNum, devAddr, expireTime);
+}
+
+bool UsbService::CheckDevicePermission(uint8_t busNum, uint8_t devAddr, uint64_t &expireTime)
 {
     std::string name = std::to_string(busNum) + "-" + std::to_string(devAddr);
-    if (!UsbService::HasRight(name)) {
+    if (!UsbService::HasRight(name, expireTime)) {
         USB_HILOGE(MODULE_USB_HOST, "No permission");
         return false;
     }
     return true;
 }
 
+// LCOV_EXCL_START
+void UsbService::ClearDeviceSessions()
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return;
+    }
+    usbHostManager_->ClearDeviceSessions();
+}
+
+void UsbService::RemoveDeviceSessions(const std::string &tokenId, const std::string &identity)
+{
+    if (usbHostManager_ == nullptr) {
+        USB_HILOGE(MODULE_USB_HOST, "UsbService::usbHostManager_ is nullptr");
+        return;
+    }
+    char *end = nullptr;
+    errno = 0;
+    unsigned long long token = std::strtoull(tokenId.c_str(), &end, DECIMAL_BASE);
+    if (tokenId == USB_DEFAULT_TOKEN || tokenId.empty() || end == nullptr || *end != '\0' || errno == ERANGE ||
+        token > UINT32_MAX) {
+        /* the right is not bound to one token, any token may have opened the device under it */
+        usbHostManager_->RemoveDeviceSessions(identity);
+        return;
+    }
+    usbHostManager_->RemoveDeviceSessions(static_cast<uint32_t>(token), identity);
+}
+// LCOV_EXCL_STOP
+
 // LCOV_EXCL_START
 int32_t UsbService::HasRight(const std::string &deviceName, bool &hasRight)
 {
@@ -1476,8 +2011,15 @@ int32_t UsbService::HasRight(const std::string &deviceName, bool &hasRight)
 // LCOV_EXCL_STOP
 
 bool UsbService::HasRight(const std::string &deviceName)
+{
+    uint64_t expireTime = UINT64_MAX;
+    return HasRight(deviceName, expireTime);
+}
+
+bool UsbService::HasRight(const std::string &deviceName, uint64_t &expireTime)
 {
     USB_HILOGI(MODULE_USB_HOST, "calling usbRightManager HasRight");
+    expireTime = UINT64_MAX;
     if (usbRightManager_ == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "invalid usbRightManager_");
         return false;
@@ -1504,11 +2046,11 @@ bool UsbService::HasRight(const std::string &deviceName)
     }
 
     USB_HILOGI(MODULE_USB_HOST, "bundle=%{public}s, device=%{public}s", bundleName.c_str(), deviceName.c_str());
-    if (usbRightManager_->HasRight(deviceVidPidSerialNum, bundleName, tokenId, userId)) {
+    if (usbRightManager_->HasRight(deviceVidPidSerialNum, bundleName, tokenId, userId, expireTime)) {
         return true;
     }
 
-    return usbRightManager_->HasRight(deviceVidPidSerialNum, bundleName, USB_DEFAULT_TOKEN, userId);
+    return usbRightManager_->HasRight(deviceVidPidSerialNum, bundleName, USB_DEFAULT_TOKEN, userId, expireTime);
     // LCOV_EXCL_STOP
 }
 
@@ -1647,15 +2189,14 @@ int32_t UsbService::AddAccessRight(const std::string &tokenId, const std::string
 // LCOV_EXCL_START
 bool UsbService::GetBundleInfo(std::string &tokenId, int32_t &userId)
 {
-    OHOS::Security::AccessToken::AccessTokenID token = IPCSkeleton::GetCallingTokenID();
-    OHOS::Security::AccessToken::HapTokenInfo hapTokenInfoRes;
-    int32_t ret = OHOS::Security::AccessToken::AccessTokenKit::GetHapTokenInfo(token, hapTokenInfoRes);
-    if (ret != ERR_OK) {
-        USB_HILOGE(MODULE_USB_HOST, "failed, ret: %{public}d", ret);
+    UsbCallerIdentity identity;
+    UsbRightManager::GetCallerIdentity(identity);
+    if (!identity.isHap) {
+        USB_HILOGE(MODULE_USB_HOST, "failed, not a hap caller");
         return false;
     }
     tokenId = USB_DEFAULT_TOKEN;
-    userId = hapTokenInfoRes.userID;
+    userId = identity.userId;
     return true;
 }
 // LCOV_EXCL_STOP
@@ -1679,12 +2220,9 @@ std::string UsbService::GetDeviceVidPidSerialNumber(const std::string &deviceNam
 {
     std::string strDesc = "test";
     std::lock_guard<std::mutex> guard(mutex_);
-    for (auto it = deviceVidPidMap_.begin(); it != deviceVidPidMap_.end(); ++it) {
-        USB_HILOGI(MODULE_USB_HOST, " it->first = %{public}s", it->first.c_str());
-        if (it->first == deviceName) {
-            strDesc = it->second;
-            break;
-        }
+    auto it = deviceVidPidMap_.find(deviceName);
+    if (it != deviceVidPidMap_.end()) {
+        strDesc = it->second;
     }
     return strDesc;
 }
@@ -1692,17 +2230,14 @@ std::string UsbService::GetDeviceVidPidSerialNumber(const std::string &deviceNam
 
 int32_t UsbService::GetDeviceVidPidSerialNumber(const std::string &deviceName, std::string& strDesc)
 {
-    int32_t isMatched = UEC_INTERFACE_INVALID_VALUE;
     std::lock_guard<std::mutex> guard(mutex_);
-    for (auto it = deviceVidPidMap_.begin(); it != deviceVidPidMap_.end(); ++it) {
-        USB_HILOGI(MODULE_USB_HOST, " it->first = %{public}s", it->first.c_str());
-        if (it->first == deviceName) {
-            strDesc = it->second;
-            isMatched = UEC_OK;
-            break;
-        }
+    auto it = deviceVidPidMap_.find(deviceName);
+    if (it == deviceVidPidMap_.end()) {
+        USB_HILOGW(MODULE_USB_HOST, "device %{public}s not found", deviceName.c_str());
+        return UEC_INTERFACE_INVALID_VALUE;
     }
-    return isMatched;
+    strDesc = it->second;
+    return UEC_OK;
 }
 
 // LCOV_EXCL_START
@@ -2257,18 +2792,16 @@ void UsbService::UpdateUsbPort(int32_t portId, int32_t powerRole,
 // LCOV_EXCL_START
 bool UsbService::GetCallingInfo(std::string &bundleName, std::string &tokenId, int32_t &userId)
 {
-    OHOS::Security::AccessToken::AccessTokenID token = IPCSkeleton::GetCallingTokenID();
-    OHOS::Security::AccessToken::HapTokenInfo hapTokenInfoRes;
-    int32_t ret = OHOS::Security::AccessToken::AccessTokenKit::GetHapTokenInfo(token, hapTokenInfoRes);
-    if (ret != ERR_OK) {
-        USB_HILOGE(MODULE_USB_SERVICE, "failed, ret: %{public}d, app: %{public}s",
-            ret, bundleName.c_str());
+    UsbCallerIdentity identity;
+    UsbRightManager::GetCallerIdentity(identity);
+    if (!identity.isHap) {
+        USB_HILOGE(MODULE_USB_SERVICE, "failed, token: %{public}s is not a hap", identity.tokenIdStr.c_str());
         return false;
     }
-    bundleName = hapTokenInfoRes.bundleName;
-    tokenId = std::to_string((uint32_t)token);
-    userId = hapTokenInfoRes.userID;
-    USB_HILOGD(MODULE_USB_SERVICE, "ret: %{public}d, app: %{public}s", ret, bundleName.c_str());
+    bundleName = identity.bundleName;
+    tokenId = identity.tokenIdStr;
+    userId = identity.userId;
+    USB_HILOGD(MODULE_USB_SERVICE, "app: %{public}s", bundleName.c_str());
     return true;
 }
 // LCOV_EXCL_STOP
@@ -2296,14 +2829,13 @@ int32_t UsbService::CheckSysApiPermission()
 // LCOV_EXCL_START
 int32_t UsbService::GetHapApiVersion()
 {
-    OHOS::Security::AccessToken::AccessTokenID token = IPCSkeleton::GetCallingTokenID();
-    OHOS::Security::AccessToken::HapTokenInfo hapTokenInfoRes;
-    int32_t ret = OHOS::Security::AccessToken::AccessTokenKit::GetHapTokenInfo(token, hapTokenInfoRes);
-    if (ret != ERR_OK) {
-        USB_HILOGE(MODULE_USB_SERVICE, "GetHapTokenInfo failed, ret: %{public}d", ret);
+    UsbCallerIdentity identity;
+    UsbRightManager::GetCallerIdentity(identity);
+    if (!identity.isHap) {
+        USB_HILOGE(MODULE_USB_SERVICE, "GetHapTokenInfo failed, not a hap caller");
         return API_VERSION_ID_18;
     }
-    int32_t hapApiVersion = hapTokenInfoRes.apiVersion;
+    int32_t hapApiVersion = identity.apiVersion;
     USB_HILOGD(MODULE_USB_SERVICE, "API check hapApiVersion = %{public}d", hapApiVersion);
 
     return hapApiVersion;
@@ -2382,6 +2914,9 @@ int UsbService::DoDump(int fd, const std::vector<std::string> &argList)
             return UEC_SERVICE_INVALID_VALUE;
         }
         usbHostManager_->Dump(fd, argList[1]);
+        if (argList[1] == "-perf" && deviceEventDispatcher_ != nullptr) {
+            deviceEventDispatcher_->Dump(fd);
+        }
         return UEC_OK;
     }
 #endif // USB_MANAGER_FEATURE_HOST
@@ -2412,6 +2947,8 @@ int UsbService::DoDump(int fd, const std::vector<std::string> &argList)
         usbSerialManager_->SerialPortListDump(fd, argList);
     } else if (argList[0] == USB_GETT) {
         usbSerialManager_->SerialGetAttributeDump(fd, argList);
+    } else if (argList[0] == USB_STREAM) {
+        usbSerialManager_->SerialStreamDump(fd);
     } else {
         dprintf(fd, "Usb Dump service:invalid parameter.\n");
         DumpHelp(fd);
@@ -2464,6 +3001,7 @@ void UsbService::DumpHelp(int32_t fd)
     dprintf(fd, "-h: dump help\n");
     dprintf(fd, "============= dump the all device ==============\n");
     dprintf(fd, "usb_host -a: dump the all device list info\n");
+    dprintf(fd, "usb_host -perf: dump the transfer counters, latency histograms and hot-plug settle times\n");
     dprintf(fd, "------------------------------------------------\n");
 #ifdef USB_MANAGER_FEATURE_DEVICE
     if (usbDeviceManager_ == nullptr) {
@@ -2576,6 +3114,7 @@ void UsbService::UsbdDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &obj
 void UsbService::SerialDeathRecipient::OnRemoteDied(const wptr<IRemoteObject> &object)
 {
     USB_HILOGI(MODULE_USB_SERVICE, "UsbService SerialDeathRecipient enter");
+    UsbRightManager::EraseCallerIdentityByToken(this->tokenId_);
     service_->FreeTokenId(this->portId_, this->tokenId_);
     service_->CancelSerialRight(this->portId_);
 }
@@ -2627,14 +3166,25 @@ int32_t UsbService::DeviceEvent(const HDI::Usb::V1_0::USBDeviceInfo &info)
 #ifdef USB_MANAGER_FEATURE_HOST
     int32_t busNum = info.busNum;
     int32_t devAddr = info.devNum;
-    if (status == ACT_DEVUP) {
-        USB_HILOGI(MODULE_USB_SERVICE, "host: usb attached");
-        g_serviceInstance->AddDevice(busNum, devAddr);
+    /* events of one bus/dev stay ordered, different devices attach in parallel */
+    auto task = [busNum, devAddr, status]() {
+        if (status == ACT_DEVUP) {
+            USB_HILOGI(MODULE_USB_SERVICE, "host: usb attached");
+            g_serviceInstance->AddDevice(busNum, devAddr);
+        } else {
+            USB_HILOGI(MODULE_USB_SERVICE, "host: usb detached");
+            g_serviceInstance->DelDevice(busNum, devAddr);
+        }
+        /* the unload delay starts once the device is handled, a slow attach must not race the unload timer */
+        g_serviceInstance->UnLoadSelf(UsbService::UnLoadSaType::UNLOAD_SA_DELAY);
+    };
+    if (deviceEventDispatcher_ != nullptr) {
+        uint16_t key = static_cast<uint16_t>((static_cast<uint32_t>(busNum) << DEVICE_EVENT_KEY_BUS_SHIFT) |
+            static_cast<uint8_t>(devAddr));
+        deviceEventDispatcher_->Dispatch(key, task);
     } else {
-        USB_HILOGI(MODULE_USB_SERVICE, "host: usb detached");
-        g_serviceInstance->DelDevice(busNum, devAddr);
+        task();
     }
-    g_serviceInstance->UnLoadSelf(UsbService::UnLoadSaType::UNLOAD_SA_DELAY);
 #endif // USB_MANAGER_FEATURE_HOST
     if (status == ACT_DEVUP) {
         std::unique_lock lock(serialManagerMutex_);
@@ -2839,6 +3389,74 @@ void UsbService::SerialAttributeChange(UsbSerialAttr &serialAttr,
 }
 // LCOV_EXCL_STOP
 
+// LCOV_EXCL_START
+int32_t UsbService::SerialSubscribe(int32_t portId, const sptr<IRemoteObject> &serialRemote)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "%{public}s: Start", __func__);
+    if (serialRemote == nullptr) {
+        USB_HILOGE(MODULE_USB_SERVICE, "%{public}s: serialRemote is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    int32_t ret = ValidateUsbSerialManagerAndPort(portId);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERVICE, "%{public}s: ValidateUsbSerialManagerAndPort failed", __func__);
+        return ret;
+    }
+
+    ret = usbSerialManager_->SerialSubscribe(portId, serialRemote);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERVICE, "%{public}s: SerialSubscribe failed", __func__);
+        ReportUsbSerialOperationFaultSysEvent(portId, "SerialSubscribe", ret, "SerialSubscribe failed");
+    }
+    return ret;
+}
+// LCOV_EXCL_STOP
+
+// LCOV_EXCL_START
+int32_t UsbService::SerialUnsubscribe(int32_t portId)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "%{public}s: Start", __func__);
+    int32_t ret = ValidateUsbSerialManagerAndPort(portId);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERVICE, "%{public}s: ValidateUsbSerialManagerAndPort failed", __func__);
+        return ret;
+    }
+
+    return usbSerialManager_->SerialUnsubscribe(portId);
+}
+// LCOV_EXCL_STOP
+
+// LCOV_EXCL_START
+int32_t UsbService::SerialOpenRing(int32_t portId, const sptr<IRemoteObject> &serialRemote, int32_t &ringFd,
+    int32_t &rxDataFd, int32_t &rxSpaceFd, int32_t &txDataFd, int32_t &txSpaceFd)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "%{public}s: Start", __func__);
+    if (serialRemote == nullptr) {
+        USB_HILOGE(MODULE_USB_SERVICE, "%{public}s: serialRemote is nullptr", __func__);
+        return UEC_SERVICE_INVALID_VALUE;
+    }
+    int32_t ret = SerialOpen(portId, serialRemote);
+    if (ret != UEC_OK) {
+        return ret;
+    }
+
+    SERIAL::SerialRingFds fds;
+    ret = usbSerialManager_->SerialAttachRing(portId, fds);
+    if (ret != UEC_OK) {
+        USB_HILOGE(MODULE_USB_SERVICE, "%{public}s: SerialAttachRing failed", __func__);
+        ReportUsbSerialOperationFaultSysEvent(portId, "SerialOpenRing", ret, "SerialAttachRing failed");
+        usbSerialManager_->SerialClose(portId);
+        return ret;
+    }
+    ringFd = fds.ringFd;
+    rxDataFd = fds.rxDataFd;
+    rxSpaceFd = fds.rxSpaceFd;
+    txDataFd = fds.txDataFd;
+    txSpaceFd = fds.txSpaceFd;
+    return UEC_OK;
+}
+// LCOV_EXCL_STOP
+
 // LCOV_EXCL_START
 int32_t UsbService::SerialGetAttribute(int32_t portId, UsbSerialAttr& attributeInfo)
 {
@@ -23,9 +23,19 @@
 
 namespace OHOS {
 namespace USB {
+void UsbTransferCallbackImpl::RecordCompletion(int32_t status, int32_t actLength)
+{
+    if (probe_.startNs == 0) {
+        return;
+    }
+    UsbTransferProbe probe = probe_;
+    UsbTransferStats::End(probe, UsbLatencyStage::SUBMIT_TO_CALLBACK, status, actLength > 0 ? actLength : 0);
+}
+
 int32_t UsbTransferCallbackImpl::OnTransferWriteCallback(int32_t status, int32_t actLength,
     const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData)
 {
+    RecordCompletion(status, actLength);
     if (remote_ == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "%{public}s: remote_ is nullptr", __func__);
         return UEC_SERVICE_INVALID_VALUE;
@@ -68,6 +78,7 @@ int32_t UsbTransferCallbackImpl::OnTransferWriteCallback(int32_t status, int32_t
 int32_t UsbTransferCallbackImpl::OnTransferReadCallback(int32_t status, int32_t actLength,
     const std::vector<HDI::Usb::V2_0::UsbIsoPacketDescriptor> &isoInfo, const uint64_t userData)
 {
+    RecordCompletion(status, actLength);
     USB_HILOGI(MODULE_USB_HOST, "%{public}s: UsbdTransferCallbackImpl OnTransferReadCallback enter", __func__);
     if (remote_ == nullptr) {
         USB_HILOGE(MODULE_USB_HOST, "%{public}s: remote_ is nullptr", __func__);
@@ -0,0 +1,239 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_fault_reporter.h"
+
+#include <cinttypes>
+#include <pthread.h>
+#include <string_view>
+#include <utility>
+#include "hilog_wrapper.h"
+#include "usb_report_sys_event.h"
+
+namespace OHOS {
+namespace USB {
+constexpr size_t PENDING_FAULTS_MAX_SIZE = 256;
+constexpr size_t RESOLVED_FAULTS_MAX_SIZE = 256;
+constexpr size_t FAULT_HASH_SEED = 0x9E3779B9;
+constexpr uint32_t FAULT_HASH_LEFT_SHIFT = 6;
+constexpr uint32_t FAULT_HASH_RIGHT_SHIFT = 2;
+constexpr uint32_t FAULT_KEY_BUS_SHIFT = 24;
+constexpr uint32_t FAULT_KEY_DEV_SHIFT = 16;
+constexpr uint32_t FAULT_KEY_INTF_SHIFT = 8;
+constexpr const char *FLUSHER_NAME = "usb_fault_rpt";
+
+static std::string_view ToView(const char *str)
+{
+    return str == nullptr ? std::string_view() : std::string_view(str);
+}
+
+static void HashCombine(size_t &seed, size_t value)
+{
+    seed ^= value + FAULT_HASH_SEED + (seed << FAULT_HASH_LEFT_SHIFT) + (seed >> FAULT_HASH_RIGHT_SHIFT);
+}
+
+bool UsbTransferFault::operator==(const UsbTransferFault &other) const
+{
+    return ret == other.ret && submitType == other.submitType && busNum == other.busNum &&
+        devAddr == other.devAddr && pipe.intfId == other.pipe.intfId && pipe.endpointId == other.pipe.endpointId &&
+        vendorId == other.vendorId && productId == other.productId && interfaceClass == other.interfaceClass &&
+        interfaceSubClass == other.interfaceSubClass && interfaceProtocol == other.interfaceProtocol &&
+        transferType == other.transferType && ToView(description) == ToView(other.description);
+}
+
+size_t UsbTransferFaultHash::operator()(const UsbTransferFault &fault) const
+{
+    size_t seed = (static_cast<size_t>(fault.busNum) << FAULT_KEY_BUS_SHIFT) |
+        (static_cast<size_t>(fault.devAddr) << FAULT_KEY_DEV_SHIFT) |
+        (static_cast<size_t>(fault.pipe.intfId) << FAULT_KEY_INTF_SHIFT) | fault.pipe.endpointId;
+    HashCombine(seed, std::hash<int32_t>()(fault.ret));
+    HashCombine(seed, std::hash<int32_t>()(fault.submitType));
+    HashCombine(seed, std::hash<int32_t>()(fault.vendorId));
+    HashCombine(seed, std::hash<int32_t>()(fault.productId));
+    HashCombine(seed, std::hash<std::string>()(fault.transferType));
+    HashCombine(seed, std::hash<std::string_view>()(ToView(fault.description)));
+    return seed;
+}
+
+UsbTransferFaultReporter::UsbTransferFaultReporter(Resolver resolver, uint32_t intervalMs)
+    : resolver_(std::move(resolver)), intervalMs_(intervalMs)
+{
+}
+
+UsbTransferFaultReporter::~UsbTransferFaultReporter()
+{
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        stop_ = true;
+    }
+    cond_.notify_all();
+    if (flusher_.joinable()) {
+        flusher_.join();
+    }
+}
+
+void UsbTransferFaultReporter::Report(const char *transferType, uint8_t busNum, uint8_t devAddr,
+    const HDI::Usb::V1_0::UsbPipe &pipe, int32_t ret, const char *description)
+{
+    UsbTransferFault fault;
+    fault.transferType = transferType == nullptr ? "" : transferType;
+    fault.description = description;
+    fault.ret = ret;
+    fault.busNum = busNum;
+    fault.devAddr = devAddr;
+    fault.pipe = pipe;
+    Record(fault);
+}
+
+void UsbTransferFaultReporter::ReportEndpoint(const char *transferType, uint8_t busNum, uint8_t devAddr,
+    const USBEndpoint &ep, int32_t ret, const char *description)
+{
+    if (UsbReportSysEvent::IsExpectedTransferFault(ep, ret)) {
+        return;
+    }
+    HDI::Usb::V1_0::UsbPipe pipe = {static_cast<uint8_t>(ep.GetInterfaceId()), static_cast<uint8_t>(ep.GetAddress())};
+    Report(transferType, busNum, devAddr, pipe, ret, description);
+}
+
+void UsbTransferFaultReporter::ReportSubmit(int32_t submitType, uint8_t busNum, uint8_t devAddr, int32_t endpoint,
+    int32_t ret, const char *description)
+{
+    UsbTransferFault fault;
+    fault.description = description;
+    fault.ret = ret;
+    fault.submitType = submitType;
+    fault.busNum = busNum;
+    fault.devAddr = devAddr;
+    fault.pipe = {0, static_cast<uint8_t>(endpoint)};
+    Record(fault);
+}
+
+void UsbTransferFaultReporter::Record(UsbTransferFault &fault)
+{
+    UsbTransferFault resolved;
+    if (FindResolved(fault, resolved)) {
+        AddPending(std::move(resolved));
+        return;
+    }
+    /* resolved now, by the end of the interval the device may be gone or its address taken by another one */
+    UsbTransferFault reported = fault;
+    uint64_t generation = 0;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        generation = forgetGeneration_;
+    }
+    if (resolver_ == nullptr || !resolver_(fault)) {
+        USB_HILOGW(MODULE_USB_SERVICE, "drop fault %{public}d, device %{public}u-%{public}u is gone", fault.ret,
+            fault.busNum, fault.devAddr);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        /* a device detached while resolving may be the one just resolved, do not remember it */
+        if (generation == forgetGeneration_) {
+            if (resolvedFaults_.size() >= RESOLVED_FAULTS_MAX_SIZE) {
+                resolvedFaults_.clear();
+            }
+            resolvedFaults_.emplace(std::move(reported), fault);
+        }
+    }
+    AddPending(std::move(fault));
+}
+
+bool UsbTransferFaultReporter::FindResolved(const UsbTransferFault &fault, UsbTransferFault &resolved)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    auto it = resolvedFaults_.find(fault);
+    if (it == resolvedFaults_.end()) {
+        return false;
+    }
+    resolved = it->second;
+    return true;
+}
+
+void UsbTransferFaultReporter::AddPending(UsbTransferFault &&fault)
+{
+    bool wakeUp = false;
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        auto it = pendingFaults_.find(fault);
+        if (it != pendingFaults_.end()) {
+            ++it->second;
+            return;
+        }
+        if (pendingFaults_.size() >= PENDING_FAULTS_MAX_SIZE) {
+            ++droppedFaults_;
+            return;
+        }
+        wakeUp = pendingFaults_.empty();
+        pendingFaults_.emplace(std::move(fault), 1);
+        if (!flusher_.joinable() && !stop_) {
+            flusher_ = std::thread([this]() {
+                pthread_setname_np(pthread_self(), FLUSHER_NAME);
+                FlushLoop();
+            });
+        }
+    }
+    if (wakeUp) {
+        cond_.notify_one();
+    }
+}
+
+void UsbTransferFaultReporter::ForgetDevice(uint8_t busNum, uint8_t devAddr)
+{
+    std::lock_guard<std::mutex> guard(mutex_);
+    ++forgetGeneration_;
+    for (auto it = resolvedFaults_.begin(); it != resolvedFaults_.end();) {
+        if (it->first.busNum == busNum && it->first.devAddr == devAddr) {
+            it = resolvedFaults_.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void UsbTransferFaultReporter::FlushLoop()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        cond_.wait(lock, [this]() { return stop_ || !pendingFaults_.empty(); });
+        /* the first fault opens the interval, everything of the same kind until it ends is counted only */
+        cond_.wait_for(lock, std::chrono::milliseconds(intervalMs_), [this]() { return stop_; });
+        std::unordered_map<UsbTransferFault, uint32_t, UsbTransferFaultHash> faults;
+        faults.swap(pendingFaults_);
+        uint64_t dropped = droppedFaults_;
+        droppedFaults_ = 0;
+        lock.unlock();
+        Flush(faults, dropped);
+        lock.lock();
+    }
+}
+
+void UsbTransferFaultReporter::Flush(
+    const std::unordered_map<UsbTransferFault, uint32_t, UsbTransferFaultHash> &faults, uint64_t dropped)
+{
+    if (faults.empty() && dropped == 0) {
+        return;
+    }
+    uint64_t total = dropped;
+    for (const auto &[fault, count] : faults) {
+        total += count;
+        UsbReportSysEvent::ReportTransferFaultSysEvent(fault, count);
+    }
+    USB_HILOGI(MODULE_USB_SERVICE, "transfer faults flushed, kinds:%{public}zu faults:%{public}" PRIu64
+        " dropped:%{public}" PRIu64, faults.size(), total, dropped);
+}
+} // namespace USB
+} // namespace OHOS
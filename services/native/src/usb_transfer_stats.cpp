@@ -0,0 +1,334 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_stats.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <cstdio>
+#include <map>
+#include "usb_errors.h"
+
+namespace OHOS {
+namespace USB {
+constexpr uint64_t NS_PER_US = 1000;
+constexpr uint32_t U64_TOP_BIT = 63;
+constexpr uint64_t SLOT_KEY_USED = 1ULL << 32;
+/* a slot of a detached device, the owning thread may claim it again for another key */
+constexpr uint64_t SLOT_KEY_RETIRED = 1ULL << 33;
+constexpr uint32_t KEY_BUS_SHIFT = 24;
+constexpr uint32_t KEY_DEV_SHIFT = 16;
+constexpr uint32_t KEY_ENDPOINT_SHIFT = 8;
+constexpr uint32_t KEY_KIND_SHIFT = 4;
+constexpr uint32_t KEY_FIELD_MASK = 0xFF;
+constexpr uint32_t KEY_NIBBLE_MASK = 0x0F;
+constexpr uint32_t SLOT_HASH_MULTIPLIER = 0x9E3779B1;
+constexpr int32_t TRANSFER_TYPE_CONTROL = 0;
+constexpr int32_t TRANSFER_TYPE_ISOCHRONOUS = 1;
+constexpr int32_t TRANSFER_TYPE_INTERRUPT = 3;
+constexpr uint32_t PERCENT_50 = 50;
+constexpr uint32_t PERCENT_90 = 90;
+constexpr uint32_t PERCENT_99 = 99;
+constexpr uint32_t PERCENT_100 = 100;
+constexpr const char *KIND_NAMES[] = {"control", "iso", "bulk", "interrupt"};
+constexpr const char *STAGE_NAMES[] = {"permission", "hdi", "callback"};
+
+/* hands the shard of a thread back to the pool when the thread exits, the counters stay */
+class UsbTransferStats::ShardLease {
+public:
+    explicit ShardLease(UsbTransferStats &stats) : stats_(stats), shard_(stats.AcquireShard()) {}
+    ~ShardLease()
+    {
+        stats_.ReleaseShard(shard_);
+    }
+    Shard *Get() const
+    {
+        return shard_;
+    }
+
+private:
+    UsbTransferStats &stats_;
+    Shard *shard_;
+};
+
+UsbTransferStats &UsbTransferStats::GetInstance()
+{
+    static UsbTransferStats instance;
+    return instance;
+}
+
+uint64_t UsbTransferStats::NowNs()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+uint32_t UsbTransferStats::BucketOf(uint64_t us)
+{
+    if (us < SUB_BUCKET_COUNT) {
+        return static_cast<uint32_t>(us);
+    }
+    uint32_t exponent = static_cast<uint32_t>(U64_TOP_BIT - __builtin_clzll(us));
+    if (exponent >= MAX_BUCKET_EXPONENT + 1) {
+        return BUCKET_COUNT - 1;
+    }
+    uint32_t sub = static_cast<uint32_t>(us >> (exponent - SUB_BUCKET_BITS)) & (SUB_BUCKET_COUNT - 1);
+    return (exponent - SUB_BUCKET_BITS + 1) * SUB_BUCKET_COUNT + sub;
+}
+
+uint64_t UsbTransferStats::BucketLowerBound(uint32_t bucket)
+{
+    if (bucket < SUB_BUCKET_COUNT) {
+        return bucket;
+    }
+    uint32_t exponent = bucket / SUB_BUCKET_COUNT + SUB_BUCKET_BITS - 1;
+    uint64_t sub = bucket % SUB_BUCKET_COUNT;
+    return (SUB_BUCKET_COUNT + sub) << (exponent - SUB_BUCKET_BITS);
+}
+
+UsbTransferKind UsbTransferStats::KindOfType(int32_t type)
+{
+    switch (type) {
+        case TRANSFER_TYPE_CONTROL:
+            return UsbTransferKind::CONTROL;
+        case TRANSFER_TYPE_ISOCHRONOUS:
+            return UsbTransferKind::ISOCHRONOUS;
+        case TRANSFER_TYPE_INTERRUPT:
+            return UsbTransferKind::INTERRUPT;
+        default:
+            return UsbTransferKind::BULK;
+    }
+}
+
+UsbTransferProbe UsbTransferStats::Begin(uint8_t busNum, uint8_t devAddr, uint8_t endpoint, UsbTransferKind kind)
+{
+    UsbTransferProbe probe;
+    probe.busNum = busNum;
+    probe.devAddr = devAddr;
+    probe.endpoint = endpoint;
+    probe.kind = kind;
+    probe.startNs = NowNs();
+    return probe;
+}
+
+void UsbTransferStats::End(UsbTransferProbe &probe, UsbLatencyStage stage, int32_t ret, uint64_t bytes)
+{
+    uint64_t now = NowNs();
+    uint64_t us = now > probe.startNs ? (now - probe.startNs) / NS_PER_US : 0;
+    GetInstance().Record(probe, stage, us, ret != UEC_OK, bytes);
+    probe.startNs = now;
+}
+
+UsbTransferStats::Shard *UsbTransferStats::AcquireShard()
+{
+    std::lock_guard<std::mutex> guard(shardsMutex_);
+    if (!freeShards_.empty()) {
+        Shard *shard = freeShards_.back();
+        freeShards_.pop_back();
+        return shard;
+    }
+    shards_.push_back(std::make_unique<Shard>());
+    return shards_.back().get();
+}
+
+void UsbTransferStats::ReleaseShard(Shard *shard)
+{
+    std::lock_guard<std::mutex> guard(shardsMutex_);
+    freeShards_.push_back(shard);
+}
+
+void UsbTransferStats::Record(const UsbTransferProbe &probe, UsbLatencyStage stage, uint64_t us, bool failed,
+    uint64_t bytes)
+{
+    thread_local ShardLease lease(*this);
+    Shard *shard = lease.Get();
+    uint64_t key = SLOT_KEY_USED | (static_cast<uint64_t>(probe.busNum) << KEY_BUS_SHIFT) |
+        (static_cast<uint64_t>(probe.devAddr) << KEY_DEV_SHIFT) |
+        (static_cast<uint64_t>(probe.endpoint) << KEY_ENDPOINT_SHIFT) |
+        (static_cast<uint64_t>(probe.kind) << KEY_KIND_SHIFT) | static_cast<uint64_t>(stage);
+    Slot *slot = FindSlot(*shard, key);
+    if (slot == nullptr) {
+        shard->dropped.store(shard->dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+        return;
+    }
+    auto bump = [](auto &counter, uint64_t delta) {
+        counter.store(counter.load(std::memory_order_relaxed) + delta, std::memory_order_relaxed);
+    };
+    bump(slot->count, 1);
+    bump(slot->errors, failed ? 1 : 0);
+    bump(slot->bytes, bytes);
+    bump(slot->sumUs, us);
+    if (us > slot->maxUs.load(std::memory_order_relaxed)) {
+        slot->maxUs.store(us, std::memory_order_relaxed);
+    }
+    bump(slot->buckets[BucketOf(us)], 1);
+}
+
+UsbTransferStats::Slot *UsbTransferStats::FindSlot(Shard &shard, uint64_t key)
+{
+    /*
+     * only the owning thread claims a slot and bumps its counters, so neither needs a read-modify-write. A detach
+     * only turns the key of a slot into SLOT_KEY_RETIRED, the probe goes on past it and reuses the first one
+     */
+    uint32_t start = (static_cast<uint32_t>(key) * SLOT_HASH_MULTIPLIER) % SHARD_SLOT_COUNT;
+    Slot *reusable = nullptr;
+    for (uint32_t i = 0; i < SHARD_SLOT_COUNT; ++i) {
+        Slot &candidate = shard.slots[(start + i) % SHARD_SLOT_COUNT];
+        uint64_t current = candidate.key.load(std::memory_order_relaxed);
+        if (current == key) {
+            return &candidate;
+        }
+        if (current == 0) {
+            reusable = reusable == nullptr ? &candidate : reusable;
+            break;
+        }
+        if (current == SLOT_KEY_RETIRED && reusable == nullptr) {
+            reusable = &candidate;
+        }
+    }
+    if (reusable != nullptr) {
+        ClaimSlot(*reusable, key);
+    }
+    return reusable;
+}
+
+void UsbTransferStats::ClaimSlot(Slot &slot, uint64_t key)
+{
+    if (slot.key.load(std::memory_order_relaxed) != SLOT_KEY_RETIRED) {
+        slot.key.store(key, std::memory_order_release);
+        return;
+    }
+    /* the counters of a retired slot still belong to the detached device, cleared before the key is published */
+    slot.count.store(0, std::memory_order_relaxed);
+    slot.errors.store(0, std::memory_order_relaxed);
+    slot.bytes.store(0, std::memory_order_relaxed);
+    slot.sumUs.store(0, std::memory_order_relaxed);
+    slot.maxUs.store(0, std::memory_order_relaxed);
+    for (auto &bucket : slot.buckets) {
+        bucket.store(0, std::memory_order_relaxed);
+    }
+    slot.key.store(key, std::memory_order_release);
+}
+
+void UsbTransferStats::ForgetDevice(uint8_t busNum, uint8_t devAddr)
+{
+    UsbTransferStats &stats = GetInstance();
+    std::lock_guard<std::mutex> guard(stats.shardsMutex_);
+    for (const auto &shard : stats.shards_) {
+        for (Slot &slot : shard->slots) {
+            uint64_t key = slot.key.load(std::memory_order_acquire);
+            if ((key & SLOT_KEY_USED) == 0 || ((key >> KEY_BUS_SHIFT) & KEY_FIELD_MASK) != busNum ||
+                ((key >> KEY_DEV_SHIFT) & KEY_FIELD_MASK) != devAddr) {
+                continue;
+            }
+            /* the owner may claim the slot for another key meanwhile, that one is kept */
+            slot.key.compare_exchange_strong(key, SLOT_KEY_RETIRED, std::memory_order_acq_rel);
+        }
+    }
+}
+
+namespace {
+struct MergedSlot {
+    uint64_t count = 0;
+    uint64_t errors = 0;
+    uint64_t bytes = 0;
+    uint64_t sumUs = 0;
+    uint64_t maxUs = 0;
+    std::array<uint64_t, UsbTransferStats::BUCKET_COUNT> buckets {};
+};
+
+void MergeSlot(MergedSlot &target, const MergedSlot &read)
+{
+    target.count += read.count;
+    target.errors += read.errors;
+    target.bytes += read.bytes;
+    target.sumUs += read.sumUs;
+    target.maxUs = std::max(target.maxUs, read.maxUs);
+    for (uint32_t i = 0; i < UsbTransferStats::BUCKET_COUNT; ++i) {
+        target.buckets[i] += read.buckets[i];
+    }
+}
+
+uint64_t Percentile(const MergedSlot &merged, uint32_t percent)
+{
+    uint64_t rank = (merged.count * percent + PERCENT_100 - 1) / PERCENT_100;
+    uint64_t seen = 0;
+    for (uint32_t i = 0; i < UsbTransferStats::BUCKET_COUNT; ++i) {
+        seen += merged.buckets[i];
+        if (seen >= rank && merged.buckets[i] != 0) {
+            /* report the upper edge of the bucket, never more than the largest sample */
+            uint64_t upper = i + 1 < UsbTransferStats::BUCKET_COUNT ?
+                UsbTransferStats::BucketLowerBound(i + 1) : merged.maxUs;
+            return std::min(upper, merged.maxUs);
+        }
+    }
+    return merged.maxUs;
+}
+} // namespace
+
+void UsbTransferStats::Dump(int32_t fd)
+{
+    UsbTransferStats &stats = GetInstance();
+    std::map<uint64_t, MergedSlot> merged;
+    uint64_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> guard(stats.shardsMutex_);
+        for (const auto &shard : stats.shards_) {
+            dropped += shard->dropped.load(std::memory_order_relaxed);
+            for (const Slot &slot : shard->slots) {
+                uint64_t key = slot.key.load(std::memory_order_acquire);
+                if ((key & SLOT_KEY_USED) == 0) {
+                    continue;
+                }
+                MergedSlot read;
+                read.count = slot.count.load(std::memory_order_relaxed);
+                read.errors = slot.errors.load(std::memory_order_relaxed);
+                read.bytes = slot.bytes.load(std::memory_order_relaxed);
+                read.sumUs = slot.sumUs.load(std::memory_order_relaxed);
+                read.maxUs = slot.maxUs.load(std::memory_order_relaxed);
+                for (uint32_t i = 0; i < BUCKET_COUNT; ++i) {
+                    read.buckets[i] = slot.buckets[i].load(std::memory_order_relaxed);
+                }
+                /* retired and claimed for another key while being read, the counters may be of either one */
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (slot.key.load(std::memory_order_relaxed) != key) {
+                    continue;
+                }
+                MergeSlot(merged[key], read);
+            }
+        }
+    }
+    dprintf(fd, "Usb host transfer latency (us), %zu entries, %" PRIu64 " samples dropped:\n", merged.size(),
+        dropped);
+    for (const auto &[key, slot] : merged) {
+        if (slot.count == 0) {
+            continue;
+        }
+        uint32_t kind = (key >> KEY_KIND_SHIFT) & KEY_NIBBLE_MASK;
+        uint32_t stage = key & KEY_NIBBLE_MASK;
+        dprintf(fd, "%u-%u ep:0x%02x %s %s count:%" PRIu64 " error:%" PRIu64 " bytes:%" PRIu64 " avg:%" PRIu64
+            " p50:%" PRIu64 " p90:%" PRIu64 " p99:%" PRIu64 " max:%" PRIu64 "\n",
+            static_cast<uint32_t>((key >> KEY_BUS_SHIFT) & KEY_FIELD_MASK),
+            static_cast<uint32_t>((key >> KEY_DEV_SHIFT) & KEY_FIELD_MASK),
+            static_cast<uint32_t>((key >> KEY_ENDPOINT_SHIFT) & KEY_FIELD_MASK),
+            kind < static_cast<uint32_t>(UsbTransferKind::KIND_COUNT) ? KIND_NAMES[kind] : "unknown",
+            stage < static_cast<uint32_t>(UsbLatencyStage::STAGE_COUNT) ? STAGE_NAMES[stage] : "unknown",
+            slot.count, slot.errors, slot.bytes, slot.sumUs / slot.count, Percentile(slot, PERCENT_50),
+            Percentile(slot, PERCENT_90), Percentile(slot, PERCENT_99), slot.maxUs);
+    }
+}
+} // namespace USB
+} // namespace OHOS
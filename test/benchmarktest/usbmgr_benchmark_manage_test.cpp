@@ -24,6 +24,7 @@
 #include "usb_common_test.h"
 #include "usb_errors.h"
 #include "usb_interface_type.h"
+#include "usb_policy_matcher.h"
 
 using namespace OHOS;
 using namespace OHOS::EventFwk;
@@ -38,6 +39,7 @@ std::vector<UsbDevice> g_devices;
 
 constexpr int32_t ITERATION_FREQUENCY = 10;
 constexpr int32_t REPETITION_FREQUENCY = 5;
+constexpr int32_t TRUST_LIST_SIZE = 1000;
 
 // benchmark test for functions of usb management (i.e., enterprise device management)
 class UsbmgrBenchmarkManageTest : public benchmark::Fixture {
@@ -193,5 +195,73 @@ BENCHMARK_F(UsbmgrBenchmarkManageTest, ManageTypes02)(benchmark::State &state)
 BENCHMARK_REGISTER_F(UsbmgrBenchmarkManageTest, ManageTypes02)->
     Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
 
+/**
+ * @tc.name: PolicyMatcher01
+ * @tc.desc: Test usbmgr functions: UsbPolicyMatcher
+ * @tc.desc: bool IsTrusted(int32_t vendorId, int32_t productId) const;
+ * @tc.desc: Positive test: full size trust list compiled, attached devices looked up
+ * @tc.type: FUNC
+ */
+BENCHMARK_F(UsbmgrBenchmarkManageTest, PolicyMatcher01)(benchmark::State &state)
+{
+    std::vector<UsbDeviceId> trustList;
+    for (int32_t i = 0; i < TRUST_LIST_SIZE; ++i) {
+        trustList.push_back({i, i});
+    }
+    auto dev = g_devices.front();
+    trustList.back().productId = dev.GetProductId();
+    trustList.back().vendorId = dev.GetVendorId();
+    UsbPolicyMatcher matcher;
+    bool trusted = false;
+    for (auto _ : state) {
+        matcher.CompileTrustList(trustList);
+        for (auto &device : g_devices) {
+            trusted = matcher.IsTrusted(device.GetVendorId(), device.GetProductId()) || trusted;
+        }
+    }
+    EXPECT_TRUE(trusted);
+}
+BENCHMARK_REGISTER_F(UsbmgrBenchmarkManageTest, PolicyMatcher01)->
+    Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
+
+/**
+ * @tc.name: PolicyMatcher02
+ * @tc.desc: Test usbmgr functions: UsbPolicyMatcher
+ * @tc.desc: void MatchInterfaceType(int32_t baseClass, int32_t subClass, int32_t protocol,
+ * @tc.desc:     std::vector<TypeDecision> &decisions) const;
+ * @tc.desc: Positive test: type policy compiled, every device and interface matched
+ * @tc.type: FUNC
+ */
+BENCHMARK_F(UsbmgrBenchmarkManageTest, PolicyMatcher02)(benchmark::State &state)
+{
+    std::vector<UsbDeviceType> disableTypes;
+    for (auto &[interfaceType, typeValues] : g_typeMap) {
+        disableTypes.emplace_back(typeValues[0], typeValues[1], typeValues[2], false);
+    }
+    for (auto &[interfaceType, typeValues] : d_typeMap) {
+        disableTypes.emplace_back(typeValues[0], typeValues[1], typeValues[2], true);
+    }
+    UsbPolicyMatcher matcher;
+    std::vector<UsbPolicyMatcher::TypeDecision> decisions;
+    for (auto _ : state) {
+        matcher.CompileTypePolicy(disableTypes);
+        decisions.clear();
+        for (auto &device : g_devices) {
+            matcher.MatchDeviceType(device.GetClass(), device.GetSubclass(), device.GetProtocol(), decisions);
+            for (auto &config : device.GetConfigs()) {
+                for (auto &interface : config.GetInterfaces()) {
+                    matcher.MatchInterfaceType(interface.GetClass(), interface.GetSubClass(),
+                        interface.GetProtocol(), decisions);
+                }
+            }
+        }
+    }
+    for (auto &decision : decisions) {
+        EXPECT_TRUE(decision.second);
+    }
+}
+BENCHMARK_REGISTER_F(UsbmgrBenchmarkManageTest, PolicyMatcher02)->
+    Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
+
 } // namespace
 BENCHMARK_MAIN();
\ No newline at end of file
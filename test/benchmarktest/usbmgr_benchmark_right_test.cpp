@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "usb_errors.h"
+#include "usb_right_db_helper.h"
+#include "usb_right_manager.h"
+
+using namespace OHOS;
+using namespace OHOS::USB;
+
+namespace {
+constexpr int32_t ITERATION_FREQUENCY = 10;
+constexpr int32_t REPETITION_FREQUENCY = 5;
+constexpr int32_t RECORD_COUNT = 1000;
+constexpr int32_t APP_STATE_COUNT = 4;
+constexpr int32_t APP_STATE_UNINSTALLED = 1;
+constexpr int32_t APP_STATE_REINSTALLED = 2;
+constexpr int32_t BENCHMARK_UID = 8888;
+constexpr uint64_t INSTALL_TIME = 1700000000;
+constexpr uint64_t REINSTALL_TIME = 1800000000;
+const std::string BENCHMARK_TOKEN_ID = "0";
+const std::string BENCHMARK_DEVICE_NAME = "1234-5678-benchmark";
+
+// benchmark test for the sweep of stale usb right records
+class UsbmgrBenchmarkRightTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State &state);
+    void TearDown(const ::benchmark::State &state);
+
+protected:
+    // a quarter of the apps are uninstalled and a quarter are installed again after the right was granted
+    void MakeSyntheticRecords(std::vector<UsbRightAppInfo> &infos,
+        std::unordered_map<std::string, uint64_t> &installTimes);
+};
+
+void UsbmgrBenchmarkRightTest::SetUp(const ::benchmark::State &state)
+{
+    // initialization
+    ;
+}
+
+void UsbmgrBenchmarkRightTest::TearDown(const ::benchmark::State &state)
+{
+    // end of the test
+    (void)UsbRightDbHelper::GetInstance()->DeleteUidRightRecord(BENCHMARK_UID);
+}
+
+void UsbmgrBenchmarkRightTest::MakeSyntheticRecords(std::vector<UsbRightAppInfo> &infos,
+    std::unordered_map<std::string, uint64_t> &installTimes)
+{
+    infos.clear();
+    installTimes.clear();
+    for (int32_t i = 0; i < RECORD_COUNT; i++) {
+        UsbRightAppInfo info = {};
+        info.uid = BENCHMARK_UID;
+        info.installTime = INSTALL_TIME;
+        info.updateTime = INSTALL_TIME;
+        info.requestTime = INSTALL_TIME;
+        info.validPeriod = USB_RIGHT_VALID_PERIOD_MAX;
+        info.bundleName = "com.example.usbright" + std::to_string(i);
+        int32_t appState = i % APP_STATE_COUNT;
+        if (appState != APP_STATE_UNINSTALLED) {
+            installTimes.emplace(info.bundleName, appState == APP_STATE_REINSTALLED ? REINSTALL_TIME : INSTALL_TIME);
+        }
+        infos.push_back(info);
+    }
+}
+
+/**
+ * @tc.name: FindStaleRightApps01
+ * @tc.desc: Test usbmgr functions: FindStaleRightApps
+ * @tc.desc: Positive test: diff 1k records against the installed apps in memory
+ * @tc.type: FUNC
+ */
+BENCHMARK_F(UsbmgrBenchmarkRightTest, FindStaleRightApps01)(benchmark::State &state)
+{
+    std::vector<UsbRightAppInfo> infos;
+    std::unordered_map<std::string, uint64_t> installTimes;
+    MakeSyntheticRecords(infos, installTimes);
+    std::vector<std::string> bundleNames;
+    for (auto _ : state) {
+        bundleNames.clear();
+        UsbRightManager::FindStaleRightApps(infos, installTimes, true, true, bundleNames);
+    }
+    EXPECT_EQ(bundleNames.size(), static_cast<size_t>(RECORD_COUNT / APP_STATE_COUNT * 2));
+}
+BENCHMARK_REGISTER_F(UsbmgrBenchmarkRightTest, FindStaleRightApps01)->
+    Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
+
+/**
+ * @tc.name: SweepRightRecord01
+ * @tc.desc: Test usbmgr functions: QueryUserRightRecord, FindStaleRightApps, DeleteSweptRightRecord
+ * @tc.desc: Positive test: sweep 1k records of a user in one query and one transaction
+ * @tc.type: FUNC
+ */
+BENCHMARK_F(UsbmgrBenchmarkRightTest, SweepRightRecord01)(benchmark::State &state)
+{
+    std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
+    std::vector<UsbRightAppInfo> infos;
+    std::unordered_map<std::string, uint64_t> installTimes;
+    MakeSyntheticRecords(infos, installTimes);
+    int32_t ret = USB_RIGHT_OK;
+    for (auto _ : state) {
+        state.PauseTiming();
+        (void)helper->DeleteUidRightRecord(BENCHMARK_UID);
+        for (auto &info : infos) {
+            ret = helper->AddOrUpdateRightRecord(BENCHMARK_UID, BENCHMARK_DEVICE_NAME, info.bundleName,
+                BENCHMARK_TOKEN_ID, info);
+            if (ret < USB_RIGHT_OK) {
+                break;
+            }
+        }
+        state.ResumeTiming();
+        if (ret < USB_RIGHT_OK) {
+            state.SkipWithError("right database is not available");
+            break;
+        }
+        std::vector<UsbRightAppInfo> records;
+        (void)helper->QueryUserRightRecord(BENCHMARK_UID, records);
+        UsbRightSweep sweep;
+        sweep.uid = BENCHMARK_UID;
+        UsbRightManager::FindStaleRightApps(records, installTimes, true, true, sweep.bundleNames);
+        ret = helper->DeleteSweptRightRecord(sweep);
+    }
+    EXPECT_EQ(ret, USB_RIGHT_OK);
+}
+BENCHMARK_REGISTER_F(UsbmgrBenchmarkRightTest, SweepRightRecord01)->
+    Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
+
+} // namespace
+BENCHMARK_MAIN();
@@ -0,0 +1,154 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <gtest/gtest.h>
+#include <iostream>
+#include <vector>
+
+#include "ashmem.h"
+#include "usb_common.h"
+#include "usb_common_test.h"
+#include "usb_errors.h"
+#include "usb_srv_client.h"
+
+using namespace OHOS;
+using namespace OHOS::USB;
+using namespace OHOS::USB::Common;
+using namespace testing::ext;
+
+namespace {
+UsbSrvClient &g_usbSrvClient = UsbSrvClient::GetInstance();
+OHOS::USB::UsbDevice g_device;
+
+constexpr int32_t ITERATION_FREQUENCY = 100;
+constexpr int32_t REPETITION_FREQUENCY = 3;
+constexpr int32_t TRANSFER_TIMEOUT = 500;
+constexpr int64_t SMALL_PAYLOAD = 16 * 1024;
+constexpr int64_t LARGE_PAYLOAD = 512 * 1024;
+constexpr uint8_t PAYLOAD_PATTERN = 0x5A;
+
+// benchmark test for bulk transfer throughput, reported as bytes_per_second
+class UsbmgrBenchmarkTransferTest : public benchmark::Fixture {
+public:
+    void SetUp(const ::benchmark::State &state);
+    void TearDown(const ::benchmark::State &state);
+};
+
+void UsbmgrBenchmarkTransferTest::SetUp(const ::benchmark::State &state)
+{
+    // initialization
+    UsbCommonTest::GrantPermissionSysNative();
+    std::vector<UsbDevice> devices;
+    (void)g_usbSrvClient.GetDevices(devices);
+    ASSERT_NE(devices.size(), 0);
+    g_device = devices.back();
+}
+
+void UsbmgrBenchmarkTransferTest::TearDown(const ::benchmark::State &state)
+{
+    // end of the test
+    ;
+}
+
+static bool OpenBulkOutEndpoint(USBDevicePipe &pipe, USBEndpoint &endpoint)
+{
+    if (g_usbSrvClient.OpenDevice(g_device, pipe) != UEC_OK) {
+        return false;
+    }
+    for (auto &config : g_device.GetConfigs()) {
+        for (auto &interface : config.GetInterfaces()) {
+            for (auto &ep : interface.GetEndpoints()) {
+                if (ep.GetType() == USB_ENDPOINT_XFER_BULK && ep.GetDirection() == USB_ENDPOINT_DIR_OUT &&
+                    g_usbSrvClient.ClaimInterface(pipe, interface, true) == UEC_OK) {
+                    endpoint = ep;
+                    return true;
+                }
+            }
+        }
+    }
+    g_usbSrvClient.Close(pipe);
+    return false;
+}
+
+/**
+ * @tc.name: BulkTransferCopy01
+ * @tc.desc: Test usbmgr functions: BulkTransfer
+ * @tc.desc: int32_t BulkTransfer(USBDevicePipe &pipe, const USBEndpoint &endpoint,
+ * @tc.desc:     std::vector<uint8_t> &bufferData, int32_t timeOut);
+ * @tc.desc: Throughput of the copying path used by bulkTransfer without a shared buffer
+ * @tc.type: FUNC
+ */
+BENCHMARK_DEFINE_F(UsbmgrBenchmarkTransferTest, BulkTransferCopy01)(benchmark::State &state)
+{
+    USBDevicePipe pipe;
+    USBEndpoint endpoint;
+    if (!OpenBulkOutEndpoint(pipe, endpoint)) {
+        state.SkipWithError("no bulk out endpoint");
+        return;
+    }
+    /* the source array stands in for the JS Uint8Array, each copy of the old path is kept */
+    std::vector<uint8_t> source(state.range(0), PAYLOAD_PATTERN);
+    int32_t ret = UEC_OK;
+    for (auto _ : state) {
+        std::vector<uint8_t> nativeBuffer(source);
+        std::vector<uint8_t> bufferData(nativeBuffer.begin(), nativeBuffer.end());
+        ret = g_usbSrvClient.BulkTransfer(pipe, endpoint, bufferData, TRANSFER_TIMEOUT);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    EXPECT_EQ(UEC_OK, ret);
+    EXPECT_EQ(g_usbSrvClient.Close(pipe), true);
+}
+BENCHMARK_REGISTER_F(UsbmgrBenchmarkTransferTest, BulkTransferCopy01)->Arg(SMALL_PAYLOAD)->Arg(LARGE_PAYLOAD)->
+    Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
+
+/**
+ * @tc.name: BulkTransferShared01
+ * @tc.desc: Test usbmgr functions: RegBulkTransferBuffer, BulkTransfer
+ * @tc.desc: int32_t BulkTransfer(USBDevicePipe &pipe, const USBEndpoint &endpoint, int32_t offset,
+ * @tc.desc:     int32_t length, int32_t &actualLength, int32_t timeOut);
+ * @tc.desc: Throughput of the shared buffer path used by bulkTransfer, one copy per transfer
+ * @tc.type: FUNC
+ */
+BENCHMARK_DEFINE_F(UsbmgrBenchmarkTransferTest, BulkTransferShared01)(benchmark::State &state)
+{
+    USBDevicePipe pipe;
+    USBEndpoint endpoint;
+    if (!OpenBulkOutEndpoint(pipe, endpoint)) {
+        state.SkipWithError("no bulk out endpoint");
+        return;
+    }
+    int32_t length = static_cast<int32_t>(state.range(0));
+    sptr<Ashmem> ashmem = Ashmem::CreateAshmem("UsbBenchmarkBulkBuffer", length);
+    ASSERT_NE(ashmem, nullptr);
+    ASSERT_TRUE(ashmem->MapReadAndWriteAshmem());
+    ASSERT_EQ(UEC_OK, g_usbSrvClient.RegBulkTransferBuffer(pipe, endpoint, ashmem));
+    std::vector<uint8_t> source(length, PAYLOAD_PATTERN);
+    int32_t ret = UEC_OK;
+    int32_t actualLength = 0;
+    for (auto _ : state) {
+        ashmem->WriteToAshmem(source.data(), length, 0);
+        ret = g_usbSrvClient.BulkTransfer(pipe, endpoint, 0, length, actualLength, TRANSFER_TIMEOUT);
+    }
+    state.SetBytesProcessed(state.iterations() * state.range(0));
+    EXPECT_EQ(UEC_OK, ret);
+    EXPECT_EQ(UEC_OK, g_usbSrvClient.UnRegBulkTransferBuffer(pipe, endpoint));
+    EXPECT_EQ(g_usbSrvClient.Close(pipe), true);
+}
+BENCHMARK_REGISTER_F(UsbmgrBenchmarkTransferTest, BulkTransferShared01)->Arg(SMALL_PAYLOAD)->Arg(LARGE_PAYLOAD)->
+    Iterations(ITERATION_FREQUENCY)->Repetitions(REPETITION_FREQUENCY)->ReportAggregatesOnly();
+
+} // namespace
+BENCHMARK_MAIN();
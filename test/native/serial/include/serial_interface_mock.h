@@ -0,0 +1,188 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_INTERFACE_MOCK_H
+#define SERIAL_INTERFACE_MOCK_H
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "ipc_object_stub.h"
+#include "v1_0/iserial_interface.h"
+
+namespace OHOS {
+namespace SERIAL {
+/*
+ * Scripted serial HDI. Reads are served from queued replies, an empty queue times out like an idle port.
+ * Writes accept up to the scripted length of the next reply, all of the frame once the script runs out.
+ */
+class MockSerialInterface : public OHOS::HDI::Usb::Serial::V1_0::ISerialInterface {
+public:
+    static constexpr int32_t ERR_CODE_TIMEOUT = -7;
+
+    struct ReadReply {
+        int32_t ret = 0;
+        std::vector<uint8_t> data;
+    };
+
+    int32_t SerialOpen(int32_t portId) override
+    {
+        return 0;
+    }
+
+    int32_t SerialClose(int32_t portId) override
+    {
+        return 0;
+    }
+
+    int32_t SerialRead(int32_t portId, std::vector<uint8_t> &data, uint32_t size, uint32_t timeout) override
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (!cond_.wait_for(lock, std::chrono::milliseconds(timeout), [this]() { return !reads_.empty(); })) {
+            return ERR_CODE_TIMEOUT;
+        }
+        ReadReply reply = std::move(reads_.front());
+        reads_.pop_front();
+        if (reply.ret < 0) {
+            return reply.ret;
+        }
+        if (reply.data.size() > size) {
+            reply.data.resize(size);
+        }
+        data = std::move(reply.data);
+        return static_cast<int32_t>(data.size());
+    }
+
+    int32_t SerialWrite(int32_t portId, const std::vector<uint8_t> &data, uint32_t size, uint32_t timeout) override
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        int32_t ret = static_cast<int32_t>(std::min(data.size(), static_cast<size_t>(size)));
+        if (!writes_.empty()) {
+            ret = std::min(ret, writes_.front());
+            writes_.pop_front();
+        }
+        if (ret > 0) {
+            written_.insert(written_.end(), data.begin(), data.begin() + ret);
+        }
+        ++writeCount_;
+        return ret;
+    }
+
+    int32_t SerialGetAttribute(int32_t portId, OHOS::HDI::Usb::Serial::V1_0::SerialAttribute &attribute) override
+    {
+        return 0;
+    }
+
+    int32_t SerialSetAttribute(int32_t portId,
+        const OHOS::HDI::Usb::Serial::V1_0::SerialAttribute &attribute) override
+    {
+        return 0;
+    }
+
+    int32_t SerialGetPortList(std::vector<OHOS::HDI::Usb::Serial::V1_0::SerialPort> &portList) override
+    {
+        return 0;
+    }
+
+    void PushRead(int32_t ret, const std::vector<uint8_t> &data = {})
+    {
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            reads_.push_back({ret, data});
+        }
+        cond_.notify_all();
+    }
+
+    void PushWrite(int32_t ret)
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        writes_.push_back(ret);
+    }
+
+    std::vector<uint8_t> GetWritten()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return written_;
+    }
+
+    uint32_t GetWriteCount()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return writeCount_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    std::deque<ReadReply> reads_;
+    std::deque<int32_t> writes_;
+    std::vector<uint8_t> written_;
+    uint32_t writeCount_ = 0;
+};
+
+/* stands in for the client's serialRemote, it only counts the notifications it receives */
+class MockSerialNotifier : public IPCObjectStub {
+public:
+    MockSerialNotifier() : IPCObjectStub(u"ohos.usb.test.MockSerialNotifier") {}
+
+    int OnRemoteRequest(uint32_t code, MessageParcel &data, MessageParcel &reply, MessageOption &option) override
+    {
+        (void)data.ReadInt32();
+        uint32_t available = data.ReadUint32();
+        {
+            std::lock_guard<std::mutex> guard(mutex_);
+            ++count_;
+            lastAvailable_ = available;
+        }
+        cond_.notify_all();
+        return 0;
+    }
+
+    /* waits until at least count notifications arrived */
+    bool WaitFor(uint32_t count, uint32_t timeoutMs)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(timeoutMs), [this, count]() {
+            return count_ >= count;
+        });
+    }
+
+    uint32_t GetCount()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return count_;
+    }
+
+    uint32_t GetLastAvailable()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        return lastAvailable_;
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    uint32_t count_ = 0;
+    uint32_t lastAvailable_ = 0;
+};
+} // SERIAL
+} // OHOS
+#endif
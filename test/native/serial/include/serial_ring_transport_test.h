@@ -0,0 +1,41 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef SERIAL_RING_TRANSPORT_TEST_H
+#define SERIAL_RING_TRANSPORT_TEST_H
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "serial_interface_mock.h"
+#include "serial_ring_channel.h"
+#include "serial_ring_transport.h"
+
+namespace OHOS {
+namespace SERIAL {
+class SerialRingTransportTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    sptr<MockSerialInterface> serial_;
+    std::unique_ptr<SerialRingTransport> transport_;
+    std::shared_ptr<USB::SerialRingChannel> channel_;
+};
+} // SERIAL
+} // OHOS
+#endif
@@ -0,0 +1,147 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_port_stream_test.h"
+
+#include <vector>
+
+#include "hilog_wrapper.h"
+#include "serial_port_stream.h"
+#include "usb_errors.h"
+
+using namespace testing::ext;
+using OHOS::USB::MODULE_USB_SERVICE;
+using OHOS::USB::USB_MGR_LABEL;
+using OHOS::USB::UEC_OK;
+
+namespace OHOS {
+namespace SERIAL {
+constexpr int32_t TEST_PORT_ID = 0;
+constexpr int32_t ERR_CODE_DEVICENOTOPEN = -6;
+constexpr uint32_t TEST_WAIT_MS = 1000;
+constexpr uint32_t TEST_CHUNK_SIZE = 8;
+constexpr uint32_t TEST_PART_SIZE = 3;
+
+void SerialPortStreamTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start SerialPortStreamTest");
+}
+
+void SerialPortStreamTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End SerialPortStreamTest");
+}
+
+void SerialPortStreamTest::SetUp()
+{
+    serial_ = new MockSerialInterface();
+    notifier_ = new MockSerialNotifier();
+}
+
+void SerialPortStreamTest::TearDown()
+{
+    serial_ = nullptr;
+    notifier_ = nullptr;
+}
+
+/**
+ * @tc.name: SerialPortStream001
+ * @tc.desc: a drained ring is announced again by the next byte that arrives
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialPortStreamTest, SerialPortStream001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialPortStream001");
+    SerialPortStream stream(serial_, TEST_PORT_ID, notifier_);
+    stream.Start();
+    serial_->PushRead(UEC_OK, std::vector<uint8_t>(TEST_CHUNK_SIZE, 'a'));
+    ASSERT_TRUE(notifier_->WaitFor(1, TEST_WAIT_MS));
+
+    std::vector<uint8_t> data;
+    uint32_t actualSize = 0;
+    EXPECT_EQ(stream.Read(data, TEST_CHUNK_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    EXPECT_EQ(actualSize, TEST_CHUNK_SIZE);
+    EXPECT_EQ(notifier_->GetCount(), 1U);
+
+    serial_->PushRead(UEC_OK, std::vector<uint8_t>(TEST_CHUNK_SIZE, 'b'));
+    EXPECT_TRUE(notifier_->WaitFor(2, TEST_WAIT_MS));
+    stream.Stop();
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialPortStream001");
+}
+
+/**
+ * @tc.name: SerialPortStream002
+ * @tc.desc: bytes left behind by a short read are announced at once
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialPortStreamTest, SerialPortStream002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialPortStream002");
+    SerialPortStream stream(serial_, TEST_PORT_ID, notifier_);
+    stream.Start();
+    serial_->PushRead(UEC_OK, std::vector<uint8_t>(TEST_CHUNK_SIZE, 'a'));
+    ASSERT_TRUE(notifier_->WaitFor(1, TEST_WAIT_MS));
+
+    std::vector<uint8_t> data;
+    uint32_t actualSize = 0;
+    EXPECT_EQ(stream.Read(data, TEST_PART_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    EXPECT_EQ(actualSize, TEST_PART_SIZE);
+    ASSERT_TRUE(notifier_->WaitFor(2, TEST_WAIT_MS));
+    EXPECT_EQ(notifier_->GetLastAvailable(), TEST_CHUNK_SIZE - TEST_PART_SIZE);
+
+    EXPECT_EQ(stream.Read(data, TEST_CHUNK_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    EXPECT_EQ(actualSize, TEST_CHUNK_SIZE - TEST_PART_SIZE);
+    EXPECT_EQ(notifier_->GetCount(), 2U);
+    stream.Stop();
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialPortStream002");
+}
+
+/**
+ * @tc.name: SerialPortStream003
+ * @tc.desc: a port closed under the stream wakes the client, its Read then fails
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialPortStreamTest, SerialPortStream003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialPortStream003");
+    SerialPortStream stream(serial_, TEST_PORT_ID, notifier_);
+    stream.Start();
+    serial_->PushRead(ERR_CODE_DEVICENOTOPEN);
+    ASSERT_TRUE(notifier_->WaitFor(1, TEST_WAIT_MS));
+
+    std::vector<uint8_t> data;
+    uint32_t actualSize = 0;
+    EXPECT_EQ(stream.Read(data, TEST_CHUNK_SIZE, actualSize, TEST_WAIT_MS), OHOS::USB::UEC_SERIAL_IO_EXCEPTION);
+    EXPECT_EQ(actualSize, 0U);
+    stream.Stop();
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialPortStream003");
+}
+
+/**
+ * @tc.name: SerialPortStream004
+ * @tc.desc: stopping the stream from the service side sends no notification
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialPortStreamTest, SerialPortStream004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialPortStream004");
+    SerialPortStream stream(serial_, TEST_PORT_ID, notifier_);
+    stream.Start();
+    stream.Stop();
+    EXPECT_EQ(notifier_->GetCount(), 0U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialPortStream004");
+}
+} // SERIAL
+} // OHOS
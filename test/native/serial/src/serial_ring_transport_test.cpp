@@ -0,0 +1,203 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_ring_transport_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <sys/mman.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+#include "hilog_wrapper.h"
+#include "usb_errors.h"
+
+using namespace testing::ext;
+using OHOS::USB::MODULE_USB_SERVICE;
+using OHOS::USB::USB_MGR_LABEL;
+using OHOS::USB::UEC_OK;
+using OHOS::USB::UEC_SERIAL_IO_EXCEPTION;
+
+namespace OHOS {
+namespace SERIAL {
+constexpr int32_t TEST_PORT_ID = 0;
+constexpr int32_t ERR_CODE_IOEXCEPTION = -1;
+constexpr int32_t ERR_CODE_DEVICENOTOPEN = -6;
+constexpr uint32_t TEST_WAIT_MS = 1000;
+constexpr uint32_t TEST_POLL_MS = 5;
+constexpr uint32_t TEST_FRAME_SIZE = 4;
+
+static bool WaitForWrites(const sptr<MockSerialInterface> &serial, uint32_t count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (serial->GetWriteCount() < count) {
+        if (std::chrono::steady_clock::now() > deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    }
+    /* the pump acts on the reply right after the write returns */
+    std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    return true;
+}
+
+void SerialRingTransportTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start SerialRingTransportTest");
+}
+
+void SerialRingTransportTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End SerialRingTransportTest");
+}
+
+void SerialRingTransportTest::SetUp()
+{
+    serial_ = new MockSerialInterface();
+    transport_ = std::make_unique<SerialRingTransport>(serial_, TEST_PORT_ID);
+    ASSERT_EQ(transport_->Init(), UEC_OK);
+    transport_->Start();
+    /* the channel closes what it is given, binder would hand it duplicates as well */
+    SerialRingFds fds = transport_->GetFds();
+    channel_ = USB::SerialRingChannel::Create(dup(fds.ringFd), dup(fds.rxDataFd), dup(fds.rxSpaceFd),
+        dup(fds.txDataFd), dup(fds.txSpaceFd));
+    ASSERT_NE(channel_, nullptr);
+}
+
+void SerialRingTransportTest::TearDown()
+{
+    transport_ = nullptr;
+    channel_ = nullptr;
+    serial_ = nullptr;
+}
+
+/**
+ * @tc.name: SerialRingTransport001
+ * @tc.desc: bytes written to the ring reach the device and device input reaches the reader
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialRingTransportTest, SerialRingTransport001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialRingTransport001");
+    std::vector<uint8_t> frame = {'a', 'b', 'c', 'd'};
+    uint32_t actualSize = 0;
+    EXPECT_EQ(channel_->Write(frame.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    EXPECT_EQ(actualSize, TEST_FRAME_SIZE);
+    ASSERT_TRUE(WaitForWrites(serial_, 1));
+    EXPECT_EQ(serial_->GetWritten(), frame);
+
+    serial_->PushRead(UEC_OK, frame);
+    std::vector<uint8_t> data(TEST_FRAME_SIZE);
+    EXPECT_EQ(channel_->Read(data.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    EXPECT_EQ(actualSize, TEST_FRAME_SIZE);
+    EXPECT_EQ(data, frame);
+    EXPECT_EQ(channel_->Close(), UEC_OK);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialRingTransport001");
+}
+
+/**
+ * @tc.name: SerialRingTransport002
+ * @tc.desc: a write the pump could not deliver fails the next write, the one after succeeds again
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialRingTransportTest, SerialRingTransport002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialRingTransport002");
+    serial_->PushWrite(ERR_CODE_IOEXCEPTION);
+    std::vector<uint8_t> frame(TEST_FRAME_SIZE, 'x');
+    uint32_t actualSize = 0;
+    EXPECT_EQ(channel_->Write(frame.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    ASSERT_TRUE(WaitForWrites(serial_, 1));
+
+    EXPECT_EQ(channel_->Write(frame.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_SERIAL_IO_EXCEPTION);
+    EXPECT_EQ(actualSize, 0U);
+    EXPECT_EQ(channel_->Write(frame.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    ASSERT_TRUE(WaitForWrites(serial_, 2));
+    EXPECT_EQ(serial_->GetWritten(), frame);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialRingTransport002");
+}
+
+/**
+ * @tc.name: SerialRingTransport003
+ * @tc.desc: an undelivered write with no later write fails the close
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialRingTransportTest, SerialRingTransport003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialRingTransport003");
+    serial_->PushWrite(ERR_CODE_IOEXCEPTION);
+    std::vector<uint8_t> frame(TEST_FRAME_SIZE, 'x');
+    uint32_t actualSize = 0;
+    EXPECT_EQ(channel_->Write(frame.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    ASSERT_TRUE(WaitForWrites(serial_, 1));
+    transport_->Stop();
+    EXPECT_EQ(channel_->Close(), UEC_SERIAL_IO_EXCEPTION);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialRingTransport003");
+}
+
+/**
+ * @tc.name: SerialRingTransport004
+ * @tc.desc: a port closed under the ring fails the blocked reader and the pending write
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialRingTransportTest, SerialRingTransport004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialRingTransport004");
+    serial_->PushRead(ERR_CODE_DEVICENOTOPEN);
+    std::vector<uint8_t> data(TEST_FRAME_SIZE);
+    uint32_t actualSize = 0;
+    EXPECT_EQ(channel_->Read(data.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_SERIAL_IO_EXCEPTION);
+
+    serial_->PushWrite(ERR_CODE_DEVICENOTOPEN);
+    EXPECT_EQ(channel_->Write(data.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_OK);
+    ASSERT_TRUE(WaitForWrites(serial_, 1));
+    EXPECT_EQ(channel_->Write(data.data(), TEST_FRAME_SIZE, actualSize, TEST_WAIT_MS), UEC_SERIAL_IO_EXCEPTION);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialRingTransport004");
+}
+
+/**
+ * @tc.name: SerialRingTransport005
+ * @tc.desc: stop returns while the client keeps clearing the closed flag of both rings
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialRingTransportTest, SerialRingTransport005, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialRingTransport005");
+    void *base = mmap(nullptr, USB::SERIAL_SHM_REGION_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED,
+        transport_->GetFds().ringFd, 0);
+    ASSERT_NE(base, MAP_FAILED);
+    auto rx = reinterpret_cast<USB::SerialShmRingHeader *>(static_cast<uint8_t *>(base) + USB::SERIAL_SHM_RX_OFFSET);
+    auto tx = reinterpret_cast<USB::SerialShmRingHeader *>(static_cast<uint8_t *>(base) + USB::SERIAL_SHM_TX_OFFSET);
+    /* let the tx pump settle in its wait for client data */
+    std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    std::atomic<bool> stopped {false};
+    std::thread client([&stopped, rx, tx]() {
+        while (!stopped.load()) {
+            rx->closed.store(0);
+            tx->closed.store(0);
+        }
+    });
+    auto stop = std::async(std::launch::async, [this]() { transport_->Stop(); });
+    EXPECT_EQ(stop.wait_for(std::chrono::milliseconds(TEST_WAIT_MS)), std::future_status::ready);
+    stopped.store(true);
+    client.join();
+    stop.wait();
+    munmap(base, USB::SERIAL_SHM_REGION_SIZE);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialRingTransport005");
+}
+} // SERIAL
+} // OHOS
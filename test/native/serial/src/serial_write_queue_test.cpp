@@ -0,0 +1,149 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "serial_write_queue_test.h"
+
+#include <chrono>
+#include <thread>
+#include <vector>
+
+#include "hilog_wrapper.h"
+#include "serial_write_queue.h"
+
+using namespace testing::ext;
+using OHOS::USB::MODULE_USB_SERVICE;
+using OHOS::USB::USB_MGR_LABEL;
+
+namespace OHOS {
+namespace SERIAL {
+constexpr int32_t TEST_PORT_ID = 0;
+constexpr int32_t ERR_CODE_IOEXCEPTION = -1;
+constexpr uint32_t TEST_TIMEOUT_MS = 1000;
+constexpr uint32_t TEST_FRAME_SIZE = 4;
+constexpr uint32_t TEST_FRAME_NUM = 3;
+/* a batch leaves as soon as all test frames are queued, the long window only keeps it open until then */
+constexpr uint32_t TEST_WINDOW_US = 2000000;
+constexpr uint32_t TEST_MAX_BYTES = TEST_FRAME_SIZE * TEST_FRAME_NUM;
+constexpr uint32_t TEST_ARRIVAL_GAP_MS = 20;
+
+/* queues the frames 'a', 'b', 'c' in this order from writers of their own and collects their results */
+static std::vector<int32_t> WriteFrames(SerialWriteQueue &queue)
+{
+    std::vector<int32_t> results(TEST_FRAME_NUM, 0);
+    std::vector<std::vector<uint8_t>> frames;
+    for (uint32_t i = 0; i < TEST_FRAME_NUM; ++i) {
+        frames.emplace_back(TEST_FRAME_SIZE, static_cast<uint8_t>('a' + i));
+    }
+    std::vector<std::thread> writers;
+    for (uint32_t i = 0; i < TEST_FRAME_NUM; ++i) {
+        writers.emplace_back([&queue, &frames, &results, i]() {
+            results[i] = queue.Write(frames[i], TEST_FRAME_SIZE, TEST_TIMEOUT_MS);
+        });
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_ARRIVAL_GAP_MS));
+    }
+    for (auto &writer : writers) {
+        writer.join();
+    }
+    return results;
+}
+
+void SerialWriteQueueTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start SerialWriteQueueTest");
+}
+
+void SerialWriteQueueTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End SerialWriteQueueTest");
+}
+
+void SerialWriteQueueTest::SetUp()
+{
+    serial_ = new MockSerialInterface();
+}
+
+void SerialWriteQueueTest::TearDown()
+{
+    serial_ = nullptr;
+}
+
+/**
+ * @tc.name: SerialWriteQueue001
+ * @tc.desc: queued frames leave as one write and every writer gets its own count
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialWriteQueueTest, SerialWriteQueue001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialWriteQueue001");
+    SerialWriteQueue queue(serial_, TEST_PORT_ID, TEST_WINDOW_US, TEST_MAX_BYTES);
+    std::vector<int32_t> results = WriteFrames(queue);
+    EXPECT_EQ(results, std::vector<int32_t>(TEST_FRAME_NUM, TEST_FRAME_SIZE));
+    EXPECT_EQ(serial_->GetWriteCount(), 1U);
+    EXPECT_EQ(serial_->GetWritten(), std::vector<uint8_t>({'a', 'a', 'a', 'a', 'b', 'b', 'b', 'b',
+        'c', 'c', 'c', 'c'}));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialWriteQueue001");
+}
+
+/**
+ * @tc.name: SerialWriteQueue002
+ * @tc.desc: a short write cuts the batch, the frames behind the cut fail and are not sent
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialWriteQueueTest, SerialWriteQueue002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialWriteQueue002");
+    constexpr int32_t shortWrite = TEST_FRAME_SIZE + TEST_FRAME_SIZE / 2;
+    serial_->PushWrite(shortWrite);
+    SerialWriteQueue queue(serial_, TEST_PORT_ID, TEST_WINDOW_US, TEST_MAX_BYTES);
+    std::vector<int32_t> results = WriteFrames(queue);
+    EXPECT_EQ(results, std::vector<int32_t>({TEST_FRAME_SIZE, TEST_FRAME_SIZE / 2, ERR_CODE_IOEXCEPTION}));
+    EXPECT_EQ(serial_->GetWriteCount(), 1U);
+    EXPECT_EQ(serial_->GetWritten(), std::vector<uint8_t>({'a', 'a', 'a', 'a', 'b', 'b'}));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialWriteQueue002");
+}
+
+/**
+ * @tc.name: SerialWriteQueue003
+ * @tc.desc: a short write that ends on a frame boundary gives the next frame nothing and fails the rest
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialWriteQueueTest, SerialWriteQueue003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialWriteQueue003");
+    serial_->PushWrite(TEST_FRAME_SIZE);
+    SerialWriteQueue queue(serial_, TEST_PORT_ID, TEST_WINDOW_US, TEST_MAX_BYTES);
+    std::vector<int32_t> results = WriteFrames(queue);
+    EXPECT_EQ(results, std::vector<int32_t>({TEST_FRAME_SIZE, 0, ERR_CODE_IOEXCEPTION}));
+    EXPECT_EQ(serial_->GetWriteCount(), 1U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialWriteQueue003");
+}
+
+/**
+ * @tc.name: SerialWriteQueue004
+ * @tc.desc: a failed write fails every frame of the batch with the HDI error
+ * @tc.type: FUNC
+ */
+HWTEST_F(SerialWriteQueueTest, SerialWriteQueue004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : SerialWriteQueue004");
+    serial_->PushWrite(ERR_CODE_IOEXCEPTION);
+    SerialWriteQueue queue(serial_, TEST_PORT_ID, TEST_WINDOW_US, TEST_MAX_BYTES);
+    std::vector<int32_t> results = WriteFrames(queue);
+    EXPECT_EQ(results, std::vector<int32_t>(TEST_FRAME_NUM, ERR_CODE_IOEXCEPTION));
+    EXPECT_EQ(serial_->GetWriteCount(), 1U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : SerialWriteQueue004");
+}
+} // SERIAL
+} // OHOS
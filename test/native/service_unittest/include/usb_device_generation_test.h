@@ -0,0 +1,43 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_DEVICE_GENERATION_TEST_H
+#define USB_DEVICE_GENERATION_TEST_H
+
+#include <gtest/gtest.h>
+#include <memory>
+
+#include "usb_host_manager.h"
+
+namespace OHOS {
+namespace USB {
+namespace GenerationTest {
+class UsbDeviceGenerationTest : public testing::Test {
+public:
+    static void SetUpTestCase();
+    static void TearDownTestCase();
+    void SetUp();
+    void TearDown();
+
+    void AddTestDevice(uint8_t busNum, uint8_t devAddr);
+    void ChangeTestDevice(uint8_t busNum, uint8_t devAddr, AuthorizeStatus status);
+    void RemoveTestDevice(uint8_t busNum, uint8_t devAddr);
+
+    std::unique_ptr<UsbHostManager> hostManager_;
+};
+} // GenerationTest
+} // USB
+} // OHOS
+#endif
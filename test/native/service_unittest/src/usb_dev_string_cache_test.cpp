@@ -0,0 +1,158 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_dev_string_cache_test.h"
+
+#include <string>
+#include <unordered_map>
+
+#include "hilog_wrapper.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace StringCacheTest {
+/* no device sits at this address, every string read fails */
+constexpr uint8_t TEST_ABSENT_BUS_NUM = 255;
+constexpr uint8_t TEST_ABSENT_DEV_ADDR = 255;
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr uint8_t TEST_OTHER_DEV_ADDR = 3;
+constexpr int32_t TEST_VENDOR_ID = 0x1234;
+constexpr int32_t TEST_PRODUCT_ID = 0x5678;
+constexpr uint16_t TEST_BCD_DEVICE = 0x0100;
+constexpr uint8_t TEST_STRING_INDEX = 1;
+const std::string TEST_SERIAL = "0123456789";
+
+static UsbDevice MakeTestDevice(uint8_t busNum, uint8_t devAddr)
+{
+    UsbDevice dev;
+    dev.SetBusNum(busNum);
+    dev.SetDevAddr(devAddr);
+    dev.SetVendorId(TEST_VENDOR_ID);
+    dev.SetProductId(TEST_PRODUCT_ID);
+    dev.SetbcdDevice(TEST_BCD_DEVICE);
+    return dev;
+}
+
+void UsbDevStringCacheTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbDevStringCacheTest");
+}
+
+void UsbDevStringCacheTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbDevStringCacheTest");
+}
+
+void UsbDevStringCacheTest::SetUp()
+{
+    hostManager_ = std::make_unique<UsbHostManager>(nullptr);
+}
+
+void UsbDevStringCacheTest::TearDown()
+{
+    hostManager_ = nullptr;
+}
+
+/**
+ * @tc.name: DevStringCache001
+ * @tc.desc: devices without a serial get a key per port, devices with one share it across ports
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDevStringCacheTest, DevStringCache001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DevStringCache001");
+    UsbDevice dev = MakeTestDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    UsbDevice other = MakeTestDevice(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR);
+    EXPECT_NE(UsbHostManager::GetDevStringCacheKey(dev, ""), UsbHostManager::GetDevStringCacheKey(other, ""));
+    EXPECT_NE(UsbHostManager::GetDevStringCacheKey(dev, " "), UsbHostManager::GetDevStringCacheKey(other, " "));
+    EXPECT_EQ(UsbHostManager::GetDevStringCacheKey(dev, TEST_SERIAL),
+        UsbHostManager::GetDevStringCacheKey(other, TEST_SERIAL));
+    other.SetbcdDevice(TEST_BCD_DEVICE + 1);
+    EXPECT_NE(UsbHostManager::GetDevStringCacheKey(dev, TEST_SERIAL),
+        UsbHostManager::GetDevStringCacheKey(other, TEST_SERIAL));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DevStringCache001");
+}
+
+/**
+ * @tc.name: DevStringCache002
+ * @tc.desc: a failed string read returns the placeholder without keeping it
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDevStringCacheTest, DevStringCache002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DevStringCache002");
+    std::unordered_map<uint8_t, std::string> strings;
+    bool complete = true;
+    std::string str = hostManager_->GetDevStringValFromIdx(TEST_ABSENT_BUS_NUM, TEST_ABSENT_DEV_ADDR,
+        TEST_STRING_INDEX, strings, complete);
+    EXPECT_EQ(str, " ");
+    EXPECT_FALSE(complete);
+    EXPECT_TRUE(strings.empty());
+
+    complete = true;
+    str = hostManager_->GetDevStringValFromIdx(TEST_ABSENT_BUS_NUM, TEST_ABSENT_DEV_ADDR, 0, strings, complete);
+    EXPECT_EQ(str, " ");
+    EXPECT_TRUE(complete);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DevStringCache002");
+}
+
+/**
+ * @tc.name: DevStringCache003
+ * @tc.desc: a device whose string reads failed leaves nothing in the cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDevStringCacheTest, DevStringCache003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DevStringCache003");
+    UsbDevice dev = MakeTestDevice(TEST_ABSENT_BUS_NUM, TEST_ABSENT_DEV_ADDR);
+    dev.SetiManufacturer(TEST_STRING_INDEX);
+    dev.SetiProduct(TEST_STRING_INDEX + 1);
+    EXPECT_EQ(hostManager_->FillDevStrings(dev), UEC_OK);
+    EXPECT_EQ(dev.GetManufacturerName(), " ");
+
+    std::unordered_map<uint8_t, std::string> strings;
+    EXPECT_FALSE(hostManager_->QueryDevStringCache(UsbHostManager::GetDevStringCacheKey(dev, dev.GetmSerial()),
+        strings));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DevStringCache003");
+}
+
+/**
+ * @tc.name: DevStringCache004
+ * @tc.desc: strings that were all read are served from the cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDevStringCacheTest, DevStringCache004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DevStringCache004");
+    UsbDevice dev = MakeTestDevice(TEST_ABSENT_BUS_NUM, TEST_ABSENT_DEV_ADDR);
+    std::string key = UsbHostManager::GetDevStringCacheKey(dev, TEST_SERIAL);
+    hostManager_->UpdateDevStringCache(key, {{TEST_STRING_INDEX, "vendor"}});
+
+    std::unordered_map<uint8_t, std::string> strings;
+    ASSERT_TRUE(hostManager_->QueryDevStringCache(key, strings));
+    bool complete = true;
+    EXPECT_EQ(hostManager_->GetDevStringValFromIdx(TEST_ABSENT_BUS_NUM, TEST_ABSENT_DEV_ADDR, TEST_STRING_INDEX,
+        strings, complete), "vendor");
+    EXPECT_TRUE(complete);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DevStringCache004");
+}
+} // StringCacheTest
+} // USB
+} // OHOS
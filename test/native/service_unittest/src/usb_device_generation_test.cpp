@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_generation_test.h"
+
+#include <chrono>
+#include <string>
+#include <vector>
+
+#include "hilog_wrapper.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace GenerationTest {
+constexpr uint32_t TEST_EPOCH_SHIFT = 32;
+constexpr uint64_t TEST_EPOCH_STEP = 1ULL << TEST_EPOCH_SHIFT;
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr uint8_t TEST_OTHER_DEV_ADDR = 3;
+constexpr int32_t TEST_VENDOR_ID = 0x1234;
+constexpr int32_t TEST_PRODUCT_ID = 0x5678;
+
+static uint64_t GetNowSeconds()
+{
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::seconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count()) & UINT32_MAX;
+}
+
+static std::string GetTestDeviceName(uint8_t busNum, uint8_t devAddr)
+{
+    return std::to_string(busNum) + "-" + std::to_string(devAddr);
+}
+
+void UsbDeviceGenerationTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbDeviceGenerationTest");
+}
+
+void UsbDeviceGenerationTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbDeviceGenerationTest");
+}
+
+void UsbDeviceGenerationTest::SetUp()
+{
+    hostManager_ = std::make_unique<UsbHostManager>(nullptr);
+}
+
+void UsbDeviceGenerationTest::TearDown()
+{
+    hostManager_ = nullptr;
+}
+
+/* inserts the device the way AddDevice does, without the attach strategy and the broadcast */
+void UsbDeviceGenerationTest::AddTestDevice(uint8_t busNum, uint8_t devAddr)
+{
+    UsbDevice *dev = new UsbDevice();
+    dev->SetBusNum(busNum);
+    dev->SetDevAddr(devAddr);
+    dev->SetVendorId(TEST_VENDOR_ID);
+    dev->SetProductId(TEST_PRODUCT_ID);
+    dev->SetName(GetTestDeviceName(busNum, devAddr));
+    dev->SetAuthorizeStatus(ENABLED);
+    uint16_t busDev = UsbHostManager::GetBusDevKey(busNum, devAddr);
+    std::unique_lock lock(hostManager_->devicesMutex_);
+    hostManager_->devices_.emplace(busDev, dev);
+    hostManager_->MarkDevicesChanged(busDev, UsbHostManager::DeviceChangeType::ADDED);
+}
+
+void UsbDeviceGenerationTest::ChangeTestDevice(uint8_t busNum, uint8_t devAddr, AuthorizeStatus status)
+{
+    uint16_t busDev = UsbHostManager::GetBusDevKey(busNum, devAddr);
+    std::unique_lock lock(hostManager_->devicesMutex_);
+    auto it = hostManager_->devices_.find(busDev);
+    ASSERT_NE(it, hostManager_->devices_.end());
+    it->second->SetAuthorizeStatus(status);
+    hostManager_->MarkDevicesChanged(busDev, UsbHostManager::DeviceChangeType::CHANGED);
+}
+
+void UsbDeviceGenerationTest::RemoveTestDevice(uint8_t busNum, uint8_t devAddr)
+{
+    uint16_t busDev = UsbHostManager::GetBusDevKey(busNum, devAddr);
+    std::unique_lock lock(hostManager_->devicesMutex_);
+    auto it = hostManager_->devices_.find(busDev);
+    ASSERT_NE(it, hostManager_->devices_.end());
+    delete it->second;
+    hostManager_->devices_.erase(it);
+    hostManager_->MarkDevicesChanged(busDev, UsbHostManager::DeviceChangeType::REMOVED);
+}
+
+/**
+ * @tc.name: DeviceGeneration001
+ * @tc.desc: the generation carries the service start time in its high half
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceGenerationTest, DeviceGeneration001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceGeneration001");
+    uint64_t before = GetNowSeconds();
+    UsbHostManager restarted(nullptr);
+    uint64_t after = GetNowSeconds();
+    uint64_t generation = 0;
+    EXPECT_EQ(restarted.GetDeviceGeneration(generation), UEC_OK);
+    EXPECT_GE(generation >> TEST_EPOCH_SHIFT, before);
+    EXPECT_LE(generation >> TEST_EPOCH_SHIFT, after);
+    EXPECT_EQ(generation & UINT32_MAX, 1U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceGeneration001");
+}
+
+/**
+ * @tc.name: DeviceGeneration002
+ * @tc.desc: a generation from an earlier start or from the future asks for a full sync
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceGenerationTest, DeviceGeneration002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceGeneration002");
+    uint64_t start = 0;
+    hostManager_->GetDeviceGeneration(start);
+    AddTestDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    std::vector<uint64_t> stale = {0, start - TEST_EPOCH_STEP + 1, start - 1, start + TEST_EPOCH_STEP};
+    for (uint64_t since : stale) {
+        uint64_t generation = 0;
+        bool fullSync = false;
+        std::vector<UsbDevice> added;
+        std::vector<UsbDevice> changed;
+        std::vector<std::string> removed;
+        EXPECT_EQ(hostManager_->GetDevicesSince(since, generation, fullSync, added, changed, removed), UEC_OK);
+        EXPECT_TRUE(fullSync);
+        EXPECT_EQ(generation, start + 1);
+        ASSERT_EQ(added.size(), 1U);
+        EXPECT_EQ(added[0].GetName(), GetTestDeviceName(TEST_BUS_NUM, TEST_DEV_ADDR));
+        EXPECT_TRUE(changed.empty());
+        EXPECT_TRUE(removed.empty());
+    }
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceGeneration002");
+}
+
+/**
+ * @tc.name: DeviceGeneration003
+ * @tc.desc: a caller at the start generation gets the devices added since as a delta
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceGenerationTest, DeviceGeneration003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceGeneration003");
+    uint64_t start = 0;
+    hostManager_->GetDeviceGeneration(start);
+    AddTestDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+
+    uint64_t generation = 0;
+    bool fullSync = true;
+    std::vector<UsbDevice> added;
+    std::vector<UsbDevice> changed;
+    std::vector<std::string> removed;
+    EXPECT_EQ(hostManager_->GetDevicesSince(start, generation, fullSync, added, changed, removed), UEC_OK);
+    EXPECT_FALSE(fullSync);
+    ASSERT_EQ(added.size(), 1U);
+    EXPECT_EQ(added[0].GetName(), GetTestDeviceName(TEST_BUS_NUM, TEST_DEV_ADDR));
+
+    uint64_t current = generation;
+    added.clear();
+    EXPECT_EQ(hostManager_->GetDevicesSince(current, generation, fullSync, added, changed, removed), UEC_OK);
+    EXPECT_FALSE(fullSync);
+    EXPECT_EQ(generation, current);
+    EXPECT_TRUE(added.empty());
+    EXPECT_TRUE(changed.empty());
+    EXPECT_TRUE(removed.empty());
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceGeneration003");
+}
+
+/**
+ * @tc.name: DeviceGeneration004
+ * @tc.desc: changes, hidden devices and removals after a generation are reported apart
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceGenerationTest, DeviceGeneration004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceGeneration004");
+    AddTestDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    AddTestDevice(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR);
+    uint64_t since = 0;
+    hostManager_->GetDeviceGeneration(since);
+    ChangeTestDevice(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR, ENABLED);
+
+    uint64_t generation = 0;
+    bool fullSync = true;
+    std::vector<UsbDevice> added;
+    std::vector<UsbDevice> changed;
+    std::vector<std::string> removed;
+    EXPECT_EQ(hostManager_->GetDevicesSince(since, generation, fullSync, added, changed, removed), UEC_OK);
+    EXPECT_FALSE(fullSync);
+    EXPECT_TRUE(added.empty());
+    ASSERT_EQ(changed.size(), 1U);
+    EXPECT_EQ(changed[0].GetName(), GetTestDeviceName(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR));
+    EXPECT_TRUE(removed.empty());
+
+    since = generation;
+    changed.clear();
+    ChangeTestDevice(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR, DISABLED);
+    RemoveTestDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    EXPECT_EQ(hostManager_->GetDevicesSince(since, generation, fullSync, added, changed, removed), UEC_OK);
+    EXPECT_FALSE(fullSync);
+    EXPECT_TRUE(added.empty());
+    EXPECT_TRUE(changed.empty());
+    EXPECT_EQ(removed, std::vector<std::string>({GetTestDeviceName(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR),
+        GetTestDeviceName(TEST_BUS_NUM, TEST_DEV_ADDR)}));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceGeneration004");
+}
+} // GenerationTest
+} // USB
+} // OHOS
@@ -0,0 +1,235 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_io_executor_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "hilog_wrapper.h"
+#include "usb_device_io_executor.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace IoExecutorTest {
+constexpr size_t TEST_LANE_LIMIT = 2;
+constexpr size_t TEST_QUEUE_LIMIT = 4;
+constexpr uint32_t TEST_LONG_IDLE_MS = 60000;
+constexpr uint32_t TEST_SHORT_IDLE_MS = 50;
+constexpr uint32_t TEST_WAIT_MS = 2000;
+constexpr uint32_t TEST_POLL_MS = 10;
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr uint8_t TEST_OTHER_DEV_ADDR = 3;
+constexpr uint8_t TEST_IN_LANE = 0x81;
+constexpr uint8_t TEST_OUT_LANE = 0x01;
+constexpr int32_t TEST_TASK_NUM = 4;
+
+/* holds a lane on its running task until the test opens it */
+class LaneGate {
+public:
+    std::function<void()> GetTask()
+    {
+        return [this]() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            started_ = true;
+            cond_.notify_all();
+            cond_.wait(lock, [this]() { return opened_; });
+        };
+    }
+
+    bool WaitStarted()
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        return cond_.wait_for(lock, std::chrono::milliseconds(TEST_WAIT_MS), [this]() { return started_; });
+    }
+
+    void Open()
+    {
+        std::lock_guard<std::mutex> guard(mutex_);
+        opened_ = true;
+        cond_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable cond_;
+    bool started_ = false;
+    bool opened_ = false;
+};
+
+static bool WaitForRunningLanes(UsbDeviceIoExecutor &executor, size_t count)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (executor.GetRunningLaneCount() != count) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    }
+    return true;
+}
+
+void UsbDeviceIoExecutorTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbDeviceIoExecutorTest");
+}
+
+void UsbDeviceIoExecutorTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbDeviceIoExecutorTest");
+}
+
+void UsbDeviceIoExecutorTest::SetUp() {}
+
+void UsbDeviceIoExecutorTest::TearDown() {}
+
+/**
+ * @tc.name: IoExecutor001
+ * @tc.desc: the transfers of one lane run one after another in the order they are posted
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceIoExecutorTest, IoExecutor001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : IoExecutor001");
+    /* declared before the executor, so its lanes are joined before anything the tasks use goes away */
+    LaneGate gate;
+    std::mutex orderMutex;
+    std::vector<int32_t> order;
+    std::atomic<int32_t> running {0};
+    std::atomic<bool> overlapped {false};
+    UsbDeviceIoExecutor executor(TEST_LANE_LIMIT, TEST_QUEUE_LIMIT, TEST_LONG_IDLE_MS);
+    ASSERT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_OUT_LANE, gate.GetTask()));
+    EXPECT_TRUE(gate.WaitStarted());
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_OUT_LANE, [&, i]() {
+            if (++running > 1) {
+                overlapped = true;
+            }
+            {
+                std::lock_guard<std::mutex> guard(orderMutex);
+                order.push_back(i);
+            }
+            --running;
+        }));
+    }
+    gate.Open();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (std::chrono::steady_clock::now() < deadline) {
+        {
+            std::lock_guard<std::mutex> guard(orderMutex);
+            if (order.size() == static_cast<size_t>(TEST_TASK_NUM)) {
+                break;
+            }
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    }
+    std::lock_guard<std::mutex> guard(orderMutex);
+    ASSERT_EQ(order.size(), static_cast<size_t>(TEST_TASK_NUM));
+    for (int32_t i = 0; i < TEST_TASK_NUM; i++) {
+        EXPECT_EQ(order[i], i);
+    }
+    EXPECT_FALSE(overlapped.load());
+    EXPECT_EQ(executor.GetRunningLaneCount(), 1);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : IoExecutor001");
+}
+
+/**
+ * @tc.name: IoExecutor002
+ * @tc.desc: a lane queues up to its limit behind the running transfer and refuses the next one
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceIoExecutorTest, IoExecutor002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : IoExecutor002");
+    LaneGate gate;
+    LaneGate otherGate;
+    std::atomic<size_t> ran {0};
+    UsbDeviceIoExecutor executor(TEST_LANE_LIMIT, TEST_QUEUE_LIMIT, TEST_LONG_IDLE_MS);
+    ASSERT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IN_LANE, gate.GetTask()));
+    EXPECT_TRUE(gate.WaitStarted());
+    for (size_t i = 0; i < TEST_QUEUE_LIMIT; i++) {
+        EXPECT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IN_LANE, [&ran]() { ++ran; }));
+    }
+    EXPECT_FALSE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IN_LANE, [&ran]() { ++ran; }));
+    /* the other endpoint of the device has a lane of its own and is not held up */
+    EXPECT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_OUT_LANE, otherGate.GetTask()));
+    EXPECT_TRUE(otherGate.WaitStarted());
+    otherGate.Open();
+    gate.Open();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (ran.load() != TEST_QUEUE_LIMIT && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    }
+    EXPECT_EQ(ran.load(), TEST_QUEUE_LIMIT);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : IoExecutor002");
+}
+
+/**
+ * @tc.name: IoExecutor003
+ * @tc.desc: a new lane is refused once the lane limit is busy, an existing lane still takes transfers
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceIoExecutorTest, IoExecutor003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : IoExecutor003");
+    LaneGate inGate;
+    LaneGate outGate;
+    std::atomic<bool> ran {false};
+    UsbDeviceIoExecutor executor(TEST_LANE_LIMIT, TEST_QUEUE_LIMIT, TEST_LONG_IDLE_MS);
+    EXPECT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IN_LANE, inGate.GetTask()));
+    EXPECT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_OUT_LANE, outGate.GetTask()));
+    EXPECT_EQ(executor.GetRunningLaneCount(), TEST_LANE_LIMIT);
+    EXPECT_FALSE(executor.Post(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR, TEST_OUT_LANE, []() {}));
+    EXPECT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_OUT_LANE, [&ran]() { ran = true; }));
+    inGate.Open();
+    outGate.Open();
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (!ran.load() && std::chrono::steady_clock::now() < deadline) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    }
+    EXPECT_TRUE(ran.load());
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : IoExecutor003");
+}
+
+/**
+ * @tc.name: IoExecutor004
+ * @tc.desc: an idle lane exits and gives its slot back, the next transfer starts it again
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceIoExecutorTest, IoExecutor004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : IoExecutor004");
+    std::atomic<int32_t> ran {0};
+    UsbDeviceIoExecutor executor(1, TEST_QUEUE_LIMIT, TEST_SHORT_IDLE_MS);
+    ASSERT_TRUE(executor.Post(TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IN_LANE, [&ran]() { ++ran; }));
+    EXPECT_TRUE(WaitForRunningLanes(executor, 0));
+    EXPECT_EQ(ran.load(), 1);
+    ASSERT_TRUE(executor.Post(TEST_BUS_NUM, TEST_OTHER_DEV_ADDR, TEST_IN_LANE, [&ran]() { ++ran; }));
+    EXPECT_TRUE(WaitForRunningLanes(executor, 0));
+    EXPECT_EQ(ran.load(), 2);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : IoExecutor004");
+}
+} // IoExecutorTest
+} // USB
+} // OHOS
@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_session_test.h"
+
+#include <chrono>
+#include <string>
+
+#include "hilog_wrapper.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace SessionTest {
+constexpr uint32_t TEST_TOKEN_ID = 537000000;
+constexpr uint32_t TEST_OTHER_TOKEN_ID = 537000001;
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr uint8_t TEST_OTHER_DEV_ADDR = 3;
+constexpr uint64_t TEST_VALID_PERIOD = 3600;
+const std::string TEST_IDENTITY = "4660-22136-0001";
+const std::string TEST_OTHER_IDENTITY = "4660-22136-0002";
+
+static uint64_t GetNowTime()
+{
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now().time_since_epoch()).count());
+}
+
+void UsbDeviceSessionTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbDeviceSessionTest");
+}
+
+void UsbDeviceSessionTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbDeviceSessionTest");
+}
+
+void UsbDeviceSessionTest::SetUp()
+{
+    hostManager_ = std::make_unique<UsbHostManager>(nullptr);
+}
+
+void UsbDeviceSessionTest::TearDown()
+{
+    hostManager_ = nullptr;
+}
+
+/**
+ * @tc.name: DeviceSession001
+ * @tc.desc: a session opened under a right without end stays valid until it is removed
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSessionTest, DeviceSession001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSession001");
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY, UINT64_MAX);
+    EXPECT_TRUE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_OTHER_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    hostManager_->RemoveDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR);
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSession001");
+}
+
+/**
+ * @tc.name: DeviceSession002
+ * @tc.desc: a session ends with the time limited right it was opened under
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSessionTest, DeviceSession002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSession002");
+    uint64_t nowTime = GetNowTime();
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY,
+        nowTime + TEST_VALID_PERIOD);
+    EXPECT_TRUE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY, nowTime);
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSession002");
+}
+
+/**
+ * @tc.name: DeviceSession003
+ * @tc.desc: revoking the right of one token drops only the sessions of that token on that device
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSessionTest, DeviceSession003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSession003");
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY, UINT64_MAX);
+    hostManager_->AddDeviceSession(TEST_OTHER_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY, UINT64_MAX);
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_OTHER_DEV_ADDR, TEST_OTHER_IDENTITY,
+        UINT64_MAX);
+    hostManager_->RemoveDeviceSessions(TEST_TOKEN_ID, TEST_IDENTITY);
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    EXPECT_TRUE(hostManager_->CheckDeviceSession(TEST_OTHER_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    EXPECT_TRUE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_OTHER_DEV_ADDR));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSession003");
+}
+
+/**
+ * @tc.name: DeviceSession004
+ * @tc.desc: revoking a right not bound to one token drops the sessions of every token on that device
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSessionTest, DeviceSession004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSession004");
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY, UINT64_MAX);
+    hostManager_->AddDeviceSession(TEST_OTHER_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_IDENTITY, UINT64_MAX);
+    hostManager_->AddDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_OTHER_DEV_ADDR, TEST_OTHER_IDENTITY,
+        UINT64_MAX);
+    hostManager_->RemoveDeviceSessions(TEST_IDENTITY);
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_OTHER_TOKEN_ID, TEST_BUS_NUM, TEST_DEV_ADDR));
+    EXPECT_TRUE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_OTHER_DEV_ADDR));
+    hostManager_->ClearDeviceSessions();
+    EXPECT_FALSE(hostManager_->CheckDeviceSession(TEST_TOKEN_ID, TEST_BUS_NUM, TEST_OTHER_DEV_ADDR));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSession004");
+}
+} // SessionTest
+} // USB
+} // OHOS
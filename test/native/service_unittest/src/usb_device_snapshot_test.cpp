@@ -0,0 +1,233 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_snapshot_test.h"
+
+#include <string>
+#include <vector>
+
+#include "hilog_wrapper.h"
+#include "usb_device_snapshot.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace SnapshotTest {
+constexpr uint64_t TEST_SEQUENCE = 42;
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr int32_t TEST_VENDOR_ID = 0x1234;
+constexpr int32_t TEST_PRODUCT_ID = 0x5678;
+constexpr int32_t TEST_CONFIG_ID = 1;
+constexpr int32_t TEST_INTERFACE_ID = 0;
+constexpr uint32_t TEST_EP_IN = 0x81;
+constexpr uint32_t TEST_EP_OUT = 0x01;
+constexpr uint32_t TEST_EP_ATTR_BULK = 0x02;
+constexpr int32_t TEST_EP_MAX_PACKET = 512;
+constexpr uint32_t TEST_MISALIGN = 1;
+constexpr uint32_t TEST_OUT_OF_RANGE = 0x10000;
+const std::string TEST_NAME = "1-2";
+const std::string TEST_SERIAL = "0123456789";
+
+static std::vector<uint8_t> EncodeTestDevice(bool withSerial)
+{
+    UsbDevice dev;
+    dev.SetBusNum(TEST_BUS_NUM);
+    dev.SetDevAddr(TEST_DEV_ADDR);
+    dev.SetVendorId(TEST_VENDOR_ID);
+    dev.SetProductId(TEST_PRODUCT_ID);
+    dev.SetName(TEST_NAME);
+    dev.SetmSerial(TEST_SERIAL);
+    USBConfig config;
+    config.SetId(TEST_CONFIG_ID);
+    UsbInterface interface;
+    interface.SetId(TEST_INTERFACE_ID);
+    interface.GetEndpoints().emplace_back(TEST_EP_IN, TEST_EP_ATTR_BULK, 0, TEST_EP_MAX_PACKET);
+    interface.GetEndpoints().emplace_back(TEST_EP_OUT, TEST_EP_ATTR_BULK, 0, TEST_EP_MAX_PACKET);
+    config.GetInterfaces().push_back(interface);
+    dev.GetConfigs().push_back(config);
+
+    UsbDeviceSnapshotWriter writer;
+    writer.AddDevice(dev, withSerial);
+    return writer.Finish(TEST_SEQUENCE);
+}
+
+static UsbSnapshotHeader &GetHeader(std::vector<uint8_t> &encoded)
+{
+    return *reinterpret_cast<UsbSnapshotHeader *>(encoded.data());
+}
+
+template <typename T>
+static T &GetRecord(std::vector<uint8_t> &encoded, uint32_t offset)
+{
+    return *reinterpret_cast<T *>(encoded.data() + offset);
+}
+
+static bool AttachEncoded(const std::vector<uint8_t> &encoded)
+{
+    UsbDeviceSnapshot snapshot;
+    return snapshot.Attach(encoded.data(), static_cast<uint32_t>(encoded.size()));
+}
+
+void UsbDeviceSnapshotTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbDeviceSnapshotTest");
+}
+
+void UsbDeviceSnapshotTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbDeviceSnapshotTest");
+}
+
+void UsbDeviceSnapshotTest::SetUp() {}
+
+void UsbDeviceSnapshotTest::TearDown() {}
+
+/**
+ * @tc.name: DeviceSnapshot001
+ * @tc.desc: an encoded device decodes back with its configs, interfaces and endpoints
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSnapshotTest, DeviceSnapshot001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSnapshot001");
+    std::vector<uint8_t> encoded = EncodeTestDevice(true);
+    UsbDeviceSnapshot snapshot;
+    ASSERT_TRUE(snapshot.Attach(encoded.data(), static_cast<uint32_t>(encoded.size())));
+    EXPECT_EQ(snapshot.GetSequence(), TEST_SEQUENCE);
+    ASSERT_EQ(snapshot.GetDeviceCount(), 1U);
+    UsbDevice dev;
+    snapshot.ToDevice(0, dev);
+    EXPECT_EQ(dev.GetBusNum(), TEST_BUS_NUM);
+    EXPECT_EQ(dev.GetDevAddr(), TEST_DEV_ADDR);
+    EXPECT_EQ(dev.GetVendorId(), TEST_VENDOR_ID);
+    EXPECT_EQ(dev.GetProductId(), TEST_PRODUCT_ID);
+    EXPECT_EQ(dev.GetName(), TEST_NAME);
+    EXPECT_EQ(dev.GetmSerial(), TEST_SERIAL);
+    ASSERT_EQ(dev.GetConfigs().size(), 1U);
+    EXPECT_EQ(dev.GetConfigs()[0].GetId(), TEST_CONFIG_ID);
+    ASSERT_EQ(dev.GetConfigs()[0].GetInterfaces().size(), 1U);
+    const std::vector<USBEndpoint> &eps = dev.GetConfigs()[0].GetInterfaces()[0].GetEndpoints();
+    ASSERT_EQ(eps.size(), 2U);
+    EXPECT_EQ(eps[0].GetAddress(), TEST_EP_IN);
+    EXPECT_EQ(eps[1].GetAddress(), TEST_EP_OUT);
+    EXPECT_EQ(eps[1].GetMaxPacketSize(), TEST_EP_MAX_PACKET);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSnapshot001");
+}
+
+/**
+ * @tc.name: DeviceSnapshot002
+ * @tc.desc: the serial is left out of the snapshot for callers that may not see it
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSnapshotTest, DeviceSnapshot002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSnapshot002");
+    std::vector<uint8_t> encoded = EncodeTestDevice(false);
+    UsbDeviceSnapshot snapshot;
+    ASSERT_TRUE(snapshot.Attach(encoded.data(), static_cast<uint32_t>(encoded.size())));
+    UsbDevice dev;
+    snapshot.ToDevice(0, dev);
+    EXPECT_EQ(dev.GetName(), TEST_NAME);
+    EXPECT_TRUE(dev.GetmSerial().empty());
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSnapshot002");
+}
+
+/**
+ * @tc.name: DeviceSnapshot003
+ * @tc.desc: a truncated buffer or a foreign header is rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSnapshotTest, DeviceSnapshot003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSnapshot003");
+    std::vector<uint8_t> encoded = EncodeTestDevice(true);
+    UsbDeviceSnapshot snapshot;
+    EXPECT_FALSE(snapshot.Attach(nullptr, static_cast<uint32_t>(encoded.size())));
+    EXPECT_FALSE(snapshot.Attach(encoded.data(), sizeof(UsbSnapshotHeader) - 1));
+    EXPECT_FALSE(snapshot.Attach(encoded.data(), static_cast<uint32_t>(encoded.size()) - 1));
+
+    std::vector<uint8_t> corrupted = encoded;
+    GetHeader(corrupted).magic = 0;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetHeader(corrupted).version = USB_DEVICE_SNAPSHOT_VERSION + 1;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetHeader(corrupted).headerSize = 0;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    EXPECT_EQ(snapshot.GetDeviceCount(), 0U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSnapshot003");
+}
+
+/**
+ * @tc.name: DeviceSnapshot004
+ * @tc.desc: tables that are misaligned or reach past the end of the snapshot are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSnapshotTest, DeviceSnapshot004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSnapshot004");
+    std::vector<uint8_t> encoded = EncodeTestDevice(true);
+    std::vector<uint8_t> corrupted = encoded;
+    GetHeader(corrupted).configsOffset += TEST_MISALIGN;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetHeader(corrupted).endpointsOffset = GetHeader(corrupted).totalSize;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    /* the byte count of the table overflows 32 bits */
+    GetHeader(corrupted).deviceCount = UINT32_MAX;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetHeader(corrupted).stringsSize += 1;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSnapshot004");
+}
+
+/**
+ * @tc.name: DeviceSnapshot005
+ * @tc.desc: strings and child ranges pointing outside their tables are rejected
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbDeviceSnapshotTest, DeviceSnapshot005, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : DeviceSnapshot005");
+    std::vector<uint8_t> encoded = EncodeTestDevice(true);
+    const UsbSnapshotHeader header = GetHeader(encoded);
+    std::vector<uint8_t> corrupted = encoded;
+    GetRecord<UsbSnapshotDevice>(corrupted, header.devicesOffset).serial.offset = TEST_OUT_OF_RANGE;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    /* offset and length each fit, their sum does not */
+    GetRecord<UsbSnapshotDevice>(corrupted, header.devicesOffset).name = {header.stringsSize, UINT32_MAX};
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetRecord<UsbSnapshotDevice>(corrupted, header.devicesOffset).configCount = header.configCount + 1;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetRecord<UsbSnapshotConfig>(corrupted, header.configsOffset).firstInterface = TEST_OUT_OF_RANGE;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    corrupted = encoded;
+    GetRecord<UsbSnapshotInterface>(corrupted, header.interfacesOffset).endpointCount = header.endpointCount + 1;
+    EXPECT_FALSE(AttachEncoded(corrupted));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : DeviceSnapshot005");
+}
+} // SnapshotTest
+} // USB
+} // OHOS
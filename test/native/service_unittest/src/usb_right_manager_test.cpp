@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_right_manager_test.h"
+
+#include <algorithm>
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "hilog_wrapper.h"
+#include "usb_common_test.h"
+#include "usb_errors.h"
+#include "usb_right_db_helper.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+using namespace OHOS::USB::Common;
+
+namespace OHOS {
+namespace USB {
+namespace RightTest {
+constexpr int32_t TEST_USER_ID = 100;
+constexpr int32_t TEST_CHECK_THREADS = 4;
+const std::string TEST_DEVICE_NAME = "4660-22136";
+const std::string TEST_BUNDLE_NAME = "com.usb.right.test";
+const std::string TEST_TOKEN_ID = "537000000";
+const std::string TEST_UNINSTALLED_BUNDLE_NAME = "com.usb.right.uninstalled.test";
+/* same bits as TIGHT_UP_USB_RIGHT_RECORD_APP_UNINSTALLED and _EXPIRED of the right manager */
+constexpr uint32_t TEST_TIDY_UP_APP_UNINSTALLED = 1 << 0;
+constexpr uint32_t TEST_TIDY_UP_EXPIRED = 1 << 2;
+/* requested long before any normal valid period could still hold */
+constexpr uint64_t TEST_EXPIRED_REQUEST_TIME = 1;
+
+void UsbRightManagerTest::SetUpTestCase()
+{
+    UsbCommonTest::GrantPermissionSysNative();
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbRightManagerTest");
+}
+
+void UsbRightManagerTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbRightManagerTest");
+}
+
+void UsbRightManagerTest::SetUp()
+{
+    rightManager_ = std::make_shared<UsbRightManager>();
+    (void)rightManager_->RemoveDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID);
+}
+
+void UsbRightManagerTest::TearDown()
+{
+    (void)rightManager_->RemoveDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID);
+    (void)rightManager_->RemoveDeviceRight(TEST_DEVICE_NAME, TEST_UNINSTALLED_BUNDLE_NAME, TEST_TOKEN_ID,
+        TEST_USER_ID);
+    rightManager_ = nullptr;
+}
+
+/**
+ * @tc.name: RightCache001
+ * @tc.desc: a granted right is found again by the next check, which is served from the cache
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightCache001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightCache001");
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    ASSERT_TRUE(rightManager_->AddDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    EXPECT_TRUE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    EXPECT_TRUE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightCache001");
+}
+
+/**
+ * @tc.name: RightCache002
+ * @tc.desc: removing a cached right makes the next check fail
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightCache002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightCache002");
+    ASSERT_TRUE(rightManager_->AddDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    ASSERT_TRUE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    EXPECT_TRUE(rightManager_->RemoveDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightCache002");
+}
+
+/**
+ * @tc.name: RightCache003
+ * @tc.desc: cancelling a cached right makes the next check fail
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightCache003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightCache003");
+    ASSERT_TRUE(rightManager_->AddDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    ASSERT_TRUE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    EXPECT_EQ(rightManager_->CancelDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID),
+        UEC_OK);
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightCache003");
+}
+
+/**
+ * @tc.name: RightCache004
+ * @tc.desc: the records of a stopped user are not served from the cache any more
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightCache004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightCache004");
+    ASSERT_TRUE(rightManager_->AddDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    ASSERT_TRUE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    (void)UsbRightManager::CleanUpRightUserStopped(TEST_USER_ID);
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightCache004");
+}
+
+/**
+ * @tc.name: RightCache005
+ * @tc.desc: checks running while the right is removed leave no positive entry behind
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightCache005, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightCache005");
+    ASSERT_TRUE(rightManager_->AddDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    std::atomic<bool> removed {false};
+    std::vector<std::thread> checkers;
+    for (int32_t i = 0; i < TEST_CHECK_THREADS; i++) {
+        checkers.emplace_back([this, &removed]() {
+            while (!removed.load()) {
+                (void)rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID);
+            }
+        });
+    }
+    EXPECT_TRUE(rightManager_->RemoveDeviceRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    removed.store(true);
+    for (auto &checker : checkers) {
+        checker.join();
+    }
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightCache005");
+}
+
+/**
+ * @tc.name: RightSweep001
+ * @tc.desc: one sweep pass for the user deletes a record whose normal valid period is over
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightSweep001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightSweep001");
+    std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
+    ASSERT_NE(helper, nullptr);
+    struct UsbRightAppInfo info;
+    info.uid = TEST_USER_ID;
+    info.installTime = TEST_EXPIRED_REQUEST_TIME;
+    info.updateTime = TEST_EXPIRED_REQUEST_TIME;
+    info.requestTime = TEST_EXPIRED_REQUEST_TIME;
+    info.validPeriod = USB_RIGHT_VALID_PERIOD_SET;
+    ASSERT_GE(helper->AddOrUpdateRightRecord(TEST_USER_ID, TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, info),
+        0);
+    std::vector<struct UsbRightAppInfo> infos;
+    (void)helper->QueryRightRecord(TEST_USER_ID, TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, infos);
+    ASSERT_FALSE(infos.empty());
+    EXPECT_EQ(rightManager_->TidyUpRight(TEST_TIDY_UP_EXPIRED, TEST_USER_ID), USB_RIGHT_OK);
+    infos.clear();
+    (void)helper->QueryRightRecord(TEST_USER_ID, TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, infos);
+    EXPECT_TRUE(infos.empty());
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_BUNDLE_NAME, TEST_TOKEN_ID, TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightSweep001");
+}
+
+/**
+ * @tc.name: RightSweep002
+ * @tc.desc: the records of a bundle that is not installed are found stale and deleted by the sweep
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbRightManagerTest, RightSweep002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : RightSweep002");
+    ASSERT_TRUE(rightManager_->AddDeviceRight(TEST_DEVICE_NAME, TEST_UNINSTALLED_BUNDLE_NAME, TEST_TOKEN_ID,
+        TEST_USER_ID));
+    std::vector<std::string> bundleNames;
+    EXPECT_EQ(rightManager_->CollectRightAppStale(TEST_USER_ID, true, false, bundleNames), USB_RIGHT_OK);
+    EXPECT_NE(std::find(bundleNames.begin(), bundleNames.end(), TEST_UNINSTALLED_BUNDLE_NAME), bundleNames.end());
+    EXPECT_EQ(rightManager_->TidyUpRight(TEST_TIDY_UP_APP_UNINSTALLED, TEST_USER_ID), USB_RIGHT_OK);
+    std::vector<struct UsbRightAppInfo> infos;
+    std::shared_ptr<UsbRightDbHelper> helper = UsbRightDbHelper::GetInstance();
+    ASSERT_NE(helper, nullptr);
+    (void)helper->QueryAppRightRecord(TEST_USER_ID, TEST_UNINSTALLED_BUNDLE_NAME, infos);
+    EXPECT_TRUE(infos.empty());
+    EXPECT_FALSE(rightManager_->HasRight(TEST_DEVICE_NAME, TEST_UNINSTALLED_BUNDLE_NAME, TEST_TOKEN_ID,
+        TEST_USER_ID));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : RightSweep002");
+}
+} // RightTest
+} // USB
+} // OHOS
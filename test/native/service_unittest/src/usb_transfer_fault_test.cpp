@@ -0,0 +1,228 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_fault_test.h"
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+#include "hilog_wrapper.h"
+#include "usb_transfer_fault_reporter.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace TransferFaultTest {
+constexpr uint32_t TEST_LONG_INTERVAL_MS = 60000;
+constexpr uint32_t TEST_SHORT_INTERVAL_MS = 50;
+constexpr uint32_t TEST_WAIT_MS = 2000;
+constexpr uint32_t TEST_POLL_MS = 10;
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr int32_t TEST_VENDOR_ID = 0x1234;
+constexpr int32_t TEST_OTHER_VENDOR_ID = 0x4321;
+constexpr int32_t TEST_PRODUCT_ID = 0x5678;
+constexpr int32_t TEST_INTERFACE_CLASS = 0x0A;
+constexpr uint8_t TEST_INTERFACE_ID = 1;
+constexpr uint8_t TEST_ENDPOINT = 0x81;
+constexpr int32_t TEST_FAULT_RET = -1;
+constexpr size_t TEST_PENDING_MAX = 256;
+const HDI::Usb::V1_0::UsbPipe TEST_PIPE = {TEST_INTERFACE_ID, TEST_ENDPOINT};
+
+/* stands in for the device table, the test swaps the vendor to plug another device in at the same address */
+class FakeDeviceTable {
+public:
+    UsbTransferFaultReporter::Resolver GetResolver()
+    {
+        return [this](UsbTransferFault &fault) {
+            ++resolved_;
+            if (!present_.load()) {
+                return false;
+            }
+            fault.vendorId = vendorId_.load();
+            fault.productId = TEST_PRODUCT_ID;
+            fault.interfaceClass = TEST_INTERFACE_CLASS;
+            return true;
+        };
+    }
+
+    std::atomic<bool> present_ {true};
+    std::atomic<int32_t> vendorId_ {TEST_VENDOR_ID};
+    std::atomic<uint32_t> resolved_ {0};
+};
+
+static size_t GetPendingKinds(UsbTransferFaultReporter &reporter)
+{
+    std::lock_guard<std::mutex> guard(reporter.mutex_);
+    return reporter.pendingFaults_.size();
+}
+
+static uint32_t GetPendingCount(UsbTransferFaultReporter &reporter, int32_t vendorId)
+{
+    std::lock_guard<std::mutex> guard(reporter.mutex_);
+    uint32_t total = 0;
+    for (const auto &[fault, count] : reporter.pendingFaults_) {
+        if (fault.vendorId == vendorId) {
+            total += count;
+        }
+    }
+    return total;
+}
+
+static bool WaitForFlush(UsbTransferFaultReporter &reporter)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(TEST_WAIT_MS);
+    while (GetPendingKinds(reporter) != 0) {
+        if (std::chrono::steady_clock::now() >= deadline) {
+            return false;
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_POLL_MS));
+    }
+    return true;
+}
+
+void UsbTransferFaultTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbTransferFaultTest");
+}
+
+void UsbTransferFaultTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbTransferFaultTest");
+}
+
+void UsbTransferFaultTest::SetUp() {}
+
+void UsbTransferFaultTest::TearDown() {}
+
+/**
+ * @tc.name: TransferFault001
+ * @tc.desc: the same fault within one interval is counted under one key, another call site gets its own
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferFaultTest, TransferFault001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferFault001");
+    FakeDeviceTable table;
+    UsbTransferFaultReporter reporter(table.GetResolver(), TEST_LONG_INTERVAL_MS);
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "BulkTransferReadFail");
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "BulkTransferReadFail");
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "CheckDevicePermission failed");
+    EXPECT_EQ(GetPendingKinds(reporter), 2U);
+    EXPECT_EQ(GetPendingCount(reporter, TEST_VENDOR_ID), 3U);
+    /* the repeat is counted under the identity remembered for the first one */
+    EXPECT_EQ(table.resolved_.load(), 2U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferFault001");
+}
+
+/**
+ * @tc.name: TransferFault002
+ * @tc.desc: a device plugged in at the address of a failed one within the interval is kept apart
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferFaultTest, TransferFault002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferFault002");
+    FakeDeviceTable table;
+    UsbTransferFaultReporter reporter(table.GetResolver(), TEST_LONG_INTERVAL_MS);
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "BulkTransferReadFail");
+    reporter.ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    table.vendorId_ = TEST_OTHER_VENDOR_ID;
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "BulkTransferReadFail");
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "BulkTransferReadFail");
+    EXPECT_EQ(GetPendingKinds(reporter), 2U);
+    EXPECT_EQ(GetPendingCount(reporter, TEST_VENDOR_ID), 1U);
+    EXPECT_EQ(GetPendingCount(reporter, TEST_OTHER_VENDOR_ID), 2U);
+
+    /* the fault of a device that is already gone cannot be attributed and is not counted */
+    table.present_ = false;
+    reporter.ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, TEST_FAULT_RET, "BulkTransferReadFail");
+    EXPECT_EQ(GetPendingCount(reporter, TEST_OTHER_VENDOR_ID), 2U);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferFault002");
+}
+
+/**
+ * @tc.name: TransferFault003
+ * @tc.desc: the interval is flushed once it ends and the next fault opens a new one
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferFaultTest, TransferFault003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferFault003");
+    FakeDeviceTable table;
+    UsbTransferFaultReporter reporter(table.GetResolver(), TEST_SHORT_INTERVAL_MS);
+    reporter.ReportSubmit(0, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_ENDPOINT, TEST_FAULT_RET, "UsbSubmitTransferFail");
+    reporter.ReportSubmit(0, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_ENDPOINT, TEST_FAULT_RET, "UsbSubmitTransferFail");
+    EXPECT_EQ(GetPendingCount(reporter, TEST_VENDOR_ID), 2U);
+    ASSERT_TRUE(WaitForFlush(reporter));
+
+    reporter.ReportSubmit(0, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_ENDPOINT, TEST_FAULT_RET, "UsbSubmitTransferFail");
+    EXPECT_EQ(GetPendingCount(reporter, TEST_VENDOR_ID), 1U);
+    ASSERT_TRUE(WaitForFlush(reporter));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferFault003");
+}
+
+/**
+ * @tc.name: TransferFault004
+ * @tc.desc: kinds beyond the pending limit are dropped and counted until the interval is flushed
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferFaultTest, TransferFault004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferFault004");
+    FakeDeviceTable table;
+    UsbTransferFaultReporter reporter(table.GetResolver(), TEST_LONG_INTERVAL_MS);
+    for (size_t i = 0; i <= TEST_PENDING_MAX; ++i) {
+        reporter.Report("BulkRead", TEST_BUS_NUM, TEST_DEV_ADDR, TEST_PIPE, -static_cast<int32_t>(i) - 1,
+            "BulkTransferReadFail");
+    }
+    EXPECT_EQ(GetPendingKinds(reporter), TEST_PENDING_MAX);
+    {
+        std::lock_guard<std::mutex> guard(reporter.mutex_);
+        EXPECT_EQ(reporter.droppedFaults_, 1U);
+    }
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferFault004");
+}
+
+/**
+ * @tc.name: TransferFault005
+ * @tc.desc: a fault flushed with the last interval reuses the remembered identity until the device detaches
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferFaultTest, TransferFault005, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferFault005");
+    FakeDeviceTable table;
+    UsbTransferFaultReporter reporter(table.GetResolver(), TEST_SHORT_INTERVAL_MS);
+    reporter.ReportSubmit(0, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_ENDPOINT, TEST_FAULT_RET, "UsbSubmitTransferFail");
+    ASSERT_TRUE(WaitForFlush(reporter));
+    reporter.ReportSubmit(0, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_ENDPOINT, TEST_FAULT_RET, "UsbSubmitTransferFail");
+    EXPECT_EQ(GetPendingCount(reporter, TEST_VENDOR_ID), 1U);
+    EXPECT_EQ(table.resolved_.load(), 1U);
+
+    reporter.ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    reporter.ReportSubmit(0, TEST_BUS_NUM, TEST_DEV_ADDR, TEST_ENDPOINT, TEST_FAULT_RET, "UsbSubmitTransferFail");
+    EXPECT_EQ(table.resolved_.load(), 2U);
+    ASSERT_TRUE(WaitForFlush(reporter));
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferFault005");
+}
+} // TransferFaultTest
+} // USB
+} // OHOS
@@ -0,0 +1,145 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_stats_test.h"
+
+#include <cstdio>
+#include <string>
+#include <unistd.h>
+
+#include "hilog_wrapper.h"
+#include "usb_errors.h"
+#include "usb_transfer_stats.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace TransferStatsTest {
+constexpr uint8_t TEST_BUS_NUM = 1;
+constexpr uint8_t TEST_DEV_ADDR = 2;
+constexpr uint8_t TEST_NEW_DEV_ADDR = 3;
+constexpr uint32_t TEST_SLOT_COUNT = 64;
+constexpr size_t TEST_DUMP_SIZE = 65536;
+
+static void RecordTransfer(uint8_t devAddr, uint8_t endpoint)
+{
+    UsbTransferProbe probe = UsbTransferStats::Begin(TEST_BUS_NUM, devAddr, endpoint, UsbTransferKind::BULK);
+    UsbTransferStats::End(probe, UsbLatencyStage::HDI, UEC_OK);
+}
+
+static uint64_t GetDropped()
+{
+    UsbTransferStats &stats = UsbTransferStats::GetInstance();
+    std::lock_guard<std::mutex> guard(stats.shardsMutex_);
+    uint64_t dropped = 0;
+    for (const auto &shard : stats.shards_) {
+        dropped += shard->dropped.load();
+    }
+    return dropped;
+}
+
+static std::string DumpStats()
+{
+    std::string dump;
+    FILE *file = tmpfile();
+    if (file == nullptr) {
+        return dump;
+    }
+    UsbTransferStats::Dump(fileno(file));
+    dump.resize(TEST_DUMP_SIZE);
+    size_t size = static_cast<size_t>(pread(fileno(file), dump.data(), dump.size(), 0));
+    dump.resize(size > dump.size() ? 0 : size);
+    (void)fclose(file);
+    return dump;
+}
+
+void UsbTransferStatsTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbTransferStatsTest");
+}
+
+void UsbTransferStatsTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbTransferStatsTest");
+}
+
+void UsbTransferStatsTest::SetUp()
+{
+    UsbTransferStats::ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    UsbTransferStats::ForgetDevice(TEST_BUS_NUM, TEST_NEW_DEV_ADDR);
+}
+
+void UsbTransferStatsTest::TearDown()
+{
+    UsbTransferStats::ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    UsbTransferStats::ForgetDevice(TEST_BUS_NUM, TEST_NEW_DEV_ADDR);
+}
+
+/**
+ * @tc.name: TransferStats001
+ * @tc.desc: a detached device leaves the dump and its slots take the device plugged in after it
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferStatsTest, TransferStats001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferStats001");
+    /* one entry per endpoint is enough to fill every slot of the shard of this thread */
+    for (uint32_t endpoint = 0; endpoint < TEST_SLOT_COUNT; ++endpoint) {
+        RecordTransfer(TEST_DEV_ADDR, static_cast<uint8_t>(endpoint));
+    }
+    uint64_t dropped = GetDropped();
+    RecordTransfer(TEST_NEW_DEV_ADDR, 0);
+    EXPECT_EQ(GetDropped(), dropped + 1);
+    EXPECT_NE(DumpStats().find("1-2 ep:0x00 bulk hdi count:1 "), std::string::npos);
+
+    UsbTransferStats::ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    std::string dump = DumpStats();
+    EXPECT_EQ(dump.find("1-2 ep:"), std::string::npos);
+
+    dropped = GetDropped();
+    RecordTransfer(TEST_NEW_DEV_ADDR, 0);
+    EXPECT_EQ(GetDropped(), dropped);
+    /* the counters of the slot it took over are not carried on */
+    EXPECT_NE(DumpStats().find("1-3 ep:0x00 bulk hdi count:1 "), std::string::npos);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferStats001");
+}
+
+/**
+ * @tc.name: TransferStats002
+ * @tc.desc: the entries of another device stay when one device is detached
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferStatsTest, TransferStats002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferStats002");
+    RecordTransfer(TEST_DEV_ADDR, 1);
+    RecordTransfer(TEST_NEW_DEV_ADDR, 1);
+    RecordTransfer(TEST_NEW_DEV_ADDR, 1);
+    UsbTransferStats::ForgetDevice(TEST_BUS_NUM, TEST_DEV_ADDR);
+    std::string dump = DumpStats();
+    EXPECT_EQ(dump.find("1-2 ep:"), std::string::npos);
+    EXPECT_NE(dump.find("1-3 ep:0x01 bulk hdi count:2 "), std::string::npos);
+
+    /* the device plugged in at the same address again starts from zero */
+    RecordTransfer(TEST_DEV_ADDR, 1);
+    EXPECT_NE(DumpStats().find("1-2 ep:0x01 bulk hdi count:1 "), std::string::npos);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferStats002");
+}
+} // TransferStatsTest
+} // USB
+} // OHOS
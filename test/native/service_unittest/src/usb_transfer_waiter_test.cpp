@@ -0,0 +1,174 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_transfer_waiter_test.h"
+
+#include <chrono>
+#include <thread>
+
+#include "hilog_wrapper.h"
+#include "message_option.h"
+#include "message_parcel.h"
+#include "usb_errors.h"
+#include "usb_transfer_waiter.h"
+#include "usbd_callback_stub.h"
+
+using namespace testing::ext;
+using namespace OHOS::USB;
+using namespace OHOS;
+
+namespace OHOS {
+namespace USB {
+namespace TransferWaiterTest {
+constexpr int32_t TEST_TIMEOUT_MS = 100;
+/* the transfer timeout, the waiter margin and some slack */
+constexpr int32_t TEST_WAIT_BOUND_MS = 3000;
+constexpr int32_t TEST_REPLY_DELAY_MS = 50;
+constexpr int32_t TEST_ALIVE_CHECKS = 2;
+constexpr int32_t TEST_STATUS = 0;
+constexpr uint8_t TEST_DATA = 0x5A;
+
+/* what the service sends over the one way callback, delivered in process */
+static int32_t SendStarted(const sptr<IRemoteObject> &cb)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    data.WriteInterfaceToken(cb->GetInterfaceDescriptor());
+    data.WriteUint64(0);
+    return cb->SendRequest(UsbdStubCallBack::CMD_USBD_TRANSFER_CALLBACK_STARTED, data, reply, option);
+}
+
+static int32_t SendResult(const sptr<IRemoteObject> &cb, bool complete)
+{
+    MessageParcel data;
+    MessageParcel reply;
+    MessageOption option(MessageOption::TF_ASYNC);
+    data.WriteInterfaceToken(cb->GetInterfaceDescriptor());
+    data.WriteInt32(TEST_STATUS);
+    if (complete) {
+        data.WriteUInt8Vector({});
+        data.WriteUInt8Vector({TEST_DATA});
+        data.WriteUint64(0);
+    }
+    return cb->SendRequest(UsbdStubCallBack::CMD_USBD_TRANSFER_CALLBACK_DATA, data, reply, option);
+}
+
+static int64_t ElapsedMs(std::chrono::steady_clock::time_point begin)
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - begin).count();
+}
+
+void UsbTransferWaiterTest::SetUpTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Start UsbTransferWaiterTest");
+}
+
+void UsbTransferWaiterTest::TearDownTestCase()
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "End UsbTransferWaiterTest");
+}
+
+void UsbTransferWaiterTest::SetUp() {}
+
+void UsbTransferWaiterTest::TearDown() {}
+
+/**
+ * @tc.name: TransferWaiter001
+ * @tc.desc: the result of a started transfer is handed back with its data
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferWaiterTest, TransferWaiter001, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferWaiter001");
+    UsbTransferWaiter waiter;
+    sptr<IRemoteObject> cb = waiter.GetCallback();
+    ASSERT_NE(cb, nullptr);
+    std::thread service([cb]() {
+        std::this_thread::sleep_for(std::chrono::milliseconds(TEST_REPLY_DELAY_MS));
+        (void)SendStarted(cb);
+        (void)SendResult(cb, true);
+    });
+    TransferDataResult result;
+    EXPECT_EQ(waiter.Wait(TEST_TIMEOUT_MS, []() { return true; }, result), TEST_STATUS);
+    service.join();
+    ASSERT_EQ(result.bufferData.size(), 1);
+    EXPECT_EQ(result.bufferData[0], TEST_DATA);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferWaiter001");
+}
+
+/**
+ * @tc.name: TransferWaiter002
+ * @tc.desc: a started transfer whose result is dropped fails with a timeout once its deadline passes
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferWaiterTest, TransferWaiter002, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferWaiter002");
+    UsbTransferWaiter waiter;
+    sptr<IRemoteObject> cb = waiter.GetCallback();
+    ASSERT_NE(cb, nullptr);
+    ASSERT_EQ(SendStarted(cb), UEC_OK);
+    auto begin = std::chrono::steady_clock::now();
+    TransferDataResult result;
+    EXPECT_EQ(waiter.Wait(TEST_TIMEOUT_MS, []() { return true; }, result), UEC_INTERFACE_TIMED_OUT);
+    EXPECT_GE(ElapsedMs(begin), TEST_TIMEOUT_MS);
+    EXPECT_LT(ElapsedMs(begin), TEST_WAIT_BOUND_MS);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferWaiter002");
+}
+
+/**
+ * @tc.name: TransferWaiter003
+ * @tc.desc: a result that cannot be parsed fails the transfer at once instead of being dropped
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferWaiterTest, TransferWaiter003, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferWaiter003");
+    UsbTransferWaiter waiter;
+    sptr<IRemoteObject> cb = waiter.GetCallback();
+    ASSERT_NE(cb, nullptr);
+    (void)SendStarted(cb);
+    (void)SendResult(cb, false);
+    auto begin = std::chrono::steady_clock::now();
+    TransferDataResult result;
+    EXPECT_EQ(waiter.Wait(TEST_TIMEOUT_MS, []() { return true; }, result), UEC_INTERFACE_READ_PARCEL_ERROR);
+    EXPECT_LT(ElapsedMs(begin), TEST_TIMEOUT_MS);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferWaiter003");
+}
+
+/**
+ * @tc.name: TransferWaiter004
+ * @tc.desc: a transfer still queued on its lane has no deadline yet, it only fails when the service dies
+ * @tc.type: FUNC
+ */
+HWTEST_F(UsbTransferWaiterTest, TransferWaiter004, TestSize.Level1)
+{
+    USB_HILOGI(MODULE_USB_SERVICE, "Case Start : TransferWaiter004");
+    UsbTransferWaiter waiter;
+    ASSERT_NE(waiter.GetCallback(), nullptr);
+    /* the service is seen alive on the first check and gone on the next */
+    int32_t checks = 0;
+    auto isAlive = [&checks]() { return ++checks < TEST_ALIVE_CHECKS; };
+    auto begin = std::chrono::steady_clock::now();
+    TransferDataResult result;
+    EXPECT_EQ(waiter.Wait(TEST_TIMEOUT_MS, isAlive, result), UEC_INTERFACE_DEAD_OBJECT);
+    EXPECT_EQ(checks, TEST_ALIVE_CHECKS);
+    EXPECT_GT(ElapsedMs(begin), TEST_TIMEOUT_MS);
+    USB_HILOGI(MODULE_USB_SERVICE, "Case End : TransferWaiter004");
+}
+} // TransferWaiterTest
+} // USB
+} // OHOS
@@ -0,0 +1,240 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_SERIAL_SHM_RING_H
+#define USB_SERIAL_SHM_RING_H
+
+#include <poll.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "securec.h"
+
+namespace OHOS {
+namespace USB {
+/* bytes of payload per direction, must be a power of two */
+constexpr uint32_t SERIAL_SHM_RING_CAPACITY = 64 * 1024;
+constexpr size_t SERIAL_SHM_CACHE_LINE = 64;
+
+/*
+ * Control block at the start of each ring. Positions run freely and wrap at 2^32, the payload index is
+ * position & (capacity - 1). A side that is about to sleep raises its waiting flag first, so the peer only
+ * rings the doorbell when somebody actually sleeps; a busy stream costs no syscall per chunk.
+ */
+struct SerialShmRingHeader {
+    alignas(SERIAL_SHM_CACHE_LINE) std::atomic<uint32_t> head;
+    alignas(SERIAL_SHM_CACHE_LINE) std::atomic<uint32_t> tail;
+    alignas(SERIAL_SHM_CACHE_LINE) std::atomic<uint32_t> consumerWaiting;
+    alignas(SERIAL_SHM_CACHE_LINE) std::atomic<uint32_t> producerWaiting;
+    std::atomic<uint32_t> closed;
+    /* raised by the consumer when it dropped bytes, taken by the producer */
+    std::atomic<uint32_t> failed;
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "shared ring positions must be lock free");
+
+constexpr size_t SERIAL_SHM_RING_SIZE = sizeof(SerialShmRingHeader) + SERIAL_SHM_RING_CAPACITY;
+/* one mapping carries the RX ring (service produces) followed by the TX ring (client produces) */
+constexpr size_t SERIAL_SHM_REGION_SIZE = SERIAL_SHM_RING_SIZE * 2;
+constexpr size_t SERIAL_SHM_RX_OFFSET = 0;
+constexpr size_t SERIAL_SHM_TX_OFFSET = SERIAL_SHM_RING_SIZE;
+
+/*
+ * Single-producer single-consumer byte ring over shared memory. dataFd is an eventfd the producer rings for
+ * a sleeping consumer, spaceFd the one the consumer rings for a sleeping producer. The object only borrows
+ * the mapping and the descriptors, their owner closes them.
+ */
+class SerialShmRing {
+public:
+    SerialShmRing() = default;
+    SerialShmRing(void *base, int32_t dataFd, int32_t spaceFd)
+        : header_(static_cast<SerialShmRingHeader *>(base)),
+          data_(static_cast<uint8_t *>(base) + sizeof(SerialShmRingHeader)), dataFd_(dataFd), spaceFd_(spaceFd)
+    {
+    }
+
+    void Reset()
+    {
+        header_->head.store(0);
+        header_->tail.store(0);
+        header_->consumerWaiting.store(0);
+        header_->producerWaiting.store(0);
+        header_->closed.store(0);
+        header_->failed.store(0);
+    }
+
+    uint32_t Readable() const
+    {
+        return header_->tail.load(std::memory_order_acquire) - header_->head.load(std::memory_order_relaxed);
+    }
+
+    uint32_t Writable() const
+    {
+        return SERIAL_SHM_RING_CAPACITY -
+            (header_->tail.load(std::memory_order_relaxed) - header_->head.load(std::memory_order_acquire));
+    }
+
+    bool IsClosed() const
+    {
+        return header_->closed.load() != 0;
+    }
+
+    /* copies as much as fits and returns the count, never blocks */
+    uint32_t Push(const uint8_t *data, uint32_t len)
+    {
+        uint32_t tail = header_->tail.load(std::memory_order_relaxed);
+        len = std::min(len, Writable());
+        if (len == 0) {
+            return 0;
+        }
+        CopyIn(data_, tail, data, len);
+        header_->tail.store(tail + len);
+        if (header_->consumerWaiting.load() != 0) {
+            Ring(dataFd_);
+        }
+        return len;
+    }
+
+    /* copies out as much as is buffered up to len and returns the count, never blocks */
+    uint32_t Pop(uint8_t *data, uint32_t len)
+    {
+        uint32_t head = header_->head.load(std::memory_order_relaxed);
+        len = std::min(len, Readable());
+        if (len == 0) {
+            return 0;
+        }
+        CopyOut(data_, head, data, len);
+        header_->head.store(head + len);
+        if (header_->producerWaiting.load() != 0) {
+            Ring(spaceFd_);
+        }
+        return len;
+    }
+
+    /* timeoutMs 0 waits until data arrives or the ring is closed, the peer can clear closed so the service bounds it */
+    bool WaitReadable(uint32_t timeoutMs)
+    {
+        return Wait(header_->consumerWaiting, dataFd_, timeoutMs, [this]() { return Readable() > 0; });
+    }
+
+    bool WaitWritable(uint32_t need, uint32_t timeoutMs)
+    {
+        need = std::min(need, SERIAL_SHM_RING_CAPACITY);
+        return Wait(header_->producerWaiting, spaceFd_, timeoutMs, [this, need]() { return Writable() >= need; });
+    }
+
+    /* the consumer could not pass buffered bytes on, the producer learns it once through TakeFailure */
+    void ReportFailure()
+    {
+        header_->failed.store(1);
+    }
+
+    bool TakeFailure()
+    {
+        return header_->failed.exchange(0) != 0;
+    }
+
+    /* wakes every waiter on both sides, later waits return immediately */
+    void Close()
+    {
+        header_->closed.store(1);
+        Ring(dataFd_);
+        Ring(spaceFd_);
+    }
+
+private:
+    static void CopyIn(uint8_t *ring, uint32_t pos, const uint8_t *buf, uint32_t len)
+    {
+        uint32_t offset = pos & (SERIAL_SHM_RING_CAPACITY - 1);
+        uint32_t first = std::min(len, SERIAL_SHM_RING_CAPACITY - offset);
+        (void)memcpy_s(ring + offset, SERIAL_SHM_RING_CAPACITY - offset, buf, first);
+        if (len > first) {
+            (void)memcpy_s(ring, SERIAL_SHM_RING_CAPACITY, buf + first, len - first);
+        }
+    }
+
+    static void CopyOut(const uint8_t *ring, uint32_t pos, uint8_t *buf, uint32_t len)
+    {
+        uint32_t offset = pos & (SERIAL_SHM_RING_CAPACITY - 1);
+        uint32_t first = std::min(len, SERIAL_SHM_RING_CAPACITY - offset);
+        (void)memcpy_s(buf, len, ring + offset, first);
+        if (len > first) {
+            (void)memcpy_s(buf + first, len - first, ring, len - first);
+        }
+    }
+
+    static void Ring(int32_t fd)
+    {
+        uint64_t one = 1;
+        (void)write(fd, &one, sizeof(one));
+    }
+
+    static void Drain(int32_t fd)
+    {
+        uint64_t count = 0;
+        (void)read(fd, &count, sizeof(count));
+    }
+
+    template <typename Ready>
+    bool Wait(std::atomic<uint32_t> &waiting, int32_t fd, uint32_t timeoutMs, Ready ready)
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(timeoutMs);
+        while (!ready()) {
+            if (IsClosed()) {
+                return false;
+            }
+            waiting.store(1);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            /* the peer publishes before it checks the flag, so one of us sees the other */
+            if (ready() || IsClosed()) {
+                waiting.store(0);
+                break;
+            }
+            int32_t waitMs = -1;
+            if (timeoutMs != 0) {
+                auto left = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    deadline - std::chrono::steady_clock::now()).count();
+                if (left <= 0) {
+                    waiting.store(0);
+                    return false;
+                }
+                waitMs = static_cast<int32_t>(left);
+            }
+            struct pollfd pfd = { .fd = fd, .events = POLLIN, .revents = 0 };
+            int32_t ret = poll(&pfd, 1, waitMs);
+            waiting.store(0);
+            if (ret > 0) {
+                Drain(fd);
+            } else if (ret < 0 && errno != EINTR) {
+                return false;
+            }
+        }
+        return ready();
+    }
+
+    SerialShmRingHeader *header_ = nullptr;
+    uint8_t *data_ = nullptr;
+    int32_t dataFd_ = -1;
+    int32_t spaceFd_ = -1;
+};
+} // namespace USB
+} // namespace OHOS
+
+#endif // USB_SERIAL_SHM_RING_H
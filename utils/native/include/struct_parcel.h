@@ -26,6 +26,8 @@ namespace OHOS {
 namespace USB {
 
 constexpr uint32_t MAX_NUM_OF_ISO_PACKAGE = 15000;
+constexpr uint32_t MAX_NUM_OF_BATCH_TRANSFER = 128;
+constexpr uint32_t MAX_NUM_OF_SUBMIT_BUFFER_SLOT = 32;
 
 struct UsbIsoParcel final : public Parcelable {
     UsbIsoParcel() = default;
@@ -82,6 +82,12 @@ constexpr uint32_t USB_CFG_SELF_POWERED = 0x80;
  */
 constexpr uint32_t USB_CFG_REMOTE_WAKEUP = 0x20;
 
+/**
+ * One-way request sent to the serialRemote of a subscribed serial port when data becomes available,
+ * carrying the port id, the number of buffered bytes and the overrun count
+ */
+constexpr uint32_t SERIAL_NOTIFY_DATA_AVAILABLE = 1;
+
 #define INVALID_STRING_VALUE ("")
 #define RETURN_IF_WITH_RET(cond, retval) \
     if (cond) {                          \
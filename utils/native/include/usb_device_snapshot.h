@@ -0,0 +1,176 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef USB_DEVICE_SNAPSHOT_H
+#define USB_DEVICE_SNAPSHOT_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "usb_device.h"
+
+namespace OHOS {
+namespace USB {
+constexpr uint32_t USB_DEVICE_SNAPSHOT_MAGIC = 0x53445355; // "USDS"
+constexpr uint16_t USB_DEVICE_SNAPSHOT_VERSION = 1;
+
+/*
+ * Device table encoded as fixed-size records, one table per level, children referenced by index range and
+ * strings by offset into a trailing pool. The service encodes it once per device table change, clients map
+ * it read-only and decode only the fields they touch.
+ */
+struct UsbSnapshotString {
+    uint32_t offset;
+    uint32_t length;
+};
+
+struct UsbSnapshotHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t headerSize;
+    uint32_t totalSize;
+    uint32_t deviceCount;
+    uint64_t sequence;
+    uint32_t devicesOffset;
+    uint32_t configsOffset;
+    uint32_t configCount;
+    uint32_t interfacesOffset;
+    uint32_t interfaceCount;
+    uint32_t endpointsOffset;
+    uint32_t endpointCount;
+    uint32_t stringsOffset;
+    uint32_t stringsSize;
+    uint32_t reserved;
+};
+
+struct UsbSnapshotDevice {
+    int32_t vendorId;
+    int32_t productId;
+    int32_t baseClass;
+    int32_t subClass;
+    int32_t protocol;
+    uint16_t bcdUSB;
+    uint16_t bcdDevice;
+    uint8_t busNum;
+    uint8_t devAddr;
+    uint8_t iManufacturer;
+    uint8_t iProduct;
+    uint8_t iSerialNumber;
+    uint8_t bMaxPacketSize0;
+    uint8_t reserved[2];
+    UsbSnapshotString name;
+    UsbSnapshotString manufacturerName;
+    UsbSnapshotString productName;
+    UsbSnapshotString version;
+    UsbSnapshotString serial;
+    uint32_t firstConfig;
+    uint32_t configCount;
+};
+
+struct UsbSnapshotConfig {
+    int32_t id;
+    uint32_t attributes;
+    int32_t maxPower;
+    uint8_t iConfiguration;
+    uint8_t reserved[3];
+    UsbSnapshotString name;
+    uint32_t firstInterface;
+    uint32_t interfaceCount;
+};
+
+struct UsbSnapshotInterface {
+    int32_t id;
+    int32_t protocol;
+    int32_t klass;
+    int32_t subClass;
+    int32_t alternateSetting;
+    uint8_t iInterface;
+    uint8_t reserved[3];
+    UsbSnapshotString name;
+    uint32_t firstEndpoint;
+    uint32_t endpointCount;
+};
+
+struct UsbSnapshotEndpoint {
+    uint32_t address;
+    uint32_t attributes;
+    int32_t interval;
+    int32_t maxPacketSize;
+    uint8_t interfaceId;
+    uint8_t reserved[3];
+    uint32_t maxBurst;
+    uint32_t maxStreams;
+    uint32_t mult;
+    uint32_t bytesPerInterval;
+};
+
+class UsbDeviceSnapshotWriter {
+public:
+    /* serial is left empty for callers that may not see it */
+    void AddDevice(UsbDevice &device, bool withSerial);
+    /* lays the tables out back to back and returns the encoded snapshot */
+    std::vector<uint8_t> Finish(uint64_t sequence) const;
+
+private:
+    UsbSnapshotString AddString(const std::string &str);
+
+    std::vector<UsbSnapshotDevice> devices_;
+    std::vector<UsbSnapshotConfig> configs_;
+    std::vector<UsbSnapshotInterface> interfaces_;
+    std::vector<UsbSnapshotEndpoint> endpoints_;
+    std::string strings_;
+};
+
+class UsbDeviceSnapshot {
+public:
+    UsbDeviceSnapshot() = default;
+    ~UsbDeviceSnapshot();
+    UsbDeviceSnapshot(const UsbDeviceSnapshot &) = delete;
+    UsbDeviceSnapshot &operator=(const UsbDeviceSnapshot &) = delete;
+
+    /* maps fd read-only and validates it, the snapshot keeps the mapping but not the descriptor */
+    static std::shared_ptr<UsbDeviceSnapshot> Map(int32_t fd, uint32_t size);
+    /* validates every offset and index range once, accessors do no further checks */
+    bool Attach(const uint8_t *data, uint32_t size);
+
+    uint64_t GetSequence() const;
+    uint32_t GetDeviceCount() const;
+    const UsbSnapshotDevice &GetDevice(uint32_t index) const;
+    const UsbSnapshotConfig &GetConfig(uint32_t index) const;
+    const UsbSnapshotInterface &GetInterface(uint32_t index) const;
+    const UsbSnapshotEndpoint &GetEndpoint(uint32_t index) const;
+    std::string_view GetString(const UsbSnapshotString &str) const;
+    /* rebuilds the legacy object of one device */
+    void ToDevice(uint32_t index, UsbDevice &device) const;
+
+private:
+    bool CheckString(const UsbSnapshotString &str) const;
+    bool CheckRange(uint32_t first, uint32_t count, uint32_t total) const;
+
+    const uint8_t *data_ = nullptr;
+    uint32_t size_ = 0;
+    void *mapping_ = nullptr;
+    const UsbSnapshotHeader *header_ = nullptr;
+    const UsbSnapshotDevice *devices_ = nullptr;
+    const UsbSnapshotConfig *configs_ = nullptr;
+    const UsbSnapshotInterface *interfaces_ = nullptr;
+    const UsbSnapshotEndpoint *endpoints_ = nullptr;
+    const char *strings_ = nullptr;
+};
+} // namespace USB
+} // namespace OHOS
+#endif // USB_DEVICE_SNAPSHOT_H
@@ -0,0 +1,341 @@
+/*
+ * Copyright (c) 2025 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "usb_device_snapshot.h"
+
+#include <cerrno>
+#include <sys/mman.h>
+#include <type_traits>
+#include "hilog_wrapper.h"
+#include "securec.h"
+
+namespace OHOS {
+namespace USB {
+constexpr uint32_t SNAPSHOT_ALIGN = 8;
+constexpr uint32_t SNAPSHOT_MAX_SIZE = 16 * 1024 * 1024;
+
+static_assert(std::is_trivially_copyable_v<UsbSnapshotHeader> && sizeof(UsbSnapshotHeader) % SNAPSHOT_ALIGN == 0,
+    "snapshot header layout");
+static_assert(std::is_trivially_copyable_v<UsbSnapshotDevice> && sizeof(UsbSnapshotDevice) % sizeof(uint32_t) == 0,
+    "snapshot device layout");
+static_assert(std::is_trivially_copyable_v<UsbSnapshotConfig> && sizeof(UsbSnapshotConfig) % sizeof(uint32_t) == 0,
+    "snapshot config layout");
+static_assert(std::is_trivially_copyable_v<UsbSnapshotInterface> &&
+    sizeof(UsbSnapshotInterface) % sizeof(uint32_t) == 0, "snapshot interface layout");
+static_assert(std::is_trivially_copyable_v<UsbSnapshotEndpoint> &&
+    sizeof(UsbSnapshotEndpoint) % sizeof(uint32_t) == 0, "snapshot endpoint layout");
+
+static uint32_t AlignUp(size_t size)
+{
+    return static_cast<uint32_t>((size + SNAPSHOT_ALIGN - 1) & ~static_cast<size_t>(SNAPSHOT_ALIGN - 1));
+}
+
+template <typename T>
+static void CopyTable(std::vector<uint8_t> &out, uint32_t offset, const std::vector<T> &table)
+{
+    if (!table.empty()) {
+        (void)memcpy_s(out.data() + offset, out.size() - offset, table.data(), table.size() * sizeof(T));
+    }
+}
+
+UsbSnapshotString UsbDeviceSnapshotWriter::AddString(const std::string &str)
+{
+    UsbSnapshotString ref = {static_cast<uint32_t>(strings_.size()), static_cast<uint32_t>(str.size())};
+    strings_.append(str);
+    return ref;
+}
+
+void UsbDeviceSnapshotWriter::AddDevice(UsbDevice &device, bool withSerial)
+{
+    UsbSnapshotDevice dev = {};
+    dev.vendorId = device.GetVendorId();
+    dev.productId = device.GetProductId();
+    dev.baseClass = device.GetClass();
+    dev.subClass = device.GetSubclass();
+    dev.protocol = device.GetProtocol();
+    dev.bcdUSB = device.GetbcdUSB();
+    dev.bcdDevice = device.GetbcdDevice();
+    dev.busNum = device.GetBusNum();
+    dev.devAddr = device.GetDevAddr();
+    dev.iManufacturer = device.GetiManufacturer();
+    dev.iProduct = device.GetiProduct();
+    dev.iSerialNumber = device.GetiSerialNumber();
+    dev.bMaxPacketSize0 = device.GetbMaxPacketSize0();
+    dev.name = AddString(device.GetName());
+    dev.manufacturerName = AddString(device.GetManufacturerName());
+    dev.productName = AddString(device.GetProductName());
+    dev.version = AddString(device.GetVersion());
+    dev.serial = AddString(withSerial ? device.GetmSerial() : std::string());
+    dev.firstConfig = static_cast<uint32_t>(configs_.size());
+    dev.configCount = static_cast<uint32_t>(device.GetConfigs().size());
+    for (auto &config : device.GetConfigs()) {
+        UsbSnapshotConfig cfg = {};
+        cfg.id = config.GetId();
+        cfg.attributes = config.GetAttributes();
+        cfg.maxPower = config.GetMaxPower();
+        cfg.iConfiguration = config.GetiConfiguration();
+        cfg.name = AddString(config.GetName());
+        cfg.firstInterface = static_cast<uint32_t>(interfaces_.size());
+        cfg.interfaceCount = static_cast<uint32_t>(config.GetInterfaces().size());
+        configs_.emplace_back(cfg);
+        for (auto &interface : config.GetInterfaces()) {
+            UsbSnapshotInterface intf = {};
+            intf.id = interface.GetId();
+            intf.protocol = interface.GetProtocol();
+            intf.klass = interface.GetClass();
+            intf.subClass = interface.GetSubClass();
+            intf.alternateSetting = interface.GetAlternateSetting();
+            intf.iInterface = interface.GetiInterface();
+            intf.name = AddString(interface.GetName());
+            intf.firstEndpoint = static_cast<uint32_t>(endpoints_.size());
+            intf.endpointCount = static_cast<uint32_t>(interface.GetEndpoints().size());
+            interfaces_.emplace_back(intf);
+            for (const auto &endpoint : interface.GetEndpoints()) {
+                UsbSnapshotEndpoint ep = {};
+                ep.address = endpoint.GetAddress();
+                ep.attributes = endpoint.GetAttributes();
+                ep.interval = endpoint.GetInterval();
+                ep.maxPacketSize = endpoint.GetMaxPacketSize();
+                ep.interfaceId = static_cast<uint8_t>(endpoint.GetInterfaceId());
+                ep.maxBurst = endpoint.GetMaxBurst();
+                ep.maxStreams = endpoint.GetMaxStreams();
+                ep.mult = endpoint.GetMult();
+                ep.bytesPerInterval = endpoint.GetBytesPerInterval();
+                endpoints_.emplace_back(ep);
+            }
+        }
+    }
+    devices_.emplace_back(dev);
+}
+
+std::vector<uint8_t> UsbDeviceSnapshotWriter::Finish(uint64_t sequence) const
+{
+    UsbSnapshotHeader header = {};
+    header.magic = USB_DEVICE_SNAPSHOT_MAGIC;
+    header.version = USB_DEVICE_SNAPSHOT_VERSION;
+    header.headerSize = sizeof(UsbSnapshotHeader);
+    header.sequence = sequence;
+    header.deviceCount = static_cast<uint32_t>(devices_.size());
+    header.configCount = static_cast<uint32_t>(configs_.size());
+    header.interfaceCount = static_cast<uint32_t>(interfaces_.size());
+    header.endpointCount = static_cast<uint32_t>(endpoints_.size());
+    header.devicesOffset = AlignUp(sizeof(UsbSnapshotHeader));
+    header.configsOffset = AlignUp(header.devicesOffset + devices_.size() * sizeof(UsbSnapshotDevice));
+    header.interfacesOffset = AlignUp(header.configsOffset + configs_.size() * sizeof(UsbSnapshotConfig));
+    header.endpointsOffset = AlignUp(header.interfacesOffset + interfaces_.size() * sizeof(UsbSnapshotInterface));
+    header.stringsOffset = AlignUp(header.endpointsOffset + endpoints_.size() * sizeof(UsbSnapshotEndpoint));
+    header.stringsSize = static_cast<uint32_t>(strings_.size());
+    header.totalSize = header.stringsOffset + header.stringsSize;
+
+    std::vector<uint8_t> out(header.totalSize, 0);
+    (void)memcpy_s(out.data(), out.size(), &header, sizeof(header));
+    CopyTable(out, header.devicesOffset, devices_);
+    CopyTable(out, header.configsOffset, configs_);
+    CopyTable(out, header.interfacesOffset, interfaces_);
+    CopyTable(out, header.endpointsOffset, endpoints_);
+    if (!strings_.empty()) {
+        (void)memcpy_s(out.data() + header.stringsOffset, header.stringsSize, strings_.data(), strings_.size());
+    }
+    return out;
+}
+
+UsbDeviceSnapshot::~UsbDeviceSnapshot()
+{
+    if (mapping_ != nullptr) {
+        munmap(mapping_, size_);
+        mapping_ = nullptr;
+    }
+}
+
+std::shared_ptr<UsbDeviceSnapshot> UsbDeviceSnapshot::Map(int32_t fd, uint32_t size)
+{
+    if (fd < 0 || size < sizeof(UsbSnapshotHeader) || size > SNAPSHOT_MAX_SIZE) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "invalid snapshot fd:%{public}d size:%{public}u", fd, size);
+        return nullptr;
+    }
+    void *mapping = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "map snapshot failed, errno:%{public}d", errno);
+        return nullptr;
+    }
+    auto snapshot = std::make_shared<UsbDeviceSnapshot>();
+    snapshot->mapping_ = mapping;
+    snapshot->size_ = size;
+    if (!snapshot->Attach(static_cast<const uint8_t *>(mapping), size)) {
+        return nullptr;
+    }
+    return snapshot;
+}
+
+bool UsbDeviceSnapshot::CheckString(const UsbSnapshotString &str) const
+{
+    return str.offset <= header_->stringsSize && str.length <= header_->stringsSize - str.offset;
+}
+
+bool UsbDeviceSnapshot::CheckRange(uint32_t first, uint32_t count, uint32_t total) const
+{
+    return first <= total && count <= total - first;
+}
+
+bool UsbDeviceSnapshot::Attach(const uint8_t *data, uint32_t size)
+{
+    if (data == nullptr || size < sizeof(UsbSnapshotHeader)) {
+        return false;
+    }
+    const UsbSnapshotHeader *header = reinterpret_cast<const UsbSnapshotHeader *>(data);
+    if (header->magic != USB_DEVICE_SNAPSHOT_MAGIC || header->version != USB_DEVICE_SNAPSHOT_VERSION ||
+        header->headerSize != sizeof(UsbSnapshotHeader) || header->totalSize > size) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "snapshot header mismatch, version:%{public}u", header->version);
+        return false;
+    }
+    auto fits = [header](uint32_t offset, uint64_t bytes) {
+        return offset % sizeof(uint32_t) == 0 && offset <= header->totalSize && bytes <= header->totalSize - offset;
+    };
+    if (!fits(header->devicesOffset, static_cast<uint64_t>(header->deviceCount) * sizeof(UsbSnapshotDevice)) ||
+        !fits(header->configsOffset, static_cast<uint64_t>(header->configCount) * sizeof(UsbSnapshotConfig)) ||
+        !fits(header->interfacesOffset,
+            static_cast<uint64_t>(header->interfaceCount) * sizeof(UsbSnapshotInterface)) ||
+        !fits(header->endpointsOffset, static_cast<uint64_t>(header->endpointCount) * sizeof(UsbSnapshotEndpoint)) ||
+        !fits(header->stringsOffset, header->stringsSize)) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "snapshot table out of range");
+        return false;
+    }
+    header_ = header;
+    devices_ = reinterpret_cast<const UsbSnapshotDevice *>(data + header->devicesOffset);
+    configs_ = reinterpret_cast<const UsbSnapshotConfig *>(data + header->configsOffset);
+    interfaces_ = reinterpret_cast<const UsbSnapshotInterface *>(data + header->interfacesOffset);
+    endpoints_ = reinterpret_cast<const UsbSnapshotEndpoint *>(data + header->endpointsOffset);
+    strings_ = reinterpret_cast<const char *>(data + header->stringsOffset);
+
+    bool valid = true;
+    for (uint32_t i = 0; valid && i < header->deviceCount; ++i) {
+        const UsbSnapshotDevice &dev = devices_[i];
+        valid = CheckString(dev.name) && CheckString(dev.manufacturerName) && CheckString(dev.productName) &&
+            CheckString(dev.version) && CheckString(dev.serial) &&
+            CheckRange(dev.firstConfig, dev.configCount, header->configCount);
+    }
+    for (uint32_t i = 0; valid && i < header->configCount; ++i) {
+        valid = CheckString(configs_[i].name) &&
+            CheckRange(configs_[i].firstInterface, configs_[i].interfaceCount, header->interfaceCount);
+    }
+    for (uint32_t i = 0; valid && i < header->interfaceCount; ++i) {
+        valid = CheckString(interfaces_[i].name) &&
+            CheckRange(interfaces_[i].firstEndpoint, interfaces_[i].endpointCount, header->endpointCount);
+    }
+    if (!valid) {
+        USB_HILOGE(MODULE_USB_INNERKIT, "snapshot reference out of range");
+        header_ = nullptr;
+        return false;
+    }
+    data_ = data;
+    size_ = size;
+    return true;
+}
+
+uint64_t UsbDeviceSnapshot::GetSequence() const
+{
+    return header_ == nullptr ? 0 : header_->sequence;
+}
+
+uint32_t UsbDeviceSnapshot::GetDeviceCount() const
+{
+    return header_ == nullptr ? 0 : header_->deviceCount;
+}
+
+const UsbSnapshotDevice &UsbDeviceSnapshot::GetDevice(uint32_t index) const
+{
+    return devices_[index];
+}
+
+const UsbSnapshotConfig &UsbDeviceSnapshot::GetConfig(uint32_t index) const
+{
+    return configs_[index];
+}
+
+const UsbSnapshotInterface &UsbDeviceSnapshot::GetInterface(uint32_t index) const
+{
+    return interfaces_[index];
+}
+
+const UsbSnapshotEndpoint &UsbDeviceSnapshot::GetEndpoint(uint32_t index) const
+{
+    return endpoints_[index];
+}
+
+std::string_view UsbDeviceSnapshot::GetString(const UsbSnapshotString &str) const
+{
+    return std::string_view(strings_ + str.offset, str.length);
+}
+
+void UsbDeviceSnapshot::ToDevice(uint32_t index, UsbDevice &device) const
+{
+    const UsbSnapshotDevice &dev = devices_[index];
+    device.SetBusNum(dev.busNum);
+    device.SetDevAddr(dev.devAddr);
+    device.SetVendorId(dev.vendorId);
+    device.SetProductId(dev.productId);
+    device.SetClass(dev.baseClass);
+    device.SetSubclass(dev.subClass);
+    device.SetProtocol(dev.protocol);
+    device.SetiManufacturer(dev.iManufacturer);
+    device.SetiProduct(dev.iProduct);
+    device.SetiSerialNumber(dev.iSerialNumber);
+    device.SetbMaxPacketSize0(dev.bMaxPacketSize0);
+    device.SetbcdUSB(dev.bcdUSB);
+    device.SetbcdDevice(dev.bcdDevice);
+    device.SetName(std::string(GetString(dev.name)));
+    device.SetManufacturerName(std::string(GetString(dev.manufacturerName)));
+    device.SetProductName(std::string(GetString(dev.productName)));
+    device.SetVersion(std::string(GetString(dev.version)));
+    device.SetmSerial(std::string(GetString(dev.serial)));
+    std::vector<USBConfig> &configs = device.GetConfigs();
+    configs.clear();
+    configs.reserve(dev.configCount);
+    for (uint32_t i = dev.firstConfig; i < dev.firstConfig + dev.configCount; ++i) {
+        const UsbSnapshotConfig &cfg = configs_[i];
+        USBConfig &config = configs.emplace_back();
+        config.SetId(cfg.id);
+        config.SetAttribute(cfg.attributes);
+        config.SetMaxPower(cfg.maxPower);
+        config.SetiConfiguration(cfg.iConfiguration);
+        config.SetName(std::string(GetString(cfg.name)));
+        std::vector<UsbInterface> &interfaces = config.GetInterfaces();
+        interfaces.reserve(cfg.interfaceCount);
+        for (uint32_t j = cfg.firstInterface; j < cfg.firstInterface + cfg.interfaceCount; ++j) {
+            const UsbSnapshotInterface &intf = interfaces_[j];
+            UsbInterface &interface = interfaces.emplace_back();
+            interface.SetId(intf.id);
+            interface.SetProtocol(intf.protocol);
+            interface.SetClass(intf.klass);
+            interface.SetSubClass(intf.subClass);
+            interface.SetAlternateSetting(intf.alternateSetting);
+            interface.SetiInterface(intf.iInterface);
+            interface.SetName(std::string(GetString(intf.name)));
+            std::vector<USBEndpoint> &eps = interface.GetEndpoints();
+            eps.reserve(intf.endpointCount);
+            for (uint32_t k = intf.firstEndpoint; k < intf.firstEndpoint + intf.endpointCount; ++k) {
+                const UsbSnapshotEndpoint &ep = endpoints_[k];
+                USBEndpoint &endpoint = eps.emplace_back(ep.address, ep.attributes, ep.interval, ep.maxPacketSize);
+                endpoint.SetInterfaceId(ep.interfaceId);
+                endpoint.SetMaxBurst(ep.maxBurst);
+                endpoint.SetMaxStreams(ep.maxStreams);
+                endpoint.SetMult(ep.mult);
+                endpoint.SetBytesPerInterval(ep.bytesPerInterval);
+            }
+        }
+    }
+}
+} // namespace USB
+} // namespace OHOS